@@ -0,0 +1,13 @@
+/* contrib/lwlock_bench/lwlock_bench--1.0.sql */
+
+-- complain if script is sourced in psql, rather than via CREATE EXTENSION
+\echo Use "CREATE EXTENSION lwlock_bench" to load this file. \quit
+
+CREATE FUNCTION pg_lwlock_benchmark(IN loops int8, IN numa_aware bool, IN shared_percent int4,
+    OUT acquires int8, OUT elapsed_us int8, OUT avg_wait_us float8, OUT max_wait_us int8)
+RETURNS record
+AS 'MODULE_PATHNAME', 'pg_lwlock_benchmark'
+LANGUAGE C STRICT VOLATILE;
+
+-- Don't want this to be available to public.
+REVOKE ALL ON FUNCTION pg_lwlock_benchmark(int8, bool, int4) FROM PUBLIC;
@@ -0,0 +1,136 @@
+/* -------------------------------------------------------------------------
+ *
+ * lwlock_bench.cpp
+ *	  compare the plain and the NUMA-aware LWLock wakeup policies
+ *
+ *	  contrib/lwlock_bench/lwlock_bench.cpp
+ *
+ * pg_lwlock_benchmark() hammers one of two locks kept by this module, a
+ * plain one and a NUMA-aware one. Sessions are threads of one process, so
+ * the locks and the data they protect can live in module memory and need
+ * no shared memory or fixed slot in the main LWLock array. Run it from many
+ * sessions at once, see src/test/performance/lwlock_bench.sh.
+ * -------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include <pthread.h>
+
+#include "funcapi.h"
+#include "miscadmin.h"
+#include "portability/instr_time.h"
+#include "storage/lwlock.h"
+#include "utils/timestamp.h"
+
+PG_MODULE_MAGIC;
+
+PG_FUNCTION_INFO_V1(pg_lwlock_benchmark);
+
+extern "C" Datum pg_lwlock_benchmark(PG_FUNCTION_ARGS);
+
+/* a plain lock and a NUMA-aware one */
+#define NUM_BENCH_LOCKS 2
+/* one cache line of data protected by each benchmark lock */
+#define BENCH_DATA_WORDS 8
+
+typedef struct BenchLock {
+    LWLockPadded lock;
+    volatile uint64 data[BENCH_DATA_WORDS];
+} BenchLock;
+
+static BenchLock bench_locks[NUM_BENCH_LOCKS];
+static pthread_once_t bench_locks_once = PTHREAD_ONCE_INIT;
+
+static void init_bench_locks(void)
+{
+    for (int i = 0; i < NUM_BENCH_LOCKS; i++) {
+        LWLockInitialize(&bench_locks[i].lock.lock, LWTRANCHE_UNKNOWN);
+        /* the second one is the NUMA-aware one, if the machine has several nodes */
+        LWLockSetNumaAware(&bench_locks[i].lock.lock, i == 1);
+    }
+}
+
+/*
+ * pg_lwlock_benchmark - acquire and release a benchmark LWLock in a loop
+ *
+ * Takes the lock in shared mode shared_percent percent of the time and
+ * touches the cache line it protects while holding it. Returns the number
+ * of acquisitions, the elapsed time and the average and maximum time an
+ * acquisition took, in microseconds.
+ */
+Datum pg_lwlock_benchmark(PG_FUNCTION_ARGS)
+{
+    int64 loops = PG_GETARG_INT64(0);
+    bool numa_aware = PG_GETARG_BOOL(1);
+    int32 shared_percent = PG_GETARG_INT32(2);
+    BenchLock* bench = &bench_locks[numa_aware ? 1 : 0];
+    LWLock* lock = &bench->lock.lock;
+    uint32 seed = (uint32)gs_thread_self() ^ (uint32)GetCurrentTimestamp();
+    int64 total_wait = 0;
+    int64 max_wait = 0;
+    instr_time start_time;
+    instr_time end_time;
+    TupleDesc tupdesc;
+    Datum values[4];
+    bool nulls[4] = {false, false, false, false};
+
+    if (!superuser()) {
+        ereport(ERROR,
+            (errcode(ERRCODE_INSUFFICIENT_PRIVILEGE), errmsg("must be system admin to run the LWLock benchmark")));
+    }
+    if (loops <= 0 || shared_percent < 0 || shared_percent > 100) {
+        ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE), errmsg("invalid LWLock benchmark parameters")));
+    }
+    if (get_call_result_type(fcinfo, NULL, &tupdesc) != TYPEFUNC_COMPOSITE) {
+        ereport(ERROR, (errcode(ERRCODE_DATATYPE_MISMATCH), errmsg("return type must be a row type")));
+    }
+
+    (void)pthread_once(&bench_locks_once, init_bench_locks);
+
+    INSTR_TIME_SET_CURRENT(start_time);
+    for (int64 i = 0; i < loops; i++) {
+        instr_time wait_start;
+        instr_time wait_end;
+
+        /* a cheap LCG is enough to mix the lock modes */
+        seed = seed * 1103515245 + 12345;
+        LWLockMode mode = ((int32)((seed >> 16) % 100) < shared_percent) ? LW_SHARED : LW_EXCLUSIVE;
+
+        INSTR_TIME_SET_CURRENT(wait_start);
+        (void)LWLockAcquire(lock, mode);
+        INSTR_TIME_SET_CURRENT(wait_end);
+
+        if (mode == LW_EXCLUSIVE) {
+            for (int j = 0; j < BENCH_DATA_WORDS; j++) {
+                bench->data[j]++;
+            }
+        } else {
+            uint64 sum = 0;
+            for (int j = 0; j < BENCH_DATA_WORDS; j++) {
+                sum += bench->data[j];
+            }
+            (void)sum;
+        }
+        LWLockRelease(lock);
+
+        INSTR_TIME_SUBTRACT(wait_end, wait_start);
+        int64 wait = (int64)INSTR_TIME_GET_MICROSEC(wait_end);
+        total_wait += wait;
+        max_wait = Max(max_wait, wait);
+
+        if ((i & 1023) == 0) {
+            CHECK_FOR_INTERRUPTS();
+        }
+    }
+    INSTR_TIME_SET_CURRENT(end_time);
+    INSTR_TIME_SUBTRACT(end_time, start_time);
+
+    values[0] = Int64GetDatum(loops);
+    values[1] = Int64GetDatum((int64)INSTR_TIME_GET_MICROSEC(end_time));
+    values[2] = Float8GetDatum((double)total_wait / (double)loops);
+    values[3] = Int64GetDatum(max_wait);
+
+    HeapTuple tuple = heap_form_tuple(BlessTupleDesc(tupdesc), values, nulls);
+    PG_RETURN_DATUM(HeapTupleGetDatum(tuple));
+}
@@ -62,6 +62,7 @@ typedef struct {
     bool skip_empty_xacts;
     bool xact_wrote_changes;
     bool only_local;
+    bool stream_changes;
 } TestDecodingData;
 
 static void pg_decode_startup(LogicalDecodingContext* ctx, OutputPluginOptions* opt, bool is_init);
@@ -73,6 +74,13 @@ static void pg_decode_commit_txn(LogicalDecodingContext* ctx, ReorderBufferTXN*
 static void pg_decode_change(
     LogicalDecodingContext* ctx, ReorderBufferTXN* txn, Relation rel, ReorderBufferChange* change);
 static bool pg_decode_filter(LogicalDecodingContext* ctx, RepOriginId origin_id);
+static void pg_output_change(LogicalDecodingContext* ctx, Relation relation, ReorderBufferChange* change);
+static void pg_decode_stream_start(LogicalDecodingContext* ctx, ReorderBufferTXN* txn);
+static void pg_decode_stream_change(
+    LogicalDecodingContext* ctx, ReorderBufferTXN* txn, Relation relation, ReorderBufferChange* change);
+static void pg_decode_stream_stop(LogicalDecodingContext* ctx, ReorderBufferTXN* txn);
+static void pg_decode_stream_abort(LogicalDecodingContext* ctx, ReorderBufferTXN* txn, XLogRecPtr abort_lsn);
+static void pg_decode_stream_commit(LogicalDecodingContext* ctx, ReorderBufferTXN* txn, XLogRecPtr commit_lsn);
 
 void _PG_init(void)
 {
@@ -90,6 +98,11 @@ void _PG_output_plugin_init(OutputPluginCallbacks* cb)
     cb->commit_cb = pg_decode_commit_txn;
     cb->filter_by_origin_cb = pg_decode_filter;
     cb->shutdown_cb = pg_decode_shutdown;
+    cb->stream_start_cb = pg_decode_stream_start;
+    cb->stream_change_cb = pg_decode_stream_change;
+    cb->stream_stop_cb = pg_decode_stream_stop;
+    cb->stream_abort_cb = pg_decode_stream_abort;
+    cb->stream_commit_cb = pg_decode_stream_commit;
 }
 
 /* initialize this plugin */
@@ -108,6 +121,7 @@ static void pg_decode_startup(LogicalDecodingContext* ctx, OutputPluginOptions*
     data->include_timestamp = false;
     data->skip_empty_xacts = false;
     data->only_local = true;
+    data->stream_changes = false;
 
     ctx->output_plugin_private = data;
 
@@ -161,6 +175,14 @@ static void pg_decode_startup(LogicalDecodingContext* ctx, OutputPluginOptions*
                 ereport(ERROR,
                     (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
                         errmsg("could not parse value \"%s\" for parameter \"%s\"", strVal(elem->arg), elem->defname)));
+        } else if (strcmp(elem->defname, "stream-changes") == 0) {
+
+            if (elem->arg == NULL)
+                data->stream_changes = true;
+            else if (!parse_bool(strVal(elem->arg), &data->stream_changes))
+                ereport(ERROR,
+                    (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+                        errmsg("could not parse value \"%s\" for parameter \"%s\"", strVal(elem->arg), elem->defname)));
         } else {
             ereport(ERROR,
                 (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
@@ -168,6 +190,10 @@ static void pg_decode_startup(LogicalDecodingContext* ctx, OutputPluginOptions*
                         "option \"%s\" = \"%s\" is unknown", elem->defname, elem->arg ? strVal(elem->arg) : "(null)")));
         }
     }
+
+    /* large transactions are only sent before their commit if the client asked for it */
+    if (!data->stream_changes)
+        ctx->streaming = false;
 }
 
 /* cleanup this plugin's resources */
@@ -362,12 +388,7 @@ static void tuple_to_jsoninfo(
 static void pg_decode_change(
     LogicalDecodingContext* ctx, ReorderBufferTXN* txn, Relation relation, ReorderBufferChange* change)
 {
-    TestDecodingData* data = NULL;
-    Form_pg_class class_form;
-    TupleDesc tupdesc;
-    MemoryContext old;
-    char* res = NULL;
-    data = (TestDecodingData*)ctx->output_plugin_private;
+    TestDecodingData* data = (TestDecodingData*)ctx->output_plugin_private;
 
     /* output BEGIN if we haven't yet */
     if (data->skip_empty_xacts && !data->xact_wrote_changes) {
@@ -375,6 +396,18 @@ static void pg_decode_change(
     }
     data->xact_wrote_changes = true;
 
+    pg_output_change(ctx, relation, change);
+}
+
+/* print one changed tuple as a json object */
+static void pg_output_change(LogicalDecodingContext* ctx, Relation relation, ReorderBufferChange* change)
+{
+    TestDecodingData* data = (TestDecodingData*)ctx->output_plugin_private;
+    Form_pg_class class_form;
+    TupleDesc tupdesc;
+    MemoryContext old;
+    char* res = NULL;
+
     class_form = RelationGetForm(relation);
     tupdesc = RelationGetDescr(relation);
 
@@ -442,3 +475,49 @@ static void pg_decode_change(
     MemoryContextReset(data->context);
     OutputPluginWrite(ctx, true);
 }
+
+/*
+ * Changes of a large transaction that is still running, sent in blocks
+ * between STREAM START and STREAM STOP.  The client keeps them until the
+ * STREAM COMMIT of the transaction, or drops them on its STREAM ABORT; after
+ * a reconnect the transaction is streamed again from its first change.  The
+ * xid is always printed, blocks of different transactions interleave.
+ */
+static void pg_decode_stream_start(LogicalDecodingContext* ctx, ReorderBufferTXN* txn)
+{
+    OutputPluginPrepareWrite(ctx, true);
+    appendStringInfo(ctx->out, "STREAM START %lu", txn->xid);
+    OutputPluginWrite(ctx, true);
+}
+
+static void pg_decode_stream_change(
+    LogicalDecodingContext* ctx, ReorderBufferTXN* txn, Relation relation, ReorderBufferChange* change)
+{
+    pg_output_change(ctx, relation, change);
+}
+
+static void pg_decode_stream_stop(LogicalDecodingContext* ctx, ReorderBufferTXN* txn)
+{
+    OutputPluginPrepareWrite(ctx, true);
+    appendStringInfo(ctx->out, "STREAM STOP %lu", txn->xid);
+    OutputPluginWrite(ctx, true);
+}
+
+static void pg_decode_stream_abort(LogicalDecodingContext* ctx, ReorderBufferTXN* txn, XLogRecPtr abort_lsn)
+{
+    OutputPluginPrepareWrite(ctx, true);
+    appendStringInfo(ctx->out, "STREAM ABORT %lu", txn->xid);
+    OutputPluginWrite(ctx, true);
+}
+
+static void pg_decode_stream_commit(LogicalDecodingContext* ctx, ReorderBufferTXN* txn, XLogRecPtr commit_lsn)
+{
+    TestDecodingData* data = (TestDecodingData*)ctx->output_plugin_private;
+
+    OutputPluginPrepareWrite(ctx, true);
+    appendStringInfo(ctx->out, "STREAM COMMIT %lu", txn->xid);
+    if (data->include_timestamp)
+        appendStringInfo(ctx->out, " (at %s)", timestamptz_to_str(txn->commit_time));
+    appendStringInfo(ctx->out, " CSN %lu", txn->csn);
+    OutputPluginWrite(ctx, true);
+}
@@ -1281,6 +1281,12 @@ CREATE VIEW gs_total_memory_detail AS SELECT * FROM pv_total_memory_detail();
 CREATE VIEW gs_redo_stat AS SELECT * FROM pg_stat_get_redo_stat();
 CREATE VIEW gs_session_stat AS SELECT * FROM pv_session_stat();
 CREATE VIEW gs_file_stat AS SELECT * FROM pg_stat_get_file_stat();
+CREATE VIEW gs_wal_compression_stat AS SELECT * FROM pg_stat_get_wal_compression();
+
+CREATE VIEW gs_buffer_policy_stat AS SELECT * FROM pg_stat_get_buffer_policy();
+
+CREATE VIEW gs_lwlock_wait_stat AS SELECT * FROM pg_stat_get_lwlock_waits();
+CREATE VIEW gs_lwlock_wait_holders AS SELECT * FROM pg_stat_get_lwlock_holders();
 
 CREATE OR REPLACE FUNCTION pg_catalog.gs_session_memory_detail_tp(OUT sessid TEXT, OUT sesstype TEXT, OUT contextname TEXT, OUT level INT2, OUT parent TEXT, OUT totalsize INT8, OUT freesize INT8, OUT usedsize INT8)
 RETURNS setof record
@@ -1393,7 +1399,9 @@ CREATE VIEW pg_stat_replication AS
             W.receiver_flush_location,
             W.receiver_replay_location,
             W.sync_priority,
-            W.sync_state
+            W.sync_state,
+            W.wal_buffer_hits,
+            W.wal_buffer_misses
     FROM pg_stat_get_activity(NULL) AS S, pg_authid U,
             pg_stat_get_wal_senders() AS W
     WHERE S.usesysid = U.oid AND
@@ -1488,6 +1496,34 @@ CREATE VIEW pg_stat_bgwriter AS
         pg_stat_get_buf_alloc() AS buffers_alloc,
         pg_stat_get_bgwriter_stat_reset_time() AS stats_reset;
 
+CREATE VIEW pg_stat_progress_vacuum AS
+    SELECT
+            S.pid,
+            S.datid,
+            D.datname,
+            S.relid,
+            S.phase,
+            S.heap_blks_total,
+            S.heap_blks_scanned,
+            S.heap_blks_vacuumed,
+            S.index_vacuum_count,
+            S.max_dead_tuple_bytes,
+            S.dead_tuple_bytes,
+            S.num_dead_tuples,
+            S.current_indexrelid
+    FROM pg_stat_get_vacuum_progress() AS S LEFT JOIN pg_database D ON (S.datid = D.oid);
+
+CREATE VIEW pg_stat_progress_vacuum_index AS
+    SELECT
+            S.pid,
+            S.relid,
+            S.indexrelid,
+            I.relname AS indexrelname,
+            S.vacuum_time,
+            S.cleanup_time,
+            S.in_progress
+    FROM pg_stat_get_vacuum_index_progress() AS S LEFT JOIN pg_class I ON (S.indexrelid = I.oid);
+
 CREATE VIEW pg_user_mappings AS
     SELECT
         U.oid       AS umid,
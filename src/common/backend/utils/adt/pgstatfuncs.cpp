@@ -32,6 +32,7 @@
 #include "miscadmin.h"
 #include "pgstat.h"
 #include "utils/acl.h"
+#include "utils/array.h"
 #include "utils/builtins.h"
 #include "utils/globalplancache.h"
 #include "utils/inet.h"
@@ -174,6 +175,10 @@ extern Datum pg_stat_get_bgwriter_stat_reset_time(PG_FUNCTION_ARGS);
 extern Datum pg_stat_get_buf_written_backend(PG_FUNCTION_ARGS);
 extern Datum pg_stat_get_buf_fsync_backend(PG_FUNCTION_ARGS);
 extern Datum pg_stat_get_buf_alloc(PG_FUNCTION_ARGS);
+extern Datum pg_stat_get_lwlock_waits(PG_FUNCTION_ARGS);
+extern Datum pg_stat_get_lwlock_holders(PG_FUNCTION_ARGS);
+extern Datum pg_stat_get_vacuum_progress(PG_FUNCTION_ARGS);
+extern Datum pg_stat_get_vacuum_index_progress(PG_FUNCTION_ARGS);
 
 extern Datum pg_stat_get_xact_numscans(PG_FUNCTION_ARGS);
 extern Datum pg_stat_get_xact_tuples_returned(PG_FUNCTION_ARGS);
@@ -7549,6 +7554,490 @@ Datum pg_stat_get_redo_stat(PG_FUNCTION_ARGS)
     }
 }
 
+/*
+ * Statistics of WAL record payload compression since the instance started.
+ * compress_time and decompress_time are in microseconds.
+ */
+Datum pg_stat_get_wal_compression(PG_FUNCTION_ARGS)
+{
+    FuncCallContext* func_ctx = NULL;
+
+    if (SRF_IS_FIRSTCALL()) {
+        TupleDesc tup_desc;
+        MemoryContext old_context;
+
+        func_ctx = SRF_FIRSTCALL_INIT();
+        old_context = MemoryContextSwitchTo(func_ctx->multi_call_memory_ctx);
+
+        /* this had better match gs_wal_compression_stat view in system_views.sql */
+        tup_desc = CreateTemplateTupleDesc(8, false);
+        TupleDescInitEntry(tup_desc, (AttrNumber)1, "compress_attempts", INT8OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)2, "compressed_records", INT8OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)3, "raw_bytes", INT8OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)4, "compressed_bytes", INT8OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)5, "compression_ratio", FLOAT8OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)6, "compress_time", INT8OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)7, "decompressed_records", INT8OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)8, "decompress_time", INT8OID, -1, 0);
+
+        func_ctx->tuple_desc = BlessTupleDesc(tup_desc);
+        func_ctx->max_calls = 1;
+        func_ctx->call_cntr = 0;
+
+        (void)MemoryContextSwitchTo(old_context);
+    }
+
+    func_ctx = SRF_PERCALL_SETUP();
+    if (func_ctx->call_cntr < func_ctx->max_calls) {
+        Datum values[8];
+        bool nulls[8] = {false};
+        HeapTuple tuple = NULL;
+        knl_g_xlog_context* xlog_cxt = &g_instance.xlog_cxt;
+        uint64 rawBytes = pg_atomic_read_u64(&xlog_cxt->compress_raw_bytes);
+        uint64 compressedBytes = pg_atomic_read_u64(&xlog_cxt->compressed_bytes);
+
+        values[0] = Int64GetDatum((int64)pg_atomic_read_u64(&xlog_cxt->compress_attempts));
+        values[1] = Int64GetDatum((int64)pg_atomic_read_u64(&xlog_cxt->compressed_records));
+        values[2] = Int64GetDatum((int64)rawBytes);
+        values[3] = Int64GetDatum((int64)compressedBytes);
+        if (compressedBytes > 0) {
+            values[4] = Float8GetDatum((double)rawBytes / (double)compressedBytes);
+        } else {
+            nulls[4] = true;
+        }
+        values[5] = Int64GetDatum((int64)pg_atomic_read_u64(&xlog_cxt->compress_time));
+        values[6] = Int64GetDatum((int64)pg_atomic_read_u64(&xlog_cxt->decompressed_records));
+        values[7] = Int64GetDatum((int64)pg_atomic_read_u64(&xlog_cxt->decompress_time));
+
+        tuple = heap_form_tuple(func_ctx->tuple_desc, values, nulls);
+        SRF_RETURN_NEXT(func_ctx, HeapTupleGetDatum(tuple));
+    } else {
+        SRF_RETURN_DONE(func_ctx);
+    }
+}
+
+/*
+ * Statistics of the shared buffer replacement policy since the instance
+ * started: one row per queue, plus a row for the 2Q ghost list whose hits
+ * are the reads that promoted a page into the am queue. Buffer hits are
+ * only counted under 2Q and are NULL under the clock policy.
+ */
+Datum pg_stat_get_buffer_policy(PG_FUNCTION_ARGS)
+{
+    FuncCallContext* func_ctx = NULL;
+    static const char* queueNames[BUF_QUEUE_NUM] = {"main", "a1in", "am"};
+    const int ghostRow = BUF_QUEUE_NUM;
+
+    if (SRF_IS_FIRSTCALL()) {
+        TupleDesc tup_desc;
+        MemoryContext old_context;
+
+        func_ctx = SRF_FIRSTCALL_INIT();
+        old_context = MemoryContextSwitchTo(func_ctx->multi_call_memory_ctx);
+
+        /* this had better match gs_buffer_policy_stat view in system_views.sql */
+        tup_desc = CreateTemplateTupleDesc(6, false);
+        TupleDescInitEntry(tup_desc, (AttrNumber)1, "policy", TEXTOID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)2, "queue", TEXTOID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)3, "buffers", INT8OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)4, "hits", INT8OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)5, "hit_ratio", FLOAT8OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)6, "evictions", INT8OID, -1, 0);
+
+        func_ctx->tuple_desc = BlessTupleDesc(tup_desc);
+        func_ctx->max_calls = BUF_QUEUE_NUM + 1;
+        func_ctx->call_cntr = 0;
+        func_ctx->user_fctx = palloc0(sizeof(BufferQueueStat) * (BUF_QUEUE_NUM + 1) + sizeof(uint64));
+        StrategyGetQueueStats((BufferQueueStat*)func_ctx->user_fctx, (BufferQueueStat*)func_ctx->user_fctx + ghostRow,
+            (uint64*)((BufferQueueStat*)func_ctx->user_fctx + ghostRow + 1));
+
+        (void)MemoryContextSwitchTo(old_context);
+    }
+
+    func_ctx = SRF_PERCALL_SETUP();
+    BufferQueueStat* stats = (BufferQueueStat*)func_ctx->user_fctx;
+    bool is2q = (g_instance.attr.attr_storage.buffer_replacement_policy == BUFFER_POLICY_2Q);
+
+    /* the main queue is only used under clock, the other rows only under 2Q */
+    while (func_ctx->call_cntr < func_ctx->max_calls &&
+           (func_ctx->call_cntr == BUF_QUEUE_MAIN) == is2q) {
+        func_ctx->call_cntr++;
+    }
+
+    if (func_ctx->call_cntr < func_ctx->max_calls) {
+        Datum values[6];
+        bool nulls[6] = {false};
+        HeapTuple tuple = NULL;
+        int row = (int)func_ctx->call_cntr;
+        uint64 lookups = *(uint64*)(stats + ghostRow + 1);
+
+        for (int q = 0; q < BUF_QUEUE_NUM; q++) {
+            lookups += stats[q].hits;
+        }
+
+        values[0] = CStringGetTextDatum(is2q ? "2q" : "clock");
+        values[1] = CStringGetTextDatum((row == ghostRow) ? "a1out" : queueNames[row]);
+        values[2] = Int64GetDatum((int64)stats[row].buffers);
+        /* hits are only counted under 2Q */
+        if (!is2q) {
+            nulls[3] = true;
+            nulls[4] = true;
+        } else {
+            values[3] = Int64GetDatum((int64)stats[row].hits);
+            if (lookups > 0) {
+                values[4] = Float8GetDatum((double)stats[row].hits / (double)lookups);
+            } else {
+                nulls[4] = true;
+            }
+        }
+        values[5] = Int64GetDatum((int64)stats[row].evictions);
+
+        tuple = heap_form_tuple(func_ctx->tuple_desc, values, nulls);
+        SRF_RETURN_NEXT(func_ctx, HeapTupleGetDatum(tuple));
+    } else {
+        SRF_RETURN_DONE(func_ctx);
+    }
+}
+
+static const char* LWLockModeName(int mode)
+{
+    return (mode == LW_EXCLUSIVE) ? "exclusive" : "shared";
+}
+
+static LWLockWaitStat* GetAllLWLockWaitStats(void)
+{
+    LWLockWaitStat* stats = (LWLockWaitStat*)palloc(sizeof(LWLockWaitStat) * LWLOCK_STAT_SLOTS);
+
+    for (int slot = 0; slot < LWLOCK_STAT_SLOTS; slot++) {
+        GetLWLockWaitStat(slot, &stats[slot]);
+    }
+
+    /* acquisitions are counted by every PGPROC on its own, without locking */
+    for (uint32 i = 0; i < g_instance.proc_base->allProcCount; i++) {
+        volatile PGPROC* proc = g_instance.proc_base->allProcs[i];
+
+        for (int slot = 0; slot < LWLOCK_STAT_SLOTS; slot++) {
+            stats[slot].acquires[LW_EXCLUSIVE] += proc->lwAcquires[slot][LW_EXCLUSIVE];
+            stats[slot].acquires[LW_SHARED] += proc->lwAcquires[slot][LW_SHARED];
+        }
+    }
+    return stats;
+}
+
+/*
+ * pg_stat_get_lwlock_waits - acquisitions and wait times per tranche and mode
+ *
+ * wait_histogram holds the number of contended acquisitions per log2 bucket
+ * of wait time in microseconds: element 1 counts waits below 1us, element i
+ * those in [2^(i-2), 2^(i-1)) us, the last element everything longer.
+ */
+Datum pg_stat_get_lwlock_waits(PG_FUNCTION_ARGS)
+{
+    FuncCallContext* func_ctx = NULL;
+    const int colNum = 6;
+
+    if (SRF_IS_FIRSTCALL()) {
+        TupleDesc tup_desc;
+        MemoryContext old_context;
+
+        func_ctx = SRF_FIRSTCALL_INIT();
+        old_context = MemoryContextSwitchTo(func_ctx->multi_call_memory_ctx);
+
+        /* this had better match gs_lwlock_wait_stat view in system_views.sql */
+        tup_desc = CreateTemplateTupleDesc(colNum, false);
+        TupleDescInitEntry(tup_desc, (AttrNumber)1, "tranche", TEXTOID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)2, "mode", TEXTOID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)3, "acquires", INT8OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)4, "contended", INT8OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)5, "wait_time_us", INT8OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)6, "wait_histogram", INT8ARRAYOID, -1, 0);
+
+        func_ctx->tuple_desc = BlessTupleDesc(tup_desc);
+        /* one row per slot and mode */
+        func_ctx->max_calls = LWLOCK_STAT_SLOTS * 2;
+        func_ctx->call_cntr = 0;
+        func_ctx->user_fctx = GetAllLWLockWaitStats();
+
+        (void)MemoryContextSwitchTo(old_context);
+    }
+
+    func_ctx = SRF_PERCALL_SETUP();
+    LWLockWaitStat* stats = (LWLockWaitStat*)func_ctx->user_fctx;
+
+    /* skip tranches never acquired in that mode */
+    while (func_ctx->call_cntr < func_ctx->max_calls &&
+           stats[func_ctx->call_cntr / 2].acquires[func_ctx->call_cntr % 2] == 0) {
+        func_ctx->call_cntr++;
+    }
+
+    if (func_ctx->call_cntr < func_ctx->max_calls) {
+        Datum values[colNum];
+        bool nulls[colNum] = {false};
+        Datum buckets[LWLOCK_WAIT_HIST_BUCKETS];
+        HeapTuple tuple = NULL;
+        int slot = (int)(func_ctx->call_cntr / 2);
+        int mode = (int)(func_ctx->call_cntr % 2);
+        LWLockWaitStat* stat = &stats[slot];
+
+        for (int i = 0; i < LWLOCK_WAIT_HIST_BUCKETS; i++) {
+            buckets[i] = Int64GetDatum((int64)stat->wait_hist[mode][i]);
+        }
+
+        values[0] = CStringGetTextDatum(GetLWLockStatSlotName(slot));
+        values[1] = CStringGetTextDatum(LWLockModeName(mode));
+        values[2] = Int64GetDatum((int64)stat->acquires[mode]);
+        values[3] = Int64GetDatum((int64)stat->contended[mode]);
+        values[4] = Int64GetDatum((int64)stat->wait_time[mode]);
+        values[5] = PointerGetDatum(
+            construct_array(buckets, LWLOCK_WAIT_HIST_BUCKETS, INT8OID, sizeof(int64), FLOAT8PASSBYVAL, 'd'));
+
+        tuple = heap_form_tuple(func_ctx->tuple_desc, values, nulls);
+        SRF_RETURN_NEXT(func_ctx, HeapTupleGetDatum(tuple));
+    } else {
+        SRF_RETURN_DONE(func_ctx);
+    }
+}
+
+/*
+ * pg_stat_get_lwlock_holders - recent contended waits and what the holder did
+ *
+ * Every tranche keeps its last LWLOCK_HOLDER_SAMPLES contended waits.  The
+ * holder columns are null when the lock was held in shared mode, as only
+ * exclusive holders are known.
+ */
+Datum pg_stat_get_lwlock_holders(PG_FUNCTION_ARGS)
+{
+    FuncCallContext* func_ctx = NULL;
+    const int colNum = 6;
+
+    if (SRF_IS_FIRSTCALL()) {
+        TupleDesc tup_desc;
+        MemoryContext old_context;
+
+        func_ctx = SRF_FIRSTCALL_INIT();
+        old_context = MemoryContextSwitchTo(func_ctx->multi_call_memory_ctx);
+
+        /* this had better match gs_lwlock_wait_holders view in system_views.sql */
+        tup_desc = CreateTemplateTupleDesc(colNum, false);
+        TupleDescInitEntry(tup_desc, (AttrNumber)1, "tranche", TEXTOID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)2, "waiter_mode", TEXTOID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)3, "wait_us", INT8OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)4, "holder_tid", INT8OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)5, "holder_query_id", INT8OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)6, "holder_wait_event", TEXTOID, -1, 0);
+
+        func_ctx->tuple_desc = BlessTupleDesc(tup_desc);
+        /* one row per slot and sample */
+        func_ctx->max_calls = LWLOCK_STAT_SLOTS * LWLOCK_HOLDER_SAMPLES;
+        func_ctx->call_cntr = 0;
+        func_ctx->user_fctx = GetAllLWLockWaitStats();
+
+        (void)MemoryContextSwitchTo(old_context);
+    }
+
+    func_ctx = SRF_PERCALL_SETUP();
+    LWLockWaitStat* stats = (LWLockWaitStat*)func_ctx->user_fctx;
+
+    while (func_ctx->call_cntr < func_ctx->max_calls &&
+           (int)(func_ctx->call_cntr % LWLOCK_HOLDER_SAMPLES) >=
+               stats[func_ctx->call_cntr / LWLOCK_HOLDER_SAMPLES].nsamples) {
+        func_ctx->call_cntr++;
+    }
+
+    if (func_ctx->call_cntr < func_ctx->max_calls) {
+        Datum values[colNum];
+        bool nulls[colNum] = {false};
+        HeapTuple tuple = NULL;
+        int slot = (int)(func_ctx->call_cntr / LWLOCK_HOLDER_SAMPLES);
+        LWLockHolderSample* sample = &stats[slot].samples[func_ctx->call_cntr % LWLOCK_HOLDER_SAMPLES];
+
+        values[0] = CStringGetTextDatum(GetLWLockStatSlotName(slot));
+        values[1] = CStringGetTextDatum(LWLockModeName(sample->waiter_mode));
+        values[2] = Int64GetDatum(sample->wait_us);
+        if (sample->holder_tid != 0) {
+            values[3] = Int64GetDatum((int64)sample->holder_tid);
+            values[4] = Int64GetDatum((int64)sample->holder_query_id);
+            values[5] = CStringGetTextDatum(
+                (sample->holder_wait_event != 0) ? pgstat_get_wait_event(sample->holder_wait_event) : "none");
+        } else {
+            nulls[3] = true;
+            nulls[4] = true;
+            nulls[5] = true;
+        }
+
+        tuple = heap_form_tuple(func_ctx->tuple_desc, values, nulls);
+        SRF_RETURN_NEXT(func_ctx, HeapTupleGetDatum(tuple));
+    } else {
+        SRF_RETURN_DONE(func_ctx);
+    }
+}
+
+/* a backend running lazy vacuum, as seen by the progress functions */
+typedef struct VacuumProgressEntry {
+    ThreadId pid;
+    Oid datid;
+    VacuumProgress progress;
+} VacuumProgressEntry;
+
+/* copy the progress of every backend running lazy vacuum, returns the count */
+static int GetVacuumProgressEntries(VacuumProgressEntry** entries)
+{
+    int numbackends = pgstat_fetch_stat_numbackends();
+    int n = 0;
+
+    *entries = (VacuumProgressEntry*)palloc0(Max(numbackends, 1) * sizeof(VacuumProgressEntry));
+    for (int i = 1; i <= numbackends; i++) {
+        PgBackendStatus* beentry = pgstat_fetch_stat_beentry(i);
+
+        if (beentry == NULL || beentry->st_procpid == 0 || !OidIsValid(beentry->st_vacuum_progress.relid))
+            continue;
+
+        (*entries)[n].pid = beentry->st_procpid;
+        (*entries)[n].datid = beentry->st_databaseid;
+        (*entries)[n].progress = beentry->st_vacuum_progress;
+        n++;
+    }
+    return n;
+}
+
+/*
+ * pg_stat_get_vacuum_progress - one row per backend running lazy vacuum
+ */
+Datum pg_stat_get_vacuum_progress(PG_FUNCTION_ARGS)
+{
+    FuncCallContext* func_ctx = NULL;
+    const int colNum = 12;
+
+    if (SRF_IS_FIRSTCALL()) {
+        TupleDesc tup_desc;
+        MemoryContext old_context;
+        VacuumProgressEntry* entries = NULL;
+
+        func_ctx = SRF_FIRSTCALL_INIT();
+        old_context = MemoryContextSwitchTo(func_ctx->multi_call_memory_ctx);
+
+        /* this had better match pg_stat_progress_vacuum view in system_views.sql */
+        tup_desc = CreateTemplateTupleDesc(colNum, false);
+        TupleDescInitEntry(tup_desc, (AttrNumber)1, "pid", INT8OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)2, "datid", OIDOID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)3, "relid", OIDOID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)4, "phase", TEXTOID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)5, "heap_blks_total", INT8OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)6, "heap_blks_scanned", INT8OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)7, "heap_blks_vacuumed", INT8OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)8, "index_vacuum_count", INT8OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)9, "max_dead_tuple_bytes", INT8OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)10, "dead_tuple_bytes", INT8OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)11, "num_dead_tuples", INT8OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)12, "current_indexrelid", OIDOID, -1, 0);
+
+        func_ctx->tuple_desc = BlessTupleDesc(tup_desc);
+        func_ctx->max_calls = GetVacuumProgressEntries(&entries);
+        func_ctx->user_fctx = entries;
+
+        (void)MemoryContextSwitchTo(old_context);
+    }
+
+    func_ctx = SRF_PERCALL_SETUP();
+
+    if (func_ctx->call_cntr < func_ctx->max_calls) {
+        Datum values[colNum];
+        bool nulls[colNum] = {false};
+        HeapTuple tuple = NULL;
+        VacuumProgressEntry* entry = &((VacuumProgressEntry*)func_ctx->user_fctx)[func_ctx->call_cntr];
+        VacuumProgress* progress = &entry->progress;
+
+        values[0] = Int64GetDatum((int64)entry->pid);
+        values[1] = ObjectIdGetDatum(entry->datid);
+        values[2] = ObjectIdGetDatum(progress->relid);
+        values[3] = CStringGetTextDatum(
+            pgstat_get_vacuum_phase_name((VacuumProgressPhase)progress->params[VACUUM_PROGRESS_PHASE]));
+        values[4] = Int64GetDatum(progress->params[VACUUM_PROGRESS_HEAP_BLKS_TOTAL]);
+        values[5] = Int64GetDatum(progress->params[VACUUM_PROGRESS_HEAP_BLKS_SCANNED]);
+        values[6] = Int64GetDatum(progress->params[VACUUM_PROGRESS_HEAP_BLKS_VACUUMED]);
+        values[7] = Int64GetDatum(progress->params[VACUUM_PROGRESS_INDEX_VACUUM_COUNT]);
+        values[8] = Int64GetDatum(progress->params[VACUUM_PROGRESS_MAX_DEAD_TUPLE_BYTES]);
+        values[9] = Int64GetDatum(progress->params[VACUUM_PROGRESS_DEAD_TUPLE_BYTES]);
+        values[10] = Int64GetDatum(progress->params[VACUUM_PROGRESS_NUM_DEAD_TUPLES]);
+        if (progress->current_index >= 0 && progress->current_index < progress->nindexes)
+            values[11] = ObjectIdGetDatum(progress->indexes[progress->current_index].indexoid);
+        else
+            nulls[11] = true;
+
+        tuple = heap_form_tuple(func_ctx->tuple_desc, values, nulls);
+        SRF_RETURN_NEXT(func_ctx, HeapTupleGetDatum(tuple));
+    } else {
+        SRF_RETURN_DONE(func_ctx);
+    }
+}
+
+/*
+ * pg_stat_get_vacuum_index_progress - time spent so far on each index of the
+ * relations being vacuumed
+ */
+Datum pg_stat_get_vacuum_index_progress(PG_FUNCTION_ARGS)
+{
+    FuncCallContext* func_ctx = NULL;
+    const int colNum = 6;
+
+    if (SRF_IS_FIRSTCALL()) {
+        TupleDesc tup_desc;
+        MemoryContext old_context;
+        VacuumProgressEntry* entries = NULL;
+        int nentries;
+        int nrows = 0;
+
+        func_ctx = SRF_FIRSTCALL_INIT();
+        old_context = MemoryContextSwitchTo(func_ctx->multi_call_memory_ctx);
+
+        /* this had better match pg_stat_progress_vacuum_index view in system_views.sql */
+        tup_desc = CreateTemplateTupleDesc(colNum, false);
+        TupleDescInitEntry(tup_desc, (AttrNumber)1, "pid", INT8OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)2, "relid", OIDOID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)3, "indexrelid", OIDOID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)4, "vacuum_time", INT8OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)5, "cleanup_time", INT8OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)6, "in_progress", BOOLOID, -1, 0);
+
+        func_ctx->tuple_desc = BlessTupleDesc(tup_desc);
+        nentries = GetVacuumProgressEntries(&entries);
+        for (int i = 0; i < nentries; i++)
+            nrows += entries[i].progress.nindexes;
+        func_ctx->max_calls = nrows;
+        func_ctx->user_fctx = entries;
+
+        (void)MemoryContextSwitchTo(old_context);
+    }
+
+    func_ctx = SRF_PERCALL_SETUP();
+
+    if (func_ctx->call_cntr < func_ctx->max_calls) {
+        Datum values[colNum];
+        bool nulls[colNum] = {false};
+        HeapTuple tuple = NULL;
+        VacuumProgressEntry* entry = (VacuumProgressEntry*)func_ctx->user_fctx;
+        int idx = (int)func_ctx->call_cntr;
+
+        /* find the backend the row belongs to */
+        while (idx >= entry->progress.nindexes) {
+            idx -= entry->progress.nindexes;
+            entry++;
+        }
+
+        values[0] = Int64GetDatum((int64)entry->pid);
+        values[1] = ObjectIdGetDatum(entry->progress.relid);
+        values[2] = ObjectIdGetDatum(entry->progress.indexes[idx].indexoid);
+        values[3] = Int64GetDatum(entry->progress.indexes[idx].vacuum_time);
+        values[4] = Int64GetDatum(entry->progress.indexes[idx].cleanup_time);
+        values[5] = BoolGetDatum(entry->progress.current_index == idx);
+
+        tuple = heap_form_tuple(func_ctx->tuple_desc, values, nulls);
+        SRF_RETURN_NEXT(func_ctx, HeapTupleGetDatum(tuple));
+    } else {
+        SRF_RETURN_DONE(func_ctx);
+    }
+}
+
 const char* SessionStatisticsTypeName[N_TOTAL_SESSION_STATISTICS_TYPES] = {"n_commit",
     "n_rollback",
     "n_sql",
@@ -12451,6 +12940,87 @@ Datum gs_globalplancache_prepare_status(PG_FUNCTION_ARGS)
     }
 }
 
+Datum gs_globalplancache_variant_status(PG_FUNCTION_ARGS)
+{
+#ifndef ENABLE_MULTIPLE_NODES
+    DISTRIBUTED_FEATURE_NOT_SUPPORTED();
+#endif
+
+    FuncCallContext *func_ctx = NULL;
+    MemoryContext old_context;
+
+    /* stuff done only on the first call of the function */
+    if (SRF_IS_FIRSTCALL()) {
+        TupleDesc tup_desc;
+
+        /* create a function context for cross-call persistence */
+        func_ctx = SRF_FIRSTCALL_INIT();
+
+        /*
+         * switch to memory context appropriate for multiple function
+         * calls
+         */
+        old_context = MemoryContextSwitchTo(func_ctx->multi_call_memory_ctx);
+
+#define GPC_VARIANT_TUPLES_ATTR_NUM 7
+
+        tup_desc = CreateTemplateTupleDesc(GPC_VARIANT_TUPLES_ATTR_NUM, false);
+
+        TupleDescInitEntry(tup_desc, (AttrNumber) 1, "nodename", TEXTOID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber) 2, "query", TEXTOID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber) 3, "variant", INT4OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber) 4, "signature", INT8OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber) 5, "hits", INT8OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber) 6, "exec_count", INT8OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber) 7, "total_exec_time", INT8OID, -1, 0);
+
+        /* complete descriptor of the tupledesc */
+        func_ctx->tuple_desc = BlessTupleDesc(tup_desc);
+
+        /* total number of tuples to be returned */
+        if (ENABLE_THREAD_POOL && ENABLE_DN_GPC) {
+            func_ctx->user_fctx = (void *)GPC->GetVariantStatus(&(func_ctx->max_calls));
+        } else {
+            func_ctx->max_calls = 0;
+        }
+
+        (void)MemoryContextSwitchTo(old_context);
+    }
+
+    /* stuff done on every call of the function */
+    func_ctx = SRF_PERCALL_SETUP();
+    GPCVariantStatus *entry = (GPCVariantStatus *)func_ctx->user_fctx;
+
+    if (func_ctx->call_cntr < func_ctx->max_calls) {
+        /* do when there is more left to send */
+        Datum values[GPC_VARIANT_TUPLES_ATTR_NUM];
+        bool nulls[GPC_VARIANT_TUPLES_ATTR_NUM];
+        HeapTuple tuple;
+
+        errno_t rc = 0;
+        rc = memset_s(values, sizeof(values), 0, sizeof(values));
+        securec_check(rc, "\0", "\0");
+        rc = memset_s(nulls, sizeof(nulls), 0, sizeof(nulls));
+        securec_check(rc, "\0", "\0");
+
+        entry += func_ctx->call_cntr;
+
+        values[0] = CStringGetTextDatum(g_instance.attr.attr_common.PGXCNodeName);
+        values[1] = CStringGetTextDatum(entry->query);
+        values[2] = Int32GetDatum(entry->variant);
+        values[3] = Int64GetDatum((int64)entry->signature);
+        values[4] = Int64GetDatum(entry->hits);
+        values[5] = Int64GetDatum(entry->exec_count);
+        values[6] = Int64GetDatum(entry->total_exec_time);
+
+        tuple = heap_form_tuple(func_ctx->tuple_desc, values, nulls);
+        SRF_RETURN_NEXT(func_ctx, HeapTupleGetDatum(tuple));
+    } else {
+        /* do when there is no more left */
+        SRF_RETURN_DONE(func_ctx);
+    }
+}
+
 Datum local_rto_stat(PG_FUNCTION_ARGS)
 {
     TupleDesc tup_desc = NULL;
@@ -42,6 +42,7 @@
 #include "utils/extended_statistics.h"
 #include "utils/fmgroids.h"
 #include "utils/fmgrtab.h"
+#include "utils/globalcatcache.h"
 #include "utils/hashutils.h"
 #include "utils/inval.h"
 #include "utils/lsyscache.h"
@@ -100,7 +101,7 @@ static void cat_cache_remove_ctup(CatCache* cache, CatCTup* ct);
 static void cat_cache_remove_clist(CatCache* cache, CatCList* cl);
 static void catalog_cache_initialize_cache(CatCache* cache);
 static CatCTup* catalog_cache_create_entry(CatCache* cache, HeapTuple ntp, Datum* arguments, uint32 hashValue,
-    Index hashIndex, bool negative, bool isnailed = false);
+    Index hashIndex, bool negative, bool isnailed = false, GlobalCatCTup* gct = NULL);
 static void cat_cache_free_keys(TupleDesc tupdesc, int nkeys, const int* attnos, Datum* keys);
 static void cat_cache_copy_keys(TupleDesc tupdesc, int nkeys, const int* attnos, Datum* srckeys, Datum* dstkeys);
 
@@ -515,6 +516,9 @@ static void cat_cache_remove_ctup(CatCache* cache, CatCTup* ct)
     if (ct->negative) {
         cat_cache_free_keys(cache->cc_tupdesc, cache->cc_nkeys, cache->cc_keyno, ct->keys);
     }
+    if (ct->global != NULL) {
+        GlobalCatCacheRelease(ct->global);
+    }
     pfree_ext(ct);
 
     --cache->cc_ntup;
@@ -771,6 +775,36 @@ void ResetCatalogCaches(void)
     }
 }
 
+/*
+ *		AtSessExit_CatCache
+ *
+ * Drop the references this session holds on global catalog cache entries.
+ * The session's catcache memory goes away with it, but the shared tuples
+ * must be freed once they are invalidated.
+ */
+void AtSessExit_CatCache(int code, Datum arg)
+{
+    CatCache* cache = NULL;
+
+    if (u_sess->cache_cxt.cache_header == NULL) {
+        return;
+    }
+
+    for (cache = u_sess->cache_cxt.cache_header->ch_caches; cache; cache = cache->cc_next) {
+        for (int i = 0; i < cache->cc_nbuckets; i++) {
+            for (Dlelem* elt = DLGetHead(&cache->cc_bucket[i]); elt; elt = DLGetSucc(elt)) {
+                CatCTup* ct = (CatCTup*)DLE_VAL(elt);
+
+                if (ct->global != NULL) {
+                    GlobalCatCacheRelease(ct->global);
+                    ct->global = NULL;
+                    ct->dead = true;
+                }
+            }
+        }
+    }
+}
+
 /*
  *		CatalogCacheFlushCatalog
  *
@@ -1395,6 +1429,8 @@ static HeapTuple search_cat_cache_miss(
     CatCTup* ct = NULL;
     Datum arguments[CATCACHE_MAXKEYS];
     errno_t rc = EOK;
+    bool use_global = false;
+    uint64 global_version = 0;
 
     /* Initialize local parameter array */
     arguments[0] = v1;
@@ -1443,7 +1479,24 @@ static HeapTuple search_cat_cache_miss(
      * will eventually age out of the cache, so there's no functional problem.
      * This case is rare enough that it's not worth expending extra cycles to
      * detect.
+     *
+     * In thread pool mode, another session may have loaded the tuple into the
+     * global catalog cache already; then we just point at its copy.
      */
+    if (ct == NULL && GlobalCatCacheUsable(cache)) {
+        GlobalCatCTup* gct = GlobalCatCacheSearch(cache, hash_value, arguments, &global_version);
+
+        if (gct != NULL) {
+            ct = catalog_cache_create_entry(cache, NULL, arguments, hash_value, hash_index, false, false, gct);
+            /* immediately set the refcount to 1 */
+            ResourceOwnerEnlargeCatCacheRefs(t_thrd.utils_cxt.CurrentResourceOwner);
+            ct->refcount++;
+            ResourceOwnerRememberCatCacheRef(t_thrd.utils_cxt.CurrentResourceOwner, &ct->tuple);
+        } else {
+            use_global = true;
+        }
+    }
+
     if (ct == NULL) {
         relation = heap_open(cache->cc_reloid, AccessShareLock);
 
@@ -1453,7 +1506,16 @@ static HeapTuple search_cat_cache_miss(
             relation, cache->cc_indexoid, index_scan_ok(cache, cur_skey), SnapshotNow, nkeys, cur_skey);
 
         while (HeapTupleIsValid(ntp = systable_getnext(scandesc))) {
-            ct = catalog_cache_create_entry(cache, ntp, arguments, hash_value, hash_index, false);
+            GlobalCatCTup* gct = NULL;
+
+            if (use_global) {
+                gct = GlobalCatCacheInsert(cache, hash_value, ntp, global_version);
+            }
+            if (gct != NULL) {
+                ct = catalog_cache_create_entry(cache, NULL, arguments, hash_value, hash_index, false, false, gct);
+            } else {
+                ct = catalog_cache_create_entry(cache, ntp, arguments, hash_value, hash_index, false);
+            }
             /* immediately set the refcount to 1 */
             ResourceOwnerEnlargeCatCacheRefs(t_thrd.utils_cxt.CurrentResourceOwner);
             ct->refcount++;
@@ -2408,16 +2470,30 @@ void ReleaseCatCacheList(CatCList* list)
  * catalog_cache_create_entry
  *		Create a new CatCTup entry, copying the given HeapTuple and other
  *		supplied data into it.	The new entry initially has refcount 0.
+ *
+ * If gct is given, the entry points at the tuple of that global catalog cache
+ * entry instead, and takes over the caller's reference on it.
  */
-static CatCTup* catalog_cache_create_entry(
-    CatCache* cache, HeapTuple ntp, Datum* arguments, uint32 hashValue, Index hashIndex, bool negative, bool isnailed)
+static CatCTup* catalog_cache_create_entry(CatCache* cache, HeapTuple ntp, Datum* arguments, uint32 hashValue,
+    Index hashIndex, bool negative, bool isnailed, GlobalCatCTup* gct)
 {
     CatCTup* ct = NULL;
     HeapTuple dtp;
     MemoryContext oldcxt;
 
-    /* negative entries have no tuple associated */
-    if (ntp) {
+    if (gct != NULL) {
+        errno_t rc;
+        Assert(ntp == NULL && !negative);
+
+        oldcxt = MemoryContextSwitchTo(u_sess->cache_mem_cxt);
+        ct = (CatCTup*)palloc(sizeof(CatCTup));
+        MemoryContextSwitchTo(oldcxt);
+
+        /* share the tuple body, keys point into it as well */
+        ct->tuple = gct->tuple;
+        rc = memcpy_s(ct->keys, sizeof(ct->keys), gct->keys, sizeof(gct->keys));
+        securec_check(rc, "", "");
+    } else if (ntp) {
         int i;
         errno_t rc;
         Assert(!negative);
@@ -2468,6 +2544,7 @@ static CatCTup* catalog_cache_create_entry(
             ct->keys[i] = atp;
         }
     } else {
+        /* negative entries have no tuple associated */
         Assert(negative);
         oldcxt = MemoryContextSwitchTo(u_sess->cache_mem_cxt);
         ct = (CatCTup*)palloc(sizeof(CatCTup));
@@ -2493,6 +2570,7 @@ static CatCTup* catalog_cache_create_entry(
     ct->isnailed = isnailed;
     ct->negative = negative;
     ct->hash_value = hashValue;
+    ct->global = gct;
 
     DLAddHead(&cache->cc_bucket[hashIndex], &ct->cache_elem);
 
@@ -0,0 +1,417 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * globalcatcache.cpp
+ *    instance-wide catalog cache shared by thread pool sessions
+ *
+ * Concurrency: every bucket is guarded by its partition lock.  Readers pin
+ * an entry by bumping its refcount under the shared lock; invalidation
+ * unlinks entries under the exclusive lock and the last reference frees
+ * them.  A session loading a row from the catalog remembers the bucket
+ * version seen before its scan, and only publishes the row if no
+ * invalidation hit the bucket meanwhile: the row may predate a commit
+ * whose invalidation already went by.  The eviction sweep takes the same
+ * exclusive lock, but leaves the version alone since the rows it drops are
+ * not stale.
+ *
+ * IDENTIFICATION
+ *    src/common/backend/utils/cache/globalcatcache.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include "access/tuptoaster.h"
+#include "miscadmin.h"
+#include "storage/lwlock.h"
+#include "threadpool/threadpool.h"
+#include "utils/globalcatcache.h"
+#include "utils/inval.h"
+#include "utils/memutils.h"
+
+static inline uint32 GlobalCatCacheBucketIndex(Oid dbId, int cacheId, uint32 hashValue)
+{
+    return (hashValue ^ ((uint32)cacheId * 0x9E3779B1U) ^ (uint32)dbId) & (GLOBAL_CATCACHE_NUM_BUCKETS - 1);
+}
+
+static inline LWLock* GlobalCatCachePartitionLock(uint32 bucket)
+{
+    return GetMainLWLockByIndex(FirstGlobalCatCacheLock + (int)(bucket % NUM_GLOBAL_CATCACHE_PARTITIONS));
+}
+
+/* entries of shared catalogs are visible from every database */
+static inline Oid GlobalCatCacheDbId(const CatCache* cache)
+{
+    return cache->cc_relisshared ? InvalidOid : u_sess->proc_cxt.MyDatabaseId;
+}
+
+static inline uint64 GlobalCatCacheMaxSize(void)
+{
+    return (uint64)g_instance.attr.attr_common.global_catcache_max_size * 1024;
+}
+
+static void GlobalCatCacheSweep(void);
+
+static inline bool GlobalCatCacheMatch(
+    const GlobalCatCTup* gct, const CatCache* cache, Oid dbId, uint32 hashValue, const Datum* arguments)
+{
+    if (gct->hash_value != hashValue || gct->cache_id != cache->id || gct->db_id != dbId) {
+        return false;
+    }
+    for (int i = 0; i < cache->cc_nkeys; i++) {
+        if (!(cache->cc_fastequal[i])(gct->keys[i], arguments[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * InitGlobalCatCache
+ *
+ * Called while (re)creating shared memory.  After a crash restart the cached
+ * rows may miss invalidations of transactions that committed just before the
+ * crash, and no session is left holding them, so they are all thrown away.
+ */
+void InitGlobalCatCache(void)
+{
+    if (!ENABLE_GLOBAL_CATCACHE) {
+        return;
+    }
+
+    GlobalCatCacheBucket* buckets = g_instance.cache_cxt.global_catcache;
+    if (buckets == NULL) {
+        g_instance.cache_cxt.global_catcache = (GlobalCatCacheBucket*)MemoryContextAllocZero(
+            g_instance.cache_cxt.global_cache_mem, GLOBAL_CATCACHE_NUM_BUCKETS * sizeof(GlobalCatCacheBucket));
+        return;
+    }
+
+    for (int i = 0; i < GLOBAL_CATCACHE_NUM_BUCKETS; i++) {
+        GlobalCatCTup* gct = buckets[i].head;
+        while (gct != NULL) {
+            GlobalCatCTup* next = gct->next;
+            pfree(gct);
+            gct = next;
+        }
+        buckets[i].head = NULL;
+        buckets[i].version++;
+    }
+    pg_atomic_write_u64(&g_instance.cache_cxt.global_catcache_size, 0);
+}
+
+/*
+ * GlobalCatCacheUsable
+ *
+ * Only thread pool sessions use the global cache, AtSessExit_CatCache
+ * releases the references they hold.  A transaction that changed catalogs
+ * sees its own uncommitted rows through SnapshotNow, so it stays with its
+ * local catcache until it ends.
+ */
+bool GlobalCatCacheUsable(const CatCache* cache)
+{
+    if (!ENABLE_GLOBAL_CATCACHE || g_instance.cache_cxt.global_catcache == NULL) {
+        return false;
+    }
+    if (!IS_THREAD_POOL_WORKER || !IS_THREAD_POOL_SESSION || t_thrd.proc_cxt.sess_exit_inprogress) {
+        return false;
+    }
+    if (!IsNormalProcessingMode() || u_sess->attr.attr_common.IsInplaceUpgrade) {
+        return false;
+    }
+    if (!cache->cc_relisshared && !OidIsValid(u_sess->proc_cxt.MyDatabaseId)) {
+        return false;
+    }
+    return !HasPendingInvalidationMessages();
+}
+
+/*
+ * GlobalCatCacheSearch
+ *
+ * Returns the matching entry with a reference taken for the caller, or NULL
+ * with the bucket version to pass to GlobalCatCacheInsert.
+ */
+GlobalCatCTup* GlobalCatCacheSearch(const CatCache* cache, uint32 hashValue, const Datum* arguments, uint64* version)
+{
+    Oid dbId = GlobalCatCacheDbId(cache);
+    uint32 bucket = GlobalCatCacheBucketIndex(dbId, cache->id, hashValue);
+    GlobalCatCacheBucket* bkt = &g_instance.cache_cxt.global_catcache[bucket];
+    LWLock* lock = GlobalCatCachePartitionLock(bucket);
+
+    (void)LWLockAcquire(lock, LW_SHARED);
+    for (GlobalCatCTup* gct = bkt->head; gct != NULL; gct = gct->next) {
+        if (GlobalCatCacheMatch(gct, cache, dbId, hashValue, arguments)) {
+            (void)pg_atomic_fetch_add_u32(&gct->refcount, 1);
+            gct->referenced = true;
+            LWLockRelease(lock);
+            return gct;
+        }
+    }
+    *version = bkt->version;
+    LWLockRelease(lock);
+
+    return NULL;
+}
+
+/*
+ * GlobalCatCacheInsert
+ *
+ * Publish a catalog row read after GlobalCatCacheSearch returned version.
+ * Returns the entry with a reference taken for the caller, or NULL if the
+ * bucket was invalidated since, in which case the caller keeps a private copy.
+ */
+GlobalCatCTup* GlobalCatCacheInsert(CatCache* cache, uint32 hashValue, HeapTuple ntp, uint64 version)
+{
+    Oid dbId = GlobalCatCacheDbId(cache);
+    uint32 bucket = GlobalCatCacheBucketIndex(dbId, cache->id, hashValue);
+    GlobalCatCacheBucket* bkt = &g_instance.cache_cxt.global_catcache[bucket];
+    LWLock* lock = GlobalCatCachePartitionLock(bucket);
+    HeapTuple dtp;
+    GlobalCatCTup* gct = NULL;
+    Size size;
+    errno_t rc;
+
+    /* expand toasted fields in-line, as catalog_cache_create_entry does */
+    if (HeapTupleHasExternal(ntp)) {
+        dtp = toast_flatten_tuple(ntp, cache->cc_tupdesc);
+    } else {
+        dtp = ntp;
+    }
+
+    /* build the entry before taking the lock */
+    size = sizeof(GlobalCatCTup) + MAXIMUM_ALIGNOF + dtp->t_len;
+    gct = (GlobalCatCTup*)MemoryContextAlloc(g_instance.cache_cxt.global_cache_mem, size);
+    gct->size = (uint32)size;
+    gct->referenced = false;
+    gct->tuple.t_len = dtp->t_len;
+    gct->tuple.t_self = dtp->t_self;
+    gct->tuple.t_tableOid = dtp->t_tableOid;
+    gct->tuple.t_bucketId = dtp->t_bucketId;
+#ifdef PGXC
+    gct->tuple.t_xc_node_id = dtp->t_xc_node_id;
+#endif
+    gct->tuple.t_xid_base = dtp->t_xid_base;
+    gct->tuple.t_multi_base = dtp->t_multi_base;
+    gct->tuple.t_data = (HeapTupleHeader)MAXALIGN(((char*)gct) + sizeof(GlobalCatCTup));
+    rc = memcpy_s((char*)gct->tuple.t_data, dtp->t_len, (const char*)dtp->t_data, dtp->t_len);
+    securec_check(rc, "", "");
+
+    if (dtp != ntp) {
+        heap_freetuple_ext(dtp);
+    }
+
+    for (int i = 0; i < CATCACHE_MAXKEYS; i++) {
+        gct->keys[i] = (Datum)0;
+    }
+    for (int i = 0; i < cache->cc_nkeys; i++) {
+        bool isnull = false;
+
+        gct->keys[i] = heap_getattr(&gct->tuple, cache->cc_keyno[i], cache->cc_tupdesc, &isnull);
+        Assert(!isnull);
+    }
+
+    gct->db_id = dbId;
+    gct->reloid = cache->cc_reloid;
+    gct->cache_id = cache->id;
+    gct->hash_value = hashValue;
+    /* the bucket's reference and the caller's */
+    pg_atomic_init_u32(&gct->refcount, 2);
+
+    (void)LWLockAcquire(lock, LW_EXCLUSIVE);
+    if (bkt->version != version) {
+        LWLockRelease(lock);
+        pfree(gct);
+        return NULL;
+    }
+
+    /* another session may have published the same row meanwhile */
+    for (GlobalCatCTup* cur = bkt->head; cur != NULL; cur = cur->next) {
+        if (GlobalCatCacheMatch(cur, cache, dbId, hashValue, gct->keys)) {
+            (void)pg_atomic_fetch_add_u32(&cur->refcount, 1);
+            LWLockRelease(lock);
+            pfree(gct);
+            return cur;
+        }
+    }
+
+    gct->next = bkt->head;
+    bkt->head = gct;
+    LWLockRelease(lock);
+
+    if (pg_atomic_add_fetch_u64(&g_instance.cache_cxt.global_catcache_size, size) > GlobalCatCacheMaxSize()) {
+        GlobalCatCacheSweep();
+    }
+
+    return gct;
+}
+
+void GlobalCatCacheRelease(GlobalCatCTup* gct)
+{
+    Assert(gct->refcount > 0);
+
+    if (pg_atomic_sub_fetch_u32(&gct->refcount, 1) == 0) {
+        pfree(gct);
+    }
+}
+
+/* drop the bucket's references to unlinked entries */
+static void GlobalCatCacheReleaseDropped(GlobalCatCTup* dropped)
+{
+    while (dropped != NULL) {
+        GlobalCatCTup* next = dropped->next;
+        GlobalCatCacheRelease(dropped);
+        dropped = next;
+    }
+}
+
+static inline void GlobalCatCacheUnlink(GlobalCatCTup*** link, GlobalCatCTup** dropped)
+{
+    GlobalCatCTup* gct = **link;
+
+    **link = gct->next;
+    gct->next = *dropped;
+    *dropped = gct;
+    (void)pg_atomic_fetch_sub_u64(&g_instance.cache_cxt.global_catcache_size, gct->size);
+}
+
+/*
+ * unlink the entries of bucket accepted by the filter and drop the bucket's
+ * references.  A valid reloid selects the rows of that catalog, a negative
+ * cacheId every row of the database, otherwise the rows of cacheId with
+ * hashValue.
+ */
+static void GlobalCatCacheInvalidateBucket(uint32 bucket, Oid dbId, int cacheId, uint32 hashValue, Oid reloid)
+{
+    GlobalCatCacheBucket* bkt = &g_instance.cache_cxt.global_catcache[bucket];
+    LWLock* lock = GlobalCatCachePartitionLock(bucket);
+    GlobalCatCTup* dropped = NULL;
+
+    (void)LWLockAcquire(lock, LW_EXCLUSIVE);
+    bkt->version++;
+
+    GlobalCatCTup** link = &bkt->head;
+    while (*link != NULL) {
+        GlobalCatCTup* gct = *link;
+        bool match = (gct->db_id == dbId);
+
+        if (OidIsValid(reloid)) {
+            match = match && gct->reloid == reloid;
+        } else if (cacheId >= 0) {
+            match = match && gct->cache_id == cacheId && gct->hash_value == hashValue;
+        }
+
+        if (match) {
+            GlobalCatCacheUnlink(&link, &dropped);
+        } else {
+            link = &gct->next;
+        }
+    }
+    LWLockRelease(lock);
+
+    GlobalCatCacheReleaseDropped(dropped);
+}
+
+/*
+ * GlobalCatCacheSweep
+ *
+ * Bring the cache back under global_catcache_max_size, clock style: entries
+ * held by a session are kept, a referenced entry gets a second chance.  The
+ * hand is shared, so concurrent inserters sweep different buckets.  Give up
+ * after two full passes, everything left is in use.
+ */
+static void GlobalCatCacheSweep(void)
+{
+    uint64 target = GlobalCatCacheMaxSize() - GlobalCatCacheMaxSize() / 10;
+
+    for (int i = 0; i < 2 * GLOBAL_CATCACHE_NUM_BUCKETS; i++) {
+        if (pg_atomic_read_u64(&g_instance.cache_cxt.global_catcache_size) <= target) {
+            return;
+        }
+
+        uint32 bucket =
+            pg_atomic_fetch_add_u32(&g_instance.cache_cxt.global_catcache_hand, 1) & (GLOBAL_CATCACHE_NUM_BUCKETS - 1);
+        GlobalCatCacheBucket* bkt = &g_instance.cache_cxt.global_catcache[bucket];
+        LWLock* lock = GlobalCatCachePartitionLock(bucket);
+        GlobalCatCTup* dropped = NULL;
+
+        if (bkt->head == NULL) {
+            continue;
+        }
+
+        (void)LWLockAcquire(lock, LW_EXCLUSIVE);
+        GlobalCatCTup** link = &bkt->head;
+        while (*link != NULL) {
+            GlobalCatCTup* gct = *link;
+
+            /* only the bucket's reference is left, no session can take one without the lock */
+            if (!gct->referenced && pg_atomic_read_u32(&gct->refcount) == 1) {
+                GlobalCatCacheUnlink(&link, &dropped);
+            } else {
+                gct->referenced = false;
+                link = &gct->next;
+            }
+        }
+        LWLockRelease(lock);
+
+        GlobalCatCacheReleaseDropped(dropped);
+    }
+}
+
+/*
+ * GlobalCatCacheInvalMsg
+ *
+ * Apply the catalog invalidations of a committed transaction.  Must run
+ * before the messages are queued for the other sessions, so that none of
+ * them reloads a stale row from here after processing the message.
+ */
+void GlobalCatCacheInvalMsg(const SharedInvalidationMessage* msgs, int n)
+{
+    if (g_instance.cache_cxt.global_catcache == NULL) {
+        return;
+    }
+
+    for (int i = 0; i < n; i++) {
+        const SharedInvalidationMessage* msg = &msgs[i];
+
+        if (msg->id >= 0) {
+            uint32 bucket = GlobalCatCacheBucketIndex(msg->cc.dbId, msg->cc.id, msg->cc.hashValue);
+            GlobalCatCacheInvalidateBucket(bucket, msg->cc.dbId, msg->cc.id, msg->cc.hashValue, InvalidOid);
+        } else if (msg->id == SHAREDINVALCATALOG_ID) {
+            /* a whole catalog changed, e.g. by VACUUM FULL: drop its rows from every bucket */
+            for (uint32 bucket = 0; bucket < GLOBAL_CATCACHE_NUM_BUCKETS; bucket++) {
+                GlobalCatCacheInvalidateBucket(bucket, msg->cat.dbId, 0, 0, msg->cat.catId);
+            }
+        }
+    }
+}
+
+/*
+ * GlobalCatCacheDropDatabase
+ *
+ * Drop every row of a dropped database, on the primary and when replaying
+ * the drop.  No session is connected to it any more, but its rows would
+ * otherwise stay until evicted, or be found by a new database reusing the
+ * OID.
+ */
+void GlobalCatCacheDropDatabase(Oid dbId)
+{
+    if (g_instance.cache_cxt.global_catcache == NULL || !OidIsValid(dbId)) {
+        return;
+    }
+
+    for (uint32 bucket = 0; bucket < GLOBAL_CATCACHE_NUM_BUCKETS; bucket++) {
+        GlobalCatCacheInvalidateBucket(bucket, dbId, -1, 0, InvalidOid);
+    }
+}
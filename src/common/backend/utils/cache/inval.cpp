@@ -641,6 +641,24 @@ void PostPrepare_Inval(void)
     AtEOXact_Inval(false);
 }
 
+/*
+ * HasPendingInvalidationMessages
+ *		Has the current transaction changed any cached catalog row?
+ *
+ * Such a transaction sees its own uncommitted rows, which must not leak into
+ * the global catalog cache.  Messages of aborted subtransactions are gone
+ * from the lists, those of committed ones were moved to the parent.
+ */
+bool HasPendingInvalidationMessages(void)
+{
+    for (TransInvalidationInfo* info = u_sess->inval_cxt.transInvalInfo; info != NULL; info = info->parent) {
+        if (info->CurrentCmdInvalidMsgs.cclist != NULL || info->PriorCmdInvalidMsgs.cclist != NULL) {
+            return true;
+        }
+    }
+    return false;
+}
+
 /*
  * AtSubStart_Inval
  *		Initialize inval lists at start of a subtransaction.
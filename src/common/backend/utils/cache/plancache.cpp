@@ -93,6 +93,7 @@ static void ReleaseGenericPlan(CachedPlanSource* planSource);
 List* RevalidateCachedQuery(CachedPlanSource* planSource);
 static bool CheckCachedPlan(CachedPlanSource* planSource);
 static CachedPlan* BuildCachedPlan(CachedPlanSource* planSource, List* qList, ParamListInfo boundParams);
+static CachedPlan* GetPlanVariant(CachedPlanSource* planSource, ParamListInfo boundParams, CachedPlan* gplan);
 static bool ChooseCustomPlan(CachedPlanSource* planSource, ParamListInfo boundParams);
 static double CachedPlanCost(CachedPlan* plan);
 static void AcquireExecutorLocks(List* stmtList, bool acquire);
@@ -233,6 +234,9 @@ CachedPlanSource* CreateCachedPlan(Node* rawParseTree, const char* queryString,
     planSource->gpc.env = NULL;
     planSource->gpc.refcount = 1;
     planSource->gpc.in_revalidate = false;
+    planSource->gpc.variants = NULL;
+    planSource->gpc.num_variants = 0;
+    planSource->gpc.variant_CAS_flag = 0;
 
     if (ENABLE_DN_GPC && stmt_name != NULL && stmt_name[0] != '\0') {
         planSource->gpc.env = GPC->EnvCreate();
@@ -1167,6 +1171,7 @@ static CachedPlan* BuildCachedPlan(CachedPlanSource* planSource, List* qList, Pa
     plan->is_oneshot = planSource->is_oneshot;
     plan->is_saved = false;
     plan->is_valid = true;
+    plan->variant = NULL;
 
     /* assign generation number to new plan */
     plan->generation = ++(planSource->generation);
@@ -1181,6 +1186,93 @@ static CachedPlan* BuildCachedPlan(CachedPlanSource* planSource, List* qList, Pa
     return plan;
 }
 
+/*
+ * ShareCachedPlan: move a plan built by this session into shared memory
+ *
+ * The private plan is freed; the copy is linked from a plan variant.
+ */
+static CachedPlan* ShareCachedPlan(CachedPlan* plan)
+{
+    MemoryContext plan_context = AllocSetContextCreate(g_instance.cache_cxt.global_cache_mem,
+                                                       "CachedPlan",
+                                                       ALLOCSET_SMALL_MINSIZE,
+                                                       ALLOCSET_SMALL_INITSIZE,
+                                                       ALLOCSET_DEFAULT_MAXSIZE,
+                                                       SHARED_CONTEXT);
+    MemoryContext oldcxt = MemoryContextSwitchTo(plan_context);
+    CachedPlan* newplan = (CachedPlan*)palloc(sizeof(CachedPlan));
+
+    *newplan = *plan;
+    newplan->stmt_list = (List*)copyObject(plan->stmt_list);
+    newplan->context = plan_context;
+    newplan->is_saved = true;
+    newplan->is_share = true;
+    /* the link from the variant */
+    newplan->refcount = 1;
+    MemoryContextSwitchTo(oldcxt);
+
+    Assert(plan->refcount == 0);
+    plan->magic = 0;
+    MemoryContextDelete(plan->context);
+
+    return newplan;
+}
+
+/*
+ * GetPlanVariant: choose the plan of a shared planSource for boundParams
+ *
+ * The generic plan is estimated without the parameter values.  If the values
+ * fall into a selectivity class that has a variant, use its plan instead, and
+ * if the class has none yet and gpc_plan_variants allows another one, plan it.
+ * A variant is still a generic plan, its Params are not folded, but it is
+ * estimated with the values that created it.
+ */
+static CachedPlan* GetPlanVariant(CachedPlanSource* planSource, ParamListInfo boundParams, CachedPlan* gplan)
+{
+    uint32 signature = GPC->ParamSignature(planSource, boundParams);
+    if (signature == 0) {
+        return gplan;
+    }
+
+    GPCPlanVariant* variant = GPC->VariantFetch(planSource, signature);
+    if (variant == NULL) {
+        if (planSource->gpc.num_variants >= Min(u_sess->attr.attr_sql.gpc_plan_variants, GPC_MAX_PLAN_VARIANTS)) {
+            return gplan;
+        }
+
+        /* values only for estimation, so that the plan can be reused for other values */
+        ParamListInfo estimateParams = copyParamList(boundParams);
+        for (int i = 0; i < estimateParams->numParams; i++) {
+            estimateParams->params[i].pflags &= ~PARAM_FLAG_CONST;
+        }
+
+        /*
+         * Other sessions run the shared planSource concurrently, and
+         * BuildCachedPlan bumps its generation and records the stream setting
+         * in it.  Plan from a private copy instead; the query_list it copies
+         * the querytrees from is not rebuilt in a shared planSource, an
+         * invalid one is replaced by a copy, see RecreateCachePlan().
+         */
+        CachedPlanSource variantSource = *planSource;
+        CachedPlan* plan = BuildCachedPlan(&variantSource, NIL, estimateParams);
+        variant = GPC->VariantStore(planSource, signature, ShareCachedPlan(plan));
+        if (variant == NULL) {
+            return gplan;
+        }
+    }
+
+    CachedPlan* plan = variant->plan;
+    Assert(plan->magic == CACHEDPLAN_MAGIC);
+    if (!plan->is_valid || (plan->dependsOnRole && plan->planRoleId != GetUserId()) ||
+        (TransactionIdIsValid(plan->saved_xmin) &&
+            !TransactionIdEquals(plan->saved_xmin, u_sess->utils_cxt.TransactionXmin))) {
+        return gplan;
+    }
+
+    (void)gs_atomic_add_64(&variant->hits, 1);
+    return plan;
+}
+
 /*
  * ChooseCustomPlan: choose whether to use custom or generic plan
  *
@@ -1330,6 +1422,12 @@ CachedPlan* GetCachedPlan(CachedPlanSource* planSource, ParamListInfo boundParam
             plan = planSource->gplan;
             Assert(plan->magic == CACHEDPLAN_MAGIC);
 
+            /* A shared plan may have a variant fitting these parameter values better */
+            if (ENABLE_DN_GPC && planSource->gpc.is_share && boundParams != NULL &&
+                u_sess->attr.attr_sql.gpc_plan_variants > 0) {
+                plan = GetPlanVariant(planSource, boundParams, plan);
+            }
+
             /* Update soft parse counter for Unique SQL */
             UniqueSQLStatCountSoftParse(1);
         } else {
@@ -2231,4 +2329,8 @@ void DropCachedPlanInternal(CachedPlanSource* planSource)
         /* Decrement generic CachePlan's refcount and drop if no longer needed */
         ReleaseGenericPlan(planSource);
     }
+
+    if (planSource->gpc.variants != NULL) {
+        GPC->VariantDropAll(planSource);
+    }
 }
@@ -344,6 +344,7 @@ const char* sync_guc_variable_namelist[] = {"work_mem",
     "enable_fast_allocate",
     "enable_adio_debug",
     "enable_adio_function",
+    "enable_adio_io_uring",
     "fast_extend_file_size",
     "enable_global_stats",
     "td_compatible_truncation",
@@ -365,6 +366,7 @@ const char* sync_guc_variable_namelist[] = {"work_mem",
     "hll_max_sparse",
 #endif
     "enable_compress_spill",
+    "enable_compress_sort_spill",
     "resource_track_level",
     "fault_mon_timeout",
     "trace_sort",
@@ -388,6 +390,7 @@ const char* sync_guc_variable_namelist[] = {"work_mem",
     "enable_incremental_catchup",
     "wait_dummy_time",
     "max_recursive_times",
+    "gpc_plan_variants",
     "sql_use_spacelimit"};
 
 static void set_config_sourcefile(const char* name, char* sourcefile, int sourceline);
@@ -910,6 +913,9 @@ static const struct config_enum_entry remote_read_options[] = {{"off", REMOTE_RE
     {"authentication", REMOTE_READ_AUTH, false},
     {NULL, 0, false}};
 
+static const struct config_enum_entry buffer_replacement_options[] = {
+    {"clock", BUFFER_POLICY_CLOCK, false}, {"2q", BUFFER_POLICY_2Q, false}, {NULL, 0, false}};
+
 static const struct config_enum_entry resource_track_log_options[] = {
     {"summary", SUMMARY, false}, {"detail", DETAIL, false}, {NULL, 0, false}};
 
@@ -1538,6 +1544,20 @@ static void init_configure_names_bool()
             NULL,
             NULL
         },
+        {
+            {
+                "enable_compress_sort_spill",
+                PGC_USERSET,
+                QUERY_TUNING_METHOD,
+                gettext_noop("Enables LZ4 compression of the temporary files written by external sorts."),
+                NULL
+            },
+            &u_sess->attr.attr_sql.enable_compress_sort_spill,
+            false,
+            NULL,
+            NULL,
+            NULL
+        },
         {
             {
                 "enable_hashagg",
@@ -3795,6 +3815,20 @@ static void init_configure_names_bool()
             NULL,
             NULL
         },
+        {
+            {
+                "enable_global_catcache",
+                PGC_POSTMASTER,
+                CLIENT_CONN,
+                gettext_noop("enable to share catalog cache tuples between thread pool sessions. "),
+                NULL
+            },
+            &g_instance.attr.attr_common.enable_global_catcache,
+            false,
+            NULL,
+            NULL,
+            NULL
+        },
         /* Database Security: Support database audit */
         /* add guc option about audit */
         {
@@ -4102,6 +4136,20 @@ static void init_configure_names_bool()
             NULL,
             NULL
         },
+        {
+            {
+                "enable_adio_io_uring",
+                PGC_POSTMASTER,
+                DEVELOPER_OPTIONS,
+                gettext_noop("Use io_uring instead of libaio for adio."),
+                NULL
+            },
+            &g_instance.attr.attr_storage.enable_adio_io_uring,
+            false,
+            NULL,
+            NULL,
+            NULL
+        },
         {
             {
                 "td_compatible_truncation",
@@ -5842,6 +5890,23 @@ static void init_configure_names_int()
             assign_max_stack_depth,
             NULL
         },
+        {
+            {
+                "global_catcache_max_size",
+                PGC_POSTMASTER,
+                RESOURCES_MEM,
+                gettext_noop("Sets the maximum size of the global catalog cache, in kilobytes."),
+                NULL,
+                GUC_UNIT_KB
+            },
+            &g_instance.attr.attr_common.global_catcache_max_size,
+            65536,
+            1024,
+            MAX_KILOBYTES,
+            NULL,
+            NULL,
+            NULL
+        },
         {
             {
                 "temp_file_limit",
@@ -6247,6 +6312,23 @@ static void init_configure_names_int()
             NULL,
             NULL
         },
+        {
+            {
+                "wal_compression_threshold",
+                PGC_USERSET,
+                WAL_SETTINGS,
+                gettext_noop("Sets the minimum WAL record payload size, in bytes, that is compressed "
+                             "when wal_compression is on."),
+                gettext_noop("Zero disables compression of record payloads; only full-page images are compressed.")
+            },
+            &u_sess->attr.attr_storage.wal_compression_threshold,
+            0,
+            0,
+            (int)XLogRecordMaxSize,
+            NULL,
+            NULL,
+            NULL
+        },
         {
             {
                 "wal_keep_segments",
@@ -8400,6 +8482,22 @@ static void init_configure_names_int()
             NULL,
             NULL
         },
+        {
+            {
+                "gpc_plan_variants",
+                PGC_USERSET,
+                QUERY_TUNING_METHOD,
+                gettext_noop("Sets the maximum number of parameter-sensitive plans kept for a global plan cache entry."),
+                NULL
+            },
+            &u_sess->attr.attr_sql.gpc_plan_variants,
+            0,
+            0,
+            GPC_MAX_PLAN_VARIANTS,
+            NULL,
+            NULL,
+            NULL
+        },
         {
             {
                 "transaction_sync_naptime",
@@ -9877,6 +9975,21 @@ static void init_configure_names_string()
             NULL,
             NULL
         },
+        {
+            {
+                "lwlock_numa_tranches",
+                PGC_POSTMASTER,
+                LOCK_MANAGEMENT,
+                gettext_noop("LWLock tranches whose releases prefer waking waiters on the same NUMA node."),
+                NULL,
+                GUC_LIST_INPUT | GUC_SUPERUSER_ONLY
+            },
+            &g_instance.attr.attr_storage.lwlock_numa_tranches,
+            "",
+            NULL,
+            NULL,
+            NULL
+        },
         {
             {
                 "local_preload_libraries",
@@ -11689,6 +11802,22 @@ static void init_configure_names_enum()
             NULL,
             NULL
         },
+        {
+            {
+                "buffer_replacement_policy",
+                PGC_POSTMASTER,
+                RESOURCES_MEM,
+                gettext_noop("Selects the replacement policy of shared buffers."),
+                gettext_noop("clock sweeps all buffers alike, 2q keeps pages that were read only once "
+                             "from evicting frequently used pages.")
+            },
+            &g_instance.attr.attr_storage.buffer_replacement_policy,
+            BUFFER_POLICY_CLOCK,
+            buffer_replacement_options,
+            NULL,
+            NULL,
+            NULL
+        },
         /* End-of-list marker */
         {
             {
@@ -724,6 +724,7 @@ void Batchsortstate::InitCommon(int64 workMem, bool randomAccess)
     m_lastOffset = 0;
     m_colInfo = NULL;
     m_tapeset = NULL;
+    m_tapesetMem = 0;
     m_resultTape = -1;
     m_randomAccess = randomAccess;
 
@@ -1123,6 +1124,8 @@ void Batchsortstate::BeginMerge()
 
     slotsPerTape = (m_storeColumns.m_capacity - m_mergeFirstFree) / activeTapes;
     Assert(slotsPerTape > 0);
+    /* the tape set's bookkeeping may have grown since the last pass */
+    ChargeTapesetMem();
     spacePerTape = m_availMem / activeTapes;
     for (srcTape = 0; srcTape < m_maxTapes; srcTape++) {
         if (m_mergeActive[srcTape]) {
@@ -1432,7 +1435,9 @@ void Batchsortstate::InitTapes()
     /*
      * Create the tape set and allocate the per-tape data arrays.
      */
-    m_tapeset = LogicalTapeSetCreate(maxTapes);
+    m_tapeset = LogicalTapeSetCreate(maxTapes, u_sess->attr.attr_sql.enable_compress_sort_spill);
+    m_tapesetMem = 0;
+    ChargeTapesetMem();
     m_lastFileBlocks = 0L;
 
     m_mergeActive = (bool*)palloc0(maxTapes * sizeof(bool));
@@ -1541,6 +1546,21 @@ void Batchsortstate::BatchSortHeapSiftup()
     rows[i] = *multiColumn;
 }
 
+/*
+ * Charge the growth of the tape set's bookkeeping against m_availMem.  A
+ * compressed tape set keeps a map entry per block written, see
+ * LogicalTapeSetMemory(); it only ever grows until the sort ends.
+ */
+void Batchsortstate::ChargeTapesetMem()
+{
+    int64 tapesetMem = (int64)LogicalTapeSetMemory(m_tapeset);
+
+    if (tapesetMem > m_tapesetMem) {
+        m_availMem -= tapesetMem - m_tapesetMem;
+        m_tapesetMem = tapesetMem;
+    }
+}
+
 void Batchsortstate::DumpMultiColumn(bool all)
 {
     WaitState oldStatus = pgstat_report_waitstatus(STATE_EXEC_SORT_WRITE_FILE);
@@ -1554,6 +1574,7 @@ void Batchsortstate::DumpMultiColumn(bool all)
 
         writeMultiColumn(this, m_tpNum[m_destTape], &m_storeColumns.m_memValues[0]);
         BatchSortHeapSiftup<true>();
+        ChargeTapesetMem();
 
         /*
          * If the heap is empty *or* top run number has changed, we've
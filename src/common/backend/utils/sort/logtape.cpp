@@ -66,6 +66,16 @@
  * care that all calls for a single LogicalTapeSet are made in the same
  * palloc context.
  *
+ * Optionally the blocks are LZ4-compressed on their way to the file.  A
+ * compressed block no longer fills a BLCKSZ block of the file, so the file
+ * is then managed in "pages": compressed blocks are packed into the page
+ * being filled, and the block numbers seen by everything above stay logical,
+ * mapped to (page, offset, length) by an in-memory array.  A page is put on
+ * its own free list once no live block is left in it, so space recycling
+ * works as before, just at page granularity.  Each tape keeps the page it
+ * last read from, as the blocks of one tape were mostly written together;
+ * that page buffer fits in the per-tape overhead tuplesort reserves.
+ *
  * Portions Copyright (c) 1996-2012, PostgreSQL Global Development Group
  * Portions Copyright (c) 1994, Regents of the University of California
  *
@@ -78,6 +88,7 @@
 #include "postgres.h"
 #include "knl/knl_variable.h"
 
+#include "lz4.h"
 #include "storage/buffile.h"
 #include "utils/logtape.h"
 
@@ -87,6 +98,38 @@
  */
 #define BLOCKS_PER_INDIR_BLOCK ((int)(BLCKSZ / sizeof(long)))
 
+/* where a logical block lives in a compressed tape set; len == BLCKSZ means stored raw */
+typedef struct LtsBlockLocation {
+    uint32 page;
+    uint16 offset;
+    uint16 len;
+} LtsBlockLocation;
+
+/* one page of the file cached in memory for reading */
+typedef struct LtsPageCache {
+    char* data; /* NULL until first used */
+    long pagenum;
+} LtsPageCache;
+
+typedef struct LtsCompressState {
+    LtsBlockLocation* blocks; /* indexed by logical block number */
+    long blocksLen;
+    uint16* pageRefs; /* # of live blocks in each page */
+    long pageRefsLen;
+    long nPages; /* # of pages used in underlying file */
+
+    long* freePages; /* pages without live blocks, resizable */
+    int nFreePages;
+    int freePagesLen;
+
+    char* writePage; /* page being filled */
+    long writePageNum; /* its page number, or -1L */
+    int writePageUsed;
+
+    LtsPageCache indirCache; /* used for indirect blocks */
+    char* compressBuf;
+} LtsCompressState;
+
 /*
  * We use a struct like this for each active indirection level of each
  * logical tape.  If the indirect block is not the highest level of its
@@ -133,6 +176,8 @@ typedef struct LogicalTape {
     long curBlockNumber; /* this block's logical blk# within tape */
     int pos;             /* next read/write position in buffer */
     int nbytes;          /* total # of valid bytes in buffer */
+
+    LtsPageCache pageCache; /* last page read, if the set is compressed */
 } LogicalTape;
 
 /*
@@ -164,6 +209,8 @@ struct LogicalTapeSet {
     int nFreeBlocks;      /* # of currently free blocks */
     int freeBlocksLen;    /* current allocated length of freeBlocks[] */
 
+    LtsCompressState* compress; /* NULL if blocks are stored as they are */
+
     /*
      * tapes[] is declared size 1 since C wants a fixed size, but actually it
      * is of length nTapes.
@@ -174,6 +221,10 @@ struct LogicalTapeSet {
 
 static void ltsWriteBlock(LogicalTapeSet* lts, long blocknum, void* buffer);
 static void ltsReadBlock(LogicalTapeSet* lts, long blocknum, void* buffer);
+static void ltsReadDataBlock(LogicalTapeSet* lts, LogicalTape* lt, long blocknum);
+static void ltsWriteCompressedBlock(LogicalTapeSet* lts, long blocknum, const void* buffer);
+static void ltsReadCompressedBlock(LogicalTapeSet* lts, long blocknum, void* buffer, LtsPageCache* cache);
+static void ltsReleaseCompressedBlock(LogicalTapeSet* lts, long blocknum);
 static long ltsGetFreeBlock(LogicalTapeSet* lts);
 static void ltsReleaseBlock(LogicalTapeSet* lts, long blocknum);
 static void ltsRecordBlockNum(LogicalTapeSet* lts, IndirectBlock* indirect, long blocknum);
@@ -194,6 +245,10 @@ static void ltsDumpBuffer(LogicalTapeSet* lts, LogicalTape* lt);
  */
 static void ltsWriteBlock(LogicalTapeSet* lts, long blocknum, void* buffer)
 {
+    if (lts->compress != NULL) {
+        ltsWriteCompressedBlock(lts, blocknum, buffer);
+        return;
+    }
     if (BufFileSeekBlock(lts->pfile, blocknum) != 0 || BufFileWrite(lts->pfile, buffer, BLCKSZ) != BLCKSZ)
         ereport(ERROR,
             /* XXX is it okay to assume errno is correct? */
@@ -210,12 +265,190 @@ static void ltsWriteBlock(LogicalTapeSet* lts, long blocknum, void* buffer)
  */
 static void ltsReadBlock(LogicalTapeSet* lts, long blocknum, void* buffer)
 {
+    if (lts->compress != NULL) {
+        ltsReadCompressedBlock(lts, blocknum, buffer, &lts->compress->indirCache);
+        return;
+    }
     if (BufFileSeekBlock(lts->pfile, blocknum) != 0 || BufFileRead(lts->pfile, buffer, BLCKSZ) != BLCKSZ)
         ereport(ERROR,
             /* XXX is it okay to assume errno is correct? */
             (errcode_for_file_access(), errmsg("could not read block %ld of temporary file: %m", blocknum)));
 }
 
+/*
+ * Read a data block of a tape into its buffer.  Unlike ltsReadBlock(), this
+ * keeps the page the block came from with the tape, so that the tape's next
+ * blocks are usually found without another read.
+ */
+static void ltsReadDataBlock(LogicalTapeSet* lts, LogicalTape* lt, long blocknum)
+{
+    if (lts->compress != NULL) {
+        if (lt->pageCache.data == NULL) {
+            lt->pageCache.data = (char*)palloc(BLCKSZ);
+        }
+        ltsReadCompressedBlock(lts, blocknum, (void*)lt->buffer, &lt->pageCache);
+    } else {
+        ltsReadBlock(lts, blocknum, (void*)lt->buffer);
+    }
+}
+
+static void ltsWritePage(LogicalTapeSet* lts, long pagenum, const char* page)
+{
+    if (BufFileSeekBlock(lts->pfile, pagenum) != 0 || BufFileWrite(lts->pfile, page, BLCKSZ) != BLCKSZ)
+        ereport(ERROR,
+            (errcode_for_file_access(),
+                errmsg("could not write block %ld of temporary file: %m", pagenum),
+                errhint("Perhaps out of disk space?")));
+}
+
+static void ltsReadPage(LogicalTapeSet* lts, long pagenum, char* page)
+{
+    if (BufFileSeekBlock(lts->pfile, pagenum) != 0 || BufFileRead(lts->pfile, page, BLCKSZ) != BLCKSZ)
+        ereport(ERROR, (errcode_for_file_access(), errmsg("could not read block %ld of temporary file: %m", pagenum)));
+}
+
+static void ltsReleasePage(LtsCompressState* cs, long pagenum)
+{
+    if (cs->nFreePages >= cs->freePagesLen) {
+        cs->freePagesLen *= 2;
+        cs->freePages = (long*)repalloc(cs->freePages, cs->freePagesLen * sizeof(long));
+    }
+    cs->freePages[cs->nFreePages++] = pagenum;
+}
+
+/*
+ * Write out the page being filled.  Cached copies of whatever the page held
+ * before it was recycled are stale from now on.
+ */
+static void ltsFlushWritePage(LogicalTapeSet* lts)
+{
+    LtsCompressState* cs = lts->compress;
+    long pagenum = cs->writePageNum;
+
+    Assert(pagenum >= 0);
+    ltsWritePage(lts, pagenum, cs->writePage);
+    if (cs->indirCache.pagenum == pagenum)
+        cs->indirCache.pagenum = -1L;
+    for (int i = 0; i < lts->nTapes; i++) {
+        if (lts->tapes[i].pageCache.pagenum == pagenum)
+            lts->tapes[i].pageCache.pagenum = -1L;
+    }
+
+    /* every block in it may already have been read and released */
+    if (cs->pageRefs[pagenum] == 0)
+        ltsReleasePage(cs, pagenum);
+    cs->writePageNum = -1L;
+}
+
+/*
+ * Compress a block into the page being filled, starting a new page if it
+ * doesn't fit.  Blocks that don't compress are stored raw, filling a page.
+ *
+ * New pages are only appended when the previous one was written out, so
+ * the file still grows strictly sequentially.
+ */
+static void ltsWriteCompressedBlock(LogicalTapeSet* lts, long blocknum, const void* buffer)
+{
+    LtsCompressState* cs = lts->compress;
+    const char* data = cs->compressBuf;
+    int len = LZ4_compress_default((const char*)buffer, cs->compressBuf, BLCKSZ, LZ4_COMPRESSBOUND(BLCKSZ));
+
+    if (len <= 0 || len >= BLCKSZ) {
+        data = (const char*)buffer;
+        len = BLCKSZ;
+    }
+
+    if (cs->writePageNum >= 0 && cs->writePageUsed + len > BLCKSZ)
+        ltsFlushWritePage(lts);
+    if (cs->writePageNum < 0) {
+        if (cs->nFreePages > 0) {
+            cs->writePageNum = cs->freePages[--cs->nFreePages];
+        } else {
+            if (cs->nPages > (long)PG_UINT32_MAX)
+                ereport(ERROR, (errcode(ERRCODE_PROGRAM_LIMIT_EXCEEDED), errmsg("temporary file of sort is too large")));
+            cs->writePageNum = cs->nPages++;
+        }
+        cs->writePageUsed = 0;
+
+        if (cs->writePageNum >= cs->pageRefsLen) {
+            long newLen = cs->pageRefsLen * 2;
+            cs->pageRefs = (uint16*)repalloc(cs->pageRefs, newLen * sizeof(uint16));
+            errno_t rc = memset_s(cs->pageRefs + cs->pageRefsLen, (newLen - cs->pageRefsLen) * sizeof(uint16), 0,
+                (newLen - cs->pageRefsLen) * sizeof(uint16));
+            securec_check(rc, "\0", "\0");
+            cs->pageRefsLen = newLen;
+        }
+    }
+
+    errno_t rc = memcpy_s(cs->writePage + cs->writePageUsed, BLCKSZ - cs->writePageUsed, data, len);
+    securec_check(rc, "\0", "\0");
+
+    while (blocknum >= cs->blocksLen) {
+        cs->blocksLen *= 2;
+        cs->blocks = (LtsBlockLocation*)repalloc(cs->blocks, cs->blocksLen * sizeof(LtsBlockLocation));
+    }
+    cs->blocks[blocknum].page = (uint32)cs->writePageNum;
+    cs->blocks[blocknum].offset = (uint16)cs->writePageUsed;
+    cs->blocks[blocknum].len = (uint16)len;
+    cs->pageRefs[cs->writePageNum]++;
+    cs->writePageUsed += len;
+}
+
+static void ltsReadCompressedBlock(LogicalTapeSet* lts, long blocknum, void* buffer, LtsPageCache* cache)
+{
+    LtsCompressState* cs = lts->compress;
+    LtsBlockLocation* loc = &cs->blocks[blocknum];
+    const char* page = NULL;
+
+    Assert(blocknum < cs->blocksLen);
+    if ((long)loc->page == cs->writePageNum) {
+        page = cs->writePage;
+    } else {
+        if (cache->pagenum != (long)loc->page) {
+            ltsReadPage(lts, (long)loc->page, cache->data);
+            cache->pagenum = (long)loc->page;
+        }
+        page = cache->data;
+    }
+
+    if (loc->len == BLCKSZ) {
+        errno_t rc = memcpy_s(buffer, BLCKSZ, page + loc->offset, BLCKSZ);
+        securec_check(rc, "\0", "\0");
+    } else if (LZ4_decompress_safe(page + loc->offset, (char*)buffer, loc->len, BLCKSZ) != BLCKSZ) {
+        ereport(ERROR,
+            (errcode(ERRCODE_DATA_CORRUPTED), errmsg("could not decompress block %ld of temporary file", blocknum)));
+    }
+}
+
+static void ltsReleaseCompressedBlock(LogicalTapeSet* lts, long blocknum)
+{
+    LtsCompressState* cs = lts->compress;
+    long pagenum = (long)cs->blocks[blocknum].page;
+
+    Assert(cs->pageRefs[pagenum] > 0);
+    if (--cs->pageRefs[pagenum] == 0 && pagenum != cs->writePageNum)
+        ltsReleasePage(cs, pagenum);
+}
+
+static LtsCompressState* ltsCreateCompressState(void)
+{
+    LtsCompressState* cs = (LtsCompressState*)palloc0(sizeof(LtsCompressState));
+
+    /* reasonable initial guesses */
+    cs->blocksLen = 128;
+    cs->blocks = (LtsBlockLocation*)palloc(cs->blocksLen * sizeof(LtsBlockLocation));
+    cs->pageRefsLen = 128;
+    cs->pageRefs = (uint16*)palloc0(cs->pageRefsLen * sizeof(uint16));
+    cs->freePagesLen = 32;
+    cs->freePages = (long*)palloc(cs->freePagesLen * sizeof(long));
+    cs->writePage = (char*)palloc(BLCKSZ);
+    cs->writePageNum = -1L;
+    cs->indirCache.data = (char*)palloc(BLCKSZ);
+    cs->indirCache.pagenum = -1L;
+    cs->compressBuf = (char*)palloc(LZ4_COMPRESSBOUND(BLCKSZ));
+    return cs;
+}
+
 /*
  * qsort comparator for sorting freeBlocks[] into decreasing order.
  */
@@ -268,6 +501,9 @@ static void ltsReleaseBlock(LogicalTapeSet* lts, long blocknum)
     if (lts->forgetFreeSpace)
         return;
 
+    if (lts->compress != NULL)
+        ltsReleaseCompressedBlock(lts, blocknum);
+
     /*
      * Enlarge freeBlocks array if full.
      */
@@ -468,9 +704,10 @@ static long ltsRecallPrevBlockNum(LogicalTapeSet* lts, IndirectBlock* indirect)
 /*
  * Create a set of logical tapes in a temporary underlying file.
  *
- * Each tape is initialized in write state.
+ * Each tape is initialized in write state.  If compress is true, blocks are
+ * LZ4-compressed in the file, see the notes at the top of this file.
  */
-LogicalTapeSet* LogicalTapeSetCreate(int ntapes)
+LogicalTapeSet* LogicalTapeSetCreate(int ntapes, bool compress)
 {
     LogicalTapeSet* lts = NULL;
     LogicalTape* lt = NULL;
@@ -489,6 +726,7 @@ LogicalTapeSet* LogicalTapeSetCreate(int ntapes)
     lts->freeBlocksLen = 32;  /* reasonable initial guess */
     lts->freeBlocks = (long*)palloc((size_t)lts->freeBlocksLen * sizeof(long));
     lts->nFreeBlocks = 0;
+    lts->compress = compress ? ltsCreateCompressState() : NULL;
     lts->nTapes = ntapes;
 
     /*
@@ -509,6 +747,8 @@ LogicalTapeSet* LogicalTapeSetCreate(int ntapes)
         lt->curBlockNumber = 0L;
         lt->pos = 0;
         lt->nbytes = 0;
+        lt->pageCache.data = NULL;
+        lt->pageCache.pagenum = -1L;
     }
     return lts;
 }
@@ -532,6 +772,19 @@ void LogicalTapeSetClose(LogicalTapeSet* lts)
         }
         if (lt->buffer != NULL)
             pfree_ext(lt->buffer);
+        if (lt->pageCache.data != NULL)
+            pfree_ext(lt->pageCache.data);
+    }
+    if (lts->compress != NULL) {
+        LtsCompressState* cs = lts->compress;
+
+        pfree_ext(cs->blocks);
+        pfree_ext(cs->pageRefs);
+        pfree_ext(cs->freePages);
+        pfree_ext(cs->writePage);
+        pfree_ext(cs->indirCache.data);
+        pfree_ext(cs->compressBuf);
+        pfree_ext(lts->compress);
     }
     pfree_ext(lts->freeBlocks);
     pfree_ext(lts);
@@ -659,7 +912,7 @@ void LogicalTapeRewind(LogicalTapeSet* lts, int tapenum, bool forWrite)
         lt->pos = 0;
         lt->nbytes = 0;
         if (datablocknum != -1L) {
-            ltsReadBlock(lts, datablocknum, (void*)lt->buffer);
+            ltsReadDataBlock(lts, lt, datablocknum);
             if (!lt->frozen)
                 ltsReleaseBlock(lts, datablocknum);
             lt->nbytes = (lt->curBlockNumber < lt->numFullBlocks) ? BLCKSZ : lt->lastBlockBytes;
@@ -720,7 +973,7 @@ size_t LogicalTapeRead(LogicalTapeSet* lts, int tapenum, void* ptr, size_t size)
                 break; /* EOF */
             lt->curBlockNumber++;
             lt->pos = 0;
-            ltsReadBlock(lts, datablocknum, (void*)lt->buffer);
+            ltsReadDataBlock(lts, lt, datablocknum);
             if (!lt->frozen)
                 ltsReleaseBlock(lts, datablocknum);
             lt->nbytes = (lt->curBlockNumber < lt->numFullBlocks) ? BLCKSZ : lt->lastBlockBytes;
@@ -780,7 +1033,7 @@ void LogicalTapeFreeze(LogicalTapeSet* lts, int tapenum)
     lt->pos = 0;
     lt->nbytes = 0;
     if (datablocknum != -1L) {
-        ltsReadBlock(lts, datablocknum, (void*)lt->buffer);
+        ltsReadDataBlock(lts, lt, datablocknum);
         lt->nbytes = (lt->curBlockNumber < lt->numFullBlocks) ? BLCKSZ : lt->lastBlockBytes;
     }
 }
@@ -840,7 +1093,7 @@ bool LogicalTapeBackspace(LogicalTapeSet* lts, int tapenum, size_t size)
             ereport(ERROR, (errcode(ERRCODE_DATA_EXCEPTION), errmsg("unexpected end of tape")));
         lt->curBlockNumber--;
         if (nblocks == 0) {
-            ltsReadBlock(lts, datablocknum, (void*)lt->buffer);
+            ltsReadDataBlock(lts, lt, datablocknum);
             lt->nbytes = BLCKSZ;
         }
     }
@@ -890,7 +1143,7 @@ bool LogicalTapeSeek(LogicalTapeSet* lts, int tapenum, long blocknum, int offset
         if (datablocknum == -1L)
             ereport(ERROR, (errcode(ERRCODE_DATA_EXCEPTION), errmsg("unexpected end of tape")));
         if (--lt->curBlockNumber == blocknum)
-            ltsReadBlock(lts, datablocknum, (void*)lt->buffer);
+            ltsReadDataBlock(lts, lt, datablocknum);
     }
     while (lt->curBlockNumber < blocknum) {
         long datablocknum = ltsRecallNextBlockNum(lts, lt->indirect, lt->frozen);
@@ -898,7 +1151,7 @@ bool LogicalTapeSeek(LogicalTapeSet* lts, int tapenum, long blocknum, int offset
         if (datablocknum == -1L)
             ereport(ERROR, (errcode(ERRCODE_DATA_EXCEPTION), errmsg("unexpected end of tape")));
         if (++lt->curBlockNumber == blocknum)
-            ltsReadBlock(lts, datablocknum, (void*)lt->buffer);
+            ltsReadDataBlock(lts, lt, datablocknum);
     }
     lt->nbytes = (lt->curBlockNumber < lt->numFullBlocks) ? BLCKSZ : lt->lastBlockBytes;
     lt->pos = offset;
@@ -926,5 +1179,23 @@ void LogicalTapeTell(LogicalTapeSet* lts, int tapenum, long* blocknum, int* offs
  */
 long LogicalTapeSetBlocks(LogicalTapeSet* lts)
 {
+    if (lts->compress != NULL)
+        return lts->compress->nPages;
     return lts->nFileBlocks;
 }
+
+/*
+ * Obtain the memory used by the bookkeeping of a compressed LogicalTapeSet,
+ * in bytes.  The block map grows with the amount of data written, so unlike
+ * the per-tape buffers it is not covered by a fixed per-tape allowance; the
+ * caller has to charge it against its memory budget as the sort goes on.
+ */
+Size LogicalTapeSetMemory(LogicalTapeSet* lts)
+{
+    LtsCompressState* cs = lts->compress;
+
+    if (cs == NULL)
+        return 0;
+    return sizeof(LtsCompressState) + cs->blocksLen * sizeof(LtsBlockLocation) + cs->pageRefsLen * sizeof(uint16) +
+           cs->freePagesLen * sizeof(long) + 2 * BLCKSZ + LZ4_COMPRESSBOUND(BLCKSZ);
+}
@@ -224,6 +224,7 @@ struct Tuplesortstate {
     int tapeRange;             /* maxTapes-1 (Knuth's P) */
     MemoryContext sortcontext; /* memory context holding all sort data */
     LogicalTapeSet* tapeset;   /* logtape.c object for tapes in a temp file */
+    int64 tapesetMem;          /* LogicalTapeSetMemory() charged to availMem */
 #ifdef PGXC
     Oid current_xcnode; /* node from where we are got last tuple */
 #endif                  /* PGXC */
@@ -563,6 +564,7 @@ static void beginmerge(Tuplesortstate* state);
 static void mergepreread(Tuplesortstate* state);
 static void mergeprereadone(Tuplesortstate* state, int srcTape);
 static void dumptuples(Tuplesortstate* state, bool alltuples);
+static void chargetapesetmem(Tuplesortstate* state);
 static void make_bounded_heap(Tuplesortstate* state);
 static void sort_bounded_heap(Tuplesortstate* state);
 static void tuplesort_heap_insert(Tuplesortstate* state, SortTuple* tuple, int tupleindex, bool checkIndex);
@@ -2160,7 +2162,9 @@ static void inittapes(Tuplesortstate* state)
     /*
      * Create the tape set and allocate the per-tape data arrays.
      */
-    state->tapeset = LogicalTapeSetCreate(maxTapes);
+    state->tapeset = LogicalTapeSetCreate(maxTapes, u_sess->attr.attr_sql.enable_compress_sort_spill);
+    state->tapesetMem = 0;
+    chargetapesetmem(state);
 
     state->mergeactive = (bool*)palloc0(maxTapes * sizeof(bool));
     state->mergenext = (int*)palloc0(maxTapes * sizeof(int));
@@ -2493,6 +2497,9 @@ static void beginmerge(Tuplesortstate* state)
     state->mergefreelist = 0;            /* nothing in the freelist */
     state->mergefirstfree = activeTapes; /* 1st slot avail for preread */
 
+    /* the tape set's bookkeeping may have grown since the last pass */
+    chargetapesetmem(state);
+
     /*
      * Initialize space allocation to let each active input tape have an equal
      * share of preread space. For cluster environment, the memtupsize initial
@@ -2708,6 +2715,7 @@ static void dumptuples(Tuplesortstate* state, bool alltuples)
         Assert(state->memtupcount > 0);
         WRITETUP(state, state->tp_tapenum[state->destTape], &state->memtuples[0]);
         tuplesort_heap_siftup(state, true);
+        chargetapesetmem(state);
 
         /*
          * If the heap is empty *or* top run number has changed, we've
@@ -2756,6 +2764,22 @@ static void dumptuples(Tuplesortstate* state, bool alltuples)
     (void)pgstat_report_waitstatus(oldStatus);
 }
 
+/*
+ * chargetapesetmem - charge the growth of the tape set's bookkeeping
+ *
+ * A compressed tape set keeps a map entry per block written, see
+ * LogicalTapeSetMemory(); it only ever grows until the sort ends.
+ */
+static void chargetapesetmem(Tuplesortstate* state)
+{
+    int64 tapesetMem = (int64)LogicalTapeSetMemory(state->tapeset);
+
+    if (tapesetMem > state->tapesetMem) {
+        USEMEM(state, tapesetMem - state->tapesetMem);
+        state->tapesetMem = tapesetMem;
+    }
+}
+
 /*
  * tuplesort_rescan		- rewind and replay the scan
  */
@@ -25,6 +25,7 @@
 #include "knl/knl_variable.h"
 #include "instruments/instr_unique_sql.h"
 #include "instruments/unique_query.h"
+#include "instruments/instr_histogram.h"
 #include "utils/atomic.h"
 #include "utils/lsyscache.h"
 #include "utils/hsearch.h"
@@ -89,10 +90,21 @@ typedef struct {
     uint64 unique_sql_id; /* unique sql id */
 } UniqueSQLKey;
 
+/* percentiles reported by the unique sql view: p50, p95, p99, p999 */
+#define UNIQUE_SQL_PERCENTILE_NUM 4
+static const int UniqueSQLPercentiles[UNIQUE_SQL_PERCENTILE_NUM] = {500, 950, 990, 999};
+
 typedef struct {
     int64 total_time; /* total time for the unique sql entry */
     int64 min_time;   /* min time for unique sql entry's history events */
     int64 max_time;   /* max time for unique sql entry's history events */
+
+    /*
+     * distribution of elapse time, stored right after the hash entry.
+     * Snapshots only carry the percentiles computed from it.
+     */
+    InstrHistogram* histogram;
+    int64 percentiles[UNIQUE_SQL_PERCENTILE_NUM];
 } UniqueSQLElapseTime;
 
 typedef struct UniqueSQLTime {
@@ -124,7 +136,10 @@ typedef struct {
 typedef struct {
     UniqueSQLKey key; /* CN oid + user oid + unique sql id */
 
-    /* alloc extra UNIQUE_SQL_MAX_LEN space to store unique sql string */
+    /*
+     * hash entries alloc extra space after the struct for the elapse time
+     * histogram, then UNIQUE_SQL_MAX_LEN to store unique sql string
+     */
     char* unique_sql; /* unique sql text */
 
     pg_atomic_uint64 calls;          /* calling times */
@@ -187,6 +202,8 @@ static void resetUniqueSQLEntry(UniqueSQL* entry)
         gs_lock_test_and_set_64(&(entry->elapse_time.total_time), 0);
         gs_lock_test_and_set_64(&(entry->elapse_time.min_time), 0);
         gs_lock_test_and_set_64(&(entry->elapse_time.max_time), 0);
+        entry->elapse_time.histogram = (InstrHistogram*)(entry + 1);
+        InstrHistogramReset(entry->elapse_time.histogram);
 
         // reset row activity stat
         pg_atomic_write_u64(&(entry->row_activity.returned_rows), 0);
@@ -240,11 +257,11 @@ void InitUniqueSQL()
     ctl.hcxt = g_instance.stat_cxt.UniqueSqlContext;
     ctl.keysize = sizeof(UniqueSQLKey);
 
-    // alloc extra space for normalized query(only CN stores sql string)
+    // alloc extra space for the histogram and normalized query(only CN stores sql string)
     if (need_normalize_unique_string()) {
-        ctl.entrysize = sizeof(UniqueSQL) + UNIQUE_SQL_MAX_LEN;
+        ctl.entrysize = sizeof(UniqueSQL) + sizeof(InstrHistogram) + UNIQUE_SQL_MAX_LEN;
     } else {
-        ctl.entrysize = sizeof(UniqueSQL);
+        ctl.entrysize = sizeof(UniqueSQL) + sizeof(InstrHistogram);
     }
 
     ctl.hash = uniqueSQLHashCode;
@@ -326,6 +343,7 @@ static void UpdateUniqueSQLElapseTime(UniqueSQL* unique_sql, int64 elapse_start)
     gs_atomic_add_64(&(unique_sql->elapse_time.total_time), elapse_time);
     updateMaxValueForAtomicType(elapse_time, &(unique_sql->elapse_time.max_time));
     updateMinValueForAtomicType(elapse_time, &(unique_sql->elapse_time.min_time));
+    InstrHistogramRecord(unique_sql->elapse_time.histogram, elapse_time);
 }
 
 /*
@@ -419,7 +437,7 @@ static void set_unique_sql_string_in_entry(UniqueSQL* entry, Query* query, const
 
     // only CN stores normalized query string
     if (need_normalize_unique_string()) {
-        entry->unique_sql = (char*)(entry + 1);
+        entry->unique_sql = (char*)(entry + 1) + sizeof(InstrHistogram);
         rc = memset_s(entry->unique_sql, UNIQUE_SQL_MAX_LEN, 0, UNIQUE_SQL_MAX_LEN);
         securec_check(rc, "\0", "\0");
     } else {
@@ -934,6 +952,9 @@ static void copy_unique_sql_entry(UniqueSQL* unique_sql_array, int num, int i, U
     unique_sql_array[i].elapse_time.total_time = entry->elapse_time.total_time;
     unique_sql_array[i].elapse_time.min_time = entry->elapse_time.min_time;
     unique_sql_array[i].elapse_time.max_time = entry->elapse_time.max_time;
+    unique_sql_array[i].elapse_time.histogram = NULL;
+    InstrHistogramPercentiles(entry->elapse_time.histogram, UniqueSQLPercentiles, UNIQUE_SQL_PERCENTILE_NUM,
+        unique_sql_array[i].elapse_time.percentiles);
 
     // row activity
     unique_sql_array[i].row_activity.returned_rows = entry->row_activity.returned_rows;
@@ -1189,13 +1210,18 @@ static void create_tuple_entry(TupleDesc tupdesc)
     for (num = 0; num < TOTAL_TIME_INFO_TYPES; num++) {
         TupleDescInitEntry(tupdesc, (AttrNumber)++i, TimeInfoTypeName[num], INT8OID, -1, 0);
     }
+
+    TupleDescInitEntry(tupdesc, (AttrNumber)++i, "p50_elapse_time", INT8OID, -1, 0);
+    TupleDescInitEntry(tupdesc, (AttrNumber)++i, "p95_elapse_time", INT8OID, -1, 0);
+    TupleDescInitEntry(tupdesc, (AttrNumber)++i, "p99_elapse_time", INT8OID, -1, 0);
+    TupleDescInitEntry(tupdesc, (AttrNumber)++i, "p999_elapse_time", INT8OID, -1, 0);
 }
 
-static void set_tuple_cn_node_name(UniqueSQL* unique_sql, Datum* values, int* i)
+static void set_tuple_cn_node_name(uint32 cn_id, Datum* values, int* i)
 {
     // cn node name
     if (IS_PGXC_COORDINATOR || IS_SINGLE_NODE) {
-        char* node_name = get_pgxc_node_name_by_node_id(unique_sql->key.cn_id, false);
+        char* node_name = get_pgxc_node_name_by_node_id(cn_id, false);
         if (node_name != NULL) {
             values[(*i)++] = DirectFunctionCall1(namein, CStringGetDatum(node_name));
             pfree(node_name);
@@ -1241,7 +1267,7 @@ static void set_tuple_value(UniqueSQL* unique_sql, Datum* values, bool* nulls, i
     int i = 0;
     int num = 0;
 
-    set_tuple_cn_node_name(unique_sql, values, &i);
+    set_tuple_cn_node_name(unique_sql->key.cn_id, values, &i);
     values[i++] = UInt32GetDatum(unique_sql->key.cn_id);
     set_tuple_user_name(unique_sql, values, &i);
 
@@ -1278,6 +1304,11 @@ static void set_tuple_value(UniqueSQL* unique_sql, Datum* values, bool* nulls, i
         values[i++] = Int64GetDatum(unique_sql->timeInfo.TimeInfoArray[num]);
     }
 
+    // response time percentiles, never above the observed max
+    for (num = 0; num < UNIQUE_SQL_PERCENTILE_NUM; num++) {
+        values[i++] = Int64GetDatum(Min(unique_sql->elapse_time.percentiles[num], unique_sql->elapse_time.max_time));
+    }
+
     Assert(arr_size == i);
 }
 
@@ -1289,7 +1320,7 @@ Datum get_instr_unique_sql(PG_FUNCTION_ARGS)
     FuncCallContext* funcctx = NULL;
     long num = 0;
 
-#define INSTRUMENTS_UNIQUE_SQL_ATTRNUM (20 + TOTAL_TIME_INFO_TYPES)
+#define INSTRUMENTS_UNIQUE_SQL_ATTRNUM (20 + TOTAL_TIME_INFO_TYPES + UNIQUE_SQL_PERCENTILE_NUM)
 
     if (!superuser()) {
         ereport(
@@ -1344,6 +1375,142 @@ Datum get_instr_unique_sql(PG_FUNCTION_ARGS)
     }
 }
 
+/* one non-empty elapse time histogram bucket of a unique sql entry */
+typedef struct {
+    UniqueSQLKey key;
+    int bucket;
+    uint64 count;
+} UniqueSQLHistogramBucket;
+
+/*
+ * @Description: copy the non-empty histogram buckets of the local unique sql
+ *     entries, in the same way GetUniqueSQLStat copies the entries
+ * @out num - bucket count
+ * @return - the bucket array, NULL if empty
+ */
+static UniqueSQLHistogramBucket* GetUniqueSQLHistogramBuckets(long* num)
+{
+    HASH_SEQ_STATUS hash_seq;
+    UniqueSQL* entry = NULL;
+    UniqueSQLHistogramBucket* buckets = NULL;
+    long capacity = 0;
+    uint64 counts[INSTR_HIST_NUM_BUCKETS];
+    int i;
+
+    *num = 0;
+    if (!is_unique_sql_enabled() || g_instance.stat_cxt.UniqueSQLHashtbl == NULL) {
+        return NULL;
+    }
+
+    for (i = 0; i < NUM_UNIQUE_SQL_PARTITIONS; i++) {
+        LWLockAcquire(GetMainLWLockByIndex(FirstUniqueSQLMappingLock + i), LW_SHARED);
+    }
+
+    hash_seq_init(&hash_seq, g_instance.stat_cxt.UniqueSQLHashtbl);
+    while ((entry = (UniqueSQL*)hash_seq_search(&hash_seq)) != NULL) {
+        if (!(IS_PGXC_DATANODE || (IS_PGXC_COORDINATOR && entry->is_local))) {
+            continue;
+        }
+
+        (void)InstrHistogramSnapshot(entry->elapse_time.histogram, counts);
+        for (int bucket = 0; bucket < INSTR_HIST_NUM_BUCKETS; bucket++) {
+            if (counts[bucket] == 0) {
+                continue;
+            }
+            if (*num == capacity) {
+                capacity = (capacity == 0) ? INSTR_HIST_SUB_BUCKETS * 16 : capacity * 2;
+                buckets = (buckets == NULL)
+                              ? (UniqueSQLHistogramBucket*)palloc(capacity * sizeof(UniqueSQLHistogramBucket))
+                              : (UniqueSQLHistogramBucket*)repalloc(buckets, capacity * sizeof(UniqueSQLHistogramBucket));
+            }
+            buckets[*num].key = entry->key;
+            buckets[*num].bucket = bucket;
+            buckets[*num].count = counts[bucket];
+            (*num)++;
+        }
+    }
+
+    for (i = 0; i < NUM_UNIQUE_SQL_PARTITIONS; i++) {
+        LWLockRelease(GetMainLWLockByIndex(FirstUniqueSQLMappingLock + i));
+    }
+    return buckets;
+}
+
+/*
+ * get_instr_unique_sql_histogram - C function to get the raw elapse time
+ * histograms of the unique sql entries
+ *
+ * One row per non-empty bucket, the upper bound of the last bucket is NULL.
+ * Bucket bounds are the same on every node, so the histograms of several
+ * nodes merge by adding the counts of equal bounds.
+ */
+Datum get_instr_unique_sql_histogram(PG_FUNCTION_ARGS)
+{
+    FuncCallContext* funcctx = NULL;
+    long num = 0;
+
+#define INSTRUMENTS_UNIQUE_SQL_HISTOGRAM_ATTRNUM 6
+
+    if (!superuser()) {
+        ereport(
+            ERROR, (errcode(ERRCODE_INSUFFICIENT_PRIVILEGE), (errmsg("only system admin can query unique sql view"))));
+    }
+
+    if (SRF_IS_FIRSTCALL()) {
+        MemoryContext oldcontext = NULL;
+        TupleDesc tupdesc = NULL;
+        int i = 0;
+
+        funcctx = SRF_FIRSTCALL_INIT();
+        oldcontext = MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
+
+        tupdesc = CreateTemplateTupleDesc(INSTRUMENTS_UNIQUE_SQL_HISTOGRAM_ATTRNUM, false);
+        TupleDescInitEntry(tupdesc, (AttrNumber)++i, "node_name", NAMEOID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber)++i, "user_id", OIDOID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber)++i, "unique_sql_id", INT8OID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber)++i, "lower_bound", INT8OID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber)++i, "upper_bound", INT8OID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber)++i, "count", INT8OID, -1, 0);
+
+        funcctx->tuple_desc = BlessTupleDesc(tupdesc);
+        funcctx->user_fctx = GetUniqueSQLHistogramBuckets(&num);
+        funcctx->max_calls = num;
+        MemoryContextSwitchTo(oldcontext);
+    }
+
+    funcctx = SRF_PERCALL_SETUP();
+    if (funcctx->call_cntr < funcctx->max_calls) {
+        Datum values[INSTRUMENTS_UNIQUE_SQL_HISTOGRAM_ATTRNUM];
+        bool nulls[INSTRUMENTS_UNIQUE_SQL_HISTOGRAM_ATTRNUM] = {false};
+        HeapTuple tuple = NULL;
+        UniqueSQLHistogramBucket* bucket = (UniqueSQLHistogramBucket*)funcctx->user_fctx + funcctx->call_cntr;
+        int64 lower = 0;
+        int64 upper = 0;
+        int i = 0;
+
+        set_tuple_cn_node_name(bucket->key.cn_id, values, &i);
+        values[i++] = ObjectIdGetDatum(bucket->key.user_id);
+        values[i++] = Int64GetDatum(bucket->key.unique_sql_id);
+        if (InstrHistogramBucketBounds(bucket->bucket, &lower, &upper)) {
+            values[i++] = Int64GetDatum(lower);
+            values[i++] = Int64GetDatum(upper);
+        } else {
+            values[i++] = Int64GetDatum(lower);
+            nulls[i++] = true;
+        }
+        values[i++] = Int64GetDatum((int64)bucket->count);
+        Assert(i == INSTRUMENTS_UNIQUE_SQL_HISTOGRAM_ATTRNUM);
+
+        tuple = heap_form_tuple(funcctx->tuple_desc, values, nulls);
+        SRF_RETURN_NEXT(funcctx, HeapTupleGetDatum(tuple));
+    } else {
+        if (funcctx->user_fctx) {
+            pfree_ext(funcctx->user_fctx);
+        }
+        SRF_RETURN_DONE(funcctx);
+    }
+}
+
 /*
  * GenerateUniqueSQLInfo - generate unique sql info
  *
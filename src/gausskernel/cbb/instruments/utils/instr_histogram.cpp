@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ * instr_histogram.cpp
+ *        log-linear latency histogram for percentile estimation
+ *
+ * IDENTIFICATION
+ *	  src/gausskernel/cbb/instruments/utils/instr_histogram.cpp
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "instruments/instr_histogram.h"
+
+/*
+ * map a value to its bucket: values below INSTR_HIST_SUB_BUCKETS have a bucket each,
+ * larger values use the top INSTR_HIST_SUB_BUCKET_BITS + 1 significant bits.
+ */
+static inline int InstrHistogramBucket(uint64 value)
+{
+    if (value < INSTR_HIST_SUB_BUCKETS) {
+        return (int)value;
+    }
+    if (value >= (UINT64CONST(1) << INSTR_HIST_MAX_BITS)) {
+        return INSTR_HIST_NUM_BUCKETS - 1;
+    }
+
+    int msb = 63 - __builtin_clzll(value);
+    int shift = msb - INSTR_HIST_SUB_BUCKET_BITS;
+    int sub = (int)((value >> shift) & (INSTR_HIST_SUB_BUCKETS - 1));
+    return (shift + 1) * INSTR_HIST_SUB_BUCKETS + sub;
+}
+
+/* the value reported for a bucket: the middle of its range */
+static inline int64 InstrHistogramBucketValue(int bucket)
+{
+    if (bucket < INSTR_HIST_SUB_BUCKETS) {
+        return bucket;
+    }
+
+    int shift = bucket / INSTR_HIST_SUB_BUCKETS - 1;
+    int sub = bucket % INSTR_HIST_SUB_BUCKETS;
+    uint64 lower = (uint64)(INSTR_HIST_SUB_BUCKETS + sub) << shift;
+    return (int64)(lower + ((UINT64CONST(1) << shift) >> 1));
+}
+
+void InstrHistogramReset(InstrHistogram* hist)
+{
+    for (int i = 0; i < INSTR_HIST_NUM_BUCKETS; i++) {
+        pg_atomic_write_u64(&hist->buckets[i], 0);
+    }
+}
+
+void InstrHistogramRecord(InstrHistogram* hist, int64 value)
+{
+    if (value < 0) {
+        value = 0;
+    }
+    pg_atomic_fetch_add_u64(&hist->buckets[InstrHistogramBucket((uint64)value)], 1);
+}
+
+/*
+ * InstrHistogramSnapshot - copy the bucket counters to counts
+ *
+ * counts must have room for INSTR_HIST_NUM_BUCKETS entries. Counters may move
+ * while they are read, callers work on the copy. Returns the total count.
+ */
+uint64 InstrHistogramSnapshot(const InstrHistogram* hist, uint64* counts)
+{
+    uint64 total = 0;
+
+    for (int i = 0; i < INSTR_HIST_NUM_BUCKETS; i++) {
+        counts[i] = pg_atomic_read_u64((pg_atomic_uint64*)&hist->buckets[i]);
+        total += counts[i];
+    }
+    return total;
+}
+
+/*
+ * InstrHistogramBucketBounds - value range [lower, upper) of a bucket
+ *
+ * Returns false for the last bucket, which has no upper bound.
+ */
+bool InstrHistogramBucketBounds(int bucket, int64* lower, int64* upper)
+{
+    if (bucket < INSTR_HIST_SUB_BUCKETS) {
+        *lower = bucket;
+        *upper = bucket + 1;
+        return true;
+    }
+
+    int shift = bucket / INSTR_HIST_SUB_BUCKETS - 1;
+    int sub = bucket % INSTR_HIST_SUB_BUCKETS;
+    *lower = (int64)((uint64)(INSTR_HIST_SUB_BUCKETS + sub) << shift);
+    *upper = *lower + (int64)(UINT64CONST(1) << shift);
+    return bucket < INSTR_HIST_NUM_BUCKETS - 1;
+}
+
+/*
+ * InstrHistogramPercentiles - estimate several percentiles in one pass
+ *
+ * permille must be ascending, e.g. {500, 950, 990, 999} for p50/p95/p99/p999.
+ * Results are 0 when the histogram is empty.
+ */
+void InstrHistogramPercentiles(const InstrHistogram* hist, const int* permille, int num, int64* result)
+{
+    uint64 counts[INSTR_HIST_NUM_BUCKETS];
+    uint64 total = InstrHistogramSnapshot(hist, counts);
+
+    int bucket = 0;
+    uint64 seen = 0;
+    for (int p = 0; p < num; p++) {
+        if (total == 0) {
+            result[p] = 0;
+            continue;
+        }
+
+        /* rank of the percentile, 1-based and rounded up */
+        uint64 rank = (total * (uint64)permille[p] + 999) / 1000;
+        if (rank == 0) {
+            rank = 1;
+        }
+        while (bucket < INSTR_HIST_NUM_BUCKETS - 1 && seen + counts[bucket] < rank) {
+            seen += counts[bucket];
+            bucket++;
+        }
+        result[p] = InstrHistogramBucketValue(bucket);
+    }
+}
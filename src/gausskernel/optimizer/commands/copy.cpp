@@ -18,6 +18,11 @@
 #include <arpa/inet.h>
 #include <fnmatch.h>
 #include <libgen.h>
+#ifdef __aarch64__
+#include <arm_neon.h>
+#elif defined(__x86_64__)
+#include <emmintrin.h>
+#endif
 #include "access/heapam.h"
 #include "access/hash.h"
 #include "access/hbucket_am.h"
@@ -205,6 +210,54 @@ typedef struct {
 
 static const char BinarySignature[15] = "PGCOPY\n\377\r\n\0";
 
+/* bytes looked at by one vector compare in CopyPlainRunLength() */
+#define COPY_SCAN_BLOCK 16
+
+/*
+ * CopyPlainRunLength - length of the run of bytes at the start of buf[0 .. len)
+ * which the COPY scanners just pass over
+ *
+ * A byte ends the run if it is one of the nstops bytes in stops[], or if
+ * stop_at_highbit and its high bit is set.  Only whole COPY_SCAN_BLOCK sized
+ * blocks are compared, with SSE2 or NEON which every x86-64 and aarch64 CPU
+ * has; the caller's byte-at-a-time loop handles whatever is left, so the run
+ * may be reported shorter than it is, but never longer.
+ */
+static inline int CopyPlainRunLength(const char* buf, int len, const char* stops, int nstops, bool stop_at_highbit)
+{
+    int run = 0;
+
+#if defined(__x86_64__)
+    while (run + COPY_SCAN_BLOCK <= len) {
+        __m128i block = _mm_loadu_si128((const __m128i*)(buf + run));
+        /* movemask takes the high bit of every byte, of the data itself to start with */
+        __m128i hit = stop_at_highbit ? block : _mm_setzero_si128();
+        int mask;
+
+        for (int i = 0; i < nstops; i++)
+            hit = _mm_or_si128(hit, _mm_cmpeq_epi8(block, _mm_set1_epi8(stops[i])));
+        mask = _mm_movemask_epi8(hit);
+        if (mask != 0)
+            return run + __builtin_ctz((unsigned int)mask);
+        run += COPY_SCAN_BLOCK;
+    }
+#elif defined(__aarch64__)
+    while (run + COPY_SCAN_BLOCK <= len) {
+        uint8x16_t block = vld1q_u8((const uint8*)(buf + run));
+        uint8x16_t hit = stop_at_highbit ? vcgeq_u8(block, vdupq_n_u8(0x80)) : vdupq_n_u8(0);
+
+        for (int i = 0; i < nstops; i++)
+            hit = vorrq_u8(hit, vceqq_u8(block, vdupq_n_u8((uint8)stops[i])));
+        /* no cheap movemask here, leave the block to the byte loop */
+        if (vmaxvq_u8(hit) != 0)
+            break;
+        run += COPY_SCAN_BLOCK;
+    }
+#endif
+
+    return run;
+}
+
 /* non-export function prototypes */
 static CopyState BeginCopy(bool is_from, Relation rel, Node* raw_query, const char* queryString, List* attnamelist,
     List* options, bool is_copy = true);
@@ -5657,6 +5710,10 @@ static bool CopyReadLineTextTemplate(CopyState cstate)
     char quotec = '\0';
     char escapec = '\0';
 
+    /* bytes the loop below has to look at one by one */
+    char stops[5];
+    int nstops = 0;
+
     if (csv_mode) {
         quotec = cstate->quote[0];
         escapec = cstate->escape[0];
@@ -5668,6 +5725,22 @@ static bool CopyReadLineTextTemplate(CopyState cstate)
 
     mblen_str[1] = '\0';
 
+    if (cstate->eol_type == EOL_UD) {
+        stops[nstops++] = cstate->eol[0];
+        /* a quoted \r still counts as a line for cur_lineno, see below */
+        if (csv_mode && cstate->eol[0] != '\r')
+            stops[nstops++] = '\r';
+    } else {
+        stops[nstops++] = '\n';
+        stops[nstops++] = '\r';
+    }
+    stops[nstops++] = '\\';
+    if (csv_mode) {
+        stops[nstops++] = quotec;
+        if (escapec != '\0')
+            stops[nstops++] = escapec;
+    }
+
     /*
      * The objective of this loop is to transfer the entire next input line
      * into line_buf.  Hence, we only care for detecting newlines (\r and/or
@@ -5730,6 +5803,25 @@ static bool CopyReadLineTextTemplate(CopyState cstate)
             need_data = false;
         }
 
+        /*
+         * Pass over the bytes none of the checks below care about a block at
+         * a time: they are neither line ends, quotes, escapes nor backslashes,
+         * nor the lead byte of a multi-byte character.  Reaching the end of
+         * the loaded data goes back to the top to load more.
+         */
+        if (copy_buf_len - raw_buf_ptr >= COPY_SCAN_BLOCK) {
+            int run = CopyPlainRunLength(copy_raw_buf + raw_buf_ptr,
+                copy_buf_len - raw_buf_ptr, stops, nstops, cstate->encoding_embeds_ascii);
+
+            if (run > 0) {
+                raw_buf_ptr += run;
+                first_char_in_line = false;
+                last_was_esc = false;
+                if (raw_buf_ptr >= copy_buf_len)
+                    continue;
+            }
+        }
+
         /* OK to fetch a character */
         prev_raw_ptr = raw_buf_ptr;
         c = copy_raw_buf[raw_buf_ptr++];
@@ -6117,6 +6209,9 @@ static int CopyReadAttributesTextT(CopyState cstate)
     char* line_begin_ptr = NULL;
     IllegalCharErrInfo* err_info = NULL;
     ListCell* cur = NULL;
+    char stops[2];
+    int nstops = 0;
+    bool gbk_encoding = (PG_GBK == GetDatabaseEncoding());
 
     /*
      * We need a special case for zero-column tables: check that the input
@@ -6149,6 +6244,11 @@ static int CopyReadAttributesTextT(CopyState cstate)
     line_begin_ptr = cstate->line_buf.data;
     line_end_ptr = cstate->line_buf.data + cstate->line_buf.len;
 
+    /* everything but these is copied to the output as it is */
+    stops[nstops++] = delimc;
+    if (!cstate->without_escaping)
+        stops[nstops++] = '\\';
+
     /* Outer loop iterates over fields */
     fieldno = 0;
     for (;;) {
@@ -6182,6 +6282,17 @@ static int CopyReadAttributesTextT(CopyState cstate)
         for (;;) {
             char c;
 
+            if (line_end_ptr - cur_ptr >= COPY_SCAN_BLOCK) {
+                int run = CopyPlainRunLength(cur_ptr, (int)(line_end_ptr - cur_ptr), stops, nstops, gbk_encoding);
+
+                if (run > 0) {
+                    errno_t rc = memcpy_s(output_ptr, run, cur_ptr, run);
+                    securec_check(rc, "\0", "\0");
+                    output_ptr += run;
+                    cur_ptr += run;
+                }
+            }
+
             end_ptr = cur_ptr;
             if (cur_ptr >= line_end_ptr) {
                 break;
@@ -6291,7 +6402,7 @@ static int CopyReadAttributesTextT(CopyState cstate)
              * Here we have one that does not correctly identifies delimiter because of the nature
              * of GBK encoding. It is fixed by skipping the second char when we encounter a GBK 2-byte.
              */
-            if ((PG_GBK == GetDatabaseEncoding()) && IS_HIGHBIT_SET(c)) {
+            if (gbk_encoding && IS_HIGHBIT_SET(c)) {
                 /*
                  * We don't do encoding validation check here because we already went through
                  * the test in pg_any_to_server
@@ -6402,6 +6513,9 @@ static int CopyReadAttributesCSVT(CopyState cstate)
     char* line_begin_ptr = NULL;
     IllegalCharErrInfo* err_info = NULL;
     ListCell* cur = NULL;
+    /* bytes ending a run of plain data outside and inside quotes */
+    char unquoted_stops[2] = {delimc, quotec};
+    char quoted_stops[2] = {escapec, quotec};
 
     /*
      * We need a special case for zero-column tables: check that the input
@@ -6470,6 +6584,17 @@ static int CopyReadAttributesCSVT(CopyState cstate)
 
             /* Not in quote */
             for (;;) {
+                if (line_end_ptr - cur_ptr >= COPY_SCAN_BLOCK) {
+                    int run = CopyPlainRunLength(cur_ptr, (int)(line_end_ptr - cur_ptr), unquoted_stops, 2, false);
+
+                    if (run > 0) {
+                        errno_t rc = memcpy_s(output_ptr, run, cur_ptr, run);
+                        securec_check(rc, "\0", "\0");
+                        output_ptr += run;
+                        cur_ptr += run;
+                    }
+                }
+
                 end_ptr = cur_ptr;
                 if (cur_ptr >= line_end_ptr) {
                     goto endfield;
@@ -6494,6 +6619,17 @@ static int CopyReadAttributesCSVT(CopyState cstate)
 
             /* In quote */
             for (;;) {
+                if (line_end_ptr - cur_ptr >= COPY_SCAN_BLOCK) {
+                    int run = CopyPlainRunLength(cur_ptr, (int)(line_end_ptr - cur_ptr), quoted_stops, 2, false);
+
+                    if (run > 0) {
+                        errno_t rc = memcpy_s(output_ptr, run, cur_ptr, run);
+                        securec_check(rc, "\0", "\0");
+                        output_ptr += run;
+                        cur_ptr += run;
+                    }
+                }
+
                 end_ptr = cur_ptr;
                 if (cur_ptr >= line_end_ptr)
                     ereport(ERROR, (errcode(ERRCODE_BAD_COPY_FILE_FORMAT), errmsg("unterminated CSV quoted field")));
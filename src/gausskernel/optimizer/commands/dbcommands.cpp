@@ -60,6 +60,7 @@
 #include "utils/acl.h"
 #include "utils/builtins.h"
 #include "utils/fmgroids.h"
+#include "utils/globalcatcache.h"
 #include "utils/inval.h"
 #include "utils/memutils.h"
 #include "utils/pg_locale.h"
@@ -947,6 +948,11 @@ void dropdb(const char* dbname, bool missing_ok)
      */
     DropDatabaseBuffers(db_id);
 
+    /*
+     * Drop the database's rows from the global catalog cache as well.
+     */
+    GlobalCatCacheDropDatabase(db_id);
+
     /*
      * Tell the stats collector to forget it immediately, too.
      */
@@ -2134,6 +2140,9 @@ void xlog_db_drop(Oid dbId, Oid tbSpcId)
     /* Drop pages for this database that are in the shared buffer cache */
     DropDatabaseBuffers(dbId);
 
+    /* And its rows in the global catalog cache */
+    GlobalCatCacheDropDatabase(dbId);
+
     /* Also, clean out any fsync requests that might be pending in md.c */
     ForgetDatabaseFsyncRequests(dbId);
 
@@ -2355,8 +2355,12 @@ static void ExplainNode(
             show_tablesample(plan, planstate, ancestors, es);
 
             show_scan_qual(plan->qual, "Filter", planstate, ancestors, es);
+            if (IsA(plan, CStoreScan))
+                show_bloomfilter<false>(plan, planstate, ancestors, es);
             if (plan->qual)
                 show_instrumentation_count("Rows Removed by Filter", 1, planstate, es);
+            if (IsA(plan, CStoreScan) && plan->var_list != NIL)
+                show_instrumentation_count("Rows Removed by Bloom Filter", 2, planstate, es);
             show_llvm_info(planstate, es);
             break;
         case T_DfsScan: {
@@ -609,6 +609,7 @@ Oid DefineIndex(Oid relationId, IndexStmt* stmt, Oid indexRelationId, bool is_al
     }
     accessMethodId = HeapTupleGetOid(tuple);
     accessMethodForm = (Form_pg_am)GETSTRUCT(tuple);
+
     if (stmt->unique && !accessMethodForm->amcanunique)
         ereport(ERROR,
             (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
@@ -640,6 +641,23 @@ Oid DefineIndex(Oid relationId, IndexStmt* stmt, Oid indexRelationId, bool is_al
 
     (void)index_reloptions(amoptions, reloptions, true);
 
+    /*
+     * index_method only chooses between the MOT index structures, reject it on
+     * any other table rather than silently ignoring it.
+     */
+    if (!(rel->rd_rel->relkind == RELKIND_FOREIGN_TABLE && isMOTFromTblOid(RelationGetRelid(rel)))) {
+        ListCell* optcell = NULL;
+
+        foreach (optcell, stmt->options) {
+            DefElem* def = (DefElem*)lfirst(optcell);
+
+            if (pg_strcasecmp(def->defname, "index_method") == 0 && pg_strcasecmp(defGetString(def), "tree") != 0)
+                ereport(ERROR,
+                    (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+                        errmsg("index_method \"%s\" is only supported for MOT tables", defGetString(def))));
+        }
+    }
+
     /*
      * Prepare arguments for index_create, primarily an IndexInfo structure.
      * Note that ii_Predicate must be in implicit-AND format.
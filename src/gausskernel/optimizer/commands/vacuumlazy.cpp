@@ -11,17 +11,19 @@
  * on the number of tuples and pages we will keep track of at once.
  *
  * We are willing to use at most maintenance_work_mem memory space to keep
- * track of dead tuples.  We initially allocate an array of TIDs of that size,
- * with an upper limit that depends on table size (this limit ensures we don't
- * allocate a huge area uselessly for vacuuming small tables).	If the array
- * threatens to overflow, we suspend the heap scan phase and perform a pass of
- * index cleanup and page compaction, then resume the heap scan with an empty
- * TID array.
+ * track of dead tuples.  We initially allocate a TID store (see
+ * access/tidstore.h) of that size, with an upper limit that depends on table
+ * size (this limit ensures we don't allocate a huge area uselessly for
+ * vacuuming small tables).  The store keeps the dead offsets of each page as
+ * a bitmap or a short array, so it holds many more TIDs than a plain array
+ * would.  If the store threatens to overflow, we suspend the heap scan phase
+ * and perform a pass of index cleanup and page compaction, then resume the
+ * heap scan with an empty store.
  *
  * If we're processing a table with no indexes, we can just vacuum each page
  * as we go; there's no need to save up multiple tuples to minimize the number
  * of index scans performed.  So we don't use maintenance_work_mem memory for
- * the TID array, just enough to hold as many heap tuples as fit on one page.
+ * the TID store, just enough to hold the dead tuples of a page.
  *
  *
  * Portions Copyright (c) 2020 Huawei Technologies Co.,Ltd.
@@ -43,6 +45,7 @@
 #include "access/cstore_insert.h"
 #include "access/genam.h"
 #include "access/heapam.h"
+#include "access/tidstore.h"
 #include "access/transam.h"
 #include "access/visibilitymap.h"
 #include "access/xlog.h"
@@ -73,13 +76,6 @@
 #include "pgxc/pgxc.h"
 #endif
 
-/*
- * Guesstimation of number of dead tuples per page.  This is used to
- * provide an upper limit to memory allocated when vacuuming small
- * tables.
- */
-#define LAZY_ALLOC_TUPLES MaxHeapTuplesPerPage
-
 /*
  * Before we consider skipping a page that's marked as clean in
  * visibility map, we must've seen at least this many clean pages.
@@ -94,17 +90,15 @@ typedef struct LVRelStats {
     BlockNumber old_rel_pages; /* previous value of pg_class.relpages */
     BlockNumber rel_pages;     /* total number of pages */
     BlockNumber scanned_pages; /* number of pages we examined */
+    BlockNumber vacuumed_pages; /* pages whose dead tuples were reclaimed */
     double scanned_tuples;     /* counts only tuples on scanned pages */
     double old_rel_tuples;     /* previous value of pg_class.reltuples */
     double new_rel_tuples;     /* new estimated total # of tuples */
     BlockNumber pages_removed;
     double tuples_deleted;
     BlockNumber nonempty_pages; /* actually, last nonempty page + 1 */
-    /* List of TIDs of tuples we intend to delete */
-    /* NB: this list is ordered by TID address */
-    int num_dead_tuples;     /* current # of entries */
-    int max_dead_tuples;     /* # slots allocated in array */
-    ItemPointer dead_tuples; /* array of ItemPointerData */
+    /* TIDs of tuples we intend to delete, added in TID order */
+    TidStore* dead_tuples;
     int num_index_scans;
     TransactionId latestRemovedXid;
     bool lock_waiter_detected;
@@ -140,14 +134,15 @@ static void lazy_scan_rel(Relation onerel, LVRelStats* vacrelstats, VacuumStmt*
     bool scan_all, double* deleteTupleNum);
 static void lazy_vacuum_heap(Relation onerel, LVRelStats* vacrelstats);
 static bool lazy_check_needs_freeze(Buffer buf);
-static void lazy_vacuum_index(Relation indrel, IndexBulkDeleteResult** stats, LVRelStats* vacrelstats);
+static void lazy_vacuum_index(Relation indrel, int idx, IndexBulkDeleteResult** stats, LVRelStats* vacrelstats);
 static IndexBulkDeleteResult* lazy_cleanup_index(
-    Relation indrel, IndexBulkDeleteResult* stats, LVRelStats* vacrelstats);
-static int lazy_vacuum_page(Relation onerel, BlockNumber blkno, Buffer buffer, int tupindex, LVRelStats* vacrelstats);
+    Relation indrel, int idx, IndexBulkDeleteResult* stats, LVRelStats* vacrelstats);
+static void lazy_vacuum_page(
+    Relation onerel, BlockNumber blkno, Buffer buffer, OffsetNumber* offsets, int noffsets, LVRelStats* vacrelstats);
 static void lazy_space_alloc(LVRelStats* vacrelstats, BlockNumber relblocks);
 static void lazy_record_dead_tuple(LVRelStats* vacrelstats, ItemPointer itemptr);
+static void lazy_report_scan_progress(LVRelStats* vacrelstats, BlockNumber blkno);
 static bool lazy_tid_reaped(ItemPointer itemptr, void* state);
-static int vac_cmp_itemptr(const void* left, const void* right);
 
 /*
  *	lazy_vacuum_rel() -- perform LAZY VACUUM for one heap relation
@@ -386,11 +381,15 @@ void lazy_vacuum_rel(Relation onerel, VacuumStmt* vacstmt, BufferAccessStrategy
 
     vacrelstats->hasindex = (nindexes > 0);
 
+    pgstat_progress_vacuum_start(RelationGetRelid(onerel), Irel, nindexes);
+
     if (RELATION_CREATE_BUCKET(onerel)) {
         lazy_scan_bucket(onerel, vacrelstats, vacstmt, Irel, nindexes, scan_all, &deleteTupleNum);
     } else {
         lazy_scan_rel(onerel, vacrelstats, vacstmt, Irel, nindexes, scan_all, &deleteTupleNum);
     }
+    pgstat_progress_vacuum_end();
+
     /*
      * Update statistics in pg_class.
      *
@@ -793,11 +792,24 @@ static IndexBulkDeleteResult** lazy_scan_heap(
     nblocks = RelationGetNumberOfBlocks(onerel);
     vacrelstats->rel_pages = nblocks;
     vacrelstats->scanned_pages = 0;
+    vacrelstats->vacuumed_pages = 0;
     vacrelstats->nonempty_pages = 0;
     vacrelstats->latestRemovedXid = InvalidTransactionId;
 
     lazy_space_alloc(vacrelstats, nblocks);
 
+    /* for a hash bucketed relation these describe the bucket being scanned */
+    {
+        const VacuumProgressField fields[] = {VACUUM_PROGRESS_PHASE,
+            VACUUM_PROGRESS_HEAP_BLKS_TOTAL,
+            VACUUM_PROGRESS_HEAP_BLKS_SCANNED,
+            VACUUM_PROGRESS_HEAP_BLKS_VACUUMED,
+            VACUUM_PROGRESS_MAX_DEAD_TUPLE_BYTES};
+        const int64 values[] = {
+            VACUUM_PHASE_SCAN_HEAP, nblocks, 0, 0, (int64)TidStoreMaxMemory(vacrelstats->dead_tuples)};
+        pgstat_progress_vacuum_update_multi(lengthof(fields), fields, values);
+    }
+
     /*
      * We want to skip pages that don't require vacuuming according to the
      * visibility map, but only when we can skip at least SKIP_PAGES_THRESHOLD
@@ -864,7 +876,7 @@ static IndexBulkDeleteResult** lazy_scan_heap(
         OffsetNumber offnum, maxoff;
         bool tupgone = false;
         bool hastup = false;
-        int prev_dead_count;
+        int64 prev_dead_count;
         OffsetNumber frozen[MaxOffsetNumber];
         int nfrozen;
         Size freespace;
@@ -877,6 +889,8 @@ static IndexBulkDeleteResult** lazy_scan_heap(
         if (ENABLE_WORKLOAD_CONTROL)
             IOSchedulerAndUpdate(IO_TYPE_READ, 1, IO_TYPE_ROW);
 
+        lazy_report_scan_progress(vacrelstats, blkno);
+
         if (blkno == next_not_all_visible_block) {
             /* Time to advance next_not_all_visible_block */
             for (next_not_all_visible_block++; next_not_all_visible_block < nblocks; next_not_all_visible_block++) {
@@ -914,8 +928,7 @@ static IndexBulkDeleteResult** lazy_scan_heap(
          * If we are close to overrunning the available space for dead-tuple
          * TIDs, pause and do a cycle of vacuuming before we tackle this page.
          */
-        if ((vacrelstats->max_dead_tuples - vacrelstats->num_dead_tuples) < MaxHeapTuplesPerPage &&
-            vacrelstats->num_dead_tuples > 0) {
+        if (TidStoreIsFull(vacrelstats->dead_tuples) && TidStoreNumTids(vacrelstats->dead_tuples) > 0) {
             /*
              * Before beginning index vacuuming, we release any pin we may
              * hold on the visibility map page.  This isn't necessary for
@@ -931,9 +944,11 @@ static IndexBulkDeleteResult** lazy_scan_heap(
             vacuum_log_cleanup_info(onerel, vacrelstats);
 
             /* Remove index entries */
+            pgstat_progress_vacuum_update(VACUUM_PROGRESS_PHASE, VACUUM_PHASE_VACUUM_INDEX);
             for (i = 0; i < nindexes; i++)
-                lazy_vacuum_index(Irel[i], &indstats[i], vacrelstats);
+                lazy_vacuum_index(Irel[i], i, &indstats[i], vacrelstats);
             /* Remove tuples from heap */
+            pgstat_progress_vacuum_update(VACUUM_PROGRESS_PHASE, VACUUM_PHASE_VACUUM_HEAP);
             lazy_vacuum_heap(onerel, vacrelstats);
 
             /*
@@ -941,8 +956,13 @@ static IndexBulkDeleteResult** lazy_scan_heap(
              * not to reset latestRemovedXid since we want that value to be
              * valid.
              */
-            vacrelstats->num_dead_tuples = 0;
+            TidStoreReset(vacrelstats->dead_tuples);
             vacrelstats->num_index_scans++;
+            {
+                const VacuumProgressField fields[] = {VACUUM_PROGRESS_INDEX_VACUUM_COUNT, VACUUM_PROGRESS_PHASE};
+                const int64 values[] = {vacrelstats->num_index_scans, VACUUM_PHASE_SCAN_HEAP};
+                pgstat_progress_vacuum_update_multi(lengthof(fields), fields, values);
+            }
         }
 
         /*
@@ -1093,7 +1113,7 @@ static IndexBulkDeleteResult** lazy_scan_heap(
         has_dead_tuples = false;
         nfrozen = 0;
         hastup = false;
-        prev_dead_count = vacrelstats->num_dead_tuples;
+        prev_dead_count = TidStoreNumTids(vacrelstats->dead_tuples);
         maxoff = PageGetMaxOffsetNumber(page);
         for (offnum = FirstOffsetNumber; offnum <= maxoff; offnum = OffsetNumberNext(offnum)) {
             ItemId itemid;
@@ -1271,9 +1291,12 @@ static IndexBulkDeleteResult** lazy_scan_heap(
          * If there are no indexes then we can vacuum the page right now
          * instead of doing a second scan.
          */
-        if (nindexes == 0 && vacrelstats->num_dead_tuples > 0) {
+        if (nindexes == 0 && TidStoreNumTids(vacrelstats->dead_tuples) > 0) {
+            OffsetNumber dead_offsets[MaxHeapTuplesPerPage];
+            int ndead = TidStoreGetBlockOffsets(vacrelstats->dead_tuples, blkno, dead_offsets);
+
             /* Remove tuples from heap */
-            lazy_vacuum_page(onerel, blkno, buf, 0, vacrelstats);
+            lazy_vacuum_page(onerel, blkno, buf, dead_offsets, ndead, vacrelstats);
             has_dead_tuples = false;
 
             /*
@@ -1281,8 +1304,9 @@ static IndexBulkDeleteResult** lazy_scan_heap(
              * not to reset latestRemovedXid since we want that value to be
              * valid.
              */
-            vacrelstats->num_dead_tuples = 0;
+            TidStoreReset(vacrelstats->dead_tuples);
             vacuumed_pages++;
+            pgstat_progress_vacuum_update(VACUUM_PROGRESS_HEAP_BLKS_VACUUMED, ++vacrelstats->vacuumed_pages);
         }
 
         freespace = PageGetHeapFreeSpace(page);
@@ -1357,10 +1381,12 @@ static IndexBulkDeleteResult** lazy_scan_heap(
          * page, so remember its free space as-is.	(This path will always be
          * taken if there are no indexes.)
          */
-        if (vacrelstats->num_dead_tuples == prev_dead_count)
+        if (TidStoreNumTids(vacrelstats->dead_tuples) == prev_dead_count)
             RecordPageWithFreeSpace(onerel, blkno, freespace);
     }
 
+    lazy_report_scan_progress(vacrelstats, nblocks);
+
     /* save stats for use later */
     vacrelstats->scanned_tuples = num_tuples;
     vacrelstats->tuples_deleted = tups_vacuumed;
@@ -1378,27 +1404,34 @@ static IndexBulkDeleteResult** lazy_scan_heap(
 
     /* If any tuples need to be deleted, perform final vacuum cycle */
     /* XXX put a threshold on min number of tuples here? */
-    if (vacrelstats->num_dead_tuples > 0) {
+    if (TidStoreNumTids(vacrelstats->dead_tuples) > 0) {
         /* Log cleanup info before we touch indexes */
         vacuum_log_cleanup_info(onerel, vacrelstats);
 
         /* Remove index entries */
+        pgstat_progress_vacuum_update(VACUUM_PROGRESS_PHASE, VACUUM_PHASE_VACUUM_INDEX);
         for (i = 0; i < nindexes; i++)
-            lazy_vacuum_index(Irel[i], &indstats[i], vacrelstats);
+            lazy_vacuum_index(Irel[i], i, &indstats[i], vacrelstats);
         /* Remove tuples from heap */
+        pgstat_progress_vacuum_update(VACUUM_PROGRESS_PHASE, VACUUM_PHASE_VACUUM_HEAP);
         lazy_vacuum_heap(onerel, vacrelstats);
         vacrelstats->num_index_scans++;
+        pgstat_progress_vacuum_update(VACUUM_PROGRESS_INDEX_VACUUM_COUNT, vacrelstats->num_index_scans);
     }
 
     /* Do post-vacuum cleanup and statistics update for each index */
+    pgstat_progress_vacuum_update(VACUUM_PROGRESS_PHASE, VACUUM_PHASE_CLEANUP_INDEX);
     for (i = 0; i < nindexes; i++) {
         /* IO collector and IO scheduler for vacuum */
         if (ENABLE_WORKLOAD_CONTROL)
             IOSchedulerAndUpdate(IO_TYPE_WRITE, 1, IO_TYPE_ROW);
 
-        indstats[i] = lazy_cleanup_index(Irel[i], indstats[i], vacrelstats);
+        indstats[i] = lazy_cleanup_index(Irel[i], i, indstats[i], vacrelstats);
     }
 
+    TidStoreDestroy(vacrelstats->dead_tuples);
+    vacrelstats->dead_tuples = NULL;
+
     /* record vacuumed tuple for reporting to PgStatCollector */
     *ptrDeleteTupleNum = tups_vacuumed;
 
@@ -1442,32 +1475,35 @@ static IndexBulkDeleteResult** lazy_scan_heap(
  */
 static void lazy_vacuum_heap(Relation onerel, LVRelStats* vacrelstats)
 {
-    int tupindex;
+    int64 ntuples;
     int npages;
     PGRUsage ru0;
+    TidStoreIter iter;
+    BlockNumber tblk;
+    OffsetNumber offsets[MaxHeapTuplesPerPage];
+    int noffsets;
 
     gstrace_entry(GS_TRC_ID_lazy_vacuum_heap);
 
     pg_rusage_init(&ru0);
     npages = 0;
+    ntuples = 0;
 
-    tupindex = 0;
-    while (tupindex < vacrelstats->num_dead_tuples) {
-        BlockNumber tblk;
+    TidStoreBeginIterate(vacrelstats->dead_tuples, &iter);
+    while (TidStoreIterateNext(&iter, &tblk, offsets, &noffsets)) {
         Buffer buf;
         Page page;
         Size freespace;
 
         vacuum_delay_point();
 
-        tblk = ItemPointerGetBlockNumber(&vacrelstats->dead_tuples[tupindex]);
         buf = ReadBufferExtended(onerel, MAIN_FORKNUM, tblk, RBM_NORMAL, vac_strategy);
         if (!ConditionalLockBufferForCleanup(buf)) {
             ReleaseBuffer(buf);
-            ++tupindex;
             continue;
         }
-        tupindex = lazy_vacuum_page(onerel, tblk, buf, tupindex, vacrelstats);
+        lazy_vacuum_page(onerel, tblk, buf, offsets, noffsets, vacrelstats);
+        ntuples += noffsets;
 
         /* Now that we've compacted the page, record its available space */
         page = BufferGetPage(buf);
@@ -1476,10 +1512,11 @@ static void lazy_vacuum_heap(Relation onerel, LVRelStats* vacrelstats)
         UnlockReleaseBuffer(buf);
         RecordPageWithFreeSpace(onerel, tblk, freespace);
         npages++;
+        pgstat_progress_vacuum_update(VACUUM_PROGRESS_HEAP_BLKS_VACUUMED, ++vacrelstats->vacuumed_pages);
     }
 
     ereport(elevel,
-        (errmsg("\"%s\": removed %d row versions in %d pages", RelationGetRelationName(onerel), tupindex, npages),
+        (errmsg("\"%s\": removed %ld row versions in %d pages", RelationGetRelationName(onerel), ntuples, npages),
             errdetail("%s.", pg_rusage_show(&ru0))));
     gstrace_exit(GS_TRC_ID_lazy_vacuum_heap);
 }
@@ -1490,11 +1527,11 @@ static void lazy_vacuum_heap(Relation onerel, LVRelStats* vacrelstats)
  *
  * Caller must hold pin and buffer cleanup lock on the buffer.
  *
- * tupindex is the index in vacrelstats->dead_tuples of the first dead
- * tuple for this page.  We assume the rest follow sequentially.
- * The return value is the first tupindex after the tuples of this page.
+ * offsets are the noffsets dead tuples of this page, as kept in
+ * vacrelstats->dead_tuples.
  */
-static int lazy_vacuum_page(Relation onerel, BlockNumber blkno, Buffer buffer, int tupindex, LVRelStats* vacrelstats)
+static void lazy_vacuum_page(
+    Relation onerel, BlockNumber blkno, Buffer buffer, OffsetNumber* offsets, int noffsets, LVRelStats* vacrelstats)
 {
     Page page = BufferGetPage(buffer);
     OffsetNumber unused[MaxOffsetNumber];
@@ -1502,18 +1539,11 @@ static int lazy_vacuum_page(Relation onerel, BlockNumber blkno, Buffer buffer, i
 
     START_CRIT_SECTION();
 
-    for (; tupindex < vacrelstats->num_dead_tuples; tupindex++) {
-        BlockNumber tblk;
-        OffsetNumber toff;
-        ItemId itemid;
+    for (int i = 0; i < noffsets; i++) {
+        ItemId itemid = PageGetItemId(page, offsets[i]);
 
-        tblk = ItemPointerGetBlockNumber(&vacrelstats->dead_tuples[tupindex]);
-        if (tblk != blkno)
-            break; /* past end of tuples for this block */
-        toff = ItemPointerGetOffsetNumber(&vacrelstats->dead_tuples[tupindex]);
-        itemid = PageGetItemId(page, toff);
         ItemIdSetUnused(itemid);
-        unused[uncnt++] = toff;
+        unused[uncnt++] = offsets[i];
     }
 
     PageRepairFragmentation(page);
@@ -1529,8 +1559,6 @@ static int lazy_vacuum_page(Relation onerel, BlockNumber blkno, Buffer buffer, i
     }
 
     END_CRIT_SECTION();
-
-    return tupindex;
 }
 
 /*
@@ -1571,16 +1599,21 @@ static bool lazy_check_needs_freeze(Buffer buf)
 /*
  *	lazy_vacuum_index() -- vacuum one index relation.
  *
- *		Delete all the index entries pointing to tuples listed in
+ *		Delete all the index entries pointing to tuples kept in
  *		vacrelstats->dead_tuples, and update running statistics.
+ *		idx is the position of the index in the relation's index list,
+ *		used to report its timing.
  */
-static void lazy_vacuum_index(Relation indrel, IndexBulkDeleteResult** stats, LVRelStats* vacrelstats)
+static void lazy_vacuum_index(Relation indrel, int idx, IndexBulkDeleteResult** stats, LVRelStats* vacrelstats)
 {
     IndexVacuumInfo ivinfo;
     PGRUsage ru0;
+    TimestampTz start_time;
 
     gstrace_entry(GS_TRC_ID_lazy_vacuum_index);
     pg_rusage_init(&ru0);
+    start_time = GetCurrentTimestamp();
+    pgstat_progress_vacuum_index_start(idx);
 
     ivinfo.index = indrel;
     ivinfo.analyze_only = false;
@@ -1592,10 +1625,12 @@ static void lazy_vacuum_index(Relation indrel, IndexBulkDeleteResult** stats, LV
     /* Do bulk deletion */
     *stats = index_bulk_delete(&ivinfo, *stats, lazy_tid_reaped, (void*)vacrelstats);
 
+    pgstat_progress_vacuum_index_end(idx, false, GetCurrentTimestamp() - start_time);
+
     ereport(elevel,
-        (errmsg("scanned index \"%s\" to remove %d row versions",
+        (errmsg("scanned index \"%s\" to remove %ld row versions",
             RelationGetRelationName(indrel),
-            vacrelstats->num_dead_tuples),
+            TidStoreNumTids(vacrelstats->dead_tuples)),
             errdetail("%s.", pg_rusage_show(&ru0))));
     gstrace_exit(GS_TRC_ID_lazy_vacuum_index);
 }
@@ -1604,13 +1639,17 @@ static void lazy_vacuum_index(Relation indrel, IndexBulkDeleteResult** stats, LV
  *	lazy_cleanup_index() -- do post-vacuum cleanup for one index relation.
  */
 /* ADD PARA: indPartRel, indPart */
-static IndexBulkDeleteResult* lazy_cleanup_index(Relation indrel, IndexBulkDeleteResult* stats, LVRelStats* vacrelstats)
+static IndexBulkDeleteResult* lazy_cleanup_index(
+    Relation indrel, int idx, IndexBulkDeleteResult* stats, LVRelStats* vacrelstats)
 {
     IndexVacuumInfo ivinfo;
     PGRUsage ru0;
+    TimestampTz start_time;
 
     gstrace_entry(GS_TRC_ID_lazy_cleanup_index);
     pg_rusage_init(&ru0);
+    start_time = GetCurrentTimestamp();
+    pgstat_progress_vacuum_index_start(idx);
 
     ivinfo.index = indrel;
     ivinfo.analyze_only = false;
@@ -1619,6 +1658,8 @@ static IndexBulkDeleteResult* lazy_cleanup_index(Relation indrel, IndexBulkDelet
     ivinfo.num_heap_tuples = vacrelstats->new_rel_tuples;
     ivinfo.strategy = vac_strategy;
     stats = index_vacuum_cleanup(&ivinfo, stats);
+
+    pgstat_progress_vacuum_index_end(idx, true, GetCurrentTimestamp() - start_time);
     if (stats != NULL) {
         ereport(elevel,
             (errmsg("index \"%s\" now contains %.0f row versions in %u pages",
@@ -1644,83 +1685,60 @@ static IndexBulkDeleteResult* lazy_cleanup_index(Relation indrel, IndexBulkDelet
  */
 static void lazy_space_alloc(LVRelStats* vacrelstats, BlockNumber relblocks)
 {
-    unsigned long maxtuples;
-
-    if (vacrelstats->hasindex) {
-        maxtuples = (u_sess->attr.attr_memory.maintenance_work_mem * 1024L) / sizeof(ItemPointerData);
-        maxtuples = Min(maxtuples, INT_MAX);
-        maxtuples = Min(maxtuples, (int)(MaxAllocSize / sizeof(ItemPointerData)));
-        /* curious coding here to ensure the multiplication can't overflow */
-        if ((BlockNumber)(maxtuples / LAZY_ALLOC_TUPLES) > relblocks)
-            maxtuples = relblocks * LAZY_ALLOC_TUPLES;
-        /* stay sane if small maintenance_work_mem */
-        maxtuples = Max(maxtuples, MaxHeapTuplesPerPage);
-    } else {
-        maxtuples = MaxHeapTuplesPerPage;
-    }
+    Size maxbytes;
 
-    vacrelstats->num_dead_tuples = 0;
-    vacrelstats->max_dead_tuples = (int)maxtuples;
-    vacrelstats->dead_tuples = (ItemPointer)palloc(maxtuples * sizeof(ItemPointerData));
+    /* without indexes each page is vacuumed at once, the store's minimum is enough */
+    if (vacrelstats->hasindex)
+        maxbytes = (Size)u_sess->attr.attr_memory.maintenance_work_mem * 1024L;
+    else
+        maxbytes = 0;
+
+    vacrelstats->dead_tuples = TidStoreCreate(maxbytes, relblocks);
 }
 
 /*
  * lazy_record_dead_tuple - remember one deletable tuple
+ *
+ * Tuples come in TID order, as lazy_scan_heap walks the heap.  The store
+ * shouldn't overflow since lazy_scan_heap empties it before it can, but if
+ * it did the tuples of the last page would be forgotten (we'll get 'em next
+ * time).
  */
 static void lazy_record_dead_tuple(LVRelStats* vacrelstats, ItemPointer itemptr)
 {
-    /*
-     * The array shouldn't overflow under normal behavior, but perhaps it
-     * could if we are given a really small maintenance_work_mem. In that
-     * case, just forget the last few tuples (we'll get 'em next time).
-     */
-    if (vacrelstats->num_dead_tuples < vacrelstats->max_dead_tuples) {
-        vacrelstats->dead_tuples[vacrelstats->num_dead_tuples] = *itemptr;
-        vacrelstats->num_dead_tuples++;
-    }
+    TidStoreAddTid(vacrelstats->dead_tuples, itemptr);
 }
 
 /*
- *	lazy_tid_reaped() -- is a particular tid deletable?
+ * lazy_report_scan_progress - publish the heap scan position and the size of
+ * the dead tuple store
  *
- *		This has the right signature to be an IndexBulkDeleteCallback.
- *
- *		Assumes dead_tuples array is in sorted order.
+ * Called once per heap block, so the three counters go out under a single
+ * changecount bracket.
  */
-static bool lazy_tid_reaped(ItemPointer itemptr, void* state)
+static void lazy_report_scan_progress(LVRelStats* vacrelstats, BlockNumber blkno)
 {
-    LVRelStats* vacrelstats = (LVRelStats*)state;
-    ItemPointer res;
+    const VacuumProgressField fields[] = {
+        VACUUM_PROGRESS_HEAP_BLKS_SCANNED, VACUUM_PROGRESS_NUM_DEAD_TUPLES, VACUUM_PROGRESS_DEAD_TUPLE_BYTES};
+    const int64 values[] = {(int64)blkno,
+        (int64)TidStoreNumTids(vacrelstats->dead_tuples),
+        (int64)TidStoreMemoryUsage(vacrelstats->dead_tuples)};
 
-    res = (ItemPointer)bsearch((void*)itemptr,
-        (void*)vacrelstats->dead_tuples,
-        vacrelstats->num_dead_tuples,
-        sizeof(ItemPointerData),
-        vac_cmp_itemptr);
-
-    return (res != NULL);
+    pgstat_progress_vacuum_update_multi(lengthof(fields), fields, values);
 }
 
 /*
- * Comparator routines for use with qsort() and bsearch().
+ *	lazy_tid_reaped() -- is a particular tid deletable?
+ *
+ *		This has the right signature to be an IndexBulkDeleteCallback,
+ *		and is how every index AM, including GIN and GiST, probes the
+ *		dead tuple store.
  */
-static int vac_cmp_itemptr(const void* left, const void* right)
+static bool lazy_tid_reaped(ItemPointer itemptr, void* state)
 {
-    BlockNumber lblk, rblk;
-    OffsetNumber loff, roff;
-    lblk = ItemPointerGetBlockNumber((ItemPointer)left);
-    rblk = ItemPointerGetBlockNumber((ItemPointer)right);
-    if (lblk < rblk)
-        return -1;
-    if (lblk > rblk)
-        return 1;
-    loff = ItemPointerGetOffsetNumber((ItemPointer)left);
-    roff = ItemPointerGetOffsetNumber((ItemPointer)right);
-    if (loff < roff)
-        return -1;
-    if (loff > roff)
-        return 1;
-    return 0;
+    LVRelStats* vacrelstats = (LVRelStats*)state;
+
+    return TidStoreIsMember(vacrelstats->dead_tuples, itemptr);
 }
 
 void elogVacuumInfo(Relation rel, HeapTuple tuple, char* funcName, TransactionId oldestxmin)
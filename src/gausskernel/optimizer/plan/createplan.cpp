@@ -4242,7 +4242,8 @@ static void search_var_and_mark_bloomfilter(PlannerInfo* root, Expr* expr, Plan*
 
     switch (nodeTag(plan)) {
         case T_ForeignScan:
-        case T_DfsScan: {
+        case T_DfsScan:
+        case T_CStoreScan: {
             if (IsA(plan, ForeignScan)) {
                 ForeignScan* splan = (VecForeignScan*)plan;
 
@@ -4430,6 +4431,38 @@ static bool valid_bloom_filter_type(Var* var)
     return result;
 }
 
+/*
+ * @Description: Check if the probe side of a hash join scans a column store
+ *     table, whose scan can use the hash join bloom filters without a stream plan.
+ * @in plan: Hashjoin outer plan.
+ * @return: true if a CStoreScan is found.
+ */
+static bool probe_has_cstore_scan(Plan* plan)
+{
+    if (plan == NULL) {
+        return false;
+    }
+
+    switch (nodeTag(plan)) {
+        case T_CStoreScan:
+            return true;
+        case T_Append: {
+            ListCell* l = NULL;
+
+            foreach (l, ((Append*)plan)->appendplans) {
+                if (probe_has_cstore_scan((Plan*)lfirst(l))) {
+                    return true;
+                }
+            }
+            return false;
+        }
+        case T_SubqueryScan:
+            return probe_has_cstore_scan(((SubqueryScan*)plan)->subplan);
+        default:
+            return probe_has_cstore_scan(plan->lefttree) || probe_has_cstore_scan(plan->righttree);
+    }
+}
+
 /*
  * @Description: Foreach HashJoin hashclauses and set bloomfilter.
  * @in root: Per-query information for planning/optimization.
@@ -4629,7 +4662,12 @@ static HashJoin* create_hashjoin_plan(PlannerInfo* root, HashPath* best_path, Pl
 
     join_plan->isSonicHash = u_sess->attr.attr_sql.enable_sonic_hashjoin && isSonicHashJoinEnable(join_plan);
 
-    if (IS_STREAM_PLAN && u_sess->attr.attr_sql.enable_bloom_filter) {
+    /*
+     * Bloom filters used to be for the stream plans only, a column store scan
+     * on the probe side can use them in any plan.
+     */
+    if (u_sess->attr.attr_sql.enable_bloom_filter &&
+        (IS_STREAM_PLAN || probe_has_cstore_scan(outerPlan(join_plan)))) {
         left_relids = best_path->jpath.outerjoinpath->parent->relids;
         set_bloomfilter(root, left_relids, join_plan);
     }
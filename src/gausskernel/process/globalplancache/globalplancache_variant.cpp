@@ -0,0 +1,363 @@
+/*
+* Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+*
+* openGauss is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*          http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+*
+* globalplancache_variant.cpp
+*    parameter-sensitive plan variants of shared plansources
+*
+* A shared plansource always runs its generic plan, which is estimated without
+* knowing the parameter values.  For a skewed column that plan can be far off
+* for some of the values.  So the bound values are classified by the
+* selectivity the column statistics give them, and the first values of each
+* class build a plan of their own, which the later executions of that class
+* share.  The class of a set of parameters is its signature: two bits of
+* selectivity bucket per "column op parameter" qual.
+*
+* IDENTIFICATION
+*     src/gausskernel/process/globalplancache/globalplancache_variant.cpp
+*
+* -------------------------------------------------------------------------
+*/
+
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include "catalog/pg_class.h"
+#include "catalog/pg_proc.h"
+#include "catalog/pg_statistic.h"
+#include "nodes/nodeFuncs.h"
+#include "parser/parsetree.h"
+#include "utils/globalplancache.h"
+#include "utils/lsyscache.h"
+#include "utils/memutils.h"
+#include "utils/plancache.h"
+#include "utils/selfuncs.h"
+#include "utils/syscache.h"
+
+/* two bits per qual, and the leading 1 bit must fit */
+#define GPC_SIGNATURE_BUCKET_BITS 2
+#define GPC_SIGNATURE_MAX_QUALS 15
+
+typedef struct GPCSignatureContext {
+    Query* query;
+    ParamListInfo boundParams;
+    uint32 signature;
+    int nquals;
+} GPCSignatureContext;
+
+static bool GPCSignatureWalker(Node* node, GPCSignatureContext* context);
+
+static int GPCSelectivityBucket(double selec)
+{
+    if (selec < 0.001) {
+        return 0;
+    } else if (selec < 0.01) {
+        return 1;
+    } else if (selec < 0.1) {
+        return 2;
+    }
+    return 3;
+}
+
+static double GPCRelTuples(Oid relid)
+{
+    double reltuples = 0;
+    HeapTuple tuple = SearchSysCache1(RELOID, ObjectIdGetDatum(relid));
+
+    if (HeapTupleIsValid(tuple)) {
+        reltuples = ((Form_pg_class)GETSTRUCT(tuple))->reltuples;
+        ReleaseSysCache(tuple);
+    }
+    return reltuples;
+}
+
+static inline bool GPCApplyOperator(FmgrInfo* opproc, Oid collation, Datum statvalue, Datum value, bool varonleft)
+{
+    if (varonleft) {
+        return DatumGetBool(FunctionCall2Coll(opproc, collation, statvalue, value));
+    }
+    return DatumGetBool(FunctionCall2Coll(opproc, collation, value, statvalue));
+}
+
+/*
+ * @Description: selectivity of "var op value" from the column statistics
+ * @return - the selectivity, or -1 when the column has no statistics
+ *
+ * Only a rough class is needed, so this is a cut-down var_eq_const and
+ * scalarineqsel: the matching MCVs plus, for the rest of the rows, the
+ * average share of a distinct value for equality, or the fraction of
+ * histogram bounds passing the operator otherwise.
+ */
+static double GPCParamSelectivity(RangeTblEntry* rte, Var* var, OpExpr* op, Datum value, bool varonleft)
+{
+    HeapTuple statsTuple = SearchSysCache4(STATRELKINDATTINH,
+                                           ObjectIdGetDatum(rte->relid),
+                                           CharGetDatum(STARELKIND_CLASS),
+                                           Int16GetDatum(var->varattno),
+                                           BoolGetDatum(rte->inh));
+    if (!HeapTupleIsValid(statsTuple)) {
+        return -1;
+    }
+
+    Form_pg_statistic stats = (Form_pg_statistic)GETSTRUCT(statsTuple);
+    bool isEqual = (get_oprrest(op->opno) == EQSELRETURNOID);
+    FmgrInfo opproc;
+    Datum* values = NULL;
+    int nvalues = 0;
+    float4* numbers = NULL;
+    int nnumbers = 0;
+    double mcvSelec = 0;
+    double mcvTotal = 0;
+    int nmcv = 0;
+    double selec = -1;
+
+    fmgr_info(get_opcode(op->opno), &opproc);
+
+    if (get_attstatsslot(statsTuple, var->vartype, var->vartypmod, STATISTIC_KIND_MCV, InvalidOid,
+        NULL, &values, &nvalues, &numbers, &nnumbers)) {
+        nmcv = Min(nvalues, nnumbers);
+        for (int i = 0; i < nmcv; i++) {
+            mcvTotal += numbers[i];
+            if (GPCApplyOperator(&opproc, op->inputcollid, values[i], value, varonleft)) {
+                mcvSelec += numbers[i];
+            }
+        }
+        free_attstatsslot(var->vartype, values, nvalues, numbers, nnumbers);
+        selec = mcvSelec;
+    }
+
+    double rest = 1.0 - mcvTotal - stats->stanullfrac;
+    CLAMP_PROBABILITY(rest);
+
+    if (isEqual) {
+        /* a value that is not among the MCVs gets the average share of the others */
+        if (mcvSelec == 0 && stats->stadistinct != 0) {
+            double ndistinct = stats->stadistinct;
+            if (ndistinct < 0) {
+                ndistinct = -ndistinct * GPCRelTuples(rte->relid);
+            }
+            ndistinct -= nmcv;
+            selec = (ndistinct > 1) ? rest / ndistinct : rest;
+        }
+    } else if (get_attstatsslot(statsTuple, var->vartype, var->vartypmod, STATISTIC_KIND_HISTOGRAM, InvalidOid,
+        NULL, &values, &nvalues, NULL, NULL)) {
+        if (nvalues > 0) {
+            int nmatch = 0;
+            for (int i = 0; i < nvalues; i++) {
+                if (GPCApplyOperator(&opproc, op->inputcollid, values[i], value, varonleft)) {
+                    nmatch++;
+                }
+            }
+            selec = Max(selec, 0) + rest * nmatch / nvalues;
+        }
+        free_attstatsslot(var->vartype, values, nvalues, NULL, 0);
+    }
+
+    ReleaseSysCache(statsTuple);
+    return selec;
+}
+
+/*
+ * @Description: add the selectivity bucket of a "var op param" qual to the signature
+ */
+static void GPCSignatureAddQual(OpExpr* op, GPCSignatureContext* context)
+{
+    Node* left = (Node*)linitial(op->args);
+    Node* right = (Node*)lsecond(op->args);
+    bool varonleft = true;
+
+    /* binary-compatible casts do not change the statistics */
+    if (IsA(left, RelabelType)) {
+        left = (Node*)((RelabelType*)left)->arg;
+    }
+    if (IsA(right, RelabelType)) {
+        right = (Node*)((RelabelType*)right)->arg;
+    }
+    if (IsA(left, Param) && IsA(right, Var)) {
+        Node* tmp = left;
+        left = right;
+        right = tmp;
+        varonleft = false;
+    }
+    if (!IsA(left, Var) || !IsA(right, Param)) {
+        return;
+    }
+
+    Var* var = (Var*)left;
+    Param* param = (Param*)right;
+    ParamListInfo params = context->boundParams;
+
+    if (var->varlevelsup != 0 || var->varattno <= 0 || param->paramkind != PARAM_EXTERN ||
+        param->paramid <= 0 || param->paramid > params->numParams) {
+        return;
+    }
+
+    RangeTblEntry* rte = rt_fetch(var->varno, context->query->rtable);
+    if (rte->rtekind != RTE_RELATION) {
+        return;
+    }
+
+    ParamExternData* prm = &params->params[param->paramid - 1];
+    if (!OidIsValid(prm->ptype) && params->paramFetch != NULL) {
+        (*params->paramFetch)(params, param->paramid);
+    }
+    if (prm->ptype != param->paramtype) {
+        return;
+    }
+
+    /* a null never matches a strict operator */
+    double selec = prm->isnull ? 0 : GPCParamSelectivity(rte, var, op, prm->value, varonleft);
+    if (selec < 0) {
+        return;
+    }
+
+    context->signature = (context->signature << GPC_SIGNATURE_BUCKET_BITS) | (uint32)GPCSelectivityBucket(selec);
+    context->nquals++;
+}
+
+static bool GPCSignatureWalker(Node* node, GPCSignatureContext* context)
+{
+    if (node == NULL) {
+        return false;
+    }
+
+    /* sublinks have range tables of their own, leave them to the generic estimate */
+    if (IsA(node, Query)) {
+        return false;
+    }
+
+    if (IsA(node, OpExpr) && list_length(((OpExpr*)node)->args) == 2) {
+        GPCSignatureAddQual((OpExpr*)node, context);
+        if (context->nquals >= GPC_SIGNATURE_MAX_QUALS) {
+            return true;
+        }
+        return false;
+    }
+
+    return expression_tree_walker(node, (bool (*)())GPCSignatureWalker, (void*)context);
+}
+
+/*
+ * @Description: the selectivity class of a set of parameter values
+ * @in plansource: shared plansource about to be executed
+ * @in boundParams: the values bound to it
+ * @return - the signature, 0 when no qual of the statement is sensitive to the values
+ */
+uint32 GlobalPlanCache::ParamSignature(CachedPlanSource *plansource, ParamListInfo boundParams)
+{
+    GPCSignatureContext context;
+    ListCell *lc = NULL;
+
+    context.boundParams = boundParams;
+    context.signature = 1;
+    context.nquals = 0;
+
+    foreach (lc, plansource->query_list) {
+        Query *query = (Query *)lfirst(lc);
+
+        if (!IsA(query, Query) || query->commandType == CMD_UTILITY) {
+            continue;
+        }
+        context.query = query;
+        if (GPCSignatureWalker((Node *)query->jointree, &context)) {
+            break;
+        }
+    }
+
+    return (context.nquals == 0) ? 0 : context.signature;
+}
+
+/*
+ * @Description: find the variant of a shared plansource for a signature
+ * @return - the variant, or NULL if no plan was built for the signature yet
+ */
+GPCPlanVariant* GlobalPlanCache::VariantFetch(CachedPlanSource *plansource, uint32 signature)
+{
+    int num = plansource->gpc.num_variants;
+
+    /* pairs with the barrier in VariantStore: the slots below num are filled */
+    pg_read_barrier();
+
+    for (int i = 0; i < num; i++) {
+        if (plansource->gpc.variants[i].signature == signature) {
+            return &plansource->gpc.variants[i];
+        }
+    }
+    return NULL;
+}
+
+/*
+ * @Description: publish a plan built for a signature
+ * @in plan: shared plan, owned by the variant from now on
+ * @return - the variant of the signature, which may be one a concurrent session
+ *           stored first, or NULL if all the variant slots are taken
+ */
+GPCPlanVariant* GlobalPlanCache::VariantStore(CachedPlanSource *plansource, uint32 signature, CachedPlan *plan)
+{
+    GPCPlanVariant *variant = NULL;
+    int max_variants = Min(u_sess->attr.attr_sql.gpc_plan_variants, GPC_MAX_PLAN_VARIANTS);
+
+    Assert(plan->is_share);
+
+    while (!gs_compare_and_swap_32(&plansource->gpc.variant_CAS_flag, FALSE, TRUE)) {
+        pg_usleep(CAS_SLEEP_DURATION);
+    }
+
+    variant = VariantFetch(plansource, signature);
+    if (variant == NULL && plansource->gpc.num_variants < max_variants) {
+        if (plansource->gpc.variants == NULL) {
+            plansource->gpc.variants = (GPCPlanVariant *)MemoryContextAllocZero(plansource->context,
+                GPC_MAX_PLAN_VARIANTS * sizeof(GPCPlanVariant));
+        }
+
+        variant = &plansource->gpc.variants[plansource->gpc.num_variants];
+        variant->signature = signature;
+        variant->plan = plan;
+        variant->hits = 0;
+        variant->exec_count = 0;
+        variant->total_exec_time = 0;
+        plan->variant = variant;
+
+        pg_write_barrier();
+        plansource->gpc.num_variants++;
+    }
+
+    (void)gs_compare_and_swap_32(&plansource->gpc.variant_CAS_flag, TRUE, FALSE);
+
+    if (variant == NULL || variant->plan != plan) {
+        plan->magic = 0;
+        MemoryContextDelete(plan->context);
+    }
+
+    return variant;
+}
+
+/*
+ * @Description: free the variant plans of a plansource being dropped
+ */
+void GlobalPlanCache::VariantDropAll(CachedPlanSource *plansource)
+{
+    for (int i = 0; i < plansource->gpc.num_variants; i++) {
+        CachedPlan *plan = plansource->gpc.variants[i].plan;
+
+        Assert(plan->magic == CACHEDPLAN_MAGIC);
+        plan->magic = 0;
+        MemoryContextDelete(plan->context);
+    }
+
+    plansource->gpc.num_variants = 0;
+    if (plansource->gpc.variants != NULL) {
+        pfree_ext(plansource->gpc.variants);
+    }
+}
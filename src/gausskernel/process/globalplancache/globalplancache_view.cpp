@@ -213,6 +213,67 @@ void *GlobalPlanCache::GetPrepareStatus(uint32 *num)
     return stat_array;
 }
 
+/*
+* @Description: get the plan variants of the shared plansources
+* @in num: the number of variants
+* @return - void
+*/
+void *GlobalPlanCache::GetVariantStatus(uint32 *num)
+{
+    HASH_SEQ_STATUS hash_seq;
+    GPCEntry *entry = NULL;
+
+    for (int i = 0; i < NUM_GPC_PARTITIONS; i++) {
+        (void)LWLockAcquire(GetMainLWLockByIndex(FirstGPCMappingLock + i), LW_SHARED);
+    }
+
+    *num = 0;
+    hash_seq_init(&hash_seq, m_global_plan_cache);
+    while ((entry = (GPCEntry*)hash_seq_search(&hash_seq)) != NULL) {
+        for (DListCell *cell = entry->cachedPlans->head; cell != NULL; cell = cell->next) {
+            GPCEnv *env = (GPCEnv *) cell->data.ptr_value;
+            *num = (*num) + (uint32)env->plansource->gpc.num_variants;
+        }
+    }
+
+    if ((*num) == 0) {
+        for (int i = NUM_GPC_PARTITIONS - 1; i >= 0; i--) {
+            LWLockRelease(GetMainLWLockByIndex(FirstGPCMappingLock + i));
+        }
+        return NULL;
+    }
+
+    GPCVariantStatus *stat_array = (GPCVariantStatus*) palloc0(*num * sizeof(GPCVariantStatus));
+    uint32 index = 0;
+
+    hash_seq_init(&hash_seq, m_global_plan_cache);
+    while ((entry = (GPCEntry*)hash_seq_search(&hash_seq)) != NULL) {
+        for (DListCell *cell = entry->cachedPlans->head; cell != NULL; cell = cell->next) {
+            CachedPlanSource *ps = ((GPCEnv *) cell->data.ptr_value)->plansource;
+
+            /* variants added since the count are left out */
+            for (int i = 0; i < ps->gpc.num_variants && index < *num; i++) {
+                GPCPlanVariant *variant = &ps->gpc.variants[i];
+
+                stat_array[index].query = pstrdup(ps->query_string);
+                stat_array[index].variant = i;
+                stat_array[index].signature = variant->signature;
+                stat_array[index].hits = variant->hits;
+                stat_array[index].exec_count = variant->exec_count;
+                stat_array[index].total_exec_time = variant->total_exec_time;
+                index++;
+            }
+        }
+    }
+    *num = index;
+
+    for (int i = NUM_GPC_PARTITIONS - 1; i >= 0; i--) {
+        LWLockRelease(GetMainLWLockByIndex(FirstGPCMappingLock + i));
+    }
+
+    return stat_array;
+}
+
 /*
  * @Description: Clean all the global plancaches which refcount is 0.
  * This function only be called when user call the global_plancache_clean() by themselves.
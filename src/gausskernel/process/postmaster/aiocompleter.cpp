@@ -23,6 +23,16 @@
  * A single AIO completer thread serves on AIO queue associated with a
  * specific AIO context and I/O priority.
  *
+ * When enable_adio_io_uring is set, each completer owns an io_uring instead
+ * of a libaio context. Submitters then hand a whole dispatch list to the
+ * kernel with one system call, and shared_buffers is registered with the
+ * page prefetch ring so that page reads use fixed buffers. See
+ * storage/file/aio_uring.cpp.
+ *
+ * If the kernel refuses a request or the completion queue cannot be read,
+ * the completers are marked not ready, the requests at hand are completed
+ * synchronously, and the callers go back to synchronous I/O.
+ *
  * The AIO completer threads are started by the postmaster as soon as the
  * startup subprocess finishes, or as soon as recovery begins if we are
  * doing archive recovery.  They remain alive until the postmaster commands
@@ -34,6 +44,10 @@
  * as a backend crash: shared memory may be corrupted, so remaining backends
  * should be killed by SIGQUIT and then a recovery cycle started.
  *
+ * The completers are auxiliary threads with their own PGPROC, since the
+ * completion callbacks take over and release buffer LWLocks. They are the
+ * last ones to be stopped at shutdown, once the writers have exited.
+ *
  * IDENTIFICATION
  *	  src/gausskernel/process/postmaster/aiocompleter.cpp
  *
@@ -45,12 +59,15 @@
 #include "libpq/pqsignal.h"
 #include "postmaster/aiocompleter.h"
 #include "postmaster/postmaster.h"
+#include "storage/aio_uring.h"
 #include "storage/fd.h"
 #include "storage/ipc.h"
 #include "storage/pmsignal.h"
+#include "storage/proc.h"
 #include "utils/guc.h"
 #include "utils/memutils.h"
 #include <pthread.h>
+#include <sys/resource.h>
 
 /*
  * Each AIO completer thread has a unique context, and potentially
@@ -80,7 +97,7 @@ ThreadId Compltrfork_exec(int compltrIdx);
  * GUC parameters
  */
 /* Maximum number of Completer threads -compile time define */
-#define MAX_AIOCOMPLTR_THREADS 4
+#define MAX_AIOCOMPLTR_THREADS MAX_AIO_COMPLETER_THREAD_NUM
 
 /* Number of Completer threads and the number of sets of Completers */
 const int AioCompltrThreads = 4;
@@ -110,7 +127,9 @@ typedef struct AioCompltrDesc {
 } AioCompltrDesc_t;
 
 typedef struct {
+    int idx;                        /* index in the compltrArray, passed to the thread */
     io_context_t context;           /* AIO context */
+    AioUring* ring;                 /* io_uring, used instead of the context if enable_adio_io_uring is set */
     struct io_event* eventsp;       /* AIO events to process */
     ThreadId tid;                   /* AIO thread tid */
     AioCompltrDesc_t* compltrDescp; /* Completer descriptor */
@@ -179,6 +198,14 @@ AioCompltrThread_t compltrArray[MAX_AIOCOMPLTR_THREADS];
  */
 static bool volatile AioCompltrReady = false;
 
+/*
+ * Whether the completers use io_uring, decided once at startup.
+ */
+static bool AioCompltrUseUring = false;
+
+/* Submission queue size of each completer io_uring */
+#define AIOCOMPLTR_URING_ENTRIES 4096
+
 /* Associate a template with a thread index */
 #define AIOCOMPLTR_TEMPLATE(threadIdx) (&compltrDescArray[(threadIdx) % NUM_AIOCOMPLTR_TYPES])
 
@@ -233,6 +260,66 @@ io_context_t CompltrContext(AioCompltrType reqType, int h)
     return compltrArray[AIOCOMPLTR_THREAD_IDX(reqType, h)].context;
 }
 
+/*
+ * @Description: Do the requests with synchronous I/O in the calling thread
+ *  and run their completion callbacks, as the completer would have.
+ * @Param[IN] reqType: aio completer type
+ * @Param[IN] nr: number of requests
+ * @Param[IN] iocbs: requests
+ * @See also:
+ */
+static void CompltrCompleteSync(AioCompltrType reqType, long nr, struct iocb** iocbs)
+{
+    AioCallback_t callback = ComptrCallback(reqType);
+
+    for (long i = 0; i < nr; i++) {
+        struct iocb* iocb = iocbs[i];
+        ssize_t res;
+
+        if (iocb->aio_lio_opcode == IO_CMD_PWRITE) {
+            res = pwrite(iocb->aio_fildes, iocb->u.c.buf, iocb->u.c.nbytes, iocb->u.c.offset);
+        } else {
+            res = pread(iocb->aio_fildes, iocb->u.c.buf, iocb->u.c.nbytes, iocb->u.c.offset);
+        }
+        (void)callback((void*)iocb, (res < 0) ? (long)-errno : (long)res);
+    }
+}
+
+/*
+ * @Description: Submit i/o requests to the completer serving the request type,
+ *  through its io_uring or libaio context. If the kernel rejects the requests
+ *  for any reason but a full queue, ADIO is turned off and they are done
+ *  synchronously instead.
+ * @Param[IN] reqType: aio completer type
+ * @Param[IN] h: index
+ * @Param[IN] nr: number of requests
+ * @Param[IN] iocbs: requests
+ * @Return: number of submitted requests, or -EAGAIN like io_submit()
+ * @See also:
+ */
+int CompltrSubmit(AioCompltrType reqType, int h, long nr, struct iocb** iocbs)
+{
+    AioCompltrThread_t* compltr = &compltrArray[AIOCOMPLTR_THREAD_IDX(reqType, h)];
+    int ret;
+
+    if (AioCompltrUseUring) {
+        ret = AioUringSubmit(compltr->ring, nr, iocbs);
+    } else {
+        ret = io_submit(compltr->context, nr, iocbs);
+    }
+
+    if (ret < 0 && ret != -EAGAIN) {
+        if (AioCompltrReady) {
+            AioCompltrReady = false;
+            ereport(WARNING,
+                (errmsg("AIO submit failed: error %d, falling back to synchronous I/O", ret)));
+        }
+        CompltrCompleteSync(reqType, nr, iocbs);
+        return (int)nr;
+    }
+    return ret;
+}
+
 /* Prototypes for private functions */
 /*
  * Signal handlers
@@ -240,30 +327,23 @@ io_context_t CompltrContext(AioCompltrType reqType, int h)
 static void CompltrConfig(SIGNAL_ARGS);
 static void CompltrQuickDie(SIGNAL_ARGS);
 static void CompltrShutdown(SIGNAL_ARGS);
+static void CompltrReportWakeups(int compltrIdx, uint64 wakeups, uint64 reaped);
 
 /*
  * @Description:  Compltrfork_exec() and AioCompltrStart() are used to start the
  * completer threads.
  *
- * PG was designed to start processes and pass parameters on the
- * command line and via shared memory.  We do not need to do
- * that with our threads implementation, but rather than change all that
- * now we are going to pass the compltrIdx on the command line
- * and allow the running thread to find its descriptor in the compltrArray
- * in the global context.
- *
- * Compltrfork_exec formats the arglist, then fork and exec the AIO
- * Completer thread.  The compltrIdx is converted to a 3 character string,
- * so that the parameter does not have to be handled specially by the
- * intervening PG code.
+ * Compltrfork_exec starts an AIO Completer as an auxiliary thread, passing
+ * it its compltrIdx so that the running thread finds its descriptor in the
+ * compltrArray in the global context.
  * @Param[IN] compltrIdx: aio thread index
- * @Return: thread id
+ * @Return: thread id, 0 if the thread could not be started
  * @See also:
  */
 ThreadId Compltrfork_exec(int compltrIdx)
 {
-    ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED), errmsg("XuanYuanDB current do not support AIO")));
-    return InvalidTid;
+    compltrArray[compltrIdx].idx = compltrIdx;
+    return initialize_util_thread(AIO_COMPLETER, &compltrArray[compltrIdx].idx);
 }
 
 /*
@@ -289,6 +369,7 @@ int AioCompltrStart(void)
 {
     int error = 0;
     int try_times = 0;
+    bool bufferRegistered = false;
 
     /*
      * Only allow MAX_AIOCOMPLTR_THREADS
@@ -304,6 +385,12 @@ int AioCompltrStart(void)
         sizeof(AioCompltrThread_t) * MAX_AIOCOMPLTR_THREADS);
     securec_check(rc, "\0", "\0");
 
+    AioCompltrUseUring = g_instance.attr.attr_storage.enable_adio_io_uring;
+    if (AioCompltrUseUring && !AioUringSupported()) {
+        ereport(WARNING, (errmsg("io_uring is not supported by this build, using libaio for ADIO")));
+        AioCompltrUseUring = false;
+    }
+
     /*
      * Initialize the compltrArray
      */
@@ -312,20 +399,42 @@ int AioCompltrStart(void)
         /* Assign a template to the thread descriptor */
         compltrArray[i].compltrDescp = AIOCOMPLTR_TEMPLATE(i);
 
-        /* Create the i/o queue and fill in the context */
-        do {
-            error = io_setup(compltrArray[i].compltrDescp->maxevents, &compltrArray[i].context);
-            if (error == 0 || error != -EAGAIN) {
-                break;
+        if (AioCompltrUseUring) {
+            /* Create the ring, requests beyond its size are submitted in several batches */
+            compltrArray[i].ring =
+                AioUringSetup(Min(AIOCOMPLTR_URING_ENTRIES, compltrArray[i].compltrDescp->maxevents));
+            if (compltrArray[i].ring == NULL) {
+                error = 4;
+                goto AioCompltrStartError;
             }
 
-            try_times++;
-            ereport(LOG, (errmsg("AIO Startup, Completer thread id =%d try times=%d, error=%d", i, try_times, error)));
-            pg_usleep(100000L);
-        } while (try_times < 5);
-
-        if (error != 0) {
-            goto AioCompltrStartError;
+            /*
+             * Registering the buffer pool is an optimization, the ring works without it.
+             * Only the page reads target shared_buffers directly, the pagewriter writes
+             * private copies, so the pool is registered, and pinned, once.
+             */
+            if (!bufferRegistered && compltrArray[i].compltrDescp->reqtype == PageListPrefetchType) {
+                bufferRegistered = AioUringRegisterBuffers(compltrArray[i].ring,
+                    t_thrd.storage_cxt.BufferBlocks,
+                    g_instance.attr.attr_storage.NBuffers * (Size)BLCKSZ);
+            }
+        } else {
+            /* Create the i/o queue and fill in the context */
+            do {
+                error = io_setup(compltrArray[i].compltrDescp->maxevents, &compltrArray[i].context);
+                if (error == 0 || error != -EAGAIN) {
+                    break;
+                }
+
+                try_times++;
+                ereport(LOG,
+                    (errmsg("AIO Startup, Completer thread id =%d try times=%d, error=%d", i, try_times, error)));
+                pg_usleep(100000L);
+            } while (try_times < 5);
+
+            if (error != 0) {
+                goto AioCompltrStartError;
+            }
         }
 
         /* Allocate the event array for the thread */
@@ -345,7 +454,7 @@ int AioCompltrStart(void)
         /* Start AIO Completer thread */
         compltrArray[i].tid = Compltrfork_exec(i);
 
-        if (compltrArray[i].tid == (ThreadId)-1) {
+        if (compltrArray[i].tid == 0) {
             /* starting a thread failed */
             error = 3;
             ereport(LOG, (errmsg("Start AIO Completer thread failed: %d", error)));
@@ -370,16 +479,103 @@ AioCompltrStartError:
     return error;
 }
 
+/*
+ * @Description: Deallocate the contexts and event arrays of the completers,
+ *  once none of them is running.
+ * @See also:
+ */
+static void AioCompltrReleaseResources(void)
+{
+    for (int i = 0; i < AioCompltrThreads; i++) {
+        compltrArray[i].compltrDescp = (AioCompltrDesc_t*)NULL;
+
+        /* destroy the AIO context */
+        if (compltrArray[i].context) {
+            io_destroy(compltrArray[i].context);
+            compltrArray[i].context = (io_context_t)NULL;
+        }
+
+        /* destroy the io_uring */
+        if (compltrArray[i].ring != NULL) {
+            AioUringDestroy(compltrArray[i].ring);
+            compltrArray[i].ring = NULL;
+        }
+
+        /* Deallocate the events array */
+        if (compltrArray[i].eventsp) {
+            free(compltrArray[i].eventsp);
+            compltrArray[i].eventsp = (struct io_event*)NULL;
+        }
+    }
+}
+
+/*
+ * @Description: Check whether any Completer thread is still running
+ * @Return: true if a completer has not been reaped yet
+ * @See also:
+ */
+bool AioCompltrIsRunning(void)
+{
+    for (int i = 0; i < AioCompltrThreads; i++) {
+        if (compltrArray[i].tid != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * @Description: Check whether a thread is an AIO Completer
+ * @Param[IN] tid: thread id
+ * @Return: true if tid is a running completer
+ * @See also:
+ */
+bool AioCompltrIsThread(ThreadId tid)
+{
+    for (int i = 0; i < AioCompltrThreads; i++) {
+        if (tid != 0 && compltrArray[i].tid == tid) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * @Description: Forget an exited Completer thread, called by the postmaster
+ *  after joining it. The resources are released with the last completer.
+ * @Param[IN] tid: thread id
+ * @Return: true if tid was a completer
+ * @See also:
+ */
+bool AioCompltrReap(ThreadId tid)
+{
+    if (!AioCompltrIsThread(tid)) {
+        return false;
+    }
+
+    AioCompltrReady = false;
+    for (int i = 0; i < AioCompltrThreads; i++) {
+        if (compltrArray[i].tid == tid) {
+            compltrArray[i].tid = 0;
+        }
+    }
+
+    if (!AioCompltrIsRunning()) {
+        AioCompltrReleaseResources();
+    }
+    return true;
+}
+
 /*
  * @Description: Stop the Completer threads, cleanup any partially started ones.
- * Send SIGQUIT and forget about the threads.
+ * The threads are joined by the postmaster reaper like the other children,
+ * see AioCompltrReap().
  * The caller must ensure that no AIO is in progress prior to using this  function.
  * @Param[IN] signal:signal
  * @See also:
  */
 void AioCompltrStop(int signal)
 {
-    gs_thread_t thread;
     AioCompltrReady = false;
 
     /*
@@ -396,82 +592,27 @@ void AioCompltrStop(int signal)
         }
     }
 
-    if (signal == SIGQUIT) {
-        /*
-         * if the database is crashing just kill the completers
-         * and bail-out.
-         */
-        return;
-    }
-
-    /*
-     * Wait for the stopped threads to exit.
-     */
-    for (int i = 0; i < AioCompltrThreads; i++) {
-        /*
-         * Wait for the killed threads to exit
-         */
-        if (compltrArray[i].tid != 0) {
-            thread.thid = compltrArray[i].tid;
-            if (gs_thread_join(thread, NULL) != 0) {
-                /*
-                 * If the thread does not exist, treat it as normal exit and we continue to
-                 * do our clean-up work. Otherwise, we treate it as crashed 'cause we do
-                 * not know the current status of the thread and it's better to quit directly
-                 * which sames more safely.
-                 */
-                if (ESRCH == pthread_kill(thread.thid, 0))
-                    ereport(LOG, (errmsg("failed to join thread %lu, no such process", thread.thid)));
-                else
-                    HandleChildCrash(thread.thid, 1, "AIO process");
-            }
-            compltrArray[i].tid = (pid_t)0;
-        }
-    }
-
-    /*
-     * Deallocate their context and event arrays, if any
-     */
-    for (int i = 0; i < AioCompltrThreads; i++) {
-        compltrArray[i].compltrDescp = (AioCompltrDesc_t*)NULL;
-
-        /* destroy the AIO context */
-        if (compltrArray[i].context) {
-            io_destroy(compltrArray[i].context);
-            compltrArray[i].context = (io_context_t)NULL;
-        }
-
-        /* Deallocate the events array */
-        if (compltrArray[i].eventsp) {
-            free(compltrArray[i].eventsp);
-            compltrArray[i].eventsp = (struct io_event*)NULL;
-        }
+    /* Nothing was started, release what was set up */
+    if (!AioCompltrIsRunning()) {
+        AioCompltrReleaseResources();
     }
-
-    /* successful return */
-    return;
 }
 
 /*
  * @Description:  Main entry point for an AIO Completer thread
- * @Param[IN] ac: param count
- * @Param[IN] av: param list
  * @See also:
  */
-void AioCompltrMain(int ac, char** av)
+void AioCompltrMain(void)
 {
-    if (ac < 4) {
-        ereport(WARNING, (errmsg("invalid AIO argument num:%d", ac)));
-        exit(1);
-    }
     /* compltrIdx identifies this thread. */
-    int compltrIdx = atoi(av[3]);
+    int compltrIdx = t_thrd.aio_cxt.compltr_idx;
 
     /*
      * Global thread local shortcuts to the completer descriptor
      * in the compltrArray, these are assigned on entry.
      */
     io_context_t context = compltrArray[compltrIdx].context;
+    AioUring* ring = compltrArray[compltrIdx].ring;
     io_event* eventsp = compltrArray[compltrIdx].eventsp;
     AioCompltrDesc_t* compltrDescp = compltrArray[compltrIdx].compltrDescp;
     int min_nr = compltrDescp->min_nr;
@@ -483,6 +624,9 @@ void AioCompltrMain(int ac, char** av)
     shutdown_timeout.tv_sec = AioCompltrShutdownTimeout;
     shutdown_timeout.tv_nsec = 0;
     AioCallback_t callback = compltrDescp->callback;
+    bool failed = false;
+    uint64 wakeups = 0;
+    uint64 reaped = 0;
 
     /*
      * Handle signals the postmaster might send us
@@ -551,6 +695,7 @@ void AioCompltrMain(int ac, char** av)
         if (t_thrd.aio_cxt.shutdown_requested) {
             timeout = shutdown_timeout;
 
+            CompltrReportWakeups(compltrIdx, wakeups, reaped);
             ereport(LOG, (errmsg("AIO Completer %d EXITED.", compltrIdx)));
             proc_exit(0);
         }
@@ -560,7 +705,11 @@ void AioCompltrMain(int ac, char** av)
          * on the given context. Retry if the syscall is
          * interrupted.
          */
-        eventsReceived = io_getevents(context, min_nr, max_nr, eventsp, &timeout);
+        if (ring != NULL) {
+            eventsReceived = AioUringGetEvents(ring, max_nr, eventsp, &timeout);
+        } else {
+            eventsReceived = io_getevents(context, min_nr, max_nr, eventsp, &timeout);
+        }
         /*
          * If io_getevents() got interrupted,
          * take the opportunity to check for pending requests.
@@ -571,15 +720,31 @@ void AioCompltrMain(int ac, char** av)
         }
 
         /*
-         * io_getevents() reports errors as negative values.
+         * io_getevents() reports errors as negative values.  Stop taking
+         * new requests, the callers fall back to synchronous I/O, and keep
+         * trying to reap the ones in flight.
          */
         if (eventsReceived < 0) {
-            /* Report error */
-            ereport(PANIC, (errmsg("AIO Completer io_getevents() failed: error %d .", eventsReceived)));
+            if (!failed) {
+                ereport(WARNING,
+                    (errmsg("AIO Completer %d %s failed: error %d, falling back to synchronous I/O.",
+                        compltrIdx,
+                        (ring != NULL) ? "poll()" : "io_getevents()",
+                        eventsReceived)));
+                failed = true;
+            }
+            AioCompltrReady = false;
+            pg_usleep(1000000L);
+            continue;
         }
 
         Assert(eventsReceived <= max_nr);
 
+        if (eventsReceived > 0) {
+            wakeups++;
+            reaped += (uint64)eventsReceived;
+        }
+
         /*
          * Call the callback for each event returned
          * We expect 0 to max_nr requests. The obj here is
@@ -594,6 +759,32 @@ void AioCompltrMain(int ac, char** av)
     exit(0);
 }
 
+/*
+ * @Description: Log how many completions the completer reaped per wakeup and
+ *  how often it was switched out, to tell how well completions are batched.
+ * @Param[IN] compltrIdx: aio thread index
+ * @Param[IN] wakeups: number of waits that returned completions
+ * @Param[IN] reaped: number of completions reaped
+ * @See also:
+ */
+static void CompltrReportWakeups(int compltrIdx, uint64 wakeups, uint64 reaped)
+{
+    struct rusage usage;
+
+    if (getrusage(RUSAGE_THREAD, &usage) != 0) {
+        usage.ru_nvcsw = 0;
+        usage.ru_nivcsw = 0;
+    }
+    ereport(LOG,
+        (errmsg("AIO Completer %d reaped %lu completions in %lu wakeups, %ld voluntary and %ld involuntary "
+                "context switches.",
+            compltrIdx,
+            reaped,
+            wakeups,
+            usage.ru_nvcsw,
+            usage.ru_nivcsw)));
+}
+
 /*
  * @Description: signal handler routines for config,not used now
  * @See also:
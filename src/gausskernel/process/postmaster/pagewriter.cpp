@@ -749,6 +749,8 @@ static void ckpt_pagewriter_handle_exception(MemoryContext pagewriter_context)
      * AbortTransaction().  We don't have very many resources to worry
      * about in pagewriter, but we do have LWLocks, buffers, and temp files.
      */
+    /* abort async io, must before LWlock release */
+    AbortAsyncListIO();
     LWLockReleaseAll();
     AbortBufferIO();
     UnlockBuffers();
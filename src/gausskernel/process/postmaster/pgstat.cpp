@@ -2674,15 +2674,18 @@ static int GetAuxProcStatEntryIndex(void)
     int index = MAX_BACKEND_SLOT + t_thrd.bootstrap_cxt.MyAuxProcType;
     int pagewriter_thread_num = g_instance.attr.attr_storage.pagewriter_thread_num;
 
-    if (t_thrd.bootstrap_cxt.MyAuxProcType == PageWriterProcess) {
-        index += get_pagewriter_thread_id();
+    /* each AIO completer has its own slot, the later multi-thread types follow them */
+    if (t_thrd.bootstrap_cxt.MyAuxProcType == AsyncIOCompleterProcess) {
+        index += t_thrd.aio_cxt.compltr_idx;
+    } else if (t_thrd.bootstrap_cxt.MyAuxProcType == PageWriterProcess) {
+        index += get_pagewriter_thread_id() + (MAX_AIO_COMPLETER_THREAD_NUM - 1);
     } else if (t_thrd.bootstrap_cxt.MyAuxProcType == PageRedoProcess) {
-        index += MultiRedoGetWorkerId() + pagewriter_thread_num - 1;
+        index += MultiRedoGetWorkerId() + pagewriter_thread_num - 1 + (MAX_AIO_COMPLETER_THREAD_NUM - 1);
         SetPageRedoWorkerIndex(index);
     } else if (t_thrd.bootstrap_cxt.MyAuxProcType == TpoolListenerProcess) {
         /* thread pool listerner slots follow page redo threads */
         index += t_thrd.threadpool_cxt.listener->GetGroup()->GetGroupId() + (pagewriter_thread_num - 1) +
-                 (MAX_RECOVERY_THREAD_NUM - 1);
+                 (MAX_RECOVERY_THREAD_NUM - 1) + (MAX_AIO_COMPLETER_THREAD_NUM - 1);
     }
 
     return index;
@@ -2703,6 +2706,18 @@ const char* remote_conn_type_string(int remote_conn_type)
     return REMOTE_CONN_TYPET[remote_conn_type];
 }
 
+/*
+ * Point MyBEEntry at a new status entry.  Our PGPROC keeps a copy, so that
+ * LWLock waiters can tell what the thread holding a lock is doing.
+ */
+static void pgstat_set_my_beentry(PgBackendStatus* beentry)
+{
+    t_thrd.shemem_ptr_cxt.MyBEEntry = beentry;
+    if (t_thrd.proc != NULL) {
+        t_thrd.proc->statusEntry = beentry;
+    }
+}
+
 /* ----------
  * pgstat_initialize() -
  *
@@ -2724,11 +2739,11 @@ void pgstat_initialize(void)
                t_thrd.proc_cxt.MyBackendId <= (g_instance.attr.attr_common.enable_thread_pool
                                                       ? GLOBAL_RESERVE_SESSION_NUM
                                                       : g_instance.shmem_cxt.MaxBackends));
-        t_thrd.shemem_ptr_cxt.MyBEEntry = &t_thrd.shemem_ptr_cxt.BackendStatusArray[t_thrd.proc_cxt.MyBackendId - 1];
+        pgstat_set_my_beentry(&t_thrd.shemem_ptr_cxt.BackendStatusArray[t_thrd.proc_cxt.MyBackendId - 1]);
     } else {
         // Auxiliary thread
         int index = GetAuxProcStatEntryIndex();
-        t_thrd.shemem_ptr_cxt.MyBEEntry = &t_thrd.shemem_ptr_cxt.BackendStatusArray[index];
+        pgstat_set_my_beentry(&t_thrd.shemem_ptr_cxt.BackendStatusArray[index]);
     }
 
     /* init local thread bad block statistics */
@@ -2767,7 +2782,7 @@ void pgstat_initialize_session(void)
     pgstat_report_activity(STATE_COUPLED, NULL);
 
     /* change stat object to session */
-    t_thrd.shemem_ptr_cxt.MyBEEntry = &t_thrd.shemem_ptr_cxt.BackendStatusArray[u_sess->session_ctr_index];
+    pgstat_set_my_beentry(&t_thrd.shemem_ptr_cxt.BackendStatusArray[u_sess->session_ctr_index]);
 
     /* switch other stat obejct to session */
     AttachMySessionStatEntry();
@@ -2795,7 +2810,7 @@ void pgstat_deinitialize_session(void)
 
     /* proc_exit already release the slot of MyBeEntry, cannot release again */
     if (!t_thrd.proc_cxt.proc_exit_inprogress) {
-        t_thrd.shemem_ptr_cxt.MyBEEntry = &t_thrd.shemem_ptr_cxt.BackendStatusArray[t_thrd.proc_cxt.MyBackendId - 1];
+        pgstat_set_my_beentry(&t_thrd.shemem_ptr_cxt.BackendStatusArray[t_thrd.proc_cxt.MyBackendId - 1]);
 
         /*
          * reset worker's pgproc memory info
@@ -2917,6 +2932,9 @@ void pgstat_bestart(void)
     beentry->st_libpq_wait_nodecount = 0;
     beentry->st_tempid = 0;
     beentry->st_timelineid = 0;
+    beentry->st_vacuum_progress.relid = InvalidOid;
+    beentry->st_vacuum_progress.nindexes = 0;
+    beentry->st_vacuum_progress.current_index = -1;
 
     beentry->st_debug_info = &u_sess->wlm_cxt->wlm_debug_info;
     beentry->st_cgname = u_sess->wlm_cxt->control_group;
@@ -3103,7 +3121,7 @@ static void pgstat_beshutdown_hook(int code, Datum arg)
      * Clear the thread-local pointer MyBEEntry
      * so that it can not be revisited.
      */
-    t_thrd.shemem_ptr_cxt.MyBEEntry = NULL;
+    pgstat_set_my_beentry(NULL);
 }
 
 /*
@@ -3462,6 +3480,140 @@ void pgstat_report_smpid(uint32 smpid)
     beentry->st_smpid = smpid;
 }
 
+/* ----------
+ * pgstat_progress_vacuum_start() -
+ *
+ *	Called from lazy vacuum when it starts on a relation; remembers the
+ *	relation and its indexes so that pg_stat_progress_vacuum can show them.
+ * ----------
+ */
+void pgstat_progress_vacuum_start(Oid relid, Relation* Irel, int nindexes)
+{
+    volatile PgBackendStatus* beentry = t_thrd.shemem_ptr_cxt.MyBEEntry;
+
+    if (!u_sess->attr.attr_common.pgstat_track_activities || (beentry == NULL))
+        return;
+
+    nindexes = Min(nindexes, VACUUM_PROGRESS_MAX_INDEXES);
+
+    pgstat_increment_changecount_before(beentry);
+    beentry->st_vacuum_progress.relid = relid;
+    for (int i = 0; i < VACUUM_PROGRESS_NUM_FIELDS; i++)
+        beentry->st_vacuum_progress.params[i] = 0;
+    beentry->st_vacuum_progress.params[VACUUM_PROGRESS_PHASE] = VACUUM_PHASE_SCAN_HEAP;
+    beentry->st_vacuum_progress.nindexes = nindexes;
+    beentry->st_vacuum_progress.current_index = -1;
+    for (int i = 0; i < nindexes; i++) {
+        beentry->st_vacuum_progress.indexes[i].indexoid = RelationGetRelid(Irel[i]);
+        beentry->st_vacuum_progress.indexes[i].vacuum_time = 0;
+        beentry->st_vacuum_progress.indexes[i].cleanup_time = 0;
+    }
+    pgstat_increment_changecount_after(beentry);
+}
+
+void pgstat_progress_vacuum_update(VacuumProgressField field, int64 value)
+{
+    volatile PgBackendStatus* beentry = t_thrd.shemem_ptr_cxt.MyBEEntry;
+
+    if (beentry == NULL || !OidIsValid(beentry->st_vacuum_progress.relid))
+        return;
+
+    pgstat_increment_changecount_before(beentry);
+    beentry->st_vacuum_progress.params[field] = value;
+    pgstat_increment_changecount_after(beentry);
+}
+
+/*
+ * pgstat_progress_vacuum_update_multi -
+ *
+ *	Set several progress fields at once, in a single changecount bracket,
+ *	for the counters lazy vacuum updates on every heap block.
+ */
+void pgstat_progress_vacuum_update_multi(int nfields, const VacuumProgressField* fields, const int64* values)
+{
+    volatile PgBackendStatus* beentry = t_thrd.shemem_ptr_cxt.MyBEEntry;
+
+    if (beentry == NULL || !OidIsValid(beentry->st_vacuum_progress.relid))
+        return;
+
+    pgstat_increment_changecount_before(beentry);
+    for (int i = 0; i < nfields; i++)
+        beentry->st_vacuum_progress.params[fields[i]] = values[i];
+    pgstat_increment_changecount_after(beentry);
+}
+
+/*
+ * pgstat_progress_vacuum_index_start/end -
+ *
+ *	Bracket the work on the idx'th index of the relation; the elapsed time
+ *	adds up over the index vacuum passes.
+ */
+void pgstat_progress_vacuum_index_start(int idx)
+{
+    volatile PgBackendStatus* beentry = t_thrd.shemem_ptr_cxt.MyBEEntry;
+
+    if (beentry == NULL || !OidIsValid(beentry->st_vacuum_progress.relid))
+        return;
+
+    pgstat_increment_changecount_before(beentry);
+    beentry->st_vacuum_progress.current_index = (idx < beentry->st_vacuum_progress.nindexes) ? idx : -1;
+    pgstat_increment_changecount_after(beentry);
+}
+
+void pgstat_progress_vacuum_index_end(int idx, bool cleanup, int64 elapsed)
+{
+    volatile PgBackendStatus* beentry = t_thrd.shemem_ptr_cxt.MyBEEntry;
+
+    if (beentry == NULL || !OidIsValid(beentry->st_vacuum_progress.relid))
+        return;
+
+    pgstat_increment_changecount_before(beentry);
+    if (idx < beentry->st_vacuum_progress.nindexes) {
+        if (cleanup)
+            beentry->st_vacuum_progress.indexes[idx].cleanup_time += elapsed;
+        else
+            beentry->st_vacuum_progress.indexes[idx].vacuum_time += elapsed;
+    }
+    beentry->st_vacuum_progress.current_index = -1;
+    pgstat_increment_changecount_after(beentry);
+}
+
+/* ----------
+ * pgstat_progress_vacuum_end() -
+ *
+ *	Called when lazy vacuum of a relation finishes, and on abort.
+ * ----------
+ */
+void pgstat_progress_vacuum_end(void)
+{
+    volatile PgBackendStatus* beentry = t_thrd.shemem_ptr_cxt.MyBEEntry;
+
+    if (beentry == NULL || !OidIsValid(beentry->st_vacuum_progress.relid))
+        return;
+
+    pgstat_increment_changecount_before(beentry);
+    beentry->st_vacuum_progress.relid = InvalidOid;
+    beentry->st_vacuum_progress.nindexes = 0;
+    beentry->st_vacuum_progress.current_index = -1;
+    pgstat_increment_changecount_after(beentry);
+}
+
+const char* pgstat_get_vacuum_phase_name(VacuumProgressPhase phase)
+{
+    switch (phase) {
+        case VACUUM_PHASE_SCAN_HEAP:
+            return "scanning heap";
+        case VACUUM_PHASE_VACUUM_INDEX:
+            return "vacuuming indexes";
+        case VACUUM_PHASE_VACUUM_HEAP:
+            return "vacuuming heap";
+        case VACUUM_PHASE_CLEANUP_INDEX:
+            return "cleaning up indexes";
+        default:
+            return "initializing";
+    }
+}
+
 /*
  * updateMaxValueForAtomicType - using atomic type to store max value,
  * we need update the max value by using atomic method
@@ -2743,20 +2743,16 @@ static int ServerLoop(void)
          */
         ADIO_RUN()
         {
-            if (!g_instance.pid_cxt.AioCompleterStarted && !dummyStandbyMode) {
+            if (!g_instance.pid_cxt.AioCompleterStarted && !dummyStandbyMode &&
+                (pmState == PM_RECOVERY || pmState == PM_HOT_STANDBY || pmState == PM_RUN)) {
                 int aioStartErr = 0;
-                if ((aioStartErr = AioCompltrStart()) == 0) {
-                    g_instance.pid_cxt.AioCompleterStarted = 1;
-                } else {
-                    ereport(LOG, (errmsg_internal("Cannot start AIO completer threads error=%d", aioStartErr)));
-                    /*
-                     * If we failed to fork a aio process, just shut down.
-                     * Any required cleanup will happen at next restart. We
-                     * set g_instance.fatal_error so that an "abnormal shutdown" message
-                     * gets logged when we exit.
-                     */
-                    g_instance.fatal_error = true;
-                    HandleChildCrash(g_instance.pid_cxt.AioCompleterStarted, 1, "AIO process");
+                /* Only try once, the completers stay up until shutdown */
+                g_instance.pid_cxt.AioCompleterStarted = 1;
+                if ((aioStartErr = AioCompltrStart()) != 0) {
+                    /* AioCompltrIsReady() stays false, so all the I/O is done synchronously */
+                    ereport(WARNING,
+                        (errmsg_internal("Cannot start AIO completer threads error=%d, using synchronous I/O",
+                            aioStartErr)));
                 }
             }
         }
@@ -5464,6 +5460,19 @@ static void reaper(SIGNAL_ARGS)
             continue;
         }
 
+        /*
+         * Was it an AIO completer?  They only exit on their own at shutdown,
+         * anything else may have left buffers locked for a write.
+         */
+        if (AioCompltrReap(pid)) {
+            /* may be started again, after a demotion */
+            if (!AioCompltrIsRunning())
+                g_instance.pid_cxt.AioCompleterStarted = 0;
+            if (!EXIT_STATUS_0(exitstatus))
+                HandleChildCrash(pid, exitstatus, _("aio completer process"));
+            continue;
+        }
+
         /*
          * Else do standard backend child cleanup.
          */
@@ -5537,7 +5546,7 @@ static const char* GetProcName(ThreadId pid)
         return "fault monitor process";
     else if (g_instance.pid_cxt.AlarmCheckerPID == pid)
         return "alarm checker process";
-    else if (g_instance.pid_cxt.AioCompleterStarted == pid)
+    else if (AioCompltrIsThread(pid))
         return "aio completer process";
     else if (pid == g_instance.pid_cxt.CBMWriterPID)
         return "CBM writer process";
@@ -5929,9 +5938,14 @@ static void PostmasterStateMachine(void)
          * normal state transition leading up to PM_WAIT_DEAD_END, or during
          * g_instance.fatal_error processing.
          */
-        if (DLGetHead(g_instance.backend_list) == NULL && g_instance.pid_cxt.PgArchPID == 0 &&
-            g_instance.pid_cxt.PgStatPID == 0 && g_instance.pid_cxt.PgAuditPID == 0 &&
-            g_instance.pid_cxt.PageWriterPID[0] == 0) {
+        bool children_gone = DLGetHead(g_instance.backend_list) == NULL && g_instance.pid_cxt.PgArchPID == 0 &&
+                             g_instance.pid_cxt.PgStatPID == 0 && g_instance.pid_cxt.PgAuditPID == 0 &&
+                             g_instance.pid_cxt.PageWriterPID[0] == 0;
+
+        /* The AIO completers go last, they finish the I/O of all the threads above */
+        if (children_gone && AioCompltrIsRunning()) {
+            AioCompltrStop(SIGTERM);
+        } else if (children_gone) {
             /* These other guys should be dead already */
             Assert(g_instance.pid_cxt.TwoPhaseCleanerPID == 0);
             Assert(g_instance.pid_cxt.FaultMonitorPID == 0);
@@ -9309,6 +9323,9 @@ static void SetAuxType()
         case HEARTBEAT:
             t_thrd.bootstrap_cxt.MyAuxProcType = HeartbeatProcess;
             break;
+        case AIO_COMPLETER:
+            t_thrd.bootstrap_cxt.MyAuxProcType = AsyncIOCompleterProcess;
+            break;
         default:
             ereport(ERROR, (errmsg("unrecorgnized proc type %d", thread_role)));
     }
@@ -9352,6 +9369,10 @@ void SetExtraThreadInfo(knl_thread_arg* arg)
             t_thrd.threadpool_cxt.scheduler = (ThreadPoolScheduler*)arg->payload;
             break;
         }
+        case AIO_COMPLETER: {
+            t_thrd.aio_cxt.compltr_idx = *(int*)arg->payload;
+            break;
+        }
         default:
             break;
     }
@@ -9439,14 +9460,18 @@ int GaussDbAuxiliaryThreadMain(knl_thread_arg* arg)
          * particular auxiliary process type.
          */
         int index = g_instance.shmem_cxt.MaxBackends + t_thrd.bootstrap_cxt.MyAuxProcType + 1;
-        if (thread_role == PAGEWRITER_THREAD) {
-            index += get_pagewriter_thread_id();
+        if (thread_role == AIO_COMPLETER) {
+            index += t_thrd.aio_cxt.compltr_idx;
+        } else if (thread_role == PAGEWRITER_THREAD) {
+            index += get_pagewriter_thread_id() + (MAX_AIO_COMPLETER_THREAD_NUM - 1);
         } else if (thread_role == PAGEREDO) {
             SetMyPageRedoWorker(arg);
-            index += MultiRedoGetWorkerId() + g_instance.attr.attr_storage.pagewriter_thread_num - 1;
+            index += MultiRedoGetWorkerId() + g_instance.attr.attr_storage.pagewriter_thread_num - 1 +
+                     (MAX_AIO_COMPLETER_THREAD_NUM - 1);
         } else if (thread_role == THREADPOOL_LISTENER) {
             index += t_thrd.threadpool_cxt.listener->GetGroup()->GetGroupId() +
-                     (g_instance.attr.attr_storage.pagewriter_thread_num - 1) + (MAX_RECOVERY_THREAD_NUM - 1);
+                     (g_instance.attr.attr_storage.pagewriter_thread_num - 1) + (MAX_RECOVERY_THREAD_NUM - 1) +
+                     (MAX_AIO_COMPLETER_THREAD_NUM - 1);
         }
 
         ProcSignalInit(index);
@@ -9564,6 +9589,11 @@ int GaussDbAuxiliaryThreadMain(knl_thread_arg* arg)
             proc_exit(1);
             break;
 
+        case AIO_COMPLETER:
+            AioCompltrMain();
+            proc_exit(1);
+            break;
+
         default:
             ereport(PANIC, (errmsg("unrecognized process type: %d", (int)t_thrd.bootstrap_cxt.MyAuxProcType)));
             proc_exit(1);
@@ -9733,7 +9763,8 @@ int GaussDbThreadMain(knl_thread_arg* arg)
         case PAGEWRITER_THREAD:
         case HEARTBEAT:
         case THREADPOOL_LISTENER:
-        case THREADPOOL_SCHEDULER: {
+        case THREADPOOL_SCHEDULER:
+        case AIO_COMPLETER: {
             SetAuxType<thread_role>();
             /* Restore basic shared memory pointers */
             InitShmemAccess(UsedShmemSegAddr);
@@ -10011,7 +10042,8 @@ static GaussdbThreadEntry GaussdbThreadEntryGate[] = {GaussDbThreadMain<MASTER>,
     GaussDbThreadMain<COMM_RECEIVERFLOWER>,
     GaussDbThreadMain<COMM_RECEIVER>,
     GaussDbThreadMain<COMM_AUXILIARY>,
-    GaussDbThreadMain<COMM_POOLER_CLEAN>};
+    GaussDbThreadMain<COMM_POOLER_CLEAN>,
+    GaussDbThreadMain<AIO_COMPLETER>};
 
 const char* GaussdbThreadName[] = {"main",
     "worker",
@@ -10055,7 +10087,8 @@ const char* GaussdbThreadName[] = {"main",
     "communicator receiver flower",
     "communicator receiver loop",
     "communicator auxiliary",
-    "communicator pooler auto cleaner"};
+    "communicator pooler auto cleaner",
+    "AIO completer"};
 
 GaussdbThreadEntry GetThreadEntry(knl_thread_role role)
 {
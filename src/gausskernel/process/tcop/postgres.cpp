@@ -10657,8 +10657,19 @@ static void exec_batch_bind_execute(StringInfo input_message)
             int tmp_count = 0;
 
             for (int i = 0; i < batch_count; i++) {
-                exec_one_in_batch(
-                    psrc, params_set[i], numRFormats, rformats, i == 0 ? send_DP_msg : false, dest, completionTag);
+                /*
+                 * Once the first set has set up the bypass, it may take all the
+                 * remaining sets at once, e.g. an insert bypass buffers their rows
+                 * into multi-inserts.
+                 */
+                bool batched = (i > 0 && psrc->opFusionObj != NULL &&
+                                OpFusion::processBatch(psrc, params_set + i, batch_count - i, completionTag, true));
+                if (batched) {
+                    CommandCounterIncrement();
+                } else {
+                    exec_one_in_batch(
+                        psrc, params_set[i], numRFormats, rformats, i == 0 ? send_DP_msg : false, dest, completionTag);
+                }
 
                 /* Get process_count (X) from completionTag */
                 if (completionTag[0] == 'I') {
@@ -10674,6 +10685,9 @@ static void exec_batch_bind_execute(StringInfo input_message)
                 }
 
                 process_count += tmp_count;
+                if (batched) {
+                    break;
+                }
             }
         }
 
@@ -974,6 +974,10 @@ bool PortalRun(
      */
     MarkPortalActive(portal);
 
+    /* runs of a gpc plan variant are timed for gs_globalplancache_variant_status */
+    GPCPlanVariant* plan_variant = (portal->cplan != NULL) ? portal->cplan->variant : NULL;
+    TimestampTz variant_start = (plan_variant != NULL) ? GetCurrentTimestamp() : 0;
+
     QueryDesc* query_desc = portal->queryDesc;
 
     if (IS_PGXC_DATANODE && query_desc != NULL && (query_desc->plannedstmt) != NULL &&
@@ -1164,6 +1168,11 @@ bool PortalRun(
     }
     PG_END_TRY();
 
+    if (plan_variant != NULL) {
+        (void)gs_atomic_add_64(&plan_variant->exec_count, 1);
+        (void)gs_atomic_add_64(&plan_variant->total_exec_time, GetCurrentTimestamp() - variant_start);
+    }
+
     if (ENABLE_WORKLOAD_CONTROL) {
         t_thrd.wlm_cxt.parctl_state.except = 0;
 
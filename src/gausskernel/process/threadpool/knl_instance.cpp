@@ -186,6 +186,9 @@ static void knl_g_cache_init(knl_g_cache_context* cache_cxt)
                                                         SHARED_CONTEXT,
                                                         DEFAULT_MEMORY_CONTEXT_MAX_SIZE,
                                                         false);
+    cache_cxt->global_catcache = NULL;
+    pg_atomic_init_u64(&cache_cxt->global_catcache_size, 0);
+    pg_atomic_init_u32(&cache_cxt->global_catcache_hand, 0);
 }
 
 static void knl_g_comm_init(knl_g_comm_context* comm_cxt)
@@ -228,6 +231,13 @@ static void knl_g_executor_init(knl_g_executor_context* exec_cxt)
 static void knl_g_xlog_init(knl_g_xlog_context *xlog_cxt)
 {
     xlog_cxt->num_locks_in_group = 0;
+    pg_atomic_init_u64(&xlog_cxt->compress_attempts, 0);
+    pg_atomic_init_u64(&xlog_cxt->compressed_records, 0);
+    pg_atomic_init_u64(&xlog_cxt->compress_raw_bytes, 0);
+    pg_atomic_init_u64(&xlog_cxt->compressed_bytes, 0);
+    pg_atomic_init_u64(&xlog_cxt->compress_time, 0);
+    pg_atomic_init_u64(&xlog_cxt->decompressed_records, 0);
+    pg_atomic_init_u64(&xlog_cxt->decompress_time, 0);
 }
 
 static void knl_g_libpq_init(knl_g_libpq_context* libpq_cxt)
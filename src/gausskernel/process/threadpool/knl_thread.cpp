@@ -470,6 +470,10 @@ static void knl_t_xlog_init(knl_t_xlog_context* xlog_cxt)
     xlog_cxt->mainrdata_len = 0;
     xlog_cxt->ptr_hdr_rdt = (XLogRecData*)palloc0(sizeof(XLogRecData));
     xlog_cxt->hdr_scratch = NULL;
+    xlog_cxt->payload_scratch = NULL;
+    xlog_cxt->compressed_payload = NULL;
+    xlog_cxt->payload_scratch_size = 0;
+    xlog_cxt->ptr_payload_rdt = (XLogRecData*)palloc0(sizeof(XLogRecData));
     xlog_cxt->rdatas = NULL;
     xlog_cxt->num_rdatas = 0;
     xlog_cxt->max_rdatas = 0;
@@ -988,6 +992,7 @@ static void knl_t_aiocompleter_init(knl_t_aiocompleter_context* aio_cxt)
 {
     aio_cxt->shutdown_requested = false;
     aio_cxt->config_requested = false;
+    aio_cxt->compltr_idx = 0;
 }
 
 static void knl_t_twophasecleaner_init(knl_t_twophasecleaner_context* tpcleaner_cxt)
@@ -64,6 +64,10 @@ ThreadPoolControler* g_threadPoolControler = NULL;
 
 #define BUFSIZE 128
 
+/* NUMA distances as reported by the firmware, 10 means local */
+#define NUMA_LOCAL_DISTANCE 10
+#define NUMA_REMOTE_DISTANCE 20
+
 #define IS_NULL_STR(str) ((str) == NULL || (str)[0] == '\0')
 #define INVALID_ATTR_ERROR(detail) \
     ereport(FATAL, (errcode(ERRCODE_OPERATE_INVALID_PARAM), errmsg("Invalid attribute for thread pool."), detail))
@@ -73,6 +77,7 @@ ThreadPoolControler::ThreadPoolControler()
     m_threadPoolContext = NULL;
     m_sessCtrl = NULL;
     m_groups = NULL;
+    m_groupDistance = NULL;
     m_groupNum = 1;
     m_threadNum = 0;
     m_maxPoolSize = 0;
@@ -83,6 +88,7 @@ ThreadPoolControler::~ThreadPoolControler()
     MemoryContextDelete(m_threadPoolContext);
     m_threadPoolContext = NULL;
     m_groups = NULL;
+    m_groupDistance = NULL;
     m_sessCtrl = NULL;
 }
 
@@ -141,6 +147,8 @@ void ThreadPoolControler::Init(bool enableNumaDistribute)
         m_groups[i]->WaitReady();
     }
 
+    InitGroupDistance();
+
 #ifdef __USE_NUMA
     if (enableNumaDistribute) {
         /* Set to interleave mode for other than worker thread */
@@ -642,6 +650,106 @@ ThreadPoolGroup* ThreadPoolControler::FindThreadGroupWithLeastSession()
     return m_groups[idx];
 }
 
+void ThreadPoolControler::InitGroupDistance()
+{
+    int* distance = (int*)palloc(sizeof(int) * m_groupNum * m_groupNum);
+
+    for (int i = 0; i < m_groupNum; i++) {
+        for (int j = 0; j < m_groupNum; j++) {
+            int node_i = m_groups[i]->GetNumaId();
+            int node_j = m_groups[j]->GetNumaId();
+            int dist = NUMA_LOCAL_DISTANCE;
+
+            if (node_i != node_j) {
+                dist = NUMA_REMOTE_DISTANCE;
+#ifdef __USE_NUMA
+                if (node_i >= 0 && node_j >= 0 && numa_available() >= 0) {
+                    dist = Max(numa_distance(node_i, node_j), NUMA_REMOTE_DISTANCE);
+                }
+#endif
+            }
+            distance[i * m_groupNum + j] = dist;
+        }
+    }
+
+    /* workers are already running and may look at the matrix */
+    pg_write_barrier();
+    m_groupDistance = distance;
+}
+
+/*
+ * Work stealing between groups.
+ *
+ * A session stays with the group whose listener polls its socket, so skewed
+ * connections can leave one group queueing while workers of another group
+ * sit idle.  An idle worker thus serves the ready queue of another group
+ * before going to sleep, and a listener that has to queue a session wakes an
+ * idle worker of another group to do that.  The session's memory stays on
+ * its home node, so the farther away the busy group is, the longer its queue
+ * must be before we steal from it: one waiting session for each 10 units
+ * of NUMA distance.
+ */
+bool ThreadPoolControler::CanStealFrom(int thiefIdx, ThreadPoolGroup* busy) const
+{
+    int dist = m_groupDistance[thiefIdx * m_groupNum + busy->GetGroupId()];
+    return busy->GetWaitServeSessionNum() * NUMA_LOCAL_DISTANCE >= dist;
+}
+
+knl_session_context* ThreadPoolControler::StealSession(ThreadPoolGroup* thief)
+{
+    if (m_groupNum <= 1 || m_groupDistance == NULL) {
+        return NULL;
+    }
+
+    /* the nearest group with enough backlog, the longest queue among equally near ones */
+    int thief_idx = thief->GetGroupId();
+    ThreadPoolGroup* victim = NULL;
+    int victim_dist = 0;
+    for (int i = 0; i < m_groupNum; i++) {
+        ThreadPoolGroup* grp = m_groups[i];
+        if (grp == thief || !CanStealFrom(thief_idx, grp)) {
+            continue;
+        }
+
+        int dist = m_groupDistance[thief_idx * m_groupNum + i];
+        if (victim == NULL || dist < victim_dist ||
+            (dist == victim_dist && grp->GetWaitServeSessionNum() > victim->GetWaitServeSessionNum())) {
+            victim = grp;
+            victim_dist = dist;
+        }
+    }
+
+    return (victim != NULL) ? victim->GetListener()->GetReadySession(thief) : NULL;
+}
+
+void ThreadPoolControler::RequestSteal(ThreadPoolGroup* busy)
+{
+    if (m_groupNum <= 1 || m_groupDistance == NULL) {
+        return;
+    }
+
+    /* wake an idle worker of the nearest group allowed to steal from us */
+    int busy_idx = busy->GetGroupId();
+    ThreadPoolGroup* helper = NULL;
+    int helper_dist = 0;
+    for (int i = 0; i < m_groupNum; i++) {
+        ThreadPoolGroup* grp = m_groups[i];
+        if (grp == busy || grp->GetIdleWorkerNum() <= 0 || !CanStealFrom(i, busy)) {
+            continue;
+        }
+
+        int dist = m_groupDistance[i * m_groupNum + busy_idx];
+        if (helper == NULL || dist < helper_dist) {
+            helper = grp;
+            helper_dist = dist;
+        }
+    }
+
+    if (helper != NULL) {
+        (void)helper->GetListener()->WakeUpWorkerToSteal();
+    }
+}
+
 bool ThreadPoolControler::StayInAttachMode()
 {
     return m_sessCtrl->GetActiveSessionCount() < m_threadNum;
@@ -68,6 +68,9 @@ ThreadPoolGroup::ThreadPoolGroup(int maxWorkerNum, int expectWorkerNum,
       m_sessionCount(0),
       m_waitServeSessionCount(0),
       m_processTaskCount(0),
+      m_queuedSessionCount(0),
+      m_queuedWaitTime(0),
+      m_stolenSessionCount(0),
       m_groupId(groupId),
       m_numaId(numaId),
       m_groupCpuNum(cpuNum),
@@ -188,10 +191,13 @@ void ThreadPoolGroup::GetThreadPoolGroupStat(ThreadPoolStat* stat)
     int run_session_num = m_workerNum - m_idleWorkerNum;
     int idle_session_num = m_sessionCount - m_waitServeSessionCount - run_session_num;
     idle_session_num = (idle_session_num < 0) ? 0 : idle_session_num;
+    uint64 queued_num = pg_atomic_read_u64(&m_queuedSessionCount);
+    uint64 avg_wait = (queued_num == 0) ? 0 : pg_atomic_read_u64(&m_queuedWaitTime) / queued_num;
     rc = sprintf_s(stat->sessionInfo, STATUS_INFO_SIZE,
-        "total: %d waiting: %d running:%d idle: %d",
+        "total: %d waiting: %d running:%d idle: %d queued: %lu avg wait(us): %lu stolen: %lu",
         m_sessionCount, m_waitServeSessionCount,
-        run_session_num, idle_session_num);
+        run_session_num, idle_session_num, queued_num, avg_wait,
+        pg_atomic_read_u64(&m_stolenSessionCount));
     securec_check_ss(rc, "\0", "\0");
 }
 
@@ -167,11 +167,9 @@ void ThreadPoolListener::AddEpoll(knl_session_context* session)
 
 bool ThreadPoolListener::TryFeedWorker(ThreadPoolWorker* worker)
 {
-    Dlelem* sc = m_readySessionList->RemoveHead();
-    if (sc != NULL) {
-        worker->SetSession((knl_session_context*)sc->dle_val);
-        pg_atomic_fetch_sub_u32((volatile uint32*)&m_group->m_waitServeSessionCount, 1);
-        pg_atomic_fetch_add_u32((volatile uint32*)&m_group->m_processTaskCount, 1);
+    knl_session_context* session = GetReadySession(m_group);
+    if (session != NULL) {
+        worker->SetSession(session);
         return true;
     } else {
         m_freeWorkerList->AddTail(&worker->m_elem);
@@ -180,8 +178,45 @@ bool ThreadPoolListener::TryFeedWorker(ThreadPoolWorker* worker)
     }
 }
 
+/*
+ * Take the oldest session waiting for a worker, on behalf of a worker of
+ * group 'taker', which is another group when the session is being stolen.
+ */
+knl_session_context* ThreadPoolListener::GetReadySession(ThreadPoolGroup* taker)
+{
+    Dlelem* sc = m_readySessionList->RemoveHead();
+    if (sc == NULL) {
+        return NULL;
+    }
+
+    knl_session_context* session = (knl_session_context*)DLE_VAL(sc);
+    pg_atomic_fetch_sub_u32((volatile uint32*)&m_group->m_waitServeSessionCount, 1);
+    pg_atomic_fetch_add_u32((volatile uint32*)&m_group->m_processTaskCount, 1);
+
+    TimestampTz wait_time = GetCurrentTimestamp() - session->readyTime;
+    pg_atomic_fetch_add_u64(&m_group->m_queuedSessionCount, 1);
+    pg_atomic_fetch_add_u64(&m_group->m_queuedWaitTime, (uint64)((wait_time > 0) ? wait_time : 0));
+    if (taker != m_group) {
+        pg_atomic_fetch_add_u64(&m_group->m_stolenSessionCount, 1);
+    }
+    return session;
+}
+
+/* Wake up one idle worker of this group to steal from an overloaded group. */
+bool ThreadPoolListener::WakeUpWorkerToSteal()
+{
+    Dlelem* sc = m_freeWorkerList->RemoveHead();
+    if (sc == NULL) {
+        return false;
+    }
+
+    ((ThreadPoolWorker*)DLE_VAL(sc))->WakeUpToSteal();
+    return true;
+}
+
 void ThreadPoolListener::AddNewSession(knl_session_context* session)
 {
+    session->homeGroup = m_group;
     AddEpoll(session);
     (void)pg_atomic_fetch_add_u32((volatile uint32*)&m_group->m_sessionCount, 1);
 }
@@ -294,8 +329,10 @@ void ThreadPoolListener::DispatchSession(knl_session_context* session)
                 break;
             }
         } else {
+            session->readyTime = GetCurrentTimestamp();
             m_readySessionList->AddTail(&session->elem);
             pg_atomic_fetch_add_u32((volatile uint32*)&m_group->m_waitServeSessionCount, 1);
+            g_threadPoolControler->RequestSteal(m_group);
             break;
         }
     }
@@ -79,6 +79,7 @@ ThreadPoolWorker::ThreadPoolWorker(uint idx, ThreadPoolGroup* group, pthread_mut
     m_group = group;
     m_tid = InvalidTid;
     m_threadStatus = THREAD_UNINIT;
+    m_stealRequested = false;
     m_currentSession = NULL;
     m_mutex = mutex;
     m_cond = cond;
@@ -209,6 +210,16 @@ bool ThreadPoolWorker::WakeUpToWork(knl_session_context* session)
     return succ;
 }
 
+void ThreadPoolWorker::WakeUpToSteal()
+{
+    pthread_mutex_lock(m_mutex);
+    if (likely(m_threadStatus != THREAD_EXIT)) {
+        m_stealRequested = true;
+        pthread_cond_signal(m_cond);
+    }
+    pthread_mutex_unlock(m_mutex);
+}
+
 void ThreadPoolWorker::WakeUpToUpdate(ThreadStatus status)
 {
     pthread_mutex_lock(m_mutex);
@@ -335,7 +346,17 @@ void ThreadPoolWorker::WaitNextSession()
         } else if (m_currentSession != NULL) {
             break;
         }
-    
+
+        /* Serve our own group first, then help the nearest overloaded group. */
+        knl_session_context* session = lsn->GetReadySession(m_group);
+        if (session == NULL) {
+            session = g_threadPoolControler->StealSession(m_group);
+        }
+        if (session != NULL) {
+            m_currentSession = session;
+            continue;
+        }
+
         /* Wait for listener dispatch. */
         if (!lsn->TryFeedWorker(this)) {
             /* report thread status. */
@@ -344,11 +365,13 @@ void ThreadPoolWorker::WaitNextSession()
 
             pthread_mutex_lock(m_mutex);
             while (!m_currentSession) {
-                if (unlikely(m_threadStatus == THREAD_PENDING || m_threadStatus == THREAD_EXIT)) {
+                if (unlikely(m_threadStatus == THREAD_PENDING || m_threadStatus == THREAD_EXIT ||
+                    m_stealRequested)) {
                     break;
                 }
                 pthread_cond_wait(m_cond, m_mutex);
             }
+            m_stealRequested = false;
             pthread_mutex_unlock(m_mutex);
             m_group->GetListener()->RemoveWorkerFromList(this);
             pg_atomic_fetch_sub_u32((volatile uint32*)&m_group->m_idleWorkerNum, 1);
@@ -448,8 +471,8 @@ void ThreadPoolWorker::DetachSessionFromThread()
     pgstat_deinitialize_session();
     m_currentSession->attachPid = (ThreadId)-1;
 
-    /* should restore the data before return to listener. */
-    m_group->GetListener()->AddEpoll(m_currentSession);
+    /* should restore the data before return to listener, the session may be stolen from another group. */
+    m_currentSession->homeGroup->GetListener()->AddEpoll(m_currentSession);
     m_currentSession = NULL;
     u_sess = NULL;
 }
@@ -561,7 +584,7 @@ void ThreadPoolWorker::CleanUpSession(bool threadexit)
         }
 
         /* Close Session. */
-        m_group->GetListener()->DelSessionFromEpoll(m_currentSession);
+        m_currentSession->homeGroup->GetListener()->DelSessionFromEpoll(m_currentSession);
 
         /*
          * Record this state in case we reenter this function because
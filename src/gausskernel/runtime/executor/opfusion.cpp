@@ -318,6 +318,33 @@ bool OpFusion::process(int op, StringInfo msg, char* completionTag, bool isTopLe
     }
 }
 
+/*
+ * Execute the remaining parameter sets of a batch bind-execute message in one call
+ * of the bypass object of psrc.  Returns false if that bypass can only run one set
+ * at a time, and the caller should go on with exec_one_in_batch.
+ */
+bool OpFusion::processBatch(
+    CachedPlanSource* psrc, ParamListInfo* paramsSet, int count, char* completionTag, bool isTopLevel)
+{
+    OpFusion* opfusion = (OpFusion*)psrc->opFusionObj;
+
+    if (opfusion == NULL || !opfusion->supportBatch()) {
+        return false;
+    }
+
+    opfusion->bindClearPosition();
+    setCurrentOpFusionObj(opfusion);
+
+    opfusion->executeInit();
+    gstrace_entry(GS_TRC_ID_BypassExecutor);
+    (void)opfusion->executeBatch(paramsSet, count, completionTag);
+    gstrace_exit(GS_TRC_ID_BypassExecutor);
+    opfusion->executeEnd();
+    UpdateSingleNodeByPassUniqueSQLStat(isTopLevel);
+
+    return true;
+}
+
 void OpFusion::CopyFormats(int16* formats, int numRFormats)
 {
     MemoryContext old_context = MemoryContextSwitchTo(m_tmpContext);
@@ -971,6 +998,9 @@ bool MotJitSelectFusion::execute(long max_rows, char* completionTag)
     return success;
 }
 
+/* flush buffered tuples of a multi-row insert once this many are pending */
+#define INSERT_FUSION_MAX_BUFFERED_TUPLES 1000
+
 InsertFusion::InsertFusion(MemoryContext context, CachedPlanSource* psrc, List* plantree_list, ParamListInfo params)
     : OpFusion(context, psrc, plantree_list, INSERT_FUSION)
 {
@@ -987,23 +1017,65 @@ InsertFusion::InsertFusion(MemoryContext context, CachedPlanSource* psrc, List*
     m_estate = CreateExecutorState();
     m_estate->es_range_table = m_planstmt->rtable;
 
-    BaseResult* baseresult = (BaseResult*)linitial(node->plans);
-    List* targetList = baseresult->plan.targetlist;
+    /* the subplan is a BaseResult for a single row, or a ValuesScan for a multi-row VALUES */
+    Plan* subplan = (Plan*)linitial(node->plans);
+    List* targetList = subplan->targetlist;
+    int natts = RelationGetDescr(rel)->natts;
     m_tupDesc = ExecTypeFromTL(targetList, false);
     m_reslot = MakeSingleTupleTableSlot(m_tupDesc);
-    m_values = (Datum*)palloc0(RelationGetDescr(rel)->natts * sizeof(Datum));
-    m_isnull = (bool*)palloc0(RelationGetDescr(rel)->natts * sizeof(bool));
+    m_values = (Datum*)palloc0(natts * sizeof(Datum));
+    m_isnull = (bool*)palloc0(natts * sizeof(bool));
     m_is_bucket_rel = RELATION_OWN_BUCKET(rel);
 
     heap_close(rel, AccessShareLock);
 
     /* init param */
     m_paramNum = 0;
-    m_paramLoc = (ParamLoc*)palloc0(RelationGetDescr(rel)->natts * sizeof(ParamLoc));
-    m_targetParamNum = 0;
 
-    m_targetFuncNum = 0;
-    m_targetFuncNodes = (FuncExprInfo*)palloc0(RelationGetDescr(rel)->natts * sizeof(FuncExprInfo));
+    if (IsA(subplan, ValuesScan)) {
+        List* valuesLists = ((ValuesScan*)subplan)->values_lists;
+        ListCell* lc = NULL;
+        int i = 0;
+
+        m_rowNum = list_length(valuesLists);
+        m_rows = (ValuesRow*)palloc0(m_rowNum * sizeof(ValuesRow));
+        foreach (lc, valuesLists) {
+            initValuesRow(&m_rows[i++], targetList, (List*)lfirst(lc), natts);
+        }
+    } else {
+        m_rowNum = 1;
+        m_rows = (ValuesRow*)palloc0(sizeof(ValuesRow));
+        initValuesRow(&m_rows[0], targetList, NIL, natts);
+    }
+
+    m_paramLoc = m_rows[0].paramLoc;
+
+    initParams(params);
+
+    m_receiver = NULL;
+    m_isInsideRec = true;
+
+    MemoryContextSwitchTo(old_context);
+}
+
+/*
+ * Sort the target expressions of one row into consts, params and func/op exprs.
+ * For a ValuesScan, a Var of the targetlist stands for the expression at the same
+ * position of the row's VALUES list.
+ */
+void InsertFusion::initValuesRow(ValuesRow* row, List* targetList, List* valuesList, int natts)
+{
+    if (m_rowNum == 1) {
+        row->values = m_values;
+        row->isnull = m_isnull;
+    } else {
+        row->values = (Datum*)palloc0(natts * sizeof(Datum));
+        row->isnull = (bool*)palloc0(natts * sizeof(bool));
+    }
+    row->paramNum = 0;
+    row->paramLoc = (ParamLoc*)palloc0(natts * sizeof(ParamLoc));
+    row->funcNum = 0;
+    row->funcNodes = (FuncExprInfo*)palloc0(natts * sizeof(FuncExprInfo));
 
     ListCell* lc = NULL;
     int i = 0;
@@ -1015,6 +1087,10 @@ InsertFusion::InsertFusion(MemoryContext context, CachedPlanSource* psrc, List*
         res = (TargetEntry*)lfirst(lc);
         expr = res->expr;
 
+        if (IsA(expr, Var) && valuesList != NIL) {
+            expr = (Expr*)list_nth(valuesList, ((Var*)expr)->varattno - 1);
+        }
+
         Assert(
             IsA(expr, Const) || IsA(expr, Param) || IsA(expr, FuncExpr) || IsA(expr, RelabelType) || IsA(expr, OpExpr));
         while (IsA(expr, RelabelType)) {
@@ -1024,69 +1100,135 @@ InsertFusion::InsertFusion(MemoryContext context, CachedPlanSource* psrc, List*
         if (IsA(expr, FuncExpr)) {
             func = (FuncExpr*)expr;
 
-            m_targetFuncNodes[m_targetFuncNum].resno = res->resno;
-            m_targetFuncNodes[m_targetFuncNum].funcid = func->funcid;
-            m_targetFuncNodes[m_targetFuncNum].args = func->args;
-            ++m_targetFuncNum;
+            row->funcNodes[row->funcNum].resno = res->resno;
+            row->funcNodes[row->funcNum].funcid = func->funcid;
+            row->funcNodes[row->funcNum].args = func->args;
+            ++row->funcNum;
         } else if (IsA(expr, Param)) {
             Param* param = (Param*)expr;
-            m_paramLoc[m_targetParamNum].paramId = param->paramid;
-            m_paramLoc[m_targetParamNum++].scanKeyIndx = i;
+            row->paramLoc[row->paramNum].paramId = param->paramid;
+            row->paramLoc[row->paramNum++].scanKeyIndx = i;
         } else if (IsA(expr, Const)) {
             Assert(IsA(expr, Const));
-            m_isnull[i] = ((Const*)expr)->constisnull;
-            m_values[i] = ((Const*)expr)->constvalue;
+            row->isnull[i] = ((Const*)expr)->constisnull;
+            row->values[i] = ((Const*)expr)->constvalue;
         } else if (IsA(expr, OpExpr)) {
             opexpr = (OpExpr*)expr;
 
-            m_targetFuncNodes[m_targetFuncNum].resno = res->resno;
-            m_targetFuncNodes[m_targetFuncNum].funcid = opexpr->opfuncid;
-            m_targetFuncNodes[m_targetFuncNum].args = opexpr->args;
-            ++m_targetFuncNum;
+            row->funcNodes[row->funcNum].resno = res->resno;
+            row->funcNodes[row->funcNum].funcid = opexpr->opfuncid;
+            row->funcNodes[row->funcNum].args = opexpr->args;
+            ++row->funcNum;
         }
 
         i++;
     }
-
-    initParams(params);
-
-    m_receiver = NULL;
-    m_isInsideRec = true;
-
-    MemoryContextSwitchTo(old_context);
 }
 
-void InsertFusion::refreshParameterIfNecessary()
+void InsertFusion::refreshParameterIfNecessary(const ValuesRow* row)
 {
     ParamListInfo parms = m_outParams != NULL ? m_outParams : m_params;
+
+    /* rows of a multi-row VALUES share m_values, start from the consts of this one */
+    if (row->values != m_values) {
+        errno_t rc = memcpy_s(m_values, m_tupDesc->natts * sizeof(Datum), row->values, m_tupDesc->natts * sizeof(Datum));
+        securec_check(rc, "\0", "\0");
+        rc = memcpy_s(m_isnull, m_tupDesc->natts * sizeof(bool), row->isnull, m_tupDesc->natts * sizeof(bool));
+        securec_check(rc, "\0", "\0");
+    }
+
     /* calculate func result */
-    for (int i = 0; i < m_targetFuncNum; ++i) {
-        if (m_targetFuncNodes[i].funcid != InvalidOid) {
+    for (int i = 0; i < row->funcNum; ++i) {
+        if (row->funcNodes[i].funcid != InvalidOid) {
             bool func_isnull = false;
-            m_values[m_targetFuncNodes[i].resno - 1] = CalFuncNodeVal(
-                m_targetFuncNodes[i].funcid, m_targetFuncNodes[i].args, &func_isnull);
-            m_isnull[m_targetFuncNodes[i].resno - 1] = func_isnull;
+            m_values[row->funcNodes[i].resno - 1] = CalFuncNodeVal(
+                row->funcNodes[i].funcid, row->funcNodes[i].args, &func_isnull);
+            m_isnull[row->funcNodes[i].resno - 1] = func_isnull;
         }
     }
     /* mapping params */
-    if (m_targetParamNum > 0) {
-        for (int i = 0; i < m_targetParamNum; i++) {
-            m_values[m_paramLoc[i].scanKeyIndx] = parms->params[m_paramLoc[i].paramId - 1].value;
-            m_isnull[m_paramLoc[i].scanKeyIndx] = parms->params[m_paramLoc[i].paramId - 1].isnull;
+    if (row->paramNum > 0) {
+        for (int i = 0; i < row->paramNum; i++) {
+            m_values[row->paramLoc[i].scanKeyIndx] = parms->params[row->paramLoc[i].paramId - 1].value;
+            m_isnull[row->paramLoc[i].scanKeyIndx] = parms->params[row->paramLoc[i].paramId - 1].isnull;
         }
     }
 }
 
-bool InsertFusion::execute(long max_rows, char* completionTag)
+/* insert a single tuple through heap_insert, the tuple is freed */
+void InsertFusion::insertOneTuple(Relation rel, ResultRelInfo* resultRelInfo, HeapTuple tuple, CommandId cid)
 {
-    bool success = false;
+    Relation bucket_rel = NULL;
+    int2 bucketid = InvalidBktId;
+
+    if (m_is_bucket_rel) {
+        bucketid = computeTupleBucketId(resultRelInfo->ri_RelationDesc, tuple);
+        if (bucketid != InvalidBktId) {
+            bucket_rel = bucketGetRelation(rel, NULL, bucketid);
+        } else {
+            ereport(ERROR,
+                    (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+                     errmsg("Invaild Oid when open hash bucket relation.")));
+        }
+    }
+
+    (void)ExecStoreTuple(tuple, m_reslot, InvalidBuffer, false);
+
+    (void)heap_insert(bucket_rel == NULL ? rel : bucket_rel, tuple, cid, 0, NULL);
+
+    /* insert index entries for tuple */
+    List* recheck_indexes = NIL;
+    if (resultRelInfo->ri_NumIndices > 0) {
+        recheck_indexes = ExecInsertIndexTuples(m_reslot, &(tuple->t_self), m_estate, NULL, NULL, bucketid);
+    }
+    list_free_ext(recheck_indexes);
 
+    (void)ExecClearTuple(m_reslot);
+    heap_freetuple_ext(tuple);
+
+    if (bucket_rel != NULL) {
+        bucketCloseRelation(bucket_rel);
+    }
+}
+
+/*
+ * Insert the buffered tuples with one heap_multi_insert, which fills the pages one
+ * at a time and writes one WAL record per page, then insert their index entries.
+ * The tuples are freed.
+ */
+void InsertFusion::insertBufferedTuples(
+    Relation rel, ResultRelInfo* resultRelInfo, HeapTuple* tuples, int ntuples, CommandId cid)
+{
+    /* not compressed, and logged like any other insert rather than replicated by page */
+    HeapMultiInsertExtraArgs args = {NULL, 0, true};
+
+    /* heap_multi_insert leaks memory, keep it in the temporary context */
+    MemoryContext old_context = MemoryContextSwitchTo(m_tmpContext);
+    (void)heap_multi_insert(rel, rel, tuples, ntuples, cid, 0, NULL, &args);
+    MemoryContextSwitchTo(old_context);
+
+    for (int i = 0; i < ntuples; i++) {
+        if (resultRelInfo->ri_NumIndices > 0) {
+            (void)ExecStoreTuple(tuples[i], m_reslot, InvalidBuffer, false);
+            List* recheck_indexes =
+                ExecInsertIndexTuples(m_reslot, &(tuples[i]->t_self), m_estate, NULL, NULL, InvalidBktId);
+            list_free_ext(recheck_indexes);
+            (void)ExecClearTuple(m_reslot);
+        }
+        heap_freetuple_ext(tuples[i]);
+    }
+}
+
+/*
+ * Insert every row of the statement once per parameter set, or once with the
+ * current parameters if paramsSet is NULL.  Returns the number of rows inserted.
+ */
+uint64 InsertFusion::insertRows(ParamListInfo* paramsSet, int count)
+{
     /*******************
      * step 1: prepare *
      *******************/
     Relation rel = heap_open(m_reloid, RowExclusiveLock);
-    Relation bucket_rel = NULL;
-    int2 bucketid = InvalidBktId;
 
     ResultRelInfo* result_rel_info = makeNode(ResultRelInfo);
     InitResultRelInfo(result_rel_info, rel, 1, 0);
@@ -1098,44 +1240,58 @@ bool InsertFusion::execute(long max_rows, char* completionTag)
 
     CommandId mycid = GetCurrentCommandId(true);
 
-    refreshParameterIfNecessary();
+    /*
+     * Several rows go through heap_multi_insert, except for hash bucket relations
+     * whose rows may each land in another bucket.
+     */
+    uint64 ntotal = (uint64)count * (uint64)m_rowNum;
+    bool use_multi_insert = (ntotal > 1 && !m_is_bucket_rel);
+    HeapTuple* buffered = NULL;
+    int nbuffered = 0;
+    if (use_multi_insert) {
+        buffered = (HeapTuple*)palloc(Min(ntotal, INSERT_FUSION_MAX_BUFFERED_TUPLES) * sizeof(HeapTuple));
+    }
 
     /************************
      * step 2: begin insert *
      ************************/
-    HeapTuple tuple = heap_form_tuple(m_tupDesc, m_values, m_isnull);
-    Assert(tuple != NULL);
-    if (m_is_bucket_rel) {
-        bucketid = computeTupleBucketId(result_rel_info->ri_RelationDesc, tuple);
-        if (bucketid != InvalidBktId) {
-            bucket_rel = bucketGetRelation(rel, NULL, bucketid);
-        } else {
-            ereport(ERROR,
-                    (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
-                     errmsg("Invaild Oid when open hash bucket relation.")));
+    for (int i = 0; i < count; i++) {
+        if (paramsSet != NULL) {
+            m_outParams = paramsSet[i];
         }
-    }
 
-    (void)ExecStoreTuple(tuple, m_reslot, InvalidBuffer, false);
+        for (int j = 0; j < m_rowNum; j++) {
+            refreshParameterIfNecessary(&m_rows[j]);
 
-    if (rel->rd_att->constr) {
-        ExecConstraints(result_rel_info, m_reslot, m_estate);
-    }
+            HeapTuple tuple = heap_form_tuple(m_tupDesc, m_values, m_isnull);
+            Assert(tuple != NULL);
 
-    (void)heap_insert(bucket_rel == NULL ? rel : bucket_rel, tuple, mycid, 0, NULL);
+            if (rel->rd_att->constr) {
+                (void)ExecStoreTuple(tuple, m_reslot, InvalidBuffer, false);
+                ExecConstraints(result_rel_info, m_reslot, m_estate);
+                (void)ExecClearTuple(m_reslot);
+            }
 
-    /* insert index entries for tuple */
-    List* recheck_indexes = NIL;
-    if (result_rel_info->ri_NumIndices > 0) {
-        recheck_indexes = ExecInsertIndexTuples(m_reslot, &(tuple->t_self), m_estate, NULL, NULL, bucketid);
+            if (!use_multi_insert) {
+                insertOneTuple(rel, result_rel_info, tuple, mycid);
+                continue;
+            }
+
+            buffered[nbuffered++] = tuple;
+            if (nbuffered == INSERT_FUSION_MAX_BUFFERED_TUPLES) {
+                insertBufferedTuples(rel, result_rel_info, buffered, nbuffered, mycid);
+                nbuffered = 0;
+            }
+        }
     }
-    list_free_ext(recheck_indexes);
 
-    heap_freetuple_ext(tuple);
+    if (nbuffered > 0) {
+        insertBufferedTuples(rel, result_rel_info, buffered, nbuffered, mycid);
+    }
+    if (buffered != NULL) {
+        pfree(buffered);
+    }
 
-    (void)ExecClearTuple(m_reslot);
-    success = true;
-    m_isCompleted = true;
     /****************
      * step 3: done *
      ****************/
@@ -1147,14 +1303,37 @@ bool InsertFusion::execute(long max_rows, char* completionTag)
         FakeRelationCacheDestroy(m_estate->esfRelations);
     }
 
-    if (bucket_rel != NULL) {
-        bucketCloseRelation(bucket_rel);
-    }
+    return ntotal;
+}
+
+bool InsertFusion::execute(long max_rows, char* completionTag)
+{
+    uint64 nprocessed = insertRows(NULL, 1);
 
-    errno_t errorno = snprintf_s(completionTag, COMPLETION_TAG_BUFSIZE, COMPLETION_TAG_BUFSIZE - 1, "INSERT 0 1");
+    m_isCompleted = true;
+
+    errno_t errorno = snprintf_s(completionTag, COMPLETION_TAG_BUFSIZE, COMPLETION_TAG_BUFSIZE - 1,
+                                 "INSERT 0 %lu", nprocessed);
     securec_check_ss(errorno, "\0", "\0");
 
-    return success;
+    return true;
+}
+
+/*
+ * Run the insert once for each parameter set of a batch bind-execute message,
+ * buffering the rows of all sets into heap_multi_insert calls.
+ */
+bool InsertFusion::executeBatch(ParamListInfo* paramsSet, int count, char* completionTag)
+{
+    uint64 nprocessed = insertRows(paramsSet, count);
+
+    m_isCompleted = true;
+
+    errno_t errorno = snprintf_s(completionTag, COMPLETION_TAG_BUFSIZE, COMPLETION_TAG_BUFSIZE - 1,
+                                 "INSERT 0 %lu", nprocessed);
+    securec_check_ss(errorno, "\0", "\0");
+
+    return true;
 }
 
 MotJitModifyFusion::MotJitModifyFusion(MemoryContext context, CachedPlanSource* psrc, List* plantree_list, ParamListInfo params)
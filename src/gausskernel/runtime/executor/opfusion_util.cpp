@@ -34,6 +34,7 @@
 #include "mb/pg_wchar.h"
 #include "nodes/makefuncs.h"
 #include "optimizer/clauses.h"
+#include "optimizer/var.h"
 #include "parser/parsetree.h"
 #include "utils/dynahash.h"
 #include "utils/lsyscache.h"
@@ -721,6 +722,39 @@ FusionType checkTargetlist(List *targetList, FusionType ftype)
     return ftype;
 }
 
+/*
+ * The targetlist of a multi-row VALUES insert refers to the VALUES columns with
+ * plain Vars; other entries (defaults of columns not listed) and the VALUES
+ * expressions themselves must be simple enough for the bypass.
+ */
+static FusionType checkValuesScan(ValuesScan *scan, FusionType ftype)
+{
+    ListCell *lc = NULL;
+    foreach (lc, scan->scan.plan.targetlist) {
+        Expr *expr = ((TargetEntry *)lfirst(lc))->expr;
+        if (IsA(expr, Var)) {
+            Var *var = (Var *)expr;
+            if (var->varno != scan->scan.scanrelid || var->varattno <= 0 ||
+                var->varattno > list_length((List *)linitial(scan->values_lists))) {
+                return NOBYPASS_EXP_NOT_SUPPORT;
+            }
+        } else if (!checkExpr((Node *)expr, true) || contain_var_clause((Node *)expr)) {
+            return NOBYPASS_EXP_NOT_SUPPORT;
+        }
+    }
+
+    foreach (lc, scan->values_lists) {
+        ListCell *cell = NULL;
+        foreach (cell, (List *)lfirst(lc)) {
+            Node *expr = (Node *)lfirst(cell);
+            if (!checkExpr(expr, true) || contain_var_clause(expr)) {
+                return NOBYPASS_EXP_NOT_SUPPORT;
+            }
+        }
+    }
+    return ftype;
+}
+
 bool checkDMLRelation(Relation rel, PlannedStmt *plannedstmt)
 {
     if (rel->rd_rel->relkind != RELKIND_RELATION || rel->rd_rel->relhasrules || rel->rd_rel->relhastriggers ||
@@ -750,11 +784,18 @@ FusionType getInsertFusionType(List *stmt_list, ParamListInfo params)
     if (list_length(node->plans) != 1) {
         return NOBYPASS_NO_SIMPLE_PLAN;
     }
-    if (!IsA(linitial(node->plans), BaseResult)) {
-        return NOBYPASS_NO_SIMPLE_INSERT;
-    }
-    BaseResult *base = (BaseResult *)linitial(node->plans);
-    if (base->plan.lefttree != NULL || base->plan.initPlan != NIL || base->resconstantqual != NULL) {
+    Plan *subplan = (Plan *)linitial(node->plans);
+    if (IsA(subplan, BaseResult)) {
+        BaseResult *base = (BaseResult *)subplan;
+        if (base->plan.lefttree != NULL || base->plan.initPlan != NIL || base->resconstantqual != NULL) {
+            return NOBYPASS_NO_SIMPLE_INSERT;
+        }
+    } else if (IsA(subplan, ValuesScan)) {
+        /* multi-row VALUES */
+        if (subplan->lefttree != NULL || subplan->initPlan != NIL || subplan->qual != NIL) {
+            return NOBYPASS_NO_SIMPLE_INSERT;
+        }
+    } else {
         return NOBYPASS_NO_SIMPLE_INSERT;
     }
 
@@ -796,9 +837,10 @@ FusionType getInsertFusionType(List *stmt_list, ParamListInfo params)
      * check targetlist
      * maybe expr type is FuncExpr because of type conversion.
      */
-    BaseResult *base_result = (BaseResult *)linitial(node->plans);
-    List *targetlist = base_result->plan.targetlist;
-    return checkTargetlist(targetlist, ftype);
+    if (IsA(subplan, ValuesScan)) {
+        return checkValuesScan((ValuesScan *)subplan, ftype);
+    }
+    return checkTargetlist(subplan->targetlist, ftype);
 }
 
 FusionType getUpdateFusionType(List *stmt_list, ParamListInfo params)
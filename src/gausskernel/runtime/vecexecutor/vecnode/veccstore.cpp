@@ -75,6 +75,8 @@ extern bool CodeGenPassThreshold(double rows, int dn_num, int dop);
 static CStoreStrategyNumber get_cstore_scan_strategy_num(Oid opno);
 static Datum get_param_extern_const_value(Oid left_type, Expr* expr, PlanState* ps, uint16* flag);
 static void exec_init_next_part4cstore_scan(CStoreScanState* node);
+static void exec_cstore_collect_runtime_filters(CStoreScanState* node);
+static int exec_cstore_apply_runtime_filters(CStoreScanState* node, VectorBatch* batch, bool late_read);
 static void exec_cstore_build_scan_keys(CStoreScanState* scan_stat, List* quals, CStoreScanKey* scan_keys, int* num_scan_keys,
     CStoreScanRunTimeKeyInfo** runtime_key_info, int* runtime_keys_num);
 static void exec_cstore_scan_eval_runtime_keys(
@@ -193,6 +195,7 @@ VectorBatch* ApplyProjectionAndFilter(CStoreScanState* node, VectorBatch* p_scan
     bool simple_map = false;
     int late_read_ctid = 0;
     uint64 input_rows = p_scan_batch->m_rows;
+    uint64 bf_removed_rows = 0;
 
     VECCSTORE_SCAN_TRACE_START(node, CSTORE_PROJECT);
 
@@ -244,6 +247,17 @@ VectorBatch* ApplyProjectionAndFilter(CStoreScanState* node, VectorBatch* p_scan
             }
         }
 
+        // Drop the rows which can not match the hash join build side before
+        // the late read columns are decompressed.
+        //
+        if (node->m_runtimeFilterNum > 0) {
+            bf_removed_rows += exec_cstore_apply_runtime_filters(node, p_scan_batch, false);
+            if (p_scan_batch->m_rows == 0) {
+                p_out_batch->m_rows = 0;
+                goto done;
+            }
+        }
+
         // Late read these columns for non-delta data
         // Now we have finished filter check, and then we can read other columns
         //
@@ -251,6 +265,10 @@ VectorBatch* ApplyProjectionAndFilter(CStoreScanState* node, VectorBatch* p_scan
             VECCSTORE_SCAN_TRACE_START(node, FILL_LATER_BATCH);
             node->m_CStore->FillScanBatchLateIfNeed(p_scan_batch);
             VECCSTORE_SCAN_TRACE_END(node, FILL_LATER_BATCH);
+
+            if (node->m_runtimeFilterNum > 0) {
+                bf_removed_rows += exec_cstore_apply_runtime_filters(node, p_scan_batch, true);
+            }
         } else {
             node->ss_deltaScan = false;
         }
@@ -287,8 +305,9 @@ done:
 
     VECCSTORE_SCAN_TRACE_END(node, CSTORE_PROJECT);
 
-    // collect information of removed rows
-    InstrCountFiltered1(node, input_rows - p_out_batch->m_rows);
+    // collect information of removed rows, the bloom filter ones are reported apart
+    InstrCountFiltered1(node, input_rows - p_out_batch->m_rows - bf_removed_rows);
+    InstrCountFiltered2(node, bf_removed_rows);
 
     // Check fullness of return batch and refill it does not contain enough?
     return p_out_batch;
@@ -331,6 +350,15 @@ VectorBatch* ExecCStoreScan(CStoreScanState* node)
         node->m_ScanRunTimeKeysReady = true;
     }
 
+    // Hash join bloom filters are only ready once the build side is done,
+    // which is before the first batch of the probe side is asked for.
+    //
+    if (!node->m_runtimeFiltersReady) {
+        exec_cstore_collect_runtime_filters(node);
+        node->m_CStore->InitRuntimeFilterEnv(node);
+        node->m_runtimeFiltersReady = true;
+    }
+
     p_out_batch = node->m_pCurrentBatch;
     p_scan_batch = node->m_pScanBatch;
 
@@ -785,6 +813,9 @@ CStoreScanState* ExecInitCStoreScan(
     scan_stat->m_pScanRunTimeKeys = NULL;
     scan_stat->m_ScanRunTimeKeysNum = 0;
     scan_stat->m_ScanRunTimeKeysReady = false;
+    scan_stat->m_runtimeFilters = NULL;
+    scan_stat->m_runtimeFilterNum = 0;
+    scan_stat->m_runtimeFiltersReady = false;
     scan_stat->csss_ScanKeys = NULL;
     scan_stat->csss_NumScanKeys = 0;
 
@@ -1156,6 +1187,9 @@ void ExecReScanCStoreScan(CStoreScanState* node)
     }
     node->m_ScanRunTimeKeysReady = true;
 
+    /* the hash join may rebuild its bloom filters before the next scan */
+    node->m_runtimeFiltersReady = false;
+
     scan = (HeapScanDesc)node->ss_currentScanDesc;
     if (node->isPartTbl) {
         if (PointerIsValid(node->partitions)) {
@@ -1217,3 +1251,107 @@ static void exec_init_next_part4cstore_scan(CStoreScanState* node)
     /* reinit delta scan */
     InitScanDeltaRelation(node, node->ps.state->es_snapshot);
 }
+
+/*
+ * @Description: collect the hash join bloom filters marked on this scan by
+ *     the planner and built by the hash join. Only filters whose data type is
+ *     the same with the scanned column are used.
+ * @in node: cstore scan state
+ */
+static void exec_cstore_collect_runtime_filters(CStoreScanState* node)
+{
+    Plan* plan = node->ps.plan;
+    EState* estate = node->ps.state;
+    int bf_count = list_length(plan->var_list);
+    int num = 0;
+
+    node->m_runtimeFilterNum = 0;
+    if (!u_sess->attr.attr_sql.enable_bloom_filter || bf_count == 0 || estate->es_bloom_filter.bfarray == NULL ||
+        node->ss_currentRelation == NULL || node->isSampleScan) {
+        return;
+    }
+
+    Assert(bf_count == list_length(plan->filterIndexList));
+    if (node->m_runtimeFilters == NULL) {
+        node->m_runtimeFilters =
+            (CStoreRuntimeFilter*)MemoryContextAlloc(estate->es_query_cxt, sizeof(CStoreRuntimeFilter) * bf_count);
+    }
+
+    Form_pg_attribute* attrs = node->ss_currentRelation->rd_att->attrs;
+    List* accessed_vars = node->ps.ps_ProjInfo->pi_acessedVarNumbers;
+
+    for (int i = 0; i < bf_count; i++) {
+        Var* var = (Var*)list_nth(plan->var_list, i);
+        filter::BloomFilter* bf = estate->es_bloom_filter.bfarray[list_nth_int(plan->filterIndexList, i)];
+
+        if (bf == NULL || !IsA(var, Var) || var->varattno <= 0 ||
+            attrs[var->varattno - 1]->atttypid != bf->getDataType()) {
+            continue;
+        }
+
+        /* find the position of this column in the columns accessed by CStore */
+        int seq = 0;
+        ListCell* cell = NULL;
+        foreach (cell, accessed_vars) {
+            if (lfirst_int(cell) == var->varattno) {
+                break;
+            }
+            seq++;
+        }
+        if (cell == NULL) {
+            continue;
+        }
+
+        node->m_runtimeFilters[num].bf = bf;
+        node->m_runtimeFilters[num].seq = seq;
+        node->m_runtimeFilters[num].colIdx = var->varattno - 1;
+        node->m_runtimeFilters[num].lateRead = false;
+        num++;
+    }
+
+    node->m_runtimeFilterNum = num;
+}
+
+/*
+ * @Description: filter the scan batch by the runtime bloom filters. NULL keys
+ *     are kept since the join may treat NULL as equal.
+ * @in node: cstore scan state
+ * @in batch: scan batch to filter
+ * @in late_read: check the late read columns or the others. Delta data has no
+ *     late read column.
+ * @return: the number of rows removed from the batch.
+ */
+static int exec_cstore_apply_runtime_filters(CStoreScanState* node, VectorBatch* batch, bool late_read)
+{
+    bool* sel = batch->m_sel;
+    int removed = 0;
+    bool checked = false;
+
+    for (int i = 0; i < node->m_runtimeFilterNum; i++) {
+        CStoreRuntimeFilter* rf = &node->m_runtimeFilters[i];
+        bool is_late = rf->lateRead && !node->ss_deltaScan;
+
+        if (is_late != late_read) {
+            continue;
+        }
+
+        if (!checked) {
+            errno_t rc = memset_s(sel, sizeof(bool) * BatchMaxSize, true, sizeof(bool) * batch->m_rows);
+            securec_check(rc, "\0", "\0");
+            checked = true;
+        }
+
+        ScalarVector* vec = &batch->m_arr[rf->colIdx];
+        for (int row = 0; row < batch->m_rows; row++) {
+            if (sel[row] && NOT_NULL(vec->m_flag[row]) && !rf->bf->includeDatum(vec->m_vals[row])) {
+                sel[row] = false;
+                removed++;
+            }
+        }
+    }
+
+    if (removed > 0) {
+        batch->Pack(sel);
+    }
+    return removed;
+}
@@ -3723,6 +3723,18 @@ void HashJoinTbl::ResetNecessary()
         }
     }
 
+    /*
+     * The hash table is rebuilt, so the bloom filters pushed down from the old
+     * one must not be applied to the probe side any more. Clear their slots;
+     * the build pushes new ones down only if it still qualifies for them.
+     */
+    if (m_runtime->bf_runtime.bf_array != NULL) {
+        ListCell* lc = NULL;
+        foreach (lc, m_runtime->bf_runtime.bf_filter_index) {
+            m_runtime->bf_runtime.bf_array[lfirst_int(lc)] = NULL;
+        }
+    }
+
     MemoryContextResetAndDeleteChildren(m_hashContext);
 
     /*
@@ -30,8 +30,10 @@
 #include "utils/dynahash.h"
 #ifdef __aarch64__
 #include <arm_acle.h>
+#include <arm_neon.h>
 #else
 #include <nmmintrin.h>
+#include <immintrin.h>
 #endif
 
 extern bool anls_opt_is_on(AnalysisOpt dfx_opt);
@@ -96,6 +98,95 @@ uint32 hashquickany(uint32 seed, register const unsigned char* data, register in
     return crc;
 }
 
+/*
+ * @Description: Portable key comparison kernel, see SonicMatchKernel.
+ *	Branch free, so the compiler can vectorize it with the baseline ISA.
+ */
+static void SonicMatchInt64Keys(const int64* inner, const int64* outer, const uint8* notnull, bool* match, int nrows)
+{
+    for (int i = 0; i < nrows; i++) {
+        match[i] = (bool)((uint8)match[i] & notnull[i] & (uint8)(inner[i] == outer[i]));
+    }
+}
+
+#ifdef __aarch64__
+/*
+ * @Description: NEON key comparison kernel, four keys per step.
+ *	The lane masks are narrowed to one byte per key and combined with
+ *	the match and null flags as a single 32-bit word.
+ */
+static void SonicMatchInt64KeysNeon(
+    const int64* inner, const int64* outer, const uint8* notnull, bool* match, int nrows)
+{
+    int i = 0;
+
+    for (; i + 4 <= nrows; i += 4) {
+        uint64x2_t eq_lo = vceqq_s64(vld1q_s64(inner + i), vld1q_s64(outer + i));
+        uint64x2_t eq_hi = vceqq_s64(vld1q_s64(inner + i + 2), vld1q_s64(outer + i + 2));
+        uint16x4_t eq16 = vmovn_u32(vcombine_u32(vmovn_u64(eq_lo), vmovn_u64(eq_hi)));
+        uint8x8_t eq8 = vmovn_u16(vcombine_u16(eq16, eq16));
+        uint32 eq_word = vget_lane_u32(vreinterpret_u32_u8(eq8), 0) & 0x01010101;
+        uint32 match_word;
+        uint32 notnull_word;
+
+        memcpy(&match_word, match + i, sizeof(uint32));
+        memcpy(&notnull_word, notnull + i, sizeof(uint32));
+        match_word &= notnull_word & eq_word;
+        memcpy(match + i, &match_word, sizeof(uint32));
+    }
+
+    SonicMatchInt64Keys(inner + i, outer + i, notnull + i, match + i, nrows - i);
+}
+#elif defined(__x86_64__)
+/* one byte set to 1 for every bit of a four bit compare mask, little endian */
+static const uint32 sonic_mask_to_bytes[16] = {0x00000000, 0x00000001, 0x00000100, 0x00000101, 0x00010000,
+    0x00010001, 0x00010100, 0x00010101, 0x01000000, 0x01000001, 0x01000100, 0x01000101, 0x01010000, 0x01010001,
+    0x01010100, 0x01010101};
+
+/*
+ * @Description: AVX2 key comparison kernel, four keys per step.
+ *	Only called when the CPU supports AVX2, see SonicChooseMatchKernel.
+ */
+__attribute__((target("avx2"))) static void SonicMatchInt64KeysAvx2(
+    const int64* inner, const int64* outer, const uint8* notnull, bool* match, int nrows)
+{
+    int i = 0;
+
+    for (; i + 4 <= nrows; i += 4) {
+        __m256i eq = _mm256_cmpeq_epi64(
+            _mm256_loadu_si256((const __m256i*)(inner + i)), _mm256_loadu_si256((const __m256i*)(outer + i)));
+        uint32 eq_word = sonic_mask_to_bytes[_mm256_movemask_pd(_mm256_castsi256_pd(eq))];
+        uint32 match_word;
+        uint32 notnull_word;
+
+        memcpy(&match_word, match + i, sizeof(uint32));
+        memcpy(&notnull_word, notnull + i, sizeof(uint32));
+        match_word &= notnull_word & eq_word;
+        memcpy(match + i, &match_word, sizeof(uint32));
+    }
+
+    SonicMatchInt64Keys(inner + i, outer + i, notnull + i, match + i, nrows - i);
+}
+#endif
+
+/*
+ * @Description: Choose the key comparison kernel for the running CPU.
+ *	NEON is always present on aarch64, AVX2 is checked at runtime since
+ *	the server is built for the SSE4.2 baseline.
+ */
+SonicMatchKernel SonicChooseMatchKernel(void)
+{
+#ifdef __aarch64__
+    return SonicMatchInt64KeysNeon;
+#elif defined(__x86_64__)
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+
+    return has_avx2 ? SonicMatchInt64KeysAvx2 : SonicMatchInt64Keys;
+#else
+    return SonicMatchInt64Keys;
+#endif
+}
+
 /*
  * @Description: SonicHash constructor.
  * 	Create memory contexts and some general variables.
@@ -114,6 +205,7 @@ SonicHash::SonicHash(int size) : m_hash(0), m_atomSize(size), m_rows(0), m_selec
     m_stateLog.restore = false;
     m_eqfunctions = NULL;
     m_matchKey = NULL;
+    m_matchKernel = SonicChooseMatchKernel();
     m_data = NULL;
     m_bucket = NULL;
     m_hashSize = 0;
@@ -32,6 +32,32 @@
 #include "utils/dynahash.h"
 #include "utils/int8.h"
 
+#define leftrot(x, k) (((x) << (k)) | ((x) >> (32 - (k))))
+
+/* hash bits rotated per respill level, as sonic hash join does */
+#define RESPILL_ROT_BITS 10
+
+/*
+ * @Description	: Partition of a row spilled at the given level.
+ * @in key		: Rehashed hash value of the row.
+ * @in level		: Spill level, 0 for the first spill.
+ * @in partNum	: Number of partitions of the level, a power of 2.
+ * @return		: The partition index.
+ *
+ * All the rows of a level-n partition share the hash bits that picked it, so
+ * respilling them on the same bits would put them all into one partition and
+ * reread them pass after pass. Each level uses other bits instead.
+ */
+static inline uint16 calcSpillPartIdx(HashKey key, int level, uint16 partNum)
+{
+    uint32 rbit = (uint32)(level * RESPILL_ROT_BITS) % 32;
+
+    if (rbit != 0) {
+        key = leftrot(key, rbit);
+    }
+    return (uint16)(key & (partNum - 1));
+}
+
 /*
  * @Description	: Check if current aggref's expression is supported or not.
  * @in node		: Aggref's expression node.
@@ -361,6 +387,7 @@ SonicHashAgg::SonicHashAgg(VecAggState* runtime, int arrSize) : SonicHash(arrSiz
     m_tupleCount = m_colWidth = 0;
     m_enableExpansion = true;
     m_currPartIdx = -1;
+    m_spillLevel = 0;
     m_arrayElementSize = 0;
     m_arrayExpandSize = 0;
     m_segNum = 0;
@@ -868,6 +895,7 @@ bool SonicHashAgg::ResetNecessary(VecAggState* node)
     m_fill_table_rows = 0;
     m_partFileSource = NULL;
     m_overflowFileSource = NULL;
+    m_spillLevel = 0;
 
     m_memControl.availMem = 0;
     m_memControl.spillToDisk = false;
@@ -1155,6 +1183,7 @@ SonicHashSource* SonicHashAgg::GetHashSource()
                     /* reset current partition index */
                     m_currPartIdx = -1;
                     m_overflowNum = 0;
+                    m_spillLevel++;
 
                     return GetHashSource();
                 }
@@ -1853,7 +1882,7 @@ void SonicHashAgg::AllocHashTbl(VectorBatch* batch, int idx, uint32 hashval, int
              * mark which partition this element belongs to
              */
             HashKey key = DatumGetUInt32(hash_uint32(hashval));
-            part_idx = key & (m_partNum - 1);
+            part_idx = calcSpillPartIdx(key, 0, m_partNum);
 
             if (u_sess->attr.attr_sql.enable_sonic_optspill) {
                 for (int k = 0; k < m_partFileSource[part_idx]->m_cols; k++) {
@@ -1920,7 +1949,7 @@ void SonicHashAgg::AllocHashTbl(VectorBatch* batch, int idx, uint32 hashval, int
             /* Compute the hash value for tuple and resave to disk, first mark
              * which partition this element belongs to */
             HashKey key = DatumGetUInt32(hash_uint32(hashval));
-            part_idx = key & (m_overflowNum - 1);
+            part_idx = calcSpillPartIdx(key, m_spillLevel + 1, m_overflowNum);
 
             if (u_sess->attr.attr_sql.enable_sonic_optspill) {
                 for (int j = 0; j < m_overflowFileSource[part_idx]->m_cols; j++) {
@@ -51,6 +51,9 @@
  */
 #define GETLOCID(val, mask) ((val) & (mask))
 
+/* How many rows ahead bucket heads and chain links are prefetched */
+#define SONIC_PREFETCH_DISTANCE 16
+
 /*
  * @Description:  Check condition for sonic hash join.
  * 	If return value is true, goto Sonic hash join.
@@ -1178,6 +1181,10 @@ inline VectorBatch* SonicHashJoin::probeMemoryTable(SonicHashSource* probeP)
                     if (isSegHashTable) {
                         loc_id = (BucketType)mem_partition->m_segBucket->getNthDatum(GETLOCID(*loc3, mask));
                     } else {
+                        /* bucket heads are random accesses, start loading them early */
+                        if (i + SONIC_PREFETCH_DISTANCE < nrows) {
+                            __builtin_prefetch(&hashBucket[GETLOCID(loc3[SONIC_PREFETCH_DISTANCE], mask)]);
+                        }
                         loc_id = hashBucket[GETLOCID(*loc3, mask)];
                     }
 
@@ -1520,6 +1527,9 @@ inline VectorBatch* SonicHashJoin::innerJoin(VectorBatch* batch)
             if (isSegHashTable) {
                 loc_id = (BucketType)mem_partition->m_segNext->getNthDatum(*loc2++);
             } else {
+                if (i + SONIC_PREFETCH_DISTANCE < m_selectRows) {
+                    __builtin_prefetch(&hashNext[loc2[SONIC_PREFETCH_DISTANCE]]);
+                }
                 loc_id = hashNext[*loc2++];
             }
 
@@ -2541,25 +2551,25 @@ void SonicHashJoin::DispatchKeyOuterFunction(int KeyIdx)
             if (m_runtime->js.nulleqqual != NIL)
                 m_matchKey[KeyIdx] = &SonicHash::matchCheckColT<innerType, uint8, true, true>;
             else
-                m_matchKey[KeyIdx] = &SonicHash::matchCheckColT<innerType, uint8, true, false>;
+                m_matchKey[KeyIdx] = &SonicHash::matchIntKeyBatch<innerType, uint8>;
             break;
         case INT2OID:
             if (m_runtime->js.nulleqqual != NIL)
                 m_matchKey[KeyIdx] = &SonicHash::matchCheckColT<innerType, int16, true, true>;
             else
-                m_matchKey[KeyIdx] = &SonicHash::matchCheckColT<innerType, int16, true, false>;
+                m_matchKey[KeyIdx] = &SonicHash::matchIntKeyBatch<innerType, int16>;
             break;
         case INT4OID:
             if (m_runtime->js.nulleqqual != NIL)
                 m_matchKey[KeyIdx] = &SonicHash::matchCheckColT<innerType, int32, true, true>;
             else
-                m_matchKey[KeyIdx] = &SonicHash::matchCheckColT<innerType, int32, true, false>;
+                m_matchKey[KeyIdx] = &SonicHash::matchIntKeyBatch<innerType, int32>;
             break;
         case INT8OID:
             if (m_runtime->js.nulleqqual != NIL)
                 m_matchKey[KeyIdx] = &SonicHash::matchCheckColT<innerType, int64, true, true>;
             else
-                m_matchKey[KeyIdx] = &SonicHash::matchCheckColT<innerType, int64, true, false>;
+                m_matchKey[KeyIdx] = &SonicHash::matchIntKeyBatch<innerType, int64>;
             break;
         default:
             Assert(false);
@@ -2967,6 +2977,18 @@ void SonicHashJoin::ResetNecessary()
         return;
     }
 
+    /*
+     * The hash table is rebuilt, so the bloom filters pushed down from the old
+     * one must not be applied to the probe side any more. Clear their slots;
+     * the build pushes new ones down only if it still qualifies for them.
+     */
+    if (m_runtime->bf_runtime.bf_array != NULL) {
+        ListCell* lc = NULL;
+        foreach (lc, m_runtime->bf_runtime.bf_filter_index) {
+            m_runtime->bf_runtime.bf_array[lfirst_int(lc)] = NULL;
+        }
+    }
+
     if (m_strategy == GRACE_HASH)
         closeAllFiles();
 
@@ -64,6 +64,7 @@ static void ValidateStrOptSpcAddress(const char* val);
 static void ValidateStrOptSpcCfgPath(const char* val);
 static void ValidateStrOptSpcStorePath(const char* val);
 static void check_append_mode(const char* val);
+static void ValidateStrOptIndexMethod(const char* val);
 
 static relopt_bool boolRelOpts[] = {
     {{"autovacuum_enabled", "Enables autovacuum in this relation", RELOPT_KIND_HEAP | RELOPT_KIND_TOAST}, true},
@@ -251,6 +252,11 @@ static relopt_string string_rel_opts[] = {
         false,
         gistValidateBufferingOption,
         "auto"},
+    {{"index_method", "Index structure of a MOT table index, tree or hash", RELOPT_KIND_BTREE},
+        4,
+        false,
+        ValidateStrOptIndexMethod,
+        "tree"},
 
     {
         {"orientation", "row-store, col-store, orc-store or timeseries", RELOPT_KIND_HEAP},
@@ -1490,7 +1496,8 @@ bytea* default_reloptions(Datum reloptions, bool validate, relopt_kind kind)
         {"start_ctid_internal", RELOPT_TYPE_STRING, offsetof(StdRdOptions, start_ctid_internal)},
         {"end_ctid_internal", RELOPT_TYPE_STRING, offsetof(StdRdOptions, end_ctid_internal)},
         {"user_catalog_table", RELOPT_TYPE_BOOL, offsetof(StdRdOptions, user_catalog_table)},
-        {"hashbucket", RELOPT_TYPE_BOOL, offsetof(StdRdOptions, hashbucket)}};
+        {"hashbucket", RELOPT_TYPE_BOOL, offsetof(StdRdOptions, hashbucket)},
+        {"index_method", RELOPT_TYPE_STRING, offsetof(StdRdOptions, index_method)}};
 
     options = parseRelOptions(reloptions, validate, kind, &numoptions);
 
@@ -1736,6 +1743,19 @@ static void ValidateStrOptVersion(const char* val)
                 errdetail("Valid string are \"0.11\", \"0.12\".")));
     }
 }
+/*
+ * check parameter of index_method. Allows "tree" and "hash".
+ */
+static void ValidateStrOptIndexMethod(const char* val)
+{
+    if (val == NULL || (pg_strcasecmp(val, "tree") != 0 && pg_strcasecmp(val, "hash") != 0)) {
+        ereport(ERROR,
+            (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+                errmsg("invalid value for \"index_method\" option"),
+                errdetail("Valid values are \"tree\" and \"hash\".")));
+    }
+}
+
 /*
  * check parameter of append_mode . Allows "on", "off"
  * and "auto" values.
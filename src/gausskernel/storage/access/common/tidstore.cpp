@@ -0,0 +1,408 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * tidstore.cpp
+ *        compact store of heap TIDs, used by vacuum for the dead tuples
+ *
+ * All memory is allocated when the store is created.  The store is one
+ * arena: block entries (block number and where its offsets are) grow up
+ * from the start, and the encoded offsets grow down from the end, so the
+ * store is full exactly when the two meet, whatever the mix of sparse and
+ * dense pages.
+ *
+ * The offsets of a block are encoded as uint16 words: a header word, then
+ * either a bitmap with one bit per offset number (header has
+ * TIDSTORE_BITMAP_FLAG set and the number of bitmap words) or the sorted
+ * offsets themselves (header is their count), whichever is shorter.
+ *
+ * Block entries are sorted by block number.  A directory keeps, for every
+ * run of 2^chunk_shift heap blocks, the first entry of the run, so finding
+ * a block is a binary search over at most that many entries.  The TIDs of
+ * the block being filled are kept aside until the next block starts, which
+ * is when the encoding can be chosen.
+ *
+ * IDENTIFICATION
+ *        src/gausskernel/storage/access/common/tidstore.cpp
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include "access/tidstore.h"
+#include "utils/memutils.h"
+
+#define TIDSTORE_BITMAP_FLAG 0x8000
+
+/* words of a bitmap covering offsets up to maxoff, bit 0 is unused */
+#define TIDSTORE_BITMAP_WORDS(maxoff) ((maxoff) / 16 + 1)
+
+/* worst case size of one heap block: its entry plus header and bitmap */
+#define TIDSTORE_MAX_BLOCK_BYTES \
+    (sizeof(TidStoreBlock) + (1 + TIDSTORE_BITMAP_WORDS(MaxHeapTuplesPerPage)) * sizeof(uint16))
+
+/* smallest run of heap blocks per directory slot, and the largest */
+#define TIDSTORE_MIN_CHUNK_SHIFT 6
+#define TIDSTORE_MAX_CHUNK_SHIFT 12
+
+/* word offsets into the arena are 32 bits */
+#define TIDSTORE_MAX_ARENA ((Size)PG_UINT32_MAX)
+
+typedef struct TidStoreBlock {
+    BlockNumber blkno;
+    uint32 data; /* word offset of the encoded offsets in the arena */
+} TidStoreBlock;
+
+struct TidStore {
+    char* arena;
+    Size arena_size;
+    Size data_start; /* byte offset of the lowest encoded block */
+    int nblocks;     /* block entries at the start of the arena */
+
+    /* directory: chunks[c] is the first entry with blkno >= c << chunk_shift */
+    uint32* chunks;
+    uint32 nchunks;
+    uint32 filled_chunks;
+    int chunk_shift;
+
+    /* TIDs of the block being filled */
+    BlockNumber cur_blkno;
+    int ncur;
+    OffsetNumber cur[MaxHeapTuplesPerPage];
+
+    int64 num_tids;
+    int last_block; /* entry found by the last lookup, index AMs probe in TID order */
+};
+
+#define TidStoreBlocks(ts) ((TidStoreBlock*)(ts)->arena)
+#define TidStoreData(ts, blk) ((uint16*)(ts)->arena + (blk)->data)
+
+/*
+ * TidStoreCreate - make a store using at most max_bytes for TIDs of a
+ * relation of nblocks blocks
+ *
+ * The store never takes more than the relation could need, and always
+ * takes enough for two heap pages.
+ */
+TidStore* TidStoreCreate(Size max_bytes, BlockNumber nblocks)
+{
+    TidStore* ts = (TidStore*)palloc0(sizeof(TidStore));
+    Size dir_bytes;
+    Size arena_size;
+
+    /* keep the directory to an eighth of the budget */
+    ts->chunk_shift = TIDSTORE_MIN_CHUNK_SHIFT;
+    ts->nchunks = (nblocks >> ts->chunk_shift) + 1;
+    while (ts->chunk_shift < TIDSTORE_MAX_CHUNK_SHIFT && ts->nchunks * sizeof(uint32) > max_bytes / 8) {
+        ts->chunk_shift++;
+        ts->nchunks = (nblocks >> ts->chunk_shift) + 1;
+    }
+    dir_bytes = ts->nchunks * sizeof(uint32);
+    ts->chunks = (uint32*)palloc_huge(CurrentMemoryContext, dir_bytes);
+
+    arena_size = (max_bytes > dir_bytes) ? max_bytes - dir_bytes : 0;
+    arena_size = Min(arena_size, (Size)nblocks * TIDSTORE_MAX_BLOCK_BYTES);
+    arena_size = Max(arena_size, 2 * TIDSTORE_MAX_BLOCK_BYTES);
+    arena_size = Min(arena_size, TIDSTORE_MAX_ARENA);
+    arena_size -= arena_size % sizeof(uint16);
+
+    ts->arena = (char*)palloc_huge(CurrentMemoryContext, arena_size);
+    ts->arena_size = arena_size;
+
+    TidStoreReset(ts);
+    return ts;
+}
+
+void TidStoreDestroy(TidStore* ts)
+{
+    pfree_ext(ts->arena);
+    pfree_ext(ts->chunks);
+    pfree(ts);
+}
+
+/* forget all TIDs, keeping the memory */
+void TidStoreReset(TidStore* ts)
+{
+    ts->data_start = ts->arena_size;
+    ts->nblocks = 0;
+    ts->filled_chunks = 0;
+    ts->cur_blkno = InvalidBlockNumber;
+    ts->ncur = 0;
+    ts->num_tids = 0;
+    ts->last_block = -1;
+}
+
+/*
+ * Encode the block being filled and add its entry.  If it does not fit
+ * its TIDs are forgotten, like the old dead tuple array did on overflow;
+ * callers check TidStoreIsFull before each heap page so this should not
+ * happen.
+ */
+static void TidStoreSealBlock(TidStore* ts)
+{
+    TidStoreBlock* blk = NULL;
+    uint16* data = NULL;
+    int bitmap_words;
+    int words;
+    uint32 c;
+
+    if (ts->ncur == 0)
+        return;
+
+    bitmap_words = TIDSTORE_BITMAP_WORDS(ts->cur[ts->ncur - 1]);
+    words = 1 + Min(ts->ncur, bitmap_words);
+
+    if ((Size)(ts->nblocks + 1) * sizeof(TidStoreBlock) + words * sizeof(uint16) > ts->data_start) {
+        ts->num_tids -= ts->ncur;
+        ts->ncur = 0;
+        return;
+    }
+
+    ts->data_start -= words * sizeof(uint16);
+    blk = &TidStoreBlocks(ts)[ts->nblocks];
+    blk->blkno = ts->cur_blkno;
+    blk->data = (uint32)(ts->data_start / sizeof(uint16));
+    data = TidStoreData(ts, blk);
+
+    if (ts->ncur < bitmap_words) {
+        data[0] = (uint16)ts->ncur;
+        for (int i = 0; i < ts->ncur; i++)
+            data[i + 1] = ts->cur[i];
+    } else {
+        data[0] = (uint16)(TIDSTORE_BITMAP_FLAG | bitmap_words);
+        for (int i = 1; i <= bitmap_words; i++)
+            data[i] = 0;
+        for (int i = 0; i < ts->ncur; i++)
+            data[1 + ts->cur[i] / 16] |= (uint16)(1 << (ts->cur[i] % 16));
+    }
+
+    c = ts->cur_blkno >> ts->chunk_shift;
+    for (; ts->filled_chunks <= c; ts->filled_chunks++)
+        ts->chunks[ts->filled_chunks] = (uint32)ts->nblocks;
+    ts->nblocks++;
+    ts->ncur = 0;
+}
+
+/*
+ * TidStoreAddTid - remember one TID
+ *
+ * TIDs must be added in ascending order, and the block must lie within the
+ * relation size given at creation.
+ */
+void TidStoreAddTid(TidStore* ts, ItemPointer tid)
+{
+    BlockNumber blkno = ItemPointerGetBlockNumber(tid);
+    OffsetNumber off = ItemPointerGetOffsetNumber(tid);
+
+    if (off < FirstOffsetNumber || off > MaxHeapTuplesPerPage)
+        ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE), errmsg("invalid offset number %u", off)));
+    if ((blkno >> ts->chunk_shift) >= ts->nchunks)
+        ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE), errmsg("block number %u out of range", blkno)));
+
+    if (blkno != ts->cur_blkno) {
+        Assert(ts->cur_blkno == InvalidBlockNumber || blkno > ts->cur_blkno);
+        TidStoreSealBlock(ts);
+        ts->cur_blkno = blkno;
+    }
+
+    Assert(ts->ncur == 0 || off > ts->cur[ts->ncur - 1]);
+    ts->cur[ts->ncur++] = off;
+    ts->num_tids++;
+}
+
+/*
+ * TidStoreIsFull - true if the TIDs of one more heap page might not fit
+ */
+bool TidStoreIsFull(const TidStore* ts)
+{
+    Size used = (Size)ts->nblocks * sizeof(TidStoreBlock) + (ts->arena_size - ts->data_start);
+    Size needed = (ts->ncur > 0) ? 2 * TIDSTORE_MAX_BLOCK_BYTES : TIDSTORE_MAX_BLOCK_BYTES;
+
+    return used + needed > ts->arena_size;
+}
+
+/* find the entry of a sealed block, -1 if it has no TIDs */
+static inline int TidStoreFindBlock(TidStore* ts, BlockNumber blkno)
+{
+    TidStoreBlock* blocks = TidStoreBlocks(ts);
+    uint32 c = blkno >> ts->chunk_shift;
+    int lo;
+    int hi;
+
+    if (ts->last_block >= 0 && blocks[ts->last_block].blkno == blkno)
+        return ts->last_block;
+    if (c >= ts->filled_chunks)
+        return -1;
+
+    lo = (int)ts->chunks[c];
+    hi = (c + 1 < ts->filled_chunks) ? (int)ts->chunks[c + 1] : ts->nblocks;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+
+        if (blocks[mid].blkno < blkno)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    if (lo < ts->nblocks && blocks[lo].blkno == blkno) {
+        ts->last_block = lo;
+        return lo;
+    }
+    return -1;
+}
+
+static inline bool TidStoreOffsetInArray(const uint16* offsets, int n, OffsetNumber off)
+{
+    int lo = 0;
+    int hi = n;
+
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+
+        if (offsets[mid] < off)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return (lo < n && offsets[lo] == off);
+}
+
+/*
+ * TidStoreIsMember - is tid in the store?
+ *
+ * Index vacuum calls this once per index tuple, through the bulk delete
+ * callback, so it must stay cheap.
+ */
+bool TidStoreIsMember(TidStore* ts, ItemPointer tid)
+{
+    BlockNumber blkno = ItemPointerGetBlockNumber(tid);
+    OffsetNumber off = ItemPointerGetOffsetNumber(tid);
+    const uint16* data = NULL;
+    int idx;
+
+    if (blkno == ts->cur_blkno && ts->ncur > 0)
+        return TidStoreOffsetInArray(ts->cur, ts->ncur, off);
+
+    idx = TidStoreFindBlock(ts, blkno);
+    if (idx < 0)
+        return false;
+
+    data = TidStoreData(ts, &TidStoreBlocks(ts)[idx]);
+    if (data[0] & TIDSTORE_BITMAP_FLAG) {
+        if ((int)(off / 16) >= (data[0] & ~TIDSTORE_BITMAP_FLAG))
+            return false;
+        return (data[1 + off / 16] & (1 << (off % 16))) != 0;
+    }
+    return TidStoreOffsetInArray(data + 1, data[0], off);
+}
+
+/* decode the offsets of the idx'th entry, returns their number */
+static int TidStoreDecodeBlock(TidStore* ts, int idx, OffsetNumber* offsets)
+{
+    const uint16* data = TidStoreData(ts, &TidStoreBlocks(ts)[idx]);
+    int n = 0;
+
+    if (data[0] & TIDSTORE_BITMAP_FLAG) {
+        int words = data[0] & ~TIDSTORE_BITMAP_FLAG;
+
+        for (int w = 0; w < words; w++) {
+            uint16 bits = data[1 + w];
+
+            while (bits != 0) {
+                int bit = __builtin_ctz(bits);
+
+                offsets[n++] = (OffsetNumber)(w * 16 + bit);
+                bits &= bits - 1;
+            }
+        }
+    } else {
+        n = data[0];
+        for (int i = 0; i < n; i++)
+            offsets[i] = data[i + 1];
+    }
+    return n;
+}
+
+/*
+ * TidStoreGetBlockOffsets - fetch the offsets stored for one block, in
+ * ascending order
+ *
+ * offsets must have room for MaxHeapTuplesPerPage entries.
+ */
+int TidStoreGetBlockOffsets(TidStore* ts, BlockNumber blkno, OffsetNumber* offsets)
+{
+    int idx;
+
+    if (blkno == ts->cur_blkno && ts->ncur > 0) {
+        for (int i = 0; i < ts->ncur; i++)
+            offsets[i] = ts->cur[i];
+        return ts->ncur;
+    }
+
+    idx = TidStoreFindBlock(ts, blkno);
+    return (idx < 0) ? 0 : TidStoreDecodeBlock(ts, idx, offsets);
+}
+
+/*
+ * TidStoreBeginIterate/TidStoreIterateNext - visit the blocks in ascending
+ * order
+ *
+ * The store must not be changed during the iteration.  offsets must have
+ * room for MaxHeapTuplesPerPage entries.
+ */
+void TidStoreBeginIterate(TidStore* ts, TidStoreIter* iter)
+{
+    iter->store = ts;
+    iter->next_block = 0;
+}
+
+bool TidStoreIterateNext(TidStoreIter* iter, BlockNumber* blkno, OffsetNumber* offsets, int* noffsets)
+{
+    TidStore* ts = iter->store;
+
+    if (iter->next_block < ts->nblocks) {
+        *blkno = TidStoreBlocks(ts)[iter->next_block].blkno;
+        *noffsets = TidStoreDecodeBlock(ts, iter->next_block, offsets);
+        iter->next_block++;
+        return true;
+    }
+
+    /* the block being filled comes last */
+    if (iter->next_block == ts->nblocks && ts->ncur > 0) {
+        *blkno = ts->cur_blkno;
+        *noffsets = TidStoreGetBlockOffsets(ts, ts->cur_blkno, offsets);
+        iter->next_block++;
+        return true;
+    }
+    return false;
+}
+
+int64 TidStoreNumTids(const TidStore* ts)
+{
+    return ts->num_tids;
+}
+
+/* bytes of the arena in use plus the directory, the block being filled is not counted */
+Size TidStoreMemoryUsage(const TidStore* ts)
+{
+    return (Size)ts->nblocks * sizeof(TidStoreBlock) + (ts->arena_size - ts->data_start) +
+           ts->nchunks * sizeof(uint32);
+}
+
+/* bytes the store was created with */
+Size TidStoreMaxMemory(const TidStore* ts)
+{
+    return ts->arena_size + ts->nchunks * sizeof(uint32);
+}
@@ -45,6 +45,7 @@
 #include "libpq/pqsignal.h"
 #include "postmaster/postmaster.h"
 #include "storage/ipc.h"
+#include "storage/bufmgr.h"
 #include "storage/freespace.h"
 #include "storage/smgr.h"
 #include "access/nbtree.h"
@@ -434,6 +435,64 @@ void SubRefRecord(void* rec)
     }
 }
 
+#ifdef USE_PREFETCH
+/* the block prefetched last by this batch redo thread */
+static THR_LOCAL RelFileNode g_lastPrefetchNode;
+static THR_LOCAL ForkNumber g_lastPrefetchFork = InvalidForkNumber;
+static THR_LOCAL BlockNumber g_lastPrefetchBlock = InvalidBlockNumber;
+
+/*
+ * The batch redo thread runs ahead of the page redo workers of its pipeline,
+ * so hint the kernel about the data pages the workers are going to read.
+ * Blocks restored from a full page image or initialized by redo are never
+ * read, and blocks of other pipelines are prefetched by their own thread.
+ */
+static void BatchRedoPrefetchBlocks(XLogReaderState* record)
+{
+    for (int i = 0; i <= record->max_block_id; i++) {
+        DecodedBkpBlock* block = &record->blocks[i];
+
+        if (!block->in_use || block->has_image || (block->flags & BKPBLOCK_WILL_INIT)) {
+            continue;
+        }
+        if (GetSlotId(block->rnode, 0, 0, GetBatchCount()) != g_redoWorker->slotId) {
+            continue;
+        }
+
+        /* consecutive records often modify the same page */
+        if (block->blkno == g_lastPrefetchBlock && block->forknum == g_lastPrefetchFork &&
+            RelFileNodeEquals(block->rnode, g_lastPrefetchNode)) {
+            continue;
+        }
+
+        PrefetchSharedBuffer(smgropen(block->rnode, InvalidBackendId), block->forknum, block->blkno);
+        g_lastPrefetchNode = block->rnode;
+        g_lastPrefetchFork = block->forknum;
+        g_lastPrefetchBlock = block->blkno;
+    }
+}
+
+/*
+ * Files opened for prefetch must not keep dropped relations alive, so close
+ * them all whenever a record may remove relation files.
+ */
+static void BatchRedoClosePrefetchFilesIfNeed(XLogRecParseState* parsestate)
+{
+    for (XLogRecParseState* state = parsestate; state != NULL; state = (XLogRecParseState*)state->nextrecord) {
+        switch (XLogBlockHeadGetValidInfo(&state->blockparse.blockhead)) {
+            case BLOCK_DATA_DDL_TYPE:
+            case BLOCK_DATA_DROP_DATABASE_TYPE:
+            case BLOCK_DATA_DROP_TBLSPC_TYPE:
+                smgrcloseall();
+                g_lastPrefetchBlock = InvalidBlockNumber;
+                return;
+            default:
+                break;
+        }
+    }
+}
+#endif
+
 bool BatchRedoParseItemAndDispatch(RedoItem* item)
 {
     uint32 blockNum = 0;
@@ -445,6 +504,10 @@ bool BatchRedoParseItemAndDispatch(RedoItem* item)
         return true; /*  out of mem */
     }
 
+#ifdef USE_PREFETCH
+    BatchRedoClosePrefetchFilesIfNeed(recordblockstate);
+#endif
+
     PageRedoPipeline* myRedoLine = &g_dispatcher->pageLines[g_redoWorker->slotId];
     AddPageRedoItem(myRedoLine->managerThd, recordblockstate);
     return false;
@@ -477,6 +540,10 @@ bool BatchRedoDistributeItems(void** eleArry, uint32 eleNum)
             RedoItem* item = (RedoItem*)eleArry[i];
             UpdateRecordGlobals(item, g_redoWorker->standbyState);
 
+#ifdef USE_PREFETCH
+            BatchRedoPrefetchBlocks(&item->record);
+#endif
+
             do {
                 parsecomplete = BatchRedoParseItemAndDispatch(item);
             } while (parsecomplete);
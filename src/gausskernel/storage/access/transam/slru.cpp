@@ -107,6 +107,69 @@ typedef struct SlruFlushData* SlruFlush;
     }                                                        \
 } while (0)
 
+/* page_hash_next[] marker of a slot that was never assigned a page, chains end with -1 */
+#define SLRU_SLOT_UNMAPPED (-2)
+
+/*
+ * Multiplicative hash of a page number.  The low bits alone won't do: the
+ * CLOG and CSNLOG partitions pick their SLRU by pageno modulo the partition
+ * count, so all pages of one partition share them.
+ */
+#define SlruPageHash(shared, pageno) \
+    ((int)((((uint64)(pageno) * UINT64CONST(0x9E3779B97F4A7C15)) >> 32) & (uint64)(shared)->page_hash_mask))
+
+/* number of page-to-slot hash chains: a power of 2 of at least twice the slot count */
+static int SlruPageHashSize(int nslots)
+{
+    int nbuckets = 1;
+
+    while (nbuckets < nslots * 2)
+        nbuckets <<= 1;
+    return nbuckets;
+}
+
+/*
+ * Find the slot holding (or reading in) a page, or -1 if it has no buffer.
+ *
+ * Control lock must be held, shared is enough since chains only change under
+ * exclusive lock.
+ */
+static inline int SlruLookupSlot(SlruShared shared, int64 pageno)
+{
+    int slotno = shared->page_hash_head[SlruPageHash(shared, pageno)];
+
+    while (slotno >= 0) {
+        if (shared->page_number[slotno] == pageno && shared->page_status[slotno] != SLRU_PAGE_EMPTY)
+            return slotno;
+        slotno = shared->page_hash_next[slotno];
+    }
+    return -1;
+}
+
+/*
+ * Set a slot's page number and move it to the hash chain of the new page.
+ *
+ * Control lock must be held in exclusive mode.
+ */
+static void SlruAssignSlot(SlruShared shared, int slotno, int64 pageno)
+{
+    if (shared->page_hash_next[slotno] != SLRU_SLOT_UNMAPPED) {
+        int* link = &shared->page_hash_head[SlruPageHash(shared, shared->page_number[slotno])];
+
+        while (*link != slotno) {
+            Assert(*link >= 0);
+            link = &shared->page_hash_next[*link];
+        }
+        *link = shared->page_hash_next[slotno];
+    }
+
+    shared->page_number[slotno] = pageno;
+
+    int bucket = SlruPageHash(shared, pageno);
+    shared->page_hash_next[slotno] = shared->page_hash_head[bucket];
+    shared->page_hash_head[bucket] = slotno;
+}
+
 static void SimpleLruZeroLSNs(SlruCtl ctl, int slotno);
 static void SlruInternalWritePage(SlruCtl ctl, int slotno, SlruFlush fdata);
 static bool SlruPhysicalReadPage(SlruCtl ctl, int64 pageno, int slotno);
@@ -120,13 +183,11 @@ static inline int execSimpleLruReadPageReadOnly(SlruCtl ctl, int64 pageno, Trans
     int slotno;
 
     /* See if page is already in a buffer */
-    for (slotno = 0; slotno < shared->num_slots; slotno++) {
-        if (shared->page_number[slotno] == pageno && shared->page_status[slotno] != SLRU_PAGE_EMPTY &&
-            shared->page_status[slotno] != SLRU_PAGE_READ_IN_PROGRESS) {
-            /* See comments for SlruRecentlyUsed macro */
-            SlruRecentlyUsed(shared, slotno);
-            return slotno;
-        }
+    slotno = SlruLookupSlot(shared, pageno);
+    if (slotno >= 0 && shared->page_status[slotno] != SLRU_PAGE_READ_IN_PROGRESS) {
+        /* See comments for SlruRecentlyUsed macro */
+        SlruRecentlyUsed(shared, slotno);
+        return slotno;
     }
     /* No luck, so switch to normal exclusive lock and do regular read */
     LWLockRelease(shared->control_lock);
@@ -147,6 +208,8 @@ Size SimpleLruShmemSize(int nslots, int nlsns)
     sz += MAXALIGN(nslots * sizeof(int64));          /* page_number[] */
     sz += MAXALIGN(nslots * sizeof(int));            /* page_lru_count[] */
     sz += MAXALIGN(nslots * sizeof(LWLock*));        /* buffer_locks[] */
+    sz += MAXALIGN(SlruPageHashSize(nslots) * sizeof(int)); /* page_hash_head[] */
+    sz += MAXALIGN(nslots * sizeof(int));                   /* page_hash_next[] */
 
     if (nlsns > 0)
         sz += MAXALIGN(nslots * nlsns * sizeof(XLogRecPtr)); /* group_lsn[] */
@@ -195,6 +258,14 @@ void SimpleLruInit(
         offset += MAXALIGN(nslots * sizeof(int));
         shared->buffer_locks = (LWLock**)(ptr + offset);
         offset += MAXALIGN(nslots * sizeof(LWLock*));
+        shared->page_hash_head = (int*)(ptr + offset);
+        offset += MAXALIGN(SlruPageHashSize(nslots) * sizeof(int));
+        shared->page_hash_next = (int*)(ptr + offset);
+        offset += MAXALIGN(nslots * sizeof(int));
+        shared->page_hash_mask = SlruPageHashSize(nslots) - 1;
+
+        for (int bucket = 0; bucket <= shared->page_hash_mask; bucket++)
+            shared->page_hash_head[bucket] = -1;
 
         if (nlsns > 0) {
             shared->group_lsn = (XLogRecPtr*)(ptr + offset);
@@ -208,6 +279,7 @@ void SimpleLruInit(
             shared->page_status[slotno] = SLRU_PAGE_EMPTY;
             shared->page_dirty[slotno] = false;
             shared->page_lru_count[slotno] = 0;
+            shared->page_hash_next[slotno] = SLRU_SLOT_UNMAPPED;
             shared->buffer_locks[slotno] = LWLockAssign(trancheId);
             ptr += BLCKSZ;
         }
@@ -281,7 +353,7 @@ int SimpleLruZeroPage(SlruCtl ctl, int64 pageno, bool* pBZeroPage)
                     errhint("Try it again.")));
 
         /* Mark the slot as containing this page */
-        shared->page_number[slotno] = pageno;
+        SlruAssignSlot(shared, slotno, pageno);
         shared->page_status[slotno] = SLRU_PAGE_VALID;
         shared->page_dirty[slotno] = true;
         SlruRecentlyUsed(shared, slotno);
@@ -426,7 +498,7 @@ int SimpleLruReadPage(SlruCtl ctl, int64 pageno, bool write_ok, TransactionId xi
                         xid)));
 
         /* Mark the slot read-busy */
-        shared->page_number[slotno] = pageno;
+        SlruAssignSlot(shared, slotno, pageno);
         shared->page_status[slotno] = SLRU_PAGE_READ_IN_PROGRESS;
         shared->page_dirty[slotno] = false;
 
@@ -968,10 +1040,9 @@ static int SlruSelectLRUPage(SlruCtl ctl, int64 pageno)
         int64 best_invalid_page_number = 0; /* keep compiler quiet */
 
         /* See if page already has a buffer assigned */
-        for (slotno = 0; slotno < shared->num_slots; slotno++) {
-            if (shared->page_number[slotno] == pageno && shared->page_status[slotno] != SLRU_PAGE_EMPTY)
-                return slotno;
-        }
+        slotno = SlruLookupSlot(shared, pageno);
+        if (slotno >= 0)
+            return slotno;
 
         /*
          * If we find any EMPTY slot, just select that one. Else choose a
@@ -3655,6 +3655,7 @@ static void AbortTransaction(bool PerfectRollback = false)
 
     /* Clear wait information */
     pgstat_report_waitevent(WAIT_EVENT_END);
+    pgstat_progress_vacuum_end();
 
     /* Clean up buffer I/O and buffer context locks, too */
     AbortBufferIO();
@@ -5943,6 +5944,7 @@ static void AbortSubTransaction(void)
 
     /* Clear wait information */
     pgstat_report_waitevent(WAIT_EVENT_END);
+    pgstat_progress_vacuum_end();
 
     AbortBufferIO();
     UnlockBuffers();
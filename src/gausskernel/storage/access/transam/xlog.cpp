@@ -1944,6 +1944,57 @@ static char* GetXLogBuffer(XLogRecPtr ptr, PGPROC* proc)
 template static char* GetXLogBuffer<true>(XLogRecPtr, PGPROC*);
 template static char* GetXLogBuffer<false>(XLogRecPtr, PGPROC*);
 
+/*
+ * Copy WAL from the WAL buffers, for as long as it is still there.
+ *
+ * Reads up to 'count' bytes starting at 'startptr' into 'buf', and returns how
+ * many were read; the rest, if any, has been evicted and must be read from the
+ * segment files.  The caller must only ask for WAL that is already inserted,
+ * e.g. below the flush pointer.
+ *
+ * No lock is taken.  A buffer page is only trusted if xlblocks shows the page
+ * we want both before and after copying it: AdvanceXLInsertBuffer invalidates
+ * xlblocks before it starts reusing a buffer.
+ */
+Size XLogReadFromBuffers(char* buf, XLogRecPtr startptr, Size count)
+{
+    XLogCtlData* xlogctl = t_thrd.shemem_ptr_cxt.XLogCtl;
+    XLogRecPtr recptr = startptr;
+    Size nread = 0;
+
+    /* during recovery the buffers do not hold the WAL being replayed */
+    if (RecoveryInProgress()) {
+        return 0;
+    }
+
+    while (nread < count) {
+        int idx = XLogRecPtrToBufIdx(recptr);
+        Size offset = recptr % XLOG_BLCKSZ;
+        Size nbytes = Min(count - nread, XLOG_BLCKSZ - offset);
+        XLogRecPtr expectedEndPtr = recptr - offset + XLOG_BLCKSZ;
+
+        if (*((volatile XLogRecPtr*)&xlogctl->xlblocks[idx]) != expectedEndPtr) {
+            break;
+        }
+        /* read xlblocks before the page contents */
+        pg_read_barrier();
+
+        errno_t rc = memcpy_s(buf + nread, nbytes, xlogctl->pages + idx * (Size)XLOG_BLCKSZ + offset, nbytes);
+        securec_check(rc, "", "");
+
+        /* and the page contents before checking they were not replaced meanwhile */
+        pg_read_barrier();
+        if (*((volatile XLogRecPtr*)&xlogctl->xlblocks[idx]) != expectedEndPtr) {
+            break;
+        }
+
+        nread += nbytes;
+        recptr += nbytes;
+    }
+
+    return nread;
+}
+
 /*
  * Converts a "usable byte position" to XLogRecPtr. A usable byte position
  * is the position starting from the beginning of WAL, excluding all WAL
@@ -2419,6 +2470,13 @@ static void AdvanceXLInsertBuffer(XLogRecPtr upto, bool opportunistic, PGPROC* p
 
         NewPage = (XLogPageHeader)(t_thrd.shemem_ptr_cxt.XLogCtl->pages + nextidx * (Size)XLOG_BLCKSZ);
 
+        /*
+         * Mark the buffer as holding no page before reusing it, so that
+         * XLogReadFromBuffers() cannot take the new contents for the old page.
+         */
+        *((volatile XLogRecPtr*)&t_thrd.shemem_ptr_cxt.XLogCtl->xlblocks[nextidx]) = InvalidXLogRecPtr;
+        pg_write_barrier();
+
         /*
          * Be sure to re-zero the buffer so that bytes beyond what we've
          * written will look like zeroes and not valid XLOG records...
@@ -5519,8 +5577,9 @@ XLogRecord* ParallelReadRecord(
     }
 
     if (doDecode) {
+        /* decoding may expand a compressed record into a new buffer */
         if (DecodeXLogRecord(state, record, errormsg, readoldversion)) {
-            return record;
+            return state->decoded_record;
         } else
             return NULL;
     } else
@@ -32,6 +32,7 @@
 #include "utils/memutils.h"
 #include "utils/guc.h"
 #include "pg_trace.h"
+#include "portability/instr_time.h"
 #include "replication/logical.h"
 #include "lz4.h"
 
@@ -56,13 +57,15 @@ typedef struct registered_buffer {
     char compressed_page[BLCKSZ]; /* buffer to store a compressed version of backup block image */
 } registered_buffer;
 
-#define HEADER_SCRATCH_SIZE \
-    (SizeOfXLogRecord + MaxSizeOfXLogRecordBlockHeader * (XLR_MAX_BLOCK_ID + 1) + SizeOfXLogRecordDataHeaderLong)
+#define HEADER_SCRATCH_SIZE                                                                           \
+    (SizeOfXLogRecord + SizeOfXLogRecordCompressHeader + MaxSizeOfXLogRecordBlockHeader * (XLR_MAX_BLOCK_ID + 1) + \
+     SizeOfXLogRecordDataHeaderLong)
 
 static XLogRecData* XLogRecordAssemble(
     RmgrId rmid, uint8 info, XLogFPWInfo fpw_info, XLogRecPtr* fpw_lsn, bool isupgrade = false, int bucket_id = -1);
 static void XLogResetLogicalPage(void);
 static bool XLogCompressBackupBlock(char *page, uint16 holeOffset, uint16 holeLength, char *dest, uint16 *dlen);
+static void XLogCompressRecordPayload(RmgrId rmid, uint32 hdrLen, uint32* total_len);
 
 /*
  * Begin constructing a WAL record. This must be called before the
@@ -782,6 +785,12 @@ static XLogRecData* XLogRecordAssemble(
     t_thrd.xlog_cxt.ptr_hdr_rdt->len = (scratch - t_thrd.xlog_cxt.hdr_scratch);
     total_len += t_thrd.xlog_cxt.ptr_hdr_rdt->len;
 
+    /* Try to compress the whole payload if it is large enough */
+    if (!isupgrade && u_sess->attr.attr_storage.wal_compression &&
+        u_sess->attr.attr_storage.wal_compression_threshold > 0) {
+        XLogCompressRecordPayload(rmid, t_thrd.xlog_cxt.ptr_hdr_rdt->len, &total_len);
+    }
+
     /*
      * When read record with randAccess mode, we don't kown the record's total_len
      * is valid or not, so do a rough check, it can not beyond XLogSegSize.
@@ -894,6 +903,115 @@ static bool XLogCompressBackupBlock(char *page, uint16 holeOffset, uint16 holeLe
     return false;
 }
 
+/*
+ * Compress the payload of the record being assembled, if it is worth it.
+ *
+ * The payload is everything linked after the header rdata: block images,
+ * block data and main data. It is gathered into a contiguous buffer and
+ * compressed with LZ4 as one unit. On success the payload chain is replaced
+ * by a single rdata holding the compressed bytes, an XLogRecordCompressHeader
+ * is inserted in front of the fragment headers and *total_len is updated.
+ * Otherwise the record is left untouched.
+ *
+ * XLOG resource manager records are never compressed, because checkpoint and
+ * switch records are recognized by their length while reading WAL.
+ */
+static void XLogCompressRecordPayload(RmgrId rmid, uint32 hdrLen, uint32* total_len)
+{
+    XLogRecData* hdr_rdt = t_thrd.xlog_cxt.ptr_hdr_rdt;
+    XLogRecData* payload_rdt = t_thrd.xlog_cxt.ptr_payload_rdt;
+    uint32 payloadLen = *total_len - hdrLen;
+    uint32 offset = 0;
+    int compressedLen;
+    instr_time startTime;
+    instr_time duration;
+    errno_t rc = EOK;
+
+    if (rmid == RM_XLOG_ID || payloadLen < (uint32)u_sess->attr.attr_storage.wal_compression_threshold) {
+        return;
+    }
+
+    /*
+     * The work areas grow to the largest payload seen, like readRecordBuf on
+     * the reading side. We may be in a critical section here, so don't fail
+     * if they can't be allocated, just leave the payload uncompressed.
+     */
+    if (t_thrd.xlog_cxt.payload_scratch_size < payloadLen) {
+        uint32 newSize = Max(payloadLen, XLR_COMPRESS_SCRATCH_SIZE);
+        newSize += BLCKSZ - (newSize % BLCKSZ);
+
+        MemoryContext oldcxt = MemoryContextSwitchTo(t_thrd.xlog_cxt.xloginsert_cxt);
+        char* buf = (char*)palloc_extended((Size)newSize * 2, MCXT_ALLOC_NO_OOM);
+        (void)MemoryContextSwitchTo(oldcxt);
+        if (buf == NULL) {
+            return;
+        }
+        if (t_thrd.xlog_cxt.payload_scratch != NULL) {
+            pfree(t_thrd.xlog_cxt.payload_scratch);
+        }
+        t_thrd.xlog_cxt.payload_scratch = buf;
+        t_thrd.xlog_cxt.compressed_payload = buf + newSize;
+        t_thrd.xlog_cxt.payload_scratch_size = newSize;
+    }
+
+    INSTR_TIME_SET_CURRENT(startTime);
+
+    for (XLogRecData* rdt = hdr_rdt->next; rdt != NULL; rdt = rdt->next) {
+        if (rdt->len == 0) {
+            continue;
+        }
+        rc = memcpy_s(t_thrd.xlog_cxt.payload_scratch + offset, t_thrd.xlog_cxt.payload_scratch_size - offset,
+            rdt->data, rdt->len);
+        securec_check(rc, "", "");
+        offset += rdt->len;
+    }
+    Assert(offset == payloadLen);
+
+    /*
+     * Limit the output so that compression only succeeds if it saves more
+     * than the extra header.
+     */
+    compressedLen = LZ4_compress_default(t_thrd.xlog_cxt.payload_scratch, t_thrd.xlog_cxt.compressed_payload,
+        (int)payloadLen, (int)(payloadLen - SizeOfXLogRecordCompressHeader - 1));
+
+    INSTR_TIME_SET_CURRENT(duration);
+    INSTR_TIME_SUBTRACT(duration, startTime);
+    (void)pg_atomic_fetch_add_u64(&g_instance.xlog_cxt.compress_attempts, 1);
+    (void)pg_atomic_fetch_add_u64(&g_instance.xlog_cxt.compress_time, INSTR_TIME_GET_MICROSEC(duration));
+
+    if (compressedLen <= 0) {
+        return;
+    }
+
+    (void)pg_atomic_fetch_add_u64(&g_instance.xlog_cxt.compressed_records, 1);
+    (void)pg_atomic_fetch_add_u64(&g_instance.xlog_cxt.compress_raw_bytes, payloadLen);
+    (void)pg_atomic_fetch_add_u64(&g_instance.xlog_cxt.compressed_bytes, (uint64)compressedLen);
+
+    /* Make room for the compression header right after the record header */
+    char* fragments = t_thrd.xlog_cxt.hdr_scratch + SizeOfXLogRecord;
+    uint32 fragmentsLen = hdrLen - SizeOfXLogRecord;
+    uint32 clen = (uint32)compressedLen;
+
+    if (fragmentsLen > 0) {
+        rc = memmove_s(fragments + SizeOfXLogRecordCompressHeader,
+            HEADER_SCRATCH_SIZE - SizeOfXLogRecord - SizeOfXLogRecordCompressHeader, fragments, fragmentsLen);
+        securec_check(rc, "", "");
+    }
+    fragments[0] = (char)XLR_BLOCK_ID_COMPRESSED;
+    rc = memcpy_s(fragments + sizeof(uint8), sizeof(uint32), &payloadLen, sizeof(uint32));
+    securec_check(rc, "", "");
+    rc = memcpy_s(fragments + sizeof(uint8) + sizeof(uint32), sizeof(uint32), &clen, sizeof(uint32));
+    securec_check(rc, "", "");
+
+    hdr_rdt->len = hdrLen + SizeOfXLogRecordCompressHeader;
+    payload_rdt->data = t_thrd.xlog_cxt.compressed_payload;
+    payload_rdt->len = clen;
+    payload_rdt->next = NULL;
+    hdr_rdt->next = payload_rdt;
+
+    *total_len = hdr_rdt->len + clen;
+}
+
 /*
  * Write a backup block if needed when we are setting a hint. Note that
  * this may be called for a variety of page types, not just heaps.
@@ -30,6 +30,7 @@
 #include "replication/logical.h"
 #include "access/parallel_recovery/redo_item.h"
 #include "utils/memutils.h"
+#include "portability/instr_time.h"
 #include "lz4.h"
 
 typedef struct XLogPageReadPrivate {
@@ -48,6 +49,7 @@ static THR_LOCAL XLogSegNo xlogreadsegno = 0;
 bool ValidXLogPageHeader(XLogReaderState* state, XLogRecPtr recptr, XLogPageHeader hdr, bool readoldversion);
 static int ReadPageInternal(XLogReaderState* state, XLogRecPtr pageptr, int reqLen, bool readoldversion);
 void ResetDecoder(XLogReaderState* state);
+static XLogRecord* DecompressXLogRecord(XLogReaderState* state, XLogRecord* record);
 
 static inline void prepare_invalid_report(
     XLogReaderState* state, char* fname, const size_t fname_len, const XLogSegNo segno)
@@ -496,8 +498,9 @@ XLogRecord* XLogReadRecord(
     }
 
     if (doDecode) {
+        /* decoding may expand a compressed record into a new buffer */
         if (DecodeXLogRecord(state, record, errormsg, readoldversion)) {
-            return record;
+            return state->decoded_record;
         } else
             return NULL;
     } else
@@ -1238,9 +1241,162 @@ void ResetDecoder(XLogReaderState* state)
     state->max_block_id = -1;
 }
 
+/*
+ * Expand a record whose payload was compressed by XLogInsert.
+ *
+ * The record is rewritten in state->readRecordBuf into the layout it would
+ * have had without compression, so that decoding, and the redo dispatchers
+ * that copy readRecordBuf around, work on it unchanged. readRecordBuf is
+ * reallocated if it is too small, in the memory context that owns the reader
+ * state, since the dispatchers keep pooled reader states across records.
+ *
+ * xl_crc covers the stored form. Records can reach here without going
+ * through ReadRecord, e.g. from the extreme RTO read queue, so the CRC is
+ * verified again before anything is expanded. The expanded record keeps the
+ * stored xl_crc and must not be checked against it again.
+ *
+ * Returns the expanded record, or NULL with the error in state->errormsg_buf.
+ */
+static XLogRecord* DecompressXLogRecord(XLogReaderState* state, XLogRecord* record)
+{
+    char* fragments = NULL;
+    uint32 rawLen;
+    uint32 compressedLen;
+    uint32 fragmentsLen;
+    uint64 newLen;
+    int decompressedLen;
+    pg_crc32c crc;
+    errno_t rc = EOK;
+#ifndef FRONTEND
+    instr_time startTime;
+    instr_time duration;
+
+    INSTR_TIME_SET_CURRENT(startTime);
+#endif
+
+    if (record->xl_tot_len < SizeOfXLogRecord + SizeOfXLogRecordCompressHeader) {
+        goto shortdata_err;
+    }
+
+    INIT_CRC32C(crc);
+    COMP_CRC32C(crc, ((char*)record) + SizeOfXLogRecord, record->xl_tot_len - SizeOfXLogRecord);
+    COMP_CRC32C(crc, (char*)record, offsetof(XLogRecord, xl_crc));
+    FIN_CRC32C(crc);
+    if (!EQ_CRC32C(record->xl_crc, crc)) {
+        report_invalid_record(state,
+            "incorrect resource manager data checksum in compressed record at %X/%X",
+            (uint32)(state->ReadRecPtr >> 32),
+            (uint32)state->ReadRecPtr);
+        return NULL;
+    }
+
+    fragments = (char*)record + SizeOfXLogRecord;
+    rc = memcpy_s(&rawLen, sizeof(uint32), fragments + sizeof(uint8), sizeof(uint32));
+    securec_check(rc, "", "");
+    rc = memcpy_s(&compressedLen, sizeof(uint32), fragments + sizeof(uint8) + sizeof(uint32), sizeof(uint32));
+    securec_check(rc, "", "");
+
+    if (compressedLen == 0 || compressedLen >= rawLen ||
+        compressedLen > record->xl_tot_len - SizeOfXLogRecord - SizeOfXLogRecordCompressHeader) {
+        report_invalid_record(state,
+            "invalid compressed payload length %u (raw length %u) at %X/%X",
+            compressedLen,
+            rawLen,
+            (uint32)(state->ReadRecPtr >> 32),
+            (uint32)state->ReadRecPtr);
+        return NULL;
+    }
+
+    fragmentsLen = record->xl_tot_len - SizeOfXLogRecord - SizeOfXLogRecordCompressHeader - compressedLen;
+    newLen = (uint64)SizeOfXLogRecord + fragmentsLen + rawLen;
+    if (newLen + compressedLen + XLOG_BLCKSZ > XLogRecordMaxSize) {
+        report_invalid_record(state,
+            "compressed record at %X/%X expands to invalid length " UINT64_FORMAT,
+            (uint32)(state->ReadRecPtr >> 32),
+            (uint32)state->ReadRecPtr,
+            newLen);
+        return NULL;
+    }
+
+    /*
+     * The compressed payload is first moved past the end of the expanded
+     * record, so make sure the buffer can hold both.
+     */
+    if ((char*)record != state->readRecordBuf || state->readRecordBufSize < newLen + compressedLen) {
+        uint32 newSize = (uint32)newLen + compressedLen;
+        char* newBuf = NULL;
+#ifndef FRONTEND
+        MemoryContext oldcxt = MemoryContextSwitchTo(
+            GetMemoryChunkContext(state->readRecordBuf != NULL ? (void*)state->readRecordBuf : (void*)state));
+#endif
+
+        newSize += XLOG_BLCKSZ - (newSize % XLOG_BLCKSZ);
+        newBuf = (char*)palloc_extended(newSize, MCXT_ALLOC_NO_OOM);
+#ifndef FRONTEND
+        (void)MemoryContextSwitchTo(oldcxt);
+#endif
+        if (newBuf == NULL) {
+            report_invalid_record(state,
+                "out of memory while expanding compressed record at %X/%X",
+                (uint32)(state->ReadRecPtr >> 32),
+                (uint32)state->ReadRecPtr);
+            return NULL;
+        }
+        rc = memcpy_s(newBuf, newSize, record, record->xl_tot_len);
+        securec_check(rc, "", "");
+        if (state->readRecordBuf != NULL) {
+            pfree(state->readRecordBuf);
+        }
+        state->readRecordBuf = newBuf;
+        state->readRecordBufSize = newSize;
+        record = (XLogRecord*)newBuf;
+        fragments = newBuf + SizeOfXLogRecord;
+    }
+
+    rc = memmove_s(state->readRecordBuf + newLen,
+        state->readRecordBufSize - newLen,
+        fragments + SizeOfXLogRecordCompressHeader + fragmentsLen,
+        compressedLen);
+    securec_check(rc, "", "");
+    if (fragmentsLen > 0) {
+        rc = memmove_s(fragments,
+            state->readRecordBufSize - SizeOfXLogRecord,
+            fragments + SizeOfXLogRecordCompressHeader,
+            fragmentsLen);
+        securec_check(rc, "", "");
+    }
+
+    decompressedLen = LZ4_decompress_safe(
+        state->readRecordBuf + newLen, fragments + fragmentsLen, (int)compressedLen, (int)rawLen);
+    if (decompressedLen < 0 || (uint32)decompressedLen != rawLen) {
+        report_invalid_record(state,
+            "invalid compressed payload at %X/%X",
+            (uint32)(state->ReadRecPtr >> 32),
+            (uint32)state->ReadRecPtr);
+        return NULL;
+    }
+    record->xl_tot_len = (uint32)newLen;
+
+#ifndef FRONTEND
+    INSTR_TIME_SET_CURRENT(duration);
+    INSTR_TIME_SUBTRACT(duration, startTime);
+    (void)pg_atomic_fetch_add_u64(&g_instance.xlog_cxt.decompressed_records, 1);
+    (void)pg_atomic_fetch_add_u64(&g_instance.xlog_cxt.decompress_time, INSTR_TIME_GET_MICROSEC(duration));
+#endif
+    return record;
+
+shortdata_err:
+    report_invalid_record(
+        state, "record with invalid length at %X/%X", (uint32)(state->ReadRecPtr >> 32), (uint32)state->ReadRecPtr);
+    return NULL;
+}
+
 /*
  * Decode the previously read record.
  *
+ * A record with a compressed payload is expanded first, in which case
+ * state->decoded_record differs from the passed record on return.
+ *
  * On error, a human-readable error message is returned in *errormsg, and
  * the return value is false.
  */
@@ -1254,6 +1410,14 @@ bool DecodeXLogRecord(XLogReaderState* state, XLogRecord* record, char** errorms
 
     ResetDecoder(state);
 
+    if (!readoldversion && record->xl_tot_len > SizeOfXLogRecord &&
+        *((uint8*)record + SizeOfXLogRecord) == XLR_BLOCK_ID_COMPRESSED) {
+        record = DecompressXLogRecord(state, record);
+        if (record == NULL) {
+            goto err;
+        }
+    }
+
     state->decoded_record = record;
     state->record_origin = InvalidRepOriginId;
 
@@ -385,13 +385,28 @@ void PrefetchBuffer(Relation reln, ForkNumber forkNum, BlockNumber blockNum)
         }
     }
 
+    PrefetchSharedBuffer(reln->rd_smgr, forkNum, blockNum);
+#endif /* USE_PREFETCH && USE_POSIX_FADVISE */
+}
+
+/*
+ * PrefetchSharedBuffer -- initiate asynchronous read of a block of a relation
+ *        opened at the smgr level, unless it is already in the shared buffers.
+ *
+ * This is also used by recovery, which has no relcache entry for the block.
+ */
+void PrefetchSharedBuffer(SMgrRelation smgr_reln, ForkNumber forkNum, BlockNumber blockNum)
+{
+#if defined(USE_PREFETCH) && defined(USE_POSIX_FADVISE)
     BufferTag new_tag;         /* identity of requested block */
     uint32 new_hash;           /* hash value for newTag */
     LWLock* new_partition_lock; /* buffer partition lock for it */
     int buf_id;
 
+    Assert(BlockNumberIsValid(blockNum));
+
     /* create a tag so we can lookup the buffer */
-    INIT_BUFFERTAG(new_tag, reln->rd_smgr->smgr_rnode.node, forkNum, blockNum);
+    INIT_BUFFERTAG(new_tag, smgr_reln->smgr_rnode.node, forkNum, blockNum);
 
     /* determine its hash code and partition lock ID */
     new_hash = BufTableHashCode(&new_tag);
@@ -404,7 +419,7 @@ void PrefetchBuffer(Relation reln, ForkNumber forkNum, BlockNumber blockNum)
 
     /* If not in buffers, initiate prefetch */
     if (buf_id < 0) {
-        smgrprefetch(reln->rd_smgr, forkNum, blockNum);
+        smgrprefetch(smgr_reln, forkNum, blockNum);
     }
 
         /*
@@ -2313,6 +2328,8 @@ static BufferDesc* BufferAlloc(SMgrRelation smgr, char relpersistence, ForkNumbe
         /* Can release the mapping lock as soon as we've pinned it */
         LWLockRelease(new_partition_lock);
 
+        StrategyBufferHit(buf);
+
         *found = TRUE;
 
         if (!valid) {
@@ -2514,6 +2531,8 @@ static BufferDesc* BufferAlloc(SMgrRelation smgr, char relpersistence, ForkNumbe
             /* Can release the mapping lock as soon as we've pinned it */
             LWLockRelease(new_partition_lock);
 
+            StrategyBufferHit(buf);
+
             *found = TRUE;
 
             if (!valid) {
@@ -2595,6 +2614,10 @@ static BufferDesc* BufferAlloc(SMgrRelation smgr, char relpersistence, ForkNumbe
 
     LWLockRelease(new_partition_lock);
 
+    /* We still hold the pin, so nobody else can rename the buffer meanwhile */
+    StrategyBufferReplaced(buf, (old_flags & BM_TAG_VALID) ? &old_tag : NULL, old_hash, &new_tag, new_hash,
+        strategy);
+
     /*
      * Buffer contents are currently invalid.  Try to get the io_in_progress
      * lock.  If StartBufferIO returns false, then someone else managed to
@@ -3641,6 +3664,43 @@ bool BgBufferSync(WritebackContext* wb_context)
  * Note: caller must have done ResourceOwnerEnlargeBuffers.
  */
 const int CONDITION_LOCK_RETRY_TIMES = 5;
+/*
+ * PageWriterLockBuffer -- share-lock the content of a buffer the pagewriter is about to flush
+ *
+ * We must use a conditional lock acquisition here to avoid deadlock. If
+ * page_writer and double_write are enabled, only page_writer is allowed to
+ * flush the buffers. So the backends (BufferAlloc, FlushRelationBuffers,
+ * FlushDatabaseBuffers) are not allowed to flush the buffers, instead they
+ * will just wait for page_writer to flush the required buffer. In some cases
+ * (for example, btree split, heap_multi_insert), BufferAlloc will be called
+ * with holding exclusive lock on another buffer. So if we try to acquire
+ * the shared lock directly here (page_writer), it will block unconditionally
+ * and the backends will be blocked on the page_writer to flush the buffer,
+ * resulting in deadlock.
+ *
+ * Returns false if the lock could not be taken and the buffer must be skipped.
+ */
+static bool PageWriterLockBuffer(BufferDesc* buf_desc, int buf_id)
+{
+    int retry_times = 0;
+    int i = 0;
+    Buffer queue_head_buffer = get_dirty_page_queue_head_buffer();
+    if (!BufferIsInvalid(queue_head_buffer) && (queue_head_buffer - 1 == buf_id)) {
+        retry_times = CONDITION_LOCK_RETRY_TIMES;
+    }
+    for (;;) {
+        if (!LWLockConditionalAcquire(buf_desc->content_lock, LW_SHARED)) {
+            i++;
+            if (i >= retry_times) {
+                return false;
+            }
+            (void)sched_yield();
+            continue;
+        }
+        return true;
+    }
+}
+
 static uint32 SyncOneBuffer(int buf_id, bool skip_recently_used, WritebackContext* wb_context, bool is_page_writer)
 {
     BufferDesc* buf_desc = GetBufferDescriptor(buf_id);
@@ -3679,35 +3739,9 @@ static uint32 SyncOneBuffer(int buf_id, bool skip_recently_used, WritebackContex
     PinBuffer_Locked(buf_desc);
 
     if (dw_enabled() && is_page_writer) {
-        /*
-         * We must use a conditional lock acquisition here to avoid deadlock. If
-         * page_writer and double_write are enabled, only page_writer is allowed to
-         * flush the buffers. So the backends (BufferAlloc, FlushRelationBuffers,
-         * FlushDatabaseBuffers) are not allowed to flush the buffers, instead they
-         * will just wait for page_writer to flush the required buffer. In some cases
-         * (for example, btree split, heap_multi_insert), BufferAlloc will be called
-         * with holding exclusive lock on another buffer. So if we try to acquire
-         * the shared lock directly here (page_writer), it will block unconditionally
-         * and the backends will be blocked on the page_writer to flush the buffer,
-         * resulting in deadlock.
-         */
-        int retry_times = 0;
-        int i = 0;
-        Buffer queue_head_buffer = get_dirty_page_queue_head_buffer();
-        if (!BufferIsInvalid(queue_head_buffer) && (queue_head_buffer - 1 == buf_id)) {
-            retry_times = CONDITION_LOCK_RETRY_TIMES;
-        }
-        for (;;) {
-            if (!LWLockConditionalAcquire(buf_desc->content_lock, LW_SHARED)) {
-                i++;
-                if (i >= retry_times) {
-                    UnpinBuffer(buf_desc, true);
-                    return (result | BUF_SKIPPED);
-                }
-                (void)sched_yield();
-                continue;
-            }
-            break;
+        if (!PageWriterLockBuffer(buf_desc, buf_id)) {
+            UnpinBuffer(buf_desc, true);
+            return (result | BUF_SKIPPED);
         }
     } else {
         (void)LWLockAcquire(buf_desc->content_lock, LW_SHARED);
@@ -5926,6 +5960,182 @@ retry:
     }
 }
 
+/*
+ * @Description: flush one buffer of the pagewriter batch synchronously.
+ * @in          index of the buffer in CkptBufferIds
+ * @in          writeback context
+ * @return      true if the buffer was written
+ */
+static bool ckpt_sync_flush_one_page(uint32 loc, WritebackContext* wb_context)
+{
+    uint32 ret = SyncOneBuffer(g_instance.ckpt_cxt_ctl->CkptBufferIds[loc].buf_id, false, wb_context, true);
+    if (ret & BUF_SKIPPED) {
+        /*
+         * We could not flush the buffer as we couldn't acquire conditional
+         * lock on the buffer content_lock. So we mark it in buf_id_arr.
+         */
+        g_instance.ckpt_cxt_ctl->CkptBufferIds[loc].buf_id = DW_INVALID_BUFFER_ID;
+    }
+    return (ret & BUF_WRITTEN) != 0;
+}
+
+/*
+ * @Description: dispatch the pending pagewriter writes to the ADIO completers.
+ * @See also:
+ */
+static void ckpt_async_dispatch(AioDispatchDesc_t** dis_list)
+{
+    HOLD_INTERRUPTS();
+    smgrasyncwrite(dis_list[0]->blockDesc.smgrReln,
+        dis_list[0]->blockDesc.forkNum,
+        dis_list,
+        t_thrd.storage_cxt.InProgressAioDispatchCount);
+    t_thrd.storage_cxt.InProgressAioDispatchCount = 0;
+    RESUME_INTERRUPTS();
+}
+
+/*
+ * @Description: pagewriter thread flush dirty pages through the ADIO completers.
+ *  Each page is written from a private copy with its checksum set, allocated
+ *  together with its AIO descriptor, so the completer frees both at once.
+ *  The batch was written to the double write file, which the next batch
+ *  reuses, so wait for all the writes before returning. A write that failed
+ *  is reported as an ERROR, as a failed synchronous write would be.
+ * @in          pagewriter thread id
+ * @return      number of dirty pages actually flushed
+ */
+static uint32 ckpt_async_flush_dirty_page(int thread_id)
+{
+    uint32 actual_written = 0;
+    uint32 start_loc = g_instance.ckpt_cxt_ctl->page_writer_procs.writer_proc[thread_id].start_loc;
+    uint32 end_loc = g_instance.ckpt_cxt_ctl->page_writer_procs.writer_proc[thread_id].end_loc;
+    int dispatched_num = 0;
+    int failed_num = 0;
+    WritebackContext wb_context;
+
+    if (start_loc > end_loc) {
+        return 0;
+    }
+
+    WritebackContextInit(&wb_context, &t_thrd.pagewriter_cxt.page_writer_after);
+    BufferDesc** dispatched_bufs = (BufferDesc**)palloc(sizeof(BufferDesc*) * (end_loc - start_loc + 1));
+    BufferTag* dispatched_tags = (BufferTag*)palloc(sizeof(BufferTag) * (end_loc - start_loc + 1));
+    AioDispatchDesc_t** dis_list = (AioDispatchDesc_t**)palloc(sizeof(AioDispatchDesc_t*) * MAX_BACKWRITE_REQSIZ);
+
+    t_thrd.storage_cxt.InProgressAioDispatch = dis_list;
+    t_thrd.storage_cxt.InProgressAioDispatchCount = 0;
+    t_thrd.storage_cxt.InProgressAioType = AioWrite;
+
+    for (uint32 i = start_loc; i <= end_loc; i++) {
+        int buf_id = g_instance.ckpt_cxt_ctl->CkptBufferIds[i].buf_id;
+        if (buf_id == DW_INVALID_BUFFER_ID) {
+            continue;
+        }
+
+        BufferDesc* buf_desc = GetBufferDescriptor(buf_id);
+        uint32 buf_state = LockBufHdr(buf_desc);
+        if (!(buf_state & BM_CHECKPOINT_NEEDED) || !(buf_state & BM_DIRTY) || !(buf_state & BM_VALID)) {
+            UnlockBufHdr(buf_desc, buf_state);
+            continue;
+        }
+
+        /* column store pages are not written by md, flush them the usual way */
+        if (IsValidColForkNum(buf_desc->tag.forkNum)) {
+            UnlockBufHdr(buf_desc, buf_state);
+            if (ckpt_sync_flush_one_page(i, &wb_context)) {
+                actual_written++;
+            }
+            continue;
+        }
+
+        PinBuffer_Locked(buf_desc);
+        if (!PageWriterLockBuffer(buf_desc, buf_id)) {
+            UnpinBuffer(buf_desc, true);
+            g_instance.ckpt_cxt_ctl->CkptBufferIds[i].buf_id = DW_INVALID_BUFFER_ID;
+            continue;
+        }
+
+        /* someone else flushed the buffer before we could */
+        if (!StartBufferIO(buf_desc, false)) {
+            LWLockRelease(buf_desc->content_lock);
+            UnpinBuffer(buf_desc, true);
+            continue;
+        }
+        t_thrd.storage_cxt.InProgressAioBuf = buf_desc;
+
+        Block block = BufHdrGetBlock(buf_desc);
+        XLogFlush(BufferGetLSN(buf_desc), PageIsLogical(block));
+
+        /* Clear the BM_JUST_DIRTIED flag used to check whether block content changes while flushing */
+        buf_state = LockBufHdr(buf_desc);
+        buf_state &= ~BM_JUST_DIRTIED;
+        UnlockBufHdr(buf_desc, buf_state);
+
+        AioDispatchDesc_t* aio_desc =
+            (AioDispatchDesc_t*)adio_share_alloc(sizeof(AioDispatchDesc_t) + BLCKSZ + SYS_LOGICAL_BLOCK_SIZE);
+        char* page_copy = (char*)TYPEALIGN(SYS_LOGICAL_BLOCK_SIZE, (char*)aio_desc + sizeof(AioDispatchDesc_t));
+        errno_t rc = memcpy_s(page_copy, BLCKSZ, PageDataEncryptIfNeed((Page)block), BLCKSZ);
+        securec_check(rc, "\0", "\0");
+        PageSetChecksumInplace((Page)page_copy, buf_desc->tag.blockNum);
+
+        rc = memset_s(&aio_desc->aiocb, sizeof(struct iocb), 0, sizeof(struct iocb));
+        securec_check(rc, "\0", "\0");
+        aio_desc->blockDesc.smgrReln = smgropen(buf_desc->tag.rnode, InvalidBackendId);
+        aio_desc->blockDesc.forkNum = buf_desc->tag.forkNum;
+        aio_desc->blockDesc.blockNum = buf_desc->tag.blockNum;
+        aio_desc->blockDesc.buffer = page_copy;
+        aio_desc->blockDesc.blockSize = BLCKSZ;
+        aio_desc->blockDesc.reqType = PageListBackWriteType;
+        aio_desc->blockDesc.bufHdr = buf_desc;
+        aio_desc->blockDesc.descType = AioWrite;
+
+        dis_list[t_thrd.storage_cxt.InProgressAioDispatchCount++] = aio_desc;
+        dispatched_tags[dispatched_num] = buf_desc->tag;
+        dispatched_bufs[dispatched_num++] = buf_desc;
+        t_thrd.storage_cxt.InProgressAioBuf = NULL;
+
+        if (t_thrd.storage_cxt.InProgressAioDispatchCount >= MAX_BACKWRITE_REQSIZ) {
+            ckpt_async_dispatch(dis_list);
+        }
+    }
+
+    if (t_thrd.storage_cxt.InProgressAioDispatchCount > 0) {
+        ckpt_async_dispatch(dis_list);
+    }
+    t_thrd.storage_cxt.InProgressAioDispatch = NULL;
+    t_thrd.storage_cxt.InProgressAioType = AioUnkown;
+    pfree(dis_list);
+
+    /*
+     * The completer unpins a buffer once its write is done, after which the
+     * buffer may be reused; waiting on it then only waits for an unrelated I/O.
+     */
+    for (int i = 0; i < dispatched_num; i++) {
+        WaitIO(dispatched_bufs[i]);
+
+        /* a failed write leaves the buffer dirty with BM_IO_ERROR set, see CompltrWriteReq() */
+        uint32 state = LockBufHdr(dispatched_bufs[i]);
+        if ((state & BM_IO_ERROR) && BUFFERTAGS_EQUAL(dispatched_bufs[i]->tag, dispatched_tags[i])) {
+            failed_num++;
+        }
+        UnlockBufHdr(dispatched_bufs[i], state);
+    }
+    pfree(dispatched_bufs);
+    pfree(dispatched_tags);
+
+    if (failed_num > 0) {
+        ereport(ERROR,
+            (errcode(ERRCODE_IO_ERROR),
+                errmsg("could not write %d of the %d pages dispatched to the AIO completers",
+                    failed_num,
+                    dispatched_num)));
+    }
+    actual_written += (uint32)dispatched_num;
+
+    IssuePendingWritebacks(&wb_context);
+    return actual_written;
+}
+
 /**
  * @Description: pagewriter thread flush dirty pages to data file.
  * @in          number of pagewriter need flush dirty page.
@@ -5940,6 +6150,11 @@ void ckpt_flush_dirty_page(int thread_id)
     BufferDesc* buf_desc = NULL;
     uint32 buf_state;
 
+    if (AioCompltrIsReady() && g_instance.attr.attr_storage.enable_adio_function) {
+        actual_written = ckpt_async_flush_dirty_page(thread_id);
+        goto flush_done;
+    }
+
     WritebackContextInit(&wb_context, &t_thrd.pagewriter_cxt.page_writer_after);
 
     for (i = g_instance.ckpt_cxt_ctl->page_writer_procs.writer_proc[thread_id].start_loc;
@@ -5953,15 +6168,8 @@ void ckpt_flush_dirty_page(int thread_id)
         buf_state = LockBufHdr(buf_desc);
         if ((buf_state & BM_CHECKPOINT_NEEDED) && (buf_state & BM_DIRTY)) {
             UnlockBufHdr(buf_desc, buf_state);
-            uint32 ret = SyncOneBuffer(buf_id, false, &wb_context, true);
-            if (ret & BUF_WRITTEN) {
+            if (ckpt_sync_flush_one_page(i, &wb_context)) {
                 actual_written++;
-            } else if (ret & BUF_SKIPPED) {
-                /*
-                 * We could not flush the buffer as we couldn't acquire conditional
-                 * lock on the buffer content_lock. So we mark it in buf_id_arr.
-                 */
-                g_instance.ckpt_cxt_ctl->CkptBufferIds[i].buf_id = DW_INVALID_BUFFER_ID;
             }
         } else {
             UnlockBufHdr(buf_desc, buf_state);
@@ -5970,6 +6178,8 @@ void ckpt_flush_dirty_page(int thread_id)
 
     /* issue all pending flushes */
     IssuePendingWritebacks(&wb_context);
+
+flush_done:
     g_instance.ckpt_cxt_ctl->page_writer_procs.writer_proc[thread_id].need_flush = false;
     g_instance.ckpt_cxt_ctl->page_writer_procs.writer_proc[thread_id].actual_flush_num = actual_written;
     (void)pg_atomic_fetch_sub_u32(&g_instance.ckpt_cxt_ctl->page_writer_procs.running_num, 1);
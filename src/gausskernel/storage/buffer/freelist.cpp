@@ -28,6 +28,51 @@
 
 #define INT_ACCESS_ONCE(var) ((int)(*((volatile int*)&(var))))
 
+/*
+ * 2Q sizing: A1 (the recency queue) should hold at most A1_TARGET_PERCENT of
+ * shared buffers, and the ghost list remembers the tags of the last
+ * GHOST_TARGET_PERCENT * NBuffers pages evicted from A1.
+ */
+#define A1_TARGET_PERCENT 25
+#define GHOST_TARGET_PERCENT 50
+#define GHOST_NUM_PARTITIONS 128
+#define POLICY_COUNTER_STRIPES 64
+
+/*
+ * A ghost list entry. Each ghost partition owns a ring of entries, replaced
+ * in FIFO order, and a small hash table chaining the valid entries by tag.
+ */
+typedef struct GhostEntry {
+    BufferTag tag;
+    uint32 hash;
+    int32 next; /* next entry in the bucket chain, or -1 */
+    bool valid;
+} GhostEntry;
+
+typedef struct GhostPartition {
+    slock_t lock;
+    uint32 nextSlot; /* ring slot to be replaced next, i.e. the oldest entry */
+    uint32 nentries; /* number of valid entries */
+} GhostPartition;
+
+typedef union GhostPartitionPadded {
+    GhostPartition part;
+    char pad[PG_CACHE_LINE_SIZE];
+} GhostPartitionPadded;
+
+/* Replacement statistics, striped over cache lines to keep them cheap */
+typedef struct BufferPolicyCounters {
+    pg_atomic_uint64 hits[BUF_QUEUE_NUM];
+    pg_atomic_uint64 evictions[BUF_QUEUE_NUM];
+    pg_atomic_uint64 misses;
+    pg_atomic_uint64 ghostHits;
+} BufferPolicyCounters;
+
+typedef union BufferPolicyCountersPadded {
+    BufferPolicyCounters counters;
+    char pad[PG_CACHE_LINE_SIZE];
+} BufferPolicyCountersPadded;
+
 /*
  * The shared freelist control information.
  */
@@ -54,6 +99,26 @@ typedef struct BufferStrategyControl {
      * StrategyNotifyBgWriter.
      */
     int bgwprocno;
+
+    /* Replacement policy chosen at startup, see buffer_replacement_policy */
+    int policy;
+
+    /*
+     * 2Q state. bufQueue holds the queue of every buffer and is only touched
+     * by the backend that holds the buffer header for renaming, queueSize is
+     * the number of buffers in each queue. bufQueue and the ghost list are
+     * NULL under the clock policy.
+     */
+    uint8* bufQueue;
+    pg_atomic_uint32 queueSize[BUF_QUEUE_NUM];
+    uint32 a1Target;
+    GhostPartitionPadded* ghostParts;
+    GhostEntry* ghostEntries;
+    int32* ghostBuckets;
+    uint32 ghostPartEntries; /* ring size of each ghost partition */
+    uint32 ghostPartBuckets; /* buckets of each ghost partition, power of 2 */
+
+    BufferPolicyCountersPadded* counters;
 } BufferStrategyControl;
 
 typedef struct
@@ -155,6 +220,133 @@ static inline uint32 ClockSweepTick(int max_nbuffer_can_use)
     return victim;
 }
 
+static inline BufferPolicyCounters* GetPolicyCounters(void)
+{
+    int stripe = (t_thrd.proc != NULL) ? (t_thrd.proc->pgprocno % POLICY_COUNTER_STRIPES) : 0;
+
+    return &t_thrd.storage_cxt.StrategyControl->counters[stripe].counters;
+}
+
+/*
+ * GhostGetPartition - Locate the ghost partition, ring and bucket array that
+ * a buffer mapping hash code belongs to.
+ */
+static inline GhostPartition* GhostGetPartition(uint32 hash, GhostEntry** entries, int32** buckets)
+{
+    BufferStrategyControl* ctl = t_thrd.storage_cxt.StrategyControl;
+    uint32 partno = hash % GHOST_NUM_PARTITIONS;
+
+    *entries = ctl->ghostEntries + (Size)partno * ctl->ghostPartEntries;
+    *buckets = ctl->ghostBuckets + (Size)partno * ctl->ghostPartBuckets;
+    return &ctl->ghostParts[partno].part;
+}
+
+static inline int32* GhostGetBucket(int32* buckets, uint32 hash)
+{
+    return &buckets[(hash / GHOST_NUM_PARTITIONS) & (t_thrd.storage_cxt.StrategyControl->ghostPartBuckets - 1)];
+}
+
+/*
+ * GhostInsert - Remember the tag of a page evicted from A1, forgetting the
+ * oldest entry of the partition if it is full. Caller must not hold the
+ * partition lock.
+ */
+static void GhostInsert(const BufferTag* tag, uint32 hash)
+{
+    GhostEntry* entries = NULL;
+    int32* buckets = NULL;
+    GhostPartition* part = GhostGetPartition(hash, &entries, &buckets);
+    GhostEntry* entry = NULL;
+    int32* link = NULL;
+    int32 slot;
+
+    SpinLockAcquire(&part->lock);
+    slot = (int32)part->nextSlot;
+    entry = &entries[slot];
+    if (entry->valid) {
+        /* unlink the oldest entry from its bucket chain */
+        link = GhostGetBucket(buckets, entry->hash);
+        while (*link != slot) {
+            Assert(*link >= 0);
+            link = &entries[*link].next;
+        }
+        *link = entry->next;
+    } else {
+        part->nentries++;
+    }
+
+    entry->tag = *tag;
+    entry->hash = hash;
+    link = GhostGetBucket(buckets, hash);
+    entry->next = *link;
+    entry->valid = true;
+    *link = slot;
+    part->nextSlot = (part->nextSlot + 1) % t_thrd.storage_cxt.StrategyControl->ghostPartEntries;
+    SpinLockRelease(&part->lock);
+}
+
+/*
+ * GhostRemove - Look up a tag on the ghost list and remove it if present.
+ *
+ * Returns true if the page was evicted from A1 recently enough to still be
+ * remembered, which is the signal to promote it into AM.
+ */
+static bool GhostRemove(const BufferTag* tag, uint32 hash)
+{
+    GhostEntry* entries = NULL;
+    int32* buckets = NULL;
+    GhostPartition* part = GhostGetPartition(hash, &entries, &buckets);
+    int32* link = NULL;
+    bool found = false;
+
+    SpinLockAcquire(&part->lock);
+    for (link = GhostGetBucket(buckets, hash); *link >= 0; link = &entries[*link].next) {
+        GhostEntry* entry = &entries[*link];
+
+        if (entry->hash == hash && BUFFERTAGS_EQUAL(entry->tag, *tag)) {
+            *link = entry->next;
+            entry->valid = false;
+            part->nentries--;
+            found = true;
+            break;
+        }
+    }
+    SpinLockRelease(&part->lock);
+    return found;
+}
+
+/*
+ * TwoQAcceptVictim - Helper routine for StrategyGetBuffer()
+ *
+ * Decide whether the unpinned buffer under the clock hand may be evicted
+ * under the 2Q policy. Pages of A1 are evicted first while A1 is above its
+ * target size, otherwise AM is swept like the classic clock: a buffer with a
+ * non-zero usage count gets a second chance. Caller holds the buffer header
+ * lock; a decremented usage count is written back when it is released.
+ */
+static bool TwoQAcceptVictim(BufferDesc* buf, uint32* buf_state)
+{
+    BufferStrategyControl* ctl = t_thrd.storage_cxt.StrategyControl;
+    bool a1_full = pg_atomic_read_u32(&ctl->queueSize[BUF_QUEUE_A1]) > ctl->a1Target;
+
+    switch (ctl->bufQueue[buf->buf_id]) {
+        case BUF_QUEUE_A1:
+            return a1_full;
+        case BUF_QUEUE_AM:
+            if (a1_full) {
+                return false;
+            }
+            if (BUF_STATE_GET_USAGECOUNT(*buf_state) != 0) {
+                *buf_state -= BUF_USAGECOUNT_ONE;
+                return false;
+            }
+            return true;
+        default:
+            /* never used since startup */
+            return true;
+    }
+}
+
 /*
  * StrategyGetBuffer
  *
@@ -184,6 +376,8 @@ BufferDesc* StrategyGetBuffer(BufferAccessStrategy strategy, uint32* buf_state,
     bool am_standby = RecoveryInProgress();
     StrategyDelayStatus	retry_lock_status = {0, 0};
     StrategyDelayStatus	retry_buf_status = {0, 0};
+    bool use_2q = (t_thrd.storage_cxt.StrategyControl->policy == BUFFER_POLICY_2Q);
+    int policy_skips = 0;
 
     gstrace_entry(GS_TRC_ID_StrategyGetBuffer);
 
@@ -264,6 +458,17 @@ retry:
         retry_lock_status.retry_times = 0;
         if (BUF_STATE_GET_REFCOUNT(local_buf_state) == 0 &&
             (!dw_page_writer_running() || !(local_buf_state & BM_DIRTY))) {
+            /*
+             * Under 2Q the buffer must also come from the right queue. Give
+             * up on the queue preference after two full passes, so that a
+             * skewed queue layout can never make us fail.
+             */
+            if (use_2q && policy_skips < 2 * max_buffer_can_use &&
+                !TwoQAcceptVictim(buf, &local_buf_state)) {
+                policy_skips++;
+                UnlockBufHdr(buf, local_buf_state);
+                continue;
+            }
             /* Found a usable buffer */
             if (strategy != NULL)
                 AddBufferToRing(strategy, buf);
@@ -370,6 +575,197 @@ void StrategyNotifyBgWriter(int bgwproc_no)
     SpinLockRelease(&t_thrd.storage_cxt.StrategyControl->buffer_strategy_lock);
 }
 
+/*
+ * StrategyBufferHit -- account a buffer lookup that found the page cached
+ *
+ * Only 2Q keeps per queue hit counts, the clock policy leaves the hit path
+ * untouched.
+ */
+void StrategyBufferHit(BufferDesc* buf)
+{
+    BufferStrategyControl* ctl = t_thrd.storage_cxt.StrategyControl;
+
+    if (ctl->bufQueue == NULL) {
+        return;
+    }
+    (void)pg_atomic_fetch_add_u64(&GetPolicyCounters()->hits[ctl->bufQueue[buf->buf_id]], 1);
+}
+
+/*
+ * StrategyBufferReplaced -- tell the replacement policy about a renamed buffer
+ *
+ * Called by BufferAlloc() once buf has been retagged from old_tag (NULL if
+ * the buffer held no valid page) to new_tag. Under 2Q, pages evicted from A1
+ * are remembered on the ghost list, and a page found there when it is read in
+ * again goes to AM. Pages read through a ring strategy stay in A1 and are not
+ * remembered, so bulk scans cannot pollute AM.
+ */
+void StrategyBufferReplaced(BufferDesc* buf, BufferTag* old_tag, uint32 old_hash, BufferTag* new_tag,
+    uint32 new_hash, BufferAccessStrategy strategy)
+{
+    BufferStrategyControl* ctl = t_thrd.storage_cxt.StrategyControl;
+    BufferPolicyCounters* counters = GetPolicyCounters();
+    int old_queue;
+    int new_queue;
+
+    (void)pg_atomic_fetch_add_u64(&counters->misses, 1);
+    if (ctl->bufQueue == NULL) {
+        if (old_tag != NULL) {
+            (void)pg_atomic_fetch_add_u64(&counters->evictions[BUF_QUEUE_MAIN], 1);
+        }
+        return;
+    }
+
+    old_queue = ctl->bufQueue[buf->buf_id];
+    if (old_tag != NULL) {
+        (void)pg_atomic_fetch_add_u64(&counters->evictions[old_queue], 1);
+        if (old_queue == BUF_QUEUE_A1 && strategy == NULL) {
+            GhostInsert(old_tag, old_hash);
+        }
+    }
+
+    if (strategy == NULL && GhostRemove(new_tag, new_hash)) {
+        (void)pg_atomic_fetch_add_u64(&counters->ghostHits, 1);
+        new_queue = BUF_QUEUE_AM;
+    } else {
+        new_queue = BUF_QUEUE_A1;
+    }
+
+    if (new_queue != old_queue) {
+        (void)pg_atomic_fetch_sub_u32(&ctl->queueSize[old_queue], 1);
+        (void)pg_atomic_fetch_add_u32(&ctl->queueSize[new_queue], 1);
+        ctl->bufQueue[buf->buf_id] = (uint8)new_queue;
+    }
+}
+
+/*
+ * StrategyGetQueueStats -- report per queue statistics
+ *
+ * queues must have room for BUF_QUEUE_NUM entries. ghost reports the number
+ * of remembered tags and how often a read found its tag there. The counters
+ * are read without locking and are only approximately consistent.
+ */
+void StrategyGetQueueStats(BufferQueueStat* queues, BufferQueueStat* ghost, uint64* misses)
+{
+    BufferStrategyControl* ctl = t_thrd.storage_cxt.StrategyControl;
+    int i;
+    int q;
+
+    *misses = 0;
+    ghost->buffers = 0;
+    ghost->hits = 0;
+    ghost->evictions = 0;
+    for (q = 0; q < BUF_QUEUE_NUM; q++) {
+        queues[q].buffers = pg_atomic_read_u32(&ctl->queueSize[q]);
+        queues[q].hits = 0;
+        queues[q].evictions = 0;
+    }
+
+    for (i = 0; i < POLICY_COUNTER_STRIPES; i++) {
+        BufferPolicyCounters* counters = &ctl->counters[i].counters;
+
+        for (q = 0; q < BUF_QUEUE_NUM; q++) {
+            queues[q].hits += pg_atomic_read_u64(&counters->hits[q]);
+            queues[q].evictions += pg_atomic_read_u64(&counters->evictions[q]);
+        }
+        *misses += pg_atomic_read_u64(&counters->misses);
+        ghost->hits += pg_atomic_read_u64(&counters->ghostHits);
+    }
+
+    if (ctl->ghostParts != NULL) {
+        for (i = 0; i < GHOST_NUM_PARTITIONS; i++) {
+            ghost->buffers += ctl->ghostParts[i].part.nentries;
+        }
+    }
+}
+
+/*
+ * StrategyPolicyShmemSize -- size of the replacement policy state
+ *
+ * Also computes the ghost list geometry when asked to.
+ */
+static Size StrategyPolicyShmemSize(uint32* part_entries, uint32* part_buckets)
+{
+    int nbuffers = g_instance.attr.attr_storage.NBuffers;
+    uint32 entries;
+    uint32 buckets = 1;
+    Size size = 0;
+
+    size = add_size(size, mul_size(POLICY_COUNTER_STRIPES, sizeof(BufferPolicyCountersPadded)));
+    if (g_instance.attr.attr_storage.buffer_replacement_policy != BUFFER_POLICY_2Q) {
+        return size;
+    }
+
+    entries = (uint32)Max((uint64)nbuffers * GHOST_TARGET_PERCENT / 100 / GHOST_NUM_PARTITIONS, 1);
+    while (buckets < entries) {
+        buckets <<= 1;
+    }
+    if (part_entries != NULL) {
+        *part_entries = entries;
+        *part_buckets = buckets;
+    }
+
+    size = add_size(size, MAXALIGN(nbuffers));
+    size = add_size(size, mul_size(GHOST_NUM_PARTITIONS, sizeof(GhostPartitionPadded)));
+    size = add_size(size, mul_size(mul_size(GHOST_NUM_PARTITIONS, entries), sizeof(GhostEntry)));
+    size = add_size(size, mul_size(mul_size(GHOST_NUM_PARTITIONS, buckets), sizeof(int32)));
+    return size;
+}
+
+/*
+ * StrategyPolicyInitialize -- set up the replacement policy state of a newly
+ * created control block.
+ */
+static void StrategyPolicyInitialize(BufferStrategyControl* ctl)
+{
+    int nbuffers = g_instance.attr.attr_storage.NBuffers;
+    uint32 part_entries = 0;
+    uint32 part_buckets = 0;
+    Size size = StrategyPolicyShmemSize(&part_entries, &part_buckets);
+    bool found = false;
+    char* ptr = (char*)ShmemInitStruct("Buffer Strategy Policy", size, &found);
+    errno_t rc;
+    int i;
+
+    Assert(!found);
+    rc = memset_s(ptr, size, 0, size);
+    securec_check(rc, "\0", "\0");
+
+    ctl->policy = g_instance.attr.attr_storage.buffer_replacement_policy;
+    ctl->counters = (BufferPolicyCountersPadded*)ptr;
+    ptr += POLICY_COUNTER_STRIPES * sizeof(BufferPolicyCountersPadded);
+
+    pg_atomic_init_u32(&ctl->queueSize[BUF_QUEUE_MAIN], (uint32)nbuffers);
+    pg_atomic_init_u32(&ctl->queueSize[BUF_QUEUE_A1], 0);
+    pg_atomic_init_u32(&ctl->queueSize[BUF_QUEUE_AM], 0);
+    ctl->a1Target = (uint32)Max((uint64)nbuffers * A1_TARGET_PERCENT / 100, 1);
+    ctl->bufQueue = NULL;
+    ctl->ghostParts = NULL;
+    ctl->ghostEntries = NULL;
+    ctl->ghostBuckets = NULL;
+    ctl->ghostPartEntries = part_entries;
+    ctl->ghostPartBuckets = part_buckets;
+    if (ctl->policy != BUFFER_POLICY_2Q) {
+        return;
+    }
+
+    /* every buffer starts out in BUF_QUEUE_MAIN, which is zero */
+    ctl->bufQueue = (uint8*)ptr;
+    ptr += MAXALIGN(nbuffers);
+    ctl->ghostParts = (GhostPartitionPadded*)ptr;
+    ptr += GHOST_NUM_PARTITIONS * sizeof(GhostPartitionPadded);
+    ctl->ghostEntries = (GhostEntry*)ptr;
+    ptr += (Size)GHOST_NUM_PARTITIONS * part_entries * sizeof(GhostEntry);
+    ctl->ghostBuckets = (int32*)ptr;
+
+    for (i = 0; i < GHOST_NUM_PARTITIONS; i++) {
+        SpinLockInit(&ctl->ghostParts[i].part.lock);
+    }
+    for (Size j = 0; j < (Size)GHOST_NUM_PARTITIONS * part_buckets; j++) {
+        ctl->ghostBuckets[j] = -1;
+    }
+}
+
 /*
  * StrategyShmemSize
  *
@@ -388,6 +784,9 @@ Size StrategyShmemSize(void)
     /* size of the shared replacement strategy control block */
     size = add_size(size, MAXALIGN(sizeof(BufferStrategyControl)));
 
+    /* size of the replacement policy counters, queues and ghost list */
+    size = add_size(size, StrategyPolicyShmemSize(NULL, NULL));
+
     return size;
 }
 
@@ -436,6 +835,8 @@ void StrategyInitialize(bool init)
 
         /* No pending notification */
         t_thrd.storage_cxt.StrategyControl->bgwprocno = -1;
+
+        StrategyPolicyInitialize(t_thrd.storage_cxt.StrategyControl);
     } else {
         Assert(!init);
     }
@@ -692,6 +1093,7 @@ static BufferDesc* getBufferFromFreeList(BufferAccessStrategy strategy, Dlelem *
     bool            found = false;
     int             retry_times = 0;
     int             buf_free_list_num = 0;
+    bool            use_2q = (t_thrd.storage_cxt.StrategyControl->policy == BUFFER_POLICY_2Q);
 
     getKeyAndListNum(&buf_free_list_num, &key);
 
@@ -715,8 +1117,10 @@ static BufferDesc* getBufferFromFreeList(BufferAccessStrategy strategy, Dlelem *
                 continue;
             }
 
+            /* a free listed buffer still belongs to a 2Q queue, the same preference applies */
             if (BUF_STATE_GET_REFCOUNT(*buf_state) == 0 &&
-                (!dw_page_writer_running() || !(*buf_state & BM_DIRTY))) {
+                (!dw_page_writer_running() || !(*buf_state & BM_DIRTY)) &&
+                (!use_2q || TwoQAcceptVictim(buf, buf_state))) {
                 LWLockRelease(buf_list_entry->lock);
 
                 buf->free_list_idx = -1;
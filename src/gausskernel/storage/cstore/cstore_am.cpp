@@ -113,6 +113,12 @@ CStore::CStore()
       m_load_finish(false),
       m_scanPosInCU(NULL),
       m_RCFuncs(NULL),
+      m_runtimeFilters(NULL),
+      m_runtimeFilterMinFuncs(NULL),
+      m_runtimeFilterMaxFuncs(NULL),
+      m_runtimeFilterMin(NULL),
+      m_runtimeFilterMax(NULL),
+      m_runtimeFilterNum(0),
       m_fillVectorByTids(NULL),
       m_fillVectorLateRead(NULL),
       m_colFillFunArrary(NULL),
@@ -315,6 +321,65 @@ void CStore::InitRoughCheckEnv(CStoreScanState* state)
     }
 }
 
+/*
+ * @Description: bind the hash join bloom filters collected by the scan state.
+ *     Integer filters carrying a min/max range are also used to eliminate CUs.
+ * @IN state: cstore scan state
+ * @See also: exec_cstore_collect_runtime_filters
+ */
+void CStore::InitRuntimeFilterEnv(CStoreScanState* state)
+{
+    AutoContextSwitch newMemCnxt(m_scanMemContext);
+
+    m_runtimeFilterNum = state->m_runtimeFilterNum;
+    m_runtimeFilters = state->m_runtimeFilters;
+    if (m_runtimeFilterNum == 0) {
+        return;
+    }
+
+    if (m_runtimeFilterMinFuncs == NULL) {
+        /* the filter array is allocated once with its max size, see the scan state */
+        int maxNum = list_length(state->ps.plan->var_list);
+        m_runtimeFilterMinFuncs = (RoughCheckFunc*)palloc(sizeof(RoughCheckFunc) * maxNum);
+        m_runtimeFilterMaxFuncs = (RoughCheckFunc*)palloc(sizeof(RoughCheckFunc) * maxNum);
+        m_runtimeFilterMin = (Datum*)palloc(sizeof(Datum) * maxNum);
+        m_runtimeFilterMax = (Datum*)palloc(sizeof(Datum) * maxNum);
+    }
+
+    for (int i = 0; i < m_runtimeFilterNum; i++) {
+        filter::BloomFilter* bf = m_runtimeFilters[i].bf;
+        Oid typeOid = bf->getDataType();
+
+        m_runtimeFilters[i].lateRead = m_lateRead[m_runtimeFilters[i].seq];
+        m_runtimeFilterMinFuncs[i] = NULL;
+        m_runtimeFilterMaxFuncs[i] = NULL;
+        if (!bf->hasMinMax()) {
+            continue;
+        }
+
+        /* integer rough check functions take an int64 argument */
+        switch (typeOid) {
+            case INT2OID:
+                m_runtimeFilterMin[i] = Int64GetDatum((int64)DatumGetInt16(bf->getMin()));
+                m_runtimeFilterMax[i] = Int64GetDatum((int64)DatumGetInt16(bf->getMax()));
+                break;
+            case INT4OID:
+                m_runtimeFilterMin[i] = Int64GetDatum((int64)DatumGetInt32(bf->getMin()));
+                m_runtimeFilterMax[i] = Int64GetDatum((int64)DatumGetInt32(bf->getMax()));
+                break;
+            case INT8OID:
+                m_runtimeFilterMin[i] = bf->getMin();
+                m_runtimeFilterMax[i] = bf->getMax();
+                break;
+            default:
+                continue;
+        }
+
+        m_runtimeFilterMinFuncs[i] = GetRoughCheckFunc(typeOid, CStoreGreaterEqualStrategyNumber, InvalidOid);
+        m_runtimeFilterMaxFuncs[i] = GetRoughCheckFunc(typeOid, CStoreLessEqualStrategyNumber, InvalidOid);
+    }
+}
+
 void CStore::InitScan(CStoreScanState* state, Snapshot snapshot)
 {
     Assert(state && state->ps.ps_ProjInfo);
@@ -391,6 +456,11 @@ CStore::~CStore()
     m_CUDescInfo = NULL;
     m_perScanMemCnxt = NULL;
     m_RCFuncs = NULL;
+    m_runtimeFilters = NULL;
+    m_runtimeFilterMinFuncs = NULL;
+    m_runtimeFilterMaxFuncs = NULL;
+    m_runtimeFilterMin = NULL;
+    m_runtimeFilterMax = NULL;
     m_CUDescIdx = NULL;
     m_colFillFunArrary = NULL;
     m_cuStorage = NULL;
@@ -1174,6 +1244,31 @@ bool CStore::RoughCheck(CStoreScanKey scanKey, int nkeys, int cuDescIdx)
     return hitCU;
 }
 
+/*
+ * @Description: cudesc rough check against the runtime filters
+ * @Param[IN] cuDescIdx:index of load cudesc info
+ * @Return: true--hit, false--not hit
+ * @See also: InitRuntimeFilterEnv
+ */
+bool CStore::RuntimeFilterRoughCheck(int cuDescIdx)
+{
+    for (int j = 0; j < m_runtimeFilterNum; j++) {
+        /* build side is empty, no row of this scan can be joined */
+        if (m_runtimeFilters[j].bf->getNumValues() == 0)
+            return false;
+        if (m_runtimeFilterMinFuncs[j] == NULL)
+            continue;
+
+        CUDesc* cudesc = &(m_CUDescInfo[m_runtimeFilters[j].seq]->cuDescArray[cuDescIdx]);
+        if (cudesc->IsNullCU() || cudesc->IsNoMinMaxCU())
+            continue;
+        if (!m_runtimeFilterMinFuncs[j](cudesc, m_runtimeFilterMin[j]) ||
+            !m_runtimeFilterMaxFuncs[j](cudesc, m_runtimeFilterMax[j]))
+            return false;
+    }
+    return true;
+}
+
 void CStore::RoughCheckIfNeed(_in_ CStoreScanState* state)
 {
     int nkeys = state->csss_NumScanKeys;
@@ -1188,7 +1283,8 @@ void CStore::RoughCheckIfNeed(_in_ CStoreScanState* state)
         return;
     }
 
-    if (likely(nkeys == 0 || scanKey == NULL || m_colNum == 0)) {
+    bool hasScanKeys = (nkeys > 0 && scanKey != NULL);
+    if (likely((!hasScanKeys && m_runtimeFilterNum == 0) || m_colNum == 0)) {
         /* when no where condition, we also need set m_lastNumCUDescIdx and m_NumCUDescIdx for prefetch once */
         ADIO_RUN()
         {
@@ -1214,7 +1310,9 @@ void CStore::RoughCheckIfNeed(_in_ CStoreScanState* state)
     lastLoadNum = m_CUDescInfo[0]->lastLoadNum;
     curLoadNum = m_CUDescInfo[0]->curLoadNum;
     for (int i = (int)lastLoadNum; i != (int)curLoadNum; IncLoadCuDescIdx(i), IncLoadCuDescIdx(cudesc_idx_tmp)) {
-        hitCU = RoughCheck(scanKey, nkeys, i);
+        hitCU = !hasScanKeys || RoughCheck(scanKey, nkeys, i);
+        if (hitCU && m_runtimeFilterNum > 0)
+            hitCU = RuntimeFilterRoughCheck(i);
         if (hitCU) {
             // fliter CU not hit
             ADIO_RUN()
@@ -0,0 +1,528 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * aio_uring.cpp
+ *        io_uring backend of the ADIO completers.
+ *
+ * The ADIO requests are still prepared as libaio iocbs by md.cpp and the
+ * cstore code, so the callers and the completer callbacks do not change.
+ * AioUringSubmit() translates a whole dispatch list into submission queue
+ * entries and hands it to the kernel with a single io_uring_enter() call,
+ * and AioUringGetEvents() reports completions as io_events.
+ *
+ * Requests whose buffer lies in a range registered with the ring use
+ * IORING_OP_READ_FIXED and IORING_OP_WRITE_FIXED, which saves the kernel from
+ * pinning the user pages on every I/O. shared_buffers is registered with the
+ * page prefetch ring only, so the buffer pool is pinned once.
+ *
+ * When the kernel can bound a wait for several completions (IORING_FEAT_EXT_ARG,
+ * 5.11), the completer sleeps until the requests in flight have completed, in
+ * batches of up to AIO_URING_REAP_BATCH, or for at most AIO_URING_REAP_WINDOW_US,
+ * instead of being woken up by the first completion of a dispatch list.
+ *
+ * The ring is driven through the raw system calls, so there is no build or
+ * runtime dependency on liburing. Kernels older than 5.6 (without
+ * IORING_OP_READ/IORING_OP_WRITE) are rejected at setup.
+ *
+ * IDENTIFICATION
+ *        src/gausskernel/storage/file/aio_uring.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+#include "storage/aio_uring.h"
+
+#include <poll.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#endif
+#endif
+
+/* IORING_FEAT_RW_CUR_POS was added together with IORING_OP_READ/IORING_OP_WRITE */
+#ifdef IORING_FEAT_RW_CUR_POS
+#define HAVE_AIO_URING 1
+#endif
+
+#ifdef HAVE_AIO_URING
+
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+#ifndef __NR_io_uring_register
+#define __NR_io_uring_register 427
+#endif
+
+/* A single registered buffer may not exceed 1GB */
+#define AIO_URING_BUF_CHUNK ((Size)1024 * 1024 * 1024)
+
+/* Maximum time to wait for the kernel to accept submission queue entries, in ms */
+#define AIO_URING_SUBMIT_RETRIES 1000
+
+/* IORING_ENTER_EXT_ARG came with IORING_FEAT_EXT_ARG and struct io_uring_getevents_arg */
+#ifdef IORING_FEAT_EXT_ARG
+#define HAVE_AIO_URING_EXT_ARG 1
+#endif
+
+/* Most completions a completer waits for before it is woken up */
+#define AIO_URING_REAP_BATCH 32
+/* Longest a completion waits for the rest of its batch, in microseconds */
+#define AIO_URING_REAP_WINDOW_US 200
+
+struct AioUring {
+    int fd;
+
+    /* submission queue */
+    unsigned int sqEntries;
+    unsigned int* sqHead;
+    unsigned int* sqTail;
+    unsigned int sqMask;
+    unsigned int* sqArray;
+    struct io_uring_sqe* sqes;
+
+    /* completion queue */
+    unsigned int* cqHead;
+    unsigned int* cqTail;
+    unsigned int cqMask;
+    struct io_uring_cqe* cqes;
+
+    /* mappings */
+    void* sqRing;
+    Size sqRingSize;
+    void* cqRing;
+    Size cqRingSize;
+    Size sqesSize;
+
+    /* registered buffer range, empty if buffers are not registered */
+    char* bufBase;
+    Size bufLen;
+
+    /* requests handed to the kernel and not reaped yet */
+    unsigned int inflight;
+
+    /* whether the kernel takes a timeout with a wait for several completions */
+    bool extArg;
+
+    /* serializes submitters */
+    pthread_mutex_t submitLock;
+};
+
+static int io_uring_setup(unsigned int entries, struct io_uring_params* p)
+{
+    return (int)syscall(__NR_io_uring_setup, entries, p);
+}
+
+static int io_uring_enter(int fd, unsigned int toSubmit, unsigned int minComplete, unsigned int flags)
+{
+    return (int)syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, NULL, 0);
+}
+
+static int io_uring_register(int fd, unsigned int opcode, void* arg, unsigned int nrArgs)
+{
+    return (int)syscall(__NR_io_uring_register, fd, opcode, arg, nrArgs);
+}
+
+#ifdef HAVE_AIO_URING_EXT_ARG
+/*
+ * Sleep until minComplete completions are available or waitUs microseconds
+ * have passed, whichever comes first.
+ */
+static int io_uring_wait_batch(int fd, unsigned int minComplete, long waitUs)
+{
+    struct __kernel_timespec ts;
+    struct io_uring_getevents_arg arg;
+    errno_t rc = memset_s(&arg, sizeof(arg), 0, sizeof(arg));
+    securec_check(rc, "\0", "\0");
+
+    ts.tv_sec = waitUs / 1000000L;
+    ts.tv_nsec = (waitUs % 1000000L) * 1000L;
+    arg.ts = (uint64)(uintptr_t)&ts;
+    return (int)syscall(__NR_io_uring_enter, fd, 0, minComplete, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG,
+        &arg, sizeof(arg));
+}
+#endif
+
+bool AioUringSupported(void)
+{
+    return true;
+}
+
+/*
+ * @Description: Create an io_uring instance and map its rings
+ * @Param[IN] entries: submission queue size
+ * @Return: the ring, or NULL if io_uring is not available
+ * @See also:
+ */
+AioUring* AioUringSetup(unsigned int entries)
+{
+    struct io_uring_params params;
+    errno_t rc = memset_s(&params, sizeof(params), 0, sizeof(params));
+    securec_check(rc, "\0", "\0");
+
+    int fd = io_uring_setup(entries, &params);
+    if (fd < 0) {
+        ereport(LOG, (errmsg("AIO Startup, io_uring_setup(%u) failed: %m", entries)));
+        return NULL;
+    }
+
+    if (!(params.features & IORING_FEAT_RW_CUR_POS)) {
+        ereport(LOG, (errmsg("AIO Startup, io_uring of this kernel does not support IORING_OP_READ")));
+        close(fd);
+        return NULL;
+    }
+
+    AioUring* ring = (AioUring*)malloc(sizeof(AioUring));
+    if (ring == NULL) {
+        close(fd);
+        return NULL;
+    }
+    rc = memset_s(ring, sizeof(AioUring), 0, sizeof(AioUring));
+    securec_check(rc, "\0", "\0");
+    ring->fd = fd;
+    (void)pthread_mutex_init(&ring->submitLock, NULL);
+#ifdef HAVE_AIO_URING_EXT_ARG
+    ring->extArg = ((params.features & IORING_FEAT_EXT_ARG) != 0);
+#endif
+
+    ring->sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+    ring->cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        ring->sqRingSize = Max(ring->sqRingSize, ring->cqRingSize);
+        ring->cqRingSize = ring->sqRingSize;
+    }
+
+    ring->sqRing = mmap(NULL, ring->sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+        IORING_OFF_SQ_RING);
+    if (ring->sqRing == MAP_FAILED) {
+        ring->sqRing = NULL;
+        goto setup_error;
+    }
+
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        ring->cqRing = ring->sqRing;
+    } else {
+        ring->cqRing = mmap(NULL, ring->cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+            IORING_OFF_CQ_RING);
+        if (ring->cqRing == MAP_FAILED) {
+            ring->cqRing = NULL;
+            goto setup_error;
+        }
+    }
+
+    ring->sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+    ring->sqes = (struct io_uring_sqe*)mmap(NULL, ring->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+        fd, IORING_OFF_SQES);
+    if (ring->sqes == MAP_FAILED) {
+        ring->sqes = NULL;
+        goto setup_error;
+    }
+
+    ring->sqEntries = params.sq_entries;
+    ring->sqHead = (unsigned int*)((char*)ring->sqRing + params.sq_off.head);
+    ring->sqTail = (unsigned int*)((char*)ring->sqRing + params.sq_off.tail);
+    ring->sqMask = *(unsigned int*)((char*)ring->sqRing + params.sq_off.ring_mask);
+    ring->sqArray = (unsigned int*)((char*)ring->sqRing + params.sq_off.array);
+
+    ring->cqHead = (unsigned int*)((char*)ring->cqRing + params.cq_off.head);
+    ring->cqTail = (unsigned int*)((char*)ring->cqRing + params.cq_off.tail);
+    ring->cqMask = *(unsigned int*)((char*)ring->cqRing + params.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe*)((char*)ring->cqRing + params.cq_off.cqes);
+    return ring;
+
+setup_error:
+    ereport(LOG, (errmsg("AIO Startup, failed to map io_uring rings: %m")));
+    AioUringDestroy(ring);
+    return NULL;
+}
+
+/*
+ * @Description: Unmap the rings and close the io_uring instance
+ * @Param[IN] ring: the ring
+ * @See also:
+ */
+void AioUringDestroy(AioUring* ring)
+{
+    if (ring == NULL) {
+        return;
+    }
+
+    if (ring->sqes != NULL) {
+        (void)munmap(ring->sqes, ring->sqesSize);
+    }
+    if (ring->cqRing != NULL && ring->cqRing != ring->sqRing) {
+        (void)munmap(ring->cqRing, ring->cqRingSize);
+    }
+    if (ring->sqRing != NULL) {
+        (void)munmap(ring->sqRing, ring->sqRingSize);
+    }
+    (void)pthread_mutex_destroy(&ring->submitLock);
+    close(ring->fd);
+    free(ring);
+}
+
+/*
+ * @Description: Register a memory range (shared_buffers) as fixed buffers of the ring.
+ *  The range is split into 1GB chunks, the maximal size of a single registered buffer.
+ *  Failure is not fatal, requests are then submitted as regular reads and writes.
+ * @Param[IN] ring: the ring
+ * @Param[IN] base: start of the range
+ * @Param[IN] len: length of the range
+ * @Return: true if the range was registered
+ * @See also:
+ */
+bool AioUringRegisterBuffers(AioUring* ring, char* base, Size len)
+{
+    unsigned int nchunks = (unsigned int)((len + AIO_URING_BUF_CHUNK - 1) / AIO_URING_BUF_CHUNK);
+    struct iovec* iov = (struct iovec*)malloc(nchunks * sizeof(struct iovec));
+    if (iov == NULL) {
+        return false;
+    }
+
+    for (unsigned int i = 0; i < nchunks; i++) {
+        iov[i].iov_base = base + i * AIO_URING_BUF_CHUNK;
+        iov[i].iov_len = Min(AIO_URING_BUF_CHUNK, len - i * AIO_URING_BUF_CHUNK);
+    }
+
+    int ret = io_uring_register(ring->fd, IORING_REGISTER_BUFFERS, iov, nchunks);
+    free(iov);
+    if (ret < 0) {
+        ereport(LOG, (errmsg("AIO Startup, failed to register %lu bytes of shared buffers with io_uring: %m", len)));
+        return false;
+    }
+
+    ring->bufBase = base;
+    ring->bufLen = len;
+    return true;
+}
+
+/*
+ * @Description: Translate a libaio request into a submission queue entry
+ * @Param[IN] ring: the ring
+ * @Param[IN] iocb: the request
+ * @Param[OUT] sqe: the submission queue entry
+ * @See also:
+ */
+static void AioUringPrepSqe(AioUring* ring, struct iocb* iocb, struct io_uring_sqe* sqe)
+{
+    char* buf = (char*)iocb->u.c.buf;
+    bool isWrite = (iocb->aio_lio_opcode == IO_CMD_PWRITE);
+
+    errno_t rc = memset_s(sqe, sizeof(struct io_uring_sqe), 0, sizeof(struct io_uring_sqe));
+    securec_check(rc, "\0", "\0");
+
+    sqe->fd = iocb->aio_fildes;
+    sqe->addr = (uint64)(uintptr_t)buf;
+    sqe->len = (uint32)iocb->u.c.nbytes;
+    sqe->off = (uint64)iocb->u.c.offset;
+    sqe->user_data = (uint64)(uintptr_t)iocb;
+
+    /* a block never straddles a chunk boundary, since BLCKSZ divides the chunk size */
+    if (ring->bufLen > 0 && buf >= ring->bufBase && buf + iocb->u.c.nbytes <= ring->bufBase + ring->bufLen) {
+        Size offset = (Size)(buf - ring->bufBase);
+        if (offset / AIO_URING_BUF_CHUNK == (offset + iocb->u.c.nbytes - 1) / AIO_URING_BUF_CHUNK) {
+            sqe->opcode = isWrite ? IORING_OP_WRITE_FIXED : IORING_OP_READ_FIXED;
+            sqe->buf_index = (uint16)(offset / AIO_URING_BUF_CHUNK);
+            return;
+        }
+    }
+
+    sqe->opcode = isWrite ? IORING_OP_WRITE : IORING_OP_READ;
+}
+
+/*
+ * @Description: Submit a list of requests with a single io_uring_enter() call.
+ *  Like io_submit(), fewer requests than asked may be submitted when the
+ *  submission queue is full or the kernel fails to take all of them, the
+ *  caller retries the remainder. The entries the kernel did not consume are
+ *  taken back from the submission queue, so a retried request is never issued
+ *  twice.
+ * @Param[IN] ring: the ring
+ * @Param[IN] nr: number of requests
+ * @Param[IN] iocbs: the requests
+ * @Return: number of submitted requests, or a negative errno if none was submitted
+ * @See also:
+ */
+int AioUringSubmit(AioUring* ring, long nr, struct iocb** iocbs)
+{
+    int retries = 0;
+
+    (void)pthread_mutex_lock(&ring->submitLock);
+
+    unsigned int head = __atomic_load_n(ring->sqHead, __ATOMIC_ACQUIRE);
+    unsigned int tail = *ring->sqTail;
+    long count = Min(nr, (long)(ring->sqEntries - (tail - head)));
+    if (count <= 0) {
+        (void)pthread_mutex_unlock(&ring->submitLock);
+        return -EAGAIN;
+    }
+
+    for (long i = 0; i < count; i++) {
+        unsigned int idx = tail & ring->sqMask;
+        AioUringPrepSqe(ring, iocbs[i], &ring->sqes[idx]);
+        ring->sqArray[idx] = idx;
+        tail++;
+    }
+    __atomic_store_n(ring->sqTail, tail, __ATOMIC_RELEASE);
+
+    /* counted before the kernel sees them, so a completion never finds it short */
+    (void)__atomic_add_fetch(&ring->inflight, (unsigned int)count, __ATOMIC_RELEASE);
+
+    unsigned int pending = (unsigned int)count;
+    while (pending > 0) {
+        int ret = io_uring_enter(ring->fd, pending, 0, 0);
+        if (ret > 0) {
+            pending -= (unsigned int)ret;
+            continue;
+        }
+
+        /* consuming nothing without an error is retried like a busy queue */
+        int err = (ret == 0) ? EAGAIN : errno;
+        if (err == EINTR) {
+            continue;
+        }
+        if ((err == EAGAIN || err == EBUSY) && retries++ < AIO_URING_SUBMIT_RETRIES) {
+            pg_usleep(1000L);
+            continue;
+        }
+
+        /*
+         * The kernel only reads the queue inside io_uring_enter() with entries
+         * to submit, which submitLock serializes, so the entries it did not
+         * consume can be withdrawn by moving the tail back over them.
+         */
+        __atomic_store_n(ring->sqTail, tail - pending, __ATOMIC_RELEASE);
+        (void)__atomic_sub_fetch(&ring->inflight, pending, __ATOMIC_RELEASE);
+        (void)pthread_mutex_unlock(&ring->submitLock);
+        ereport(LOG, (errmsg("io_uring_enter() failed to submit %u requests: %s", pending, strerror(err))));
+        count -= pending;
+        return (count > 0) ? (int)count : -err;
+    }
+
+    (void)pthread_mutex_unlock(&ring->submitLock);
+    return (int)count;
+}
+
+/*
+ * @Description: Wait for completions, like io_getevents() with min_nr 1.
+ *  The ring fd polls readable while the completion queue is not empty, which
+ *  gives the wait a timeout on every kernel that has IORING_OP_READ.
+ *  When several requests are in flight and the kernel supports it, the wait
+ *  first gives the batch AIO_URING_REAP_WINDOW_US to complete, so that it is
+ *  reaped with one wakeup.
+ *  Must only be called by the completer thread that owns the ring.
+ * @Param[IN] ring: the ring
+ * @Param[IN] max_nr: maximum number of completions to return
+ * @Param[OUT] events: the completions
+ * @Param[IN] timeout: maximum time to wait, NULL to wait indefinitely
+ * @Return: number of completions, 0 on timeout, or a negative errno (-EINTR if interrupted by a signal)
+ * @See also:
+ */
+int AioUringGetEvents(AioUring* ring, long max_nr, struct io_event* events, const struct timespec* timeout)
+{
+    int timeoutMs = -1;
+    bool batchWaited = false;
+    if (timeout != NULL) {
+        timeoutMs = (int)(timeout->tv_sec * 1000 + timeout->tv_nsec / 1000000);
+    }
+
+    for (;;) {
+        unsigned int head = *ring->cqHead;
+        unsigned int tail = __atomic_load_n(ring->cqTail, __ATOMIC_ACQUIRE);
+        int count = 0;
+
+        while (head != tail && count < max_nr) {
+            struct io_uring_cqe* cqe = &ring->cqes[head & ring->cqMask];
+            events[count].data = NULL;
+            events[count].obj = (struct iocb*)(uintptr_t)cqe->user_data;
+            events[count].res = cqe->res;
+            events[count].res2 = 0;
+            head++;
+            count++;
+        }
+
+        if (count > 0) {
+            __atomic_store_n(ring->cqHead, head, __ATOMIC_RELEASE);
+            (void)__atomic_sub_fetch(&ring->inflight, (unsigned int)count, __ATOMIC_RELEASE);
+            return count;
+        }
+
+#ifdef HAVE_AIO_URING_EXT_ARG
+        unsigned int inflight = __atomic_load_n(&ring->inflight, __ATOMIC_ACQUIRE);
+        if (ring->extArg && !batchWaited && inflight > 1) {
+            /* -ETIME only means the batch is not complete yet, reap what there is */
+            batchWaited = true;
+            unsigned int batch = (unsigned int)Min(Min((long)inflight, max_nr), (long)AIO_URING_REAP_BATCH);
+            if (io_uring_wait_batch(ring->fd, batch, AIO_URING_REAP_WINDOW_US) < 0 && errno != ETIME) {
+                return -errno;
+            }
+            continue;
+        }
+#endif
+
+        struct pollfd pfd;
+        pfd.fd = ring->fd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        int ret = poll(&pfd, 1, timeoutMs);
+        if (ret < 0) {
+            return -errno;
+        }
+        if (ret == 0) {
+            return 0;
+        }
+    }
+}
+
+#else /* !HAVE_AIO_URING */
+
+bool AioUringSupported(void)
+{
+    return false;
+}
+
+AioUring* AioUringSetup(unsigned int entries)
+{
+    ereport(LOG, (errmsg("AIO Startup, io_uring is not supported by this build")));
+    return NULL;
+}
+
+void AioUringDestroy(AioUring* ring)
+{}
+
+bool AioUringRegisterBuffers(AioUring* ring, char* base, Size len)
+{
+    return false;
+}
+
+int AioUringSubmit(AioUring* ring, long nr, struct iocb** iocbs)
+{
+    return -ENOSYS;
+}
+
+int AioUringGetEvents(AioUring* ring, long max_nr, struct io_event* events, const struct timespec* timeout)
+{
+    return -ENOSYS;
+}
+
+#endif /* HAVE_AIO_URING */
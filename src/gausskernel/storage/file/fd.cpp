@@ -1906,7 +1906,7 @@ retry:
 }
 
 template <typename dlistType>
-static int FileAsyncSubmitIO(io_context_t aio_context, dlistType dList, int dListCount)
+static int FileAsyncSubmitIO(AioCompltrType reqType, dlistType dList, int dListCount)
 {
     int retCount = 0;
     int submitCount = 0;
@@ -1916,8 +1916,8 @@ static int FileAsyncSubmitIO(io_context_t aio_context, dlistType dList, int dLis
     u_sess->storage_cxt.AsyncSubmitIOCount = 0;
     do {
         Assert(dListCount > submitCount);
-        retCount =
-            io_submit(aio_context, (long)(dListCount - submitCount), (struct iocb**)((dlistType)dList + submitCount));
+        retCount = CompltrSubmit(
+            reqType, 0, (long)(dListCount - submitCount), (struct iocb**)((dlistType)dList + submitCount));
         if (retCount == -EAGAIN) {
             /* Insufficient resources, try again */
             insufficientTimes++;
@@ -1993,9 +1993,7 @@ int FileAsyncRead(AioDispatchDesc_t** dList, int32 dn)
      * If the number of requests is too great, and there are more threads
      * than request types it makes sense to spread them around.
      */
-    io_context_t aio_context = CompltrContext(dList[0]->blockDesc.reqType, 0);
-
-    returnCode = FileAsyncSubmitIO<AioDispatchDesc_t**>(aio_context, dList, dn);
+    returnCode = FileAsyncSubmitIO<AioDispatchDesc_t**>(dList[0]->blockDesc.reqType, dList, dn);
     if (returnCode != dn) {
         ereport(ERROR,
             (errcode_for_file_access(),
@@ -2036,9 +2034,7 @@ int FileAsyncWrite(AioDispatchDesc_t** dList, int32 dn)
         dList[i]->aiocb.aio_fildes = u_sess->storage_cxt.VfdCache[file].fd;
     }
 
-    io_context_t aio_context = CompltrContext(dList[0]->blockDesc.reqType, 0);
-
-    returnCode = FileAsyncSubmitIO<AioDispatchDesc_t**>(aio_context, dList, dn);
+    returnCode = FileAsyncSubmitIO<AioDispatchDesc_t**>(dList[0]->blockDesc.reqType, dList, dn);
     if (returnCode != dn) {
         ereport(PANIC, (errmsg("io_submit() async write failed %d, dispatch count(%d)", returnCode, dn)));
     }
@@ -2101,9 +2097,7 @@ int FileAsyncCURead(AioDispatchCUDesc_t** dList, int32 dn)
         dList[i]->aiocb.aio_fildes = u_sess->storage_cxt.VfdCache[file].fd;
     }
 
-    io_context_t aio_context = CompltrContext(dList[0]->cuDesc.reqType, 0);
-
-    returnCode = FileAsyncSubmitIO<AioDispatchCUDesc_t**>(aio_context, dList, dn);
+    returnCode = FileAsyncSubmitIO<AioDispatchCUDesc_t**>(dList[0]->cuDesc.reqType, dList, dn);
     if (returnCode != dn) {
         ereport(ERROR,
             (errcode_for_file_access(),
@@ -2146,9 +2140,7 @@ int FileAsyncCUWrite(AioDispatchCUDesc_t** dList, int32 dn)
         dList[i]->aiocb.aio_fildes = u_sess->storage_cxt.VfdCache[file].fd;
     }
 
-    io_context_t aio_context = CompltrContext(dList[0]->cuDesc.reqType, 0);
-
-    returnCode = FileAsyncSubmitIO<AioDispatchCUDesc_t**>(aio_context, dList, dn);
+    returnCode = FileAsyncSubmitIO<AioDispatchCUDesc_t**>(dList[0]->cuDesc.reqType, dList, dn);
     if (returnCode != dn) {
         ereport(PANIC, (errmsg("io_submit() async cu write failed %d, dispatch count(%d)", returnCode, dn)));
     }
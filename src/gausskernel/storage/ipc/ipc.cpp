@@ -69,6 +69,7 @@ extern void ShutdownPostgres(int code, Datum arg);
 extern void pq_close(int code, Datum arg);
 extern void AtProcExit_Files(int code, Datum arg);
 extern void audit_processlogout(int code, Datum arg);
+extern void AtSessExit_CatCache(int code, Datum arg);
 extern void CancelAutoAnalyze();
 
 static const pg_on_exit_callback on_sess_exit_list[] = {
@@ -79,7 +80,9 @@ static const pg_on_exit_callback on_sess_exit_list[] = {
     MOTCleanupSession, 
     pq_close,
     AtProcExit_Files,
-    audit_processlogout
+    audit_processlogout,
+    // must be last, earlier callbacks may still hold catcache entries
+    AtSessExit_CatCache
 };
 
 static const int on_sess_exit_size = lengthof(on_sess_exit_list);
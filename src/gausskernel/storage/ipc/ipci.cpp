@@ -59,6 +59,7 @@
 #include "storage/cstorealloc.h"
 #include "storage/cucache_mgr.h"
 #include "storage/dfs/dfs_connector.h"
+#include "utils/globalcatcache.h"
 #include "utils/memprot.h"
 
 /* we use semaphore not LWLOCK, because when thread InitGucConfig, it does not get a t_thrd.proc */
@@ -277,6 +278,11 @@ void CreateSharedMemoryAndSemaphores(bool makePrivate, int port)
      */
     CreateSharedInvalidationState();
 
+    /*
+     * Set up the global catalog cache, it is kept in sync by shared-inval messaging
+     */
+    InitGlobalCatCache();
+
     /*
      * Set up interprocess signaling mechanisms
      */
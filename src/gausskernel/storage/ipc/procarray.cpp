@@ -2338,6 +2338,41 @@ int BackendXidGetPid(TransactionId xid)
     return result;
 }
 
+/*
+ * TransactionIdIsRunningWithoutSubxids -- is xid a running top-level
+ * transaction with no live subtransaction XIDs
+ *
+ * Aborted subtransactions have been removed from the subxids cache, so only
+ * subtransactions whose changes may still commit are counted.  Logical
+ * decoding uses this to decide whether the changes of an in-progress
+ * transaction seen so far can be streamed as they are.
+ */
+bool TransactionIdIsRunningWithoutSubxids(TransactionId xid)
+{
+    bool result = false;
+    ProcArrayStruct* arrayP = g_instance.proc_array_idx;
+    int index;
+
+    if (xid == InvalidTransactionId) /* never match invalid xid */
+        return false;
+
+    LWLockAcquire(ProcArrayLock, LW_SHARED);
+
+    for (index = 0; index < arrayP->numProcs; index++) {
+        int pgprocno = arrayP->pgprocnos[index];
+        volatile PGXACT* pgxact = &g_instance.proc_base_all_xacts[pgprocno];
+
+        if (pgxact->xid == xid) {
+            result = (pgxact->nxids == 0);
+            break;
+        }
+    }
+
+    LWLockRelease(ProcArrayLock);
+
+    return result;
+}
+
 /*
  * IsBackendPid -- is a given pid a running backend
  */
@@ -65,7 +65,7 @@ typedef struct ProcSignalSlot {
  */
 #define NumProcSignalSlots                                                                                             \
     (g_instance.shmem_cxt.MaxBackends + NUM_AUXPROCTYPES + MAX_RECOVERY_THREAD_NUM + MAX_PAGE_WRITER_THREAD_NUM - 1 + \
-        g_instance.shmem_cxt.ThreadPoolGroupNum)
+        MAX_AIO_COMPLETER_THREAD_NUM - 1 + g_instance.shmem_cxt.ThreadPoolGroupNum)
 
 static ProcSignalSlot* g_libcomm_proc_signal_slots = NULL;
 bool CheckProcSignal(ProcSignalReason reason);
@@ -21,6 +21,7 @@
 #include "miscadmin.h"
 #include "storage/ipc.h"
 #include "storage/sinvaladt.h"
+#include "utils/globalcatcache.h"
 #include "utils/globalplancache.h"
 #include "utils/inval.h"
 #include "utils/plancache.h"
@@ -46,6 +47,11 @@ THR_LOCAL volatile sig_atomic_t catchupInterruptPending = false;
  */
 void SendSharedInvalidMessages(const SharedInvalidationMessage* msgs, int n)
 {
+    /* must precede the queue insertion, see GlobalCatCacheInvalMsg */
+    if (ENABLE_GLOBAL_CATCACHE) {
+        GlobalCatCacheInvalMsg(msgs, n);
+    }
+
     SIInsertDataEntries(msgs, n);
 
     if (ENABLE_DN_GPC) {
@@ -71,6 +71,11 @@
 #include "postgres.h"
 #include "knl/knl_variable.h"
 
+#include <sched.h>
+#ifdef __USE_NUMA
+#include <numa.h>
+#endif
+
 #include "access/clog.h"
 #include "access/csnlog.h"
 #include "access/multixact.h"
@@ -90,7 +95,9 @@
 #include "storage/spin.h"
 #include "storage/cucache_mgr.h"
 #include "utils/atomic.h"
+#include "utils/builtins.h"
 #include "instruments/instr_event.h"
+#include "portability/instr_time.h"
 #include "tsan_annotation.h"
 
 #define LW_FLAG_HAS_WAITERS ((uint32)1 << 30)
@@ -111,6 +118,24 @@
 const char **LWLockTrancheArray = NULL;
 int LWLockTranchesAllocated = 0;
 
+/*
+ * Always-on wait statistics per tranche, see GetLWLockWaitStat().
+ *
+ * Every acquisition bumps a counter, so acquisitions are counted in plain
+ * counters of our own PGPROC (lwAcquires) and summed up by whoever reads
+ * them.  Contended acquisitions are rare enough to go straight to a single
+ * shared copy.
+ */
+typedef struct LWLockSharedWaitStat {
+    pg_atomic_uint64 contended[2];
+    pg_atomic_uint64 wait_time[2];
+    pg_atomic_uint64 wait_hist[2][LWLOCK_WAIT_HIST_BUCKETS];
+    pg_atomic_uint32 next_sample;
+    LWLockHolderSample samples[LWLOCK_HOLDER_SAMPLES];
+} LWLockSharedWaitStat;
+
+static LWLockSharedWaitStat *LWLockWaitStats = NULL;
+
 /*
  * The array MainLWLockNames represents the name of individual locks
  * for LWLock in src/include/storage/lwlocknames.h.
@@ -137,6 +162,7 @@ static const char *BuiltinTrancheNames[] = {
     "InstrUserLockId",
     "GPCMappingLock",
     "GPCPrepareMappingLock",
+    "GlobalCatCacheLock",
     "BufferIOLock",
     "BufferContentLock",
     "DataCacheLock",
@@ -161,6 +187,29 @@ static void InitializeLWLocks(int numLocks);
 extern void LWLockReportWaitStart(LWLock *);
 extern void LWLockReportWaitEnd(void);
 
+/*
+ * NUMA-aware wakeup, for the tranches listed in lwlock_numa_tranches.
+ *
+ * On a release, an exclusive waiter that queued on the releaser's NUMA node
+ * is woken in preference to an exclusive waiter from another node at the
+ * head of the queue.  A remote waiter at the head can be passed over
+ * LWLOCK_NUMA_MAX_HANDOFFS times in a row at most, which bounds the
+ * unfairness.
+ *
+ * This only changes the order in which sleeping waiters are woken, it is not
+ * a cohort lock: the lock is still released, and the woken waiter competes
+ * with anybody acquiring it on the fast path, from any node.  So the lock
+ * tends to stay on one socket while it is contended, without any guarantee.
+ * The fast path is unchanged.  contrib/lwlock_bench and
+ * src/test/performance/lwlock_bench.sh measure whether it pays off.
+ */
+#define LWLOCK_NUMA_MAX_HANDOFFS 64
+#define LWLOCK_NUMA_MAX_CPUS 1024
+
+static bool LWLockNumaEnabled = false;
+static bool LWLockNumaTranche[LWTRANCHE_NATIVE_TRANCHE_NUM];
+static int8 LWLockCpuNumaNode[LWLOCK_NUMA_MAX_CPUS];
+
 #ifdef LWLOCK_STATS
 typedef struct lwlock_stats_key {
     int tranche;
@@ -389,6 +438,14 @@ void RequestAddinLWLocks(int n)
     t_thrd.storage_cxt.lock_addin_request += n;
 }
 
+static Size LWLockStatsShmemSize(void)
+{
+    Size size = mul_size(LWLOCK_STAT_SLOTS, sizeof(LWLockSharedWaitStat));
+
+    /* room for alignment */
+    return add_size(size, PG_CACHE_LINE_SIZE);
+}
+
 /*
  * Compute shmem space needed for LWLocks.
  */
@@ -403,9 +460,86 @@ Size LWLockShmemSize(void)
     /* Space for dynamic allocation counter, plus room for alignment. */
     size = add_size(size, 3 * sizeof(int) + LWLOCK_PADDED_SIZE);
 
+    /* Space for the wait statistics, see LWLockStatsShmemSize() */
+    size = add_size(size, LWLockStatsShmemSize());
+
     return size;
 }
 
+static int LWLockTrancheIdByName(const char *name)
+{
+    int i;
+    int builtInTrancheNum = (int)(sizeof(BuiltinTrancheNames) / sizeof(BuiltinTrancheNames[0]));
+
+    for (i = 0; i < NUM_INDIVIDUAL_LWLOCKS; i++) {
+        if (pg_strcasecmp(name, MainLWLockNames[i]) == 0) {
+            return i;
+        }
+    }
+    for (i = 0; i < builtInTrancheNum; i++) {
+        if (pg_strcasecmp(name, BuiltinTrancheNames[i]) == 0) {
+            return NUM_INDIVIDUAL_LWLOCKS + i;
+        }
+    }
+    return -1;
+}
+
+/*
+ * Build the CPU to NUMA node map and pick the NUMA-aware tranches.  Nothing
+ * is NUMA-aware on a machine with a single node.
+ */
+static void InitLWLockNuma(void)
+{
+    errno_t rc = memset_s(LWLockNumaTranche, sizeof(LWLockNumaTranche), 0, sizeof(LWLockNumaTranche));
+    securec_check(rc, "\0", "\0");
+    LWLockNumaEnabled = false;
+
+#ifdef __USE_NUMA
+    if (numa_available() < 0 || numa_max_node() <= 0) {
+        return;
+    }
+
+    for (int cpu = 0; cpu < LWLOCK_NUMA_MAX_CPUS; cpu++) {
+        int node = numa_node_of_cpu(cpu);
+        LWLockCpuNumaNode[cpu] = (int8)((node >= 0 && node <= PG_INT8_MAX) ? node : -1);
+    }
+    LWLockNumaEnabled = true;
+
+    char *rawstring = pstrdup(g_instance.attr.attr_storage.lwlock_numa_tranches);
+    List *elemlist = NIL;
+    ListCell *l = NULL;
+
+    if (!SplitIdentifierString(rawstring, ',', &elemlist)) {
+        ereport(WARNING, (errmsg("invalid list syntax in parameter \"lwlock_numa_tranches\"")));
+    } else {
+        foreach (l, elemlist) {
+            char *name = (char *)lfirst(l);
+            int trancheId = LWLockTrancheIdByName(name);
+
+            if (trancheId < 0) {
+                ereport(WARNING, (errmsg("unrecognized LWLock tranche \"%s\" in \"lwlock_numa_tranches\"", name)));
+                continue;
+            }
+            LWLockNumaTranche[trancheId] = true;
+        }
+    }
+    list_free(elemlist);
+    pfree(rawstring);
+#endif
+}
+
+static inline bool LWLockTrancheIsNumaAware(int tranche_id)
+{
+    return LWLockNumaEnabled && tranche_id >= 0 && tranche_id < LWTRANCHE_NATIVE_TRANCHE_NUM &&
+           LWLockNumaTranche[tranche_id];
+}
+
+static inline int8 LWLockCurrentNumaNode(void)
+{
+    int cpu = sched_getcpu();
+    return (cpu >= 0 && cpu < LWLOCK_NUMA_MAX_CPUS) ? LWLockCpuNumaNode[cpu] : -1;
+}
+
 /*
  * Allocate shmem space for LWLocks and initialize the locks.
  */
@@ -417,6 +551,8 @@ void CreateLWLocks(void)
     char *ptr = NULL;
 
     StaticAssertExpr(LW_VAL_EXCLUSIVE > (uint32)MAX_BACKENDS, "MAX_BACKENDS too big for lwlock.cpp");
+    InitLWLockNuma();
+
     /* Allocate space */
     ptr = (char *)ShmemAlloc(spaceLocks);
 
@@ -435,6 +571,14 @@ void CreateLWLocks(void)
     LWLockCounter[0] = (int)NumFixedLWLocks;
     LWLockCounter[1] = numLocks;
 
+    /* the wait statistics follow the lock array */
+    ptr += mul_size(numLocks, sizeof(LWLockPadded));
+    ptr = (char *)TYPEALIGN(PG_CACHE_LINE_SIZE, ptr);
+    Size statsSize = LWLockStatsShmemSize() - PG_CACHE_LINE_SIZE;
+    errno_t rc = memset_s(ptr, statsSize, 0, statsSize);
+    securec_check(rc, "\0", "\0");
+    LWLockWaitStats = (LWLockSharedWaitStat *)ptr;
+
     InitializeLWLocks(numLocks);
     RegisterLWLockTranches();
 }
@@ -514,6 +658,10 @@ static void InitializeLWLocks(int numLocks)
         LWLockInitialize(&lock->lock, LWTRANCHE_GPC_PREPARE_MAPPING);
     }
 
+    for (id = 0; id < NUM_GLOBAL_CATCACHE_PARTITIONS; id++, lock++) {
+        LWLockInitialize(&lock->lock, LWTRANCHE_GLOBAL_CATCACHE);
+    }
+
     Assert((lock - t_thrd.shemem_ptr_cxt.mainLWLockArray) == NumFixedLWLocks);
 
     for (id = NumFixedLWLocks; id < numLocks; id++, lock++) {
@@ -530,6 +678,136 @@ const char *GetBuiltInTrancheName(int trancheId)
     return BuiltinTrancheNames[offset];
 }
 
+static inline int LWLockStatSlot(const LWLock *lock)
+{
+    return (lock->tranche >= 0 && lock->tranche < LWTRANCHE_NATIVE_TRANCHE_NUM) ? lock->tranche
+                                                                                 : LWLOCK_STAT_SLOTS - 1;
+}
+
+/*
+ * Count one acquisition of the lock, contended or not.  Only we write our
+ * PGPROC's counters, so a plain increment does; a reader may see a slightly
+ * stale value.  Threads without a PGPROC (bootstrap, shared memory setup)
+ * are not counted.
+ */
+static inline void LWLockCountAcquire(const LWLock *lock, LWLockMode mode)
+{
+    PGPROC *proc = t_thrd.proc;
+
+    if (likely(proc != NULL)) {
+        proc->lwAcquires[LWLockStatSlot(lock)][mode]++;
+    }
+}
+
+/*
+ * Record the exclusive holder of the lock for LWLockSampleHolder().  We hold
+ * the lock exclusively, so nobody else writes the field until we release it;
+ * the write shares the cache line that acquiring the lock just dirtied.
+ */
+static inline void LWLockSetOwner(LWLock *lock, LWLockMode mode)
+{
+    if (mode == LW_EXCLUSIVE) {
+        lock->owner = t_thrd.proc;
+    }
+}
+
+/*
+ * Remember who held the lock when we had to start waiting for it.  Only an
+ * exclusive holder is known: every exclusive acquisition records itself as
+ * owner and clears it on release, while shared holders are not tracked at
+ * all, so a wait behind shared holders samples no holder.  The owner may
+ * be stale, releasing the lock or gone by now; this is a best effort hint
+ * for finding out what keeps a lock busy, nothing more.
+ */
+static void LWLockSampleHolder(const LWLock *lock, LWLockHolderSample *sample)
+{
+    uint32 state = pg_atomic_read_u32((pg_atomic_uint32 *)&lock->state);
+    PGPROC *owner = lock->owner;
+
+    sample->holder_tid = 0;
+    sample->holder_query_id = 0;
+    sample->holder_wait_event = 0;
+    if ((state & LW_VAL_EXCLUSIVE) == 0 || owner == NULL || owner == t_thrd.proc) {
+        return;
+    }
+
+    volatile PgBackendStatus *beentry = owner->statusEntry;
+    sample->holder_tid = owner->pid;
+    if (beentry != NULL) {
+        sample->holder_query_id = beentry->st_queryid;
+        sample->holder_wait_event = beentry->st_waitevent;
+    }
+}
+
+/* account a contended acquisition which waited for wait_us microseconds */
+static void LWLockCountWait(const LWLock *lock, LWLockMode mode, int64 wait_us, LWLockHolderSample *sample)
+{
+    if (LWLockWaitStats == NULL) {
+        return;
+    }
+
+    LWLockSharedWaitStat *stat = &LWLockWaitStats[LWLockStatSlot(lock)];
+    int bucket = (wait_us <= 0) ? 0 : (64 - __builtin_clzll((uint64)wait_us));
+    if (bucket >= LWLOCK_WAIT_HIST_BUCKETS) {
+        bucket = LWLOCK_WAIT_HIST_BUCKETS - 1;
+    }
+
+    pg_atomic_fetch_add_u64(&stat->contended[mode], 1);
+    pg_atomic_fetch_add_u64(&stat->wait_time[mode], (uint64)Max(wait_us, 0));
+    pg_atomic_fetch_add_u64(&stat->wait_hist[mode][bucket], 1);
+
+    /* samples are overwritten round-robin, readers may see a torn one, which is harmless */
+    sample->waiter_mode = mode;
+    sample->wait_us = wait_us;
+    uint32 idx = pg_atomic_fetch_add_u32(&stat->next_sample, 1);
+    stat->samples[idx % LWLOCK_HOLDER_SAMPLES] = *sample;
+}
+
+const char *GetLWLockStatSlotName(int slot)
+{
+    Assert(slot >= 0 && slot < LWLOCK_STAT_SLOTS);
+    if (slot < NUM_INDIVIDUAL_LWLOCKS) {
+        return MainLWLockNames[slot];
+    } else if (slot < LWTRANCHE_NATIVE_TRANCHE_NUM) {
+        return GetBuiltInTrancheName(slot);
+    }
+    return "extension";
+}
+
+/*
+ * GetLWLockWaitStat - copy out the wait statistics of one slot
+ *
+ * Slots below LWTRANCHE_NATIVE_TRANCHE_NUM are tranche ids, the last slot
+ * sums up all dynamically registered tranches.  The counters are read
+ * without any lock, so they are not a consistent snapshot of each other.
+ * acquires is left zero: those counts live in the PGPROCs (lwAcquires) and
+ * are summed up by the caller.
+ */
+void GetLWLockWaitStat(int slot, LWLockWaitStat *stat)
+{
+    errno_t rc = memset_s(stat, sizeof(LWLockWaitStat), 0, sizeof(LWLockWaitStat));
+    securec_check(rc, "\0", "\0");
+
+    if (LWLockWaitStats == NULL || slot < 0 || slot >= LWLOCK_STAT_SLOTS) {
+        return;
+    }
+
+    for (int mode = LW_EXCLUSIVE; mode <= LW_SHARED; mode++) {
+        LWLockSharedWaitStat *shared = &LWLockWaitStats[slot];
+        stat->contended[mode] = pg_atomic_read_u64(&shared->contended[mode]);
+        stat->wait_time[mode] = pg_atomic_read_u64(&shared->wait_time[mode]);
+        for (int b = 0; b < LWLOCK_WAIT_HIST_BUCKETS; b++) {
+            stat->wait_hist[mode][b] = pg_atomic_read_u64(&shared->wait_hist[mode][b]);
+        }
+    }
+
+    uint32 nsamples = pg_atomic_read_u32(&LWLockWaitStats[slot].next_sample);
+    stat->nsamples = (int)Min(nsamples, LWLOCK_HOLDER_SAMPLES);
+    for (int i = 0; i < stat->nsamples; i++) {
+        stat->samples[i] = LWLockWaitStats[slot].samples[i];
+    }
+}
+
 /*
  * Return an identifier for an LWLock based on the wait class and event.
  */
@@ -645,6 +923,7 @@ LWLock *LWLockAssign(int trancheId)
     result = &t_thrd.shemem_ptr_cxt.mainLWLockArray[LWLockCounter[0]++].lock;
     SpinLockRelease(t_thrd.shemem_ptr_cxt.ShmemLock);
     result->tranche = trancheId;
+    result->numa_aware = LWLockTrancheIsNumaAware(trancheId);
     return result;
 }
 
@@ -662,10 +941,26 @@ void LWLockInitialize(LWLock *lock, int tranche_id)
 #ifdef LOCK_DEBUG
     pg_atomic_init_u32(&lock->nwaiters, 0);
 #endif
+    lock->owner = NULL;
     lock->tranche = tranche_id;
+    lock->numa_aware = LWLockTrancheIsNumaAware(tranche_id);
+    lock->numa_handoffs = 0;
     dlist_init(&lock->waiters);
 }
 
+/*
+ * LWLockSetNumaAware - turn NUMA-aware wakeup on or off for one lock
+ *
+ * For locks that do not belong to a tranche listed in lwlock_numa_tranches,
+ * e.g. those a loadable module keeps in its own memory. It has no effect on
+ * a single-node machine. Must be called before the lock is first used.
+ */
+void LWLockSetNumaAware(LWLock *lock, bool numa_aware)
+{
+    lock->numa_aware = numa_aware && LWLockNumaEnabled;
+    lock->numa_handoffs = 0;
+}
+
 static void LWThreadSuicide(PGPROC *proc, int extraWaits, LWLock *lock, LWLockMode mode)
 {
     if (!proc->lwIsVictim) {
@@ -837,6 +1132,45 @@ static void LWLockWaitListUnlock(LWLock *lock)
     }
 }
 
+/*
+ * Move the first exclusive waiter that queued on our NUMA node in front of
+ * the first waiter, if that one is an exclusive waiter from another node.
+ * Shared waiters are all woken together anyway. Caller holds the wait list
+ * lock.
+ */
+static void LWLockNumaPromoteWaiter(LWLock *lock, int8 node)
+{
+    PGPROC *head = NULL;
+    dlist_iter iter;
+
+    dlist_foreach(iter, &lock->waiters)
+    {
+        PGPROC *waiter = dlist_container(PGPROC, lwWaitLink, iter.cur);
+
+        /* they are at the front of the queue and always woken */
+        if (waiter->lwWaitMode == LW_WAIT_UNTIL_FREE) {
+            continue;
+        }
+
+        if (head == NULL) {
+            if (waiter->lwWaitMode != LW_EXCLUSIVE || waiter->lwWaitNode == node ||
+                lock->numa_handoffs >= LWLOCK_NUMA_MAX_HANDOFFS) {
+                lock->numa_handoffs = 0;
+                return;
+            }
+            head = waiter;
+        } else if (waiter->lwWaitMode == LW_EXCLUSIVE && waiter->lwWaitNode == node) {
+            dlist_delete(&waiter->lwWaitLink);
+            dlist_insert_before(&head->lwWaitLink, &waiter->lwWaitLink);
+            lock->numa_handoffs++;
+            return;
+        }
+    }
+
+    /* nobody from our node is waiting */
+    lock->numa_handoffs = 0;
+}
+
 /*
  * Wakeup all the lockers that currently have a chance to acquire the lock.
  */
@@ -846,12 +1180,17 @@ static void LWLockWakeup(LWLock *lock)
     bool wokeup_somebody = false;
     dlist_head wakeup;
     dlist_mutable_iter iter;
+    int8 node = lock->numa_aware ? LWLockCurrentNumaNode() : -1;
 
     dlist_init(&wakeup);
 
     /* lock wait list while collecting backends to wake up */
     LWLockWaitListLock(lock);
 
+    if (node >= 0) {
+        LWLockNumaPromoteWaiter(lock, node);
+    }
+
     dlist_foreach_modify(iter, &lock->waiters)
     {
         PGPROC *waiter = dlist_container(PGPROC, lwWaitLink, iter.cur);
@@ -960,6 +1299,8 @@ static void LWLockQueueSelf(LWLock *lock, LWLockMode mode)
         ereport(PANIC, (errcode(ERRCODE_DATA_CORRUPTED), errmsg("queueing for lock while waiting on another one")));
     }
 
+    int8 node = lock->numa_aware ? LWLockCurrentNumaNode() : -1;
+
     LWLockWaitListLock(lock);
 
     /* setting the flag is protected by the spinlock */
@@ -967,6 +1308,7 @@ static void LWLockQueueSelf(LWLock *lock, LWLockMode mode)
 
     t_thrd.proc->lwWaiting = true;
     t_thrd.proc->lwWaitMode = mode;
+    t_thrd.proc->lwWaitNode = node;
 
     /* LW_WAIT_UNTIL_FREE waiters are always at the front of the queue */
     if (mode == LW_WAIT_UNTIL_FREE) {
@@ -1134,6 +1476,8 @@ bool LWLockAcquire(LWLock *lock, LWLockMode mode, bool need_update_lockid)
     PGPROC *proc = t_thrd.proc;
     bool result = true;
     int extraWaits = 0;
+    instr_time waitStart;
+    LWLockHolderSample holder = {0};
 #ifdef LWLOCK_STATS
     lwlock_stats *lwstats = NULL;
 
@@ -1143,6 +1487,7 @@ bool LWLockAcquire(LWLock *lock, LWLockMode mode, bool need_update_lockid)
     AssertArg(mode == LW_SHARED || mode == LW_EXCLUSIVE);
 
     PRINT_LWDEBUG("LWLockAcquire", lock, mode);
+    INSTR_TIME_SET_ZERO(waitStart);
 
 #ifdef LWLOCK_STATS
     /* Count lock acquisition attempts */
@@ -1250,6 +1595,12 @@ bool LWLockAcquire(LWLock *lock, LWLockMode mode, bool need_update_lockid)
         lwstats->block_count++;
 #endif
 
+        /* the wait time of a contended acquisition counts from the first sleep */
+        if (result) {
+            INSTR_TIME_SET_CURRENT(waitStart);
+            LWLockSampleHolder(lock, &holder);
+        }
+
         LWLockReportWaitStart(lock);
         TRACE_POSTGRESQL_LWLOCK_WAIT_START(T_NAME(lock), mode);
         for (;;) {
@@ -1288,6 +1639,16 @@ bool LWLockAcquire(LWLock *lock, LWLockMode mode, bool need_update_lockid)
 
     TRACE_POSTGRESQL_LWLOCK_ACQUIRE(T_NAME(lock), mode);
 
+    LWLockCountAcquire(lock, mode);
+    LWLockSetOwner(lock, mode);
+    if (!result) {
+        instr_time waitTime;
+
+        INSTR_TIME_SET_CURRENT(waitTime);
+        INSTR_TIME_SUBTRACT(waitTime, waitStart);
+        LWLockCountWait(lock, mode, (int64)INSTR_TIME_GET_MICROSEC(waitTime), &holder);
+    }
+
     forget_lwlock_acquire();
 
     /* Add lock to list of locks held by this backend */
@@ -1344,6 +1705,8 @@ bool LWLockConditionalAcquire(LWLock *lock, LWLockMode mode)
         t_thrd.storage_cxt.held_lwlocks[t_thrd.storage_cxt.num_held_lwlocks].lock = lock;
         t_thrd.storage_cxt.held_lwlocks[t_thrd.storage_cxt.num_held_lwlocks++].mode = mode;
         TRACE_POSTGRESQL_LWLOCK_CONDACQUIRE(T_NAME(lock), mode);
+        LWLockCountAcquire(lock, mode);
+        LWLockSetOwner(lock, mode);
     }
     return !mustwait;
 }
@@ -1465,6 +1828,7 @@ bool LWLockAcquireOrWait(LWLock *lock, LWLockMode mode)
         t_thrd.storage_cxt.held_lwlocks[t_thrd.storage_cxt.num_held_lwlocks].lock = lock;
         t_thrd.storage_cxt.held_lwlocks[t_thrd.storage_cxt.num_held_lwlocks++].mode = mode;
         TRACE_POSTGRESQL_LWLOCK_WAIT_UNTIL_FREE(T_NAME(lock), mode);
+        LWLockSetOwner(lock, mode);
     }
 
     return !mustwait;
@@ -1698,6 +2062,8 @@ void LWLockRelease(LWLock *lock)
      * Release my hold on lock, after that it can immediately be acquired by
      * others, even if we still have to wakeup other waiters. */
     if (mode == LW_EXCLUSIVE) {
+        /* clear the owner while nobody else can set it, see LWLockSetOwner() */
+        lock->owner = NULL;
         /* ENABLE_THREAD_CHECK only, Must release vector clock info to other
          * threads before unlock */
         TsAnnotateRWLockReleased(&lock->rwlock, 1);
@@ -1810,8 +2176,8 @@ void LWLockReset(LWLock *lock)
 
 #ifdef LOCK_DEBUG
     pg_atomic_init_u32(&lock->nwaiters, 0);
-    lock->owner = NULL;
 #endif
+    lock->owner = NULL;
     dlist_init(&lock->waiters);
 }
 
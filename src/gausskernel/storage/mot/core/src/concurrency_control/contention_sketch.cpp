@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * contention_sketch.cpp
+ *    Approximate per-key abort counters used to detect hot keys.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/concurrency_control/contention_sketch.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "contention_sketch.h"
+
+namespace MOT {
+constexpr uint32_t ContentionSketch::SKETCH_DEPTH;
+constexpr uint32_t ContentionSketch::SKETCH_WIDTH;
+constexpr uint64_t ContentionSketch::DECAY_PERIOD;
+
+const uint64_t ContentionSketch::SEEDS[SKETCH_DEPTH] = {
+    0x9E3779B97F4A7C15ULL, 0xC2B2AE3D27D4EB4FULL, 0x165667B19E3779F9ULL, 0xD6E8FEB86659FD93ULL};
+
+ContentionSketch::ContentionSketch() : m_abortCount(0), m_hotKeyCount(0), m_maxEstimate(0)
+{
+    for (uint32_t row = 0; row < SKETCH_DEPTH; row++) {
+        for (uint32_t i = 0; i < SKETCH_WIDTH; i++) {
+            m_counters[row][i].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+ContentionSketch& ContentionSketch::GetInstance()
+{
+    static ContentionSketch sketch;
+    return sketch;
+}
+
+void ContentionSketch::RecordAbort(const void* key, uint32_t threshold)
+{
+    uint32_t estimate = UINT32_MAX;
+    for (uint32_t row = 0; row < SKETCH_DEPTH; row++) {
+        uint32_t value = m_counters[row][Slot(key, row)].fetch_add(1, std::memory_order_relaxed) + 1;
+        if (value < estimate) {
+            estimate = value;
+        }
+    }
+
+    if (threshold != 0 && estimate == threshold) {
+        m_hotKeyCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint32_t maxEstimate = m_maxEstimate.load(std::memory_order_relaxed);
+    while (estimate > maxEstimate &&
+           !m_maxEstimate.compare_exchange_weak(maxEstimate, estimate, std::memory_order_relaxed)) {
+    }
+
+    // only the thread that completes a period decays, concurrent increments may be halved as well
+    if ((m_abortCount.fetch_add(1, std::memory_order_relaxed) + 1) % DECAY_PERIOD == 0) {
+        Decay();
+    }
+}
+
+uint32_t ContentionSketch::Estimate(const void* key) const
+{
+    uint32_t estimate = UINT32_MAX;
+    for (uint32_t row = 0; row < SKETCH_DEPTH; row++) {
+        uint32_t value = m_counters[row][Slot(key, row)].load(std::memory_order_relaxed);
+        if (value < estimate) {
+            estimate = value;
+        }
+    }
+    return estimate;
+}
+
+void ContentionSketch::Decay()
+{
+    for (uint32_t row = 0; row < SKETCH_DEPTH; row++) {
+        for (uint32_t i = 0; i < SKETCH_WIDTH; i++) {
+            uint32_t value = m_counters[row][i].load(std::memory_order_relaxed);
+            if (value != 0) {
+                m_counters[row][i].store(value >> 1, std::memory_order_relaxed);
+            }
+        }
+    }
+    m_hotKeyCount.store(0, std::memory_order_relaxed);
+    m_maxEstimate.store(0, std::memory_order_relaxed);
+}
+}  // namespace MOT
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * contention_sketch.h
+ *    Approximate per-key abort counters used to detect hot keys.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/concurrency_control/contention_sketch.h
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef CONTENTION_SKETCH_H
+#define CONTENTION_SKETCH_H
+
+#include <atomic>
+#include <cstdint>
+
+namespace MOT {
+/**
+ * @class ContentionSketch
+ * @brief Count-min sketch of commit-validation aborts keyed by sentinel address.
+ * @detail Each abort increments one counter in every row of the sketch, and the estimate for a key
+ * is the minimum over its counters, so collisions can only over-estimate. Counters are halved every
+ * DECAY_PERIOD recorded aborts so that keys which stopped conflicting cool down again. The sketch
+ * is shared by all sessions and updated with relaxed atomics; it is only written on the abort path.
+ * Keys are never dereferenced, so stale sentinel addresses are harmless.
+ */
+class ContentionSketch {
+public:
+    /** @var Number of hash rows. */
+    static constexpr uint32_t SKETCH_DEPTH = 4;
+
+    /** @var Number of counters per row (power of 2). */
+    static constexpr uint32_t SKETCH_WIDTH = 4096;
+
+    /** @var Number of recorded aborts between two decay rounds. */
+    static constexpr uint64_t DECAY_PERIOD = 64 * 1024;
+
+    /** @brief Retrieves the global contention sketch. */
+    static ContentionSketch& GetInstance();
+
+    /**
+     * @brief Records a validation abort caused by the given key.
+     * @param key The conflicting key (sentinel address).
+     * @param threshold The hot key threshold, used to count keys becoming hot.
+     */
+    void RecordAbort(const void* key, uint32_t threshold);
+
+    /**
+     * @brief Retrieves the estimated number of recent aborts caused by the given key.
+     * @param key The key (sentinel address).
+     */
+    uint32_t Estimate(const void* key) const;
+
+    /**
+     * @brief Queries whether the given key is hot.
+     * @param key The key (sentinel address).
+     * @param threshold The hot key threshold. Zero means no key is ever hot.
+     */
+    inline bool IsHot(const void* key, uint32_t threshold) const
+    {
+        return (threshold != 0) && (Estimate(key) >= threshold);
+    }
+
+    /** @brief Retrieves the number of keys that became hot since the last decay round. */
+    inline uint64_t GetHotKeyCount() const
+    {
+        return m_hotKeyCount.load(std::memory_order_relaxed);
+    }
+
+    /** @brief Retrieves the highest estimate recorded since the last decay round. */
+    inline uint32_t GetMaxEstimate() const
+    {
+        return m_maxEstimate.load(std::memory_order_relaxed);
+    }
+
+    /** @brief Retrieves the total number of recorded aborts. */
+    inline uint64_t GetAbortCount() const
+    {
+        return m_abortCount.load(std::memory_order_relaxed);
+    }
+
+private:
+    ContentionSketch();
+
+    ~ContentionSketch()
+    {}
+
+    /** @brief Computes the counter index of a key in the given row. */
+    static inline uint32_t Slot(const void* key, uint32_t row)
+    {
+        uint64_t h = (reinterpret_cast<uint64_t>(key) >> 4) * SEEDS[row];
+        return (uint32_t)(h >> 32) & (SKETCH_WIDTH - 1);
+    }
+
+    /** @brief Halves all counters. */
+    void Decay();
+
+    /** @var Per-row multiplicative hash seeds. */
+    static const uint64_t SEEDS[SKETCH_DEPTH];
+
+    /** @var The counters. */
+    std::atomic<uint32_t> m_counters[SKETCH_DEPTH][SKETCH_WIDTH];
+
+    /** @var Total number of recorded aborts. */
+    std::atomic<uint64_t> m_abortCount;
+
+    /** @var Number of keys that crossed the hot threshold since the last decay round. */
+    std::atomic<uint64_t> m_hotKeyCount;
+
+    /** @var Highest estimate seen since the last decay round. */
+    std::atomic<uint32_t> m_maxEstimate;
+};
+}  // namespace MOT
+
+#endif /* CONTENTION_SKETCH_H */
@@ -33,6 +33,8 @@
 #include "checkpoint_manager.h"
 #include "mm_session_api.h"
 #include "mot_error.h"
+#include "contention_sketch.h"
+#include "db_session_statistics.h"
 #include <pthread.h>
 
 namespace MOT {
@@ -41,6 +43,9 @@ DECLARE_LOGGER(OccTransactionManager, ConcurrenyControl);
 OccTransactionManager::OccTransactionManager()
     : m_txnCounter(0),
       m_abortsCounter(0),
+      m_earlyLockCount(0),
+      m_hotKeyThreshold(0),
+      m_conflictSentinel(nullptr),
       m_writeSetSize(0),
       m_rowsSetSize(0),
       m_deleteSetSize(0),
@@ -48,7 +53,8 @@ OccTransactionManager::OccTransactionManager()
       m_dynamicSleep(100),
       m_rowsLocked(false),
       m_preAbort(true),
-      m_validationNoWait(true)
+      m_validationNoWait(true),
+      m_hotKeyEarlyLock(false)
 {}
 
 OccTransactionManager::~OccTransactionManager()
@@ -101,6 +107,7 @@ bool OccTransactionManager::ValidateReadSet(TxnManager* txMan)
             continue;
         }
         if (!ac->GetRowFromHeader()->m_rowHeader.ValidateRead(ac->m_tid)) {
+            m_conflictSentinel = ac->m_origSentinel;
             return false;
         }
     }
@@ -118,6 +125,7 @@ bool OccTransactionManager::ValidateWriteSet(TxnManager* txMan)
         }
 
         if (!ac->GetRowFromHeader()->m_rowHeader.ValidateWrite(ac->m_tid)) {
+            m_conflictSentinel = ac->m_origSentinel;
             return false;
         }
     }
@@ -160,7 +168,9 @@ RC OccTransactionManager::LockHeaders(TxnManager* txMan, uint32_t& numSentinelsL
                     continue;
                 }
                 Sentinel* sent = ac->m_origSentinel;
-                if (!sent->TryLock(thdId)) {
+                // hot keys may already be locked since first access
+                if (!ac->m_params.IsEarlyLocked() && !sent->TryLock(thdId)) {
+                    m_conflictSentinel = sent;
                     break;
                 }
                 numSentinelsLock++;
@@ -170,6 +180,7 @@ RC OccTransactionManager::LockHeaders(TxnManager* txMan, uint32_t& numSentinelsL
                 // New insert row is already commited!
                 // Check if row has chainged in sentinel
                 if (!QuickHeaderValidation(ac)) {
+                    m_conflictSentinel = sent;
                     rc = RC_ABORT;
                     goto final;
                 }
@@ -182,6 +193,7 @@ RC OccTransactionManager::LockHeaders(TxnManager* txMan, uint32_t& numSentinelsL
                     for (const auto& acPair : orderedSet) {
                         const Access* ac = acPair.second;
                         if (!QuickHeaderValidation(ac)) {
+                            m_conflictSentinel = ac->m_origSentinel;
                             return RC_ABORT;
                         }
                     }
@@ -214,6 +226,7 @@ RC OccTransactionManager::LockHeaders(TxnManager* txMan, uint32_t& numSentinelsL
             // New insert row is already commited!
             // Check if row has chainged in sentinel
             if (!QuickHeaderValidation(ac)) {
+                m_conflictSentinel = sent;
                 rc = RC_ABORT;
                 goto final;
             }
@@ -235,6 +248,7 @@ RC OccTransactionManager::ValidateOcc(TxnManager* txMan)
     m_rowsSetSize = 0;
     m_deleteSetSize = 0;
     m_insertSetSize = 0;
+    m_conflictSentinel = nullptr;
     m_txnCounter++;
 
     if (rowCount == 0) {
@@ -267,6 +281,7 @@ RC OccTransactionManager::ValidateOcc(TxnManager* txMan)
                 if (txMan->GetTxnIsoLevel() > READ_COMMITED) {
                     readSetSize++;
                     if (m_preAbort && !QuickVersionCheck(ac)) {
+                        m_conflictSentinel = ac->m_origSentinel;
                         rc = RC_ABORT;
                         goto final;
                     }
@@ -278,6 +293,7 @@ RC OccTransactionManager::ValidateOcc(TxnManager* txMan)
 
         if (m_preAbort) {
             if (!QuickHeaderValidation(ac)) {
+                m_conflictSentinel = ac->m_origSentinel;
                 rc = RC_ABORT;
                 goto final;
             }
@@ -307,6 +323,7 @@ final:
     if (__builtin_expect(rc == RC_ABORT, 0)) {
         ReleaseHeaderLocks(txMan, numSentinelLock);
         m_abortsCounter++;
+        RecordAbort();
     } else {
         MOT_ASSERT(numSentinelLock == m_writeSetSize);
         m_rowsLocked = true;
@@ -457,7 +474,10 @@ void OccTransactionManager::ReleaseHeaderLocks(TxnManager* txMan, uint32_t numOf
             continue;
         } else {
             numOfLocks--;
-            access->m_origSentinel->Release();
+            // early locks are held until the transaction ends
+            if (!access->m_params.IsEarlyLocked()) {
+                access->m_origSentinel->Release();
+            }
         }
         if (!numOfLocks) {
             break;
@@ -465,6 +485,74 @@ void OccTransactionManager::ReleaseHeaderLocks(TxnManager* txMan, uint32_t numOf
     }
 }
 
+void OccTransactionManager::RecordAbort()
+{
+    if (m_conflictSentinel != nullptr) {
+        ContentionSketch::GetInstance().RecordAbort(m_conflictSentinel, m_hotKeyThreshold);
+        m_conflictSentinel = nullptr;
+    }
+    DbSessionStatisticsProvider::GetInstance().AddOccAbort();
+}
+
+bool OccTransactionManager::TryEarlyLock(TxnManager* txMan, Sentinel* sentinel)
+{
+    // with waiting validation two early lockers could wait for each other forever
+    if (!m_hotKeyEarlyLock || !m_validationNoWait) {
+        return false;
+    }
+    if (!ContentionSketch::GetInstance().IsHot(sentinel, m_hotKeyThreshold)) {
+        return false;
+    }
+
+    uint64_t thdId = txMan->GetThdId();
+    for (uint32_t i = 0; i < EARLY_LOCK_SPIN_COUNT; i++) {
+        if (sentinel->TryLock(thdId)) {
+            return true;
+        }
+        PAUSE
+    }
+    return false;
+}
+
+void OccTransactionManager::SetEarlyLocked(Access* access)
+{
+    MOT_ASSERT(access->m_origSentinel->IsLocked() == true);
+    access->m_params.SetEarlyLocked();
+    m_earlyLockCount++;
+    DbSessionStatisticsProvider::GetInstance().AddHotKeyEarlyLock();
+}
+
+void OccTransactionManager::ReleaseEarlyLocks(TxnManager* txMan)
+{
+    if (m_earlyLockCount == 0) {
+        return;
+    }
+
+    TxnOrderedSet_t& orderedSet = txMan->m_accessMgr->GetOrderedRowSet();
+    for (const auto& raPair : orderedSet) {
+        Access* access = raPair.second;
+        if (access->m_params.IsEarlyLocked()) {
+            access->m_params.UnsetEarlyLocked();
+            access->m_origSentinel->Release();
+            if (--m_earlyLockCount == 0) {
+                break;
+            }
+        }
+    }
+    MOT_ASSERT(m_earlyLockCount == 0);
+    m_earlyLockCount = 0;
+}
+
+void OccTransactionManager::ReleaseEarlyLock(Access* access)
+{
+    if (access->m_params.IsEarlyLocked()) {
+        access->m_params.UnsetEarlyLocked();
+        access->m_origSentinel->Release();
+        MOT_ASSERT(m_earlyLockCount > 0);
+        m_earlyLockCount--;
+    }
+}
+
 void OccTransactionManager::ReleaseRowsLocks(TxnManager* txMan, uint32_t numOfLocks)
 {
     if (numOfLocks == 0) {
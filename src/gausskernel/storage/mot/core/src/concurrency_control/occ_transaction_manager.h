@@ -30,8 +30,12 @@
 namespace MOT {
 // forward declaration
 class Access;
+class Sentinel;
 
 constexpr uint64_t LOCK_TIME_OUT = 1 << 16;
+
+/** @var Number of lock attempts when early locking a hot key before falling back to OCC. */
+constexpr uint32_t EARLY_LOCK_SPIN_COUNT = 64;
 /**
  * @class OccTransactionManager
  * @brief Optimistic concurrency control implementation.
@@ -72,6 +76,48 @@ public:
         m_validationNoWait = b;
     }
 
+    /**
+     * @brief Configures hot key detection and handling.
+     * @param threshold Number of recent validation aborts after which a key is considered hot.
+     * @param earlyLock Specifies whether hot keys are write-locked on first access.
+     */
+    void SetHotKeyPolicy(uint32_t threshold, bool earlyLock)
+    {
+        m_hotKeyThreshold = threshold;
+        m_hotKeyEarlyLock = earlyLock;
+    }
+
+    /**
+     * @brief Attempts to write-lock a hot key when it is first accessed for update.
+     * @detail Keys that repeatedly caused validation aborts are locked pessimistically, so the
+     * transaction does not race on them again during commit. The attempt is bounded, and fails if
+     * early locking is disabled, the key is not hot, or validation uses waiting locks (which could
+     * deadlock against early locks).
+     * @param txMan The accessing transaction.
+     * @param sentinel The primary sentinel of the accessed row.
+     * @return True if the sentinel is now locked by the transaction.
+     */
+    bool TryEarlyLock(TxnManager* txMan, Sentinel* sentinel);
+
+    /**
+     * @brief Marks an access as holding an early lock on its sentinel.
+     * @param access The access created for the locked sentinel.
+     */
+    void SetEarlyLocked(Access* access);
+
+    /**
+     * @brief Releases all early locks held by the transaction.
+     * @param txMan The transaction.
+     */
+    void ReleaseEarlyLocks(TxnManager* txMan);
+
+    /**
+     * @brief Releases the early lock of a single access, if it holds one.
+     * Used when the access is discarded before commit or rollback.
+     * @param access The access about to be released.
+     */
+    void ReleaseEarlyLock(Access* access);
+
     /**
      * @brief Performs OCC validation for a transaction commit.
      * @param tx The committed transaction.
@@ -99,6 +145,7 @@ public:
     {
         if (m_rowsLocked) {
             ReleaseHeaderLocks(txMan, m_writeSetSize);
+            ReleaseEarlyLocks(txMan);
             ReleaseRowsLocks(txMan, m_rowsSetSize);
             m_rowsLocked = false;
         }
@@ -108,6 +155,7 @@ public:
     {
         if (m_rowsLocked) {
             ReleaseHeaderLocks(txMan, m_writeSetSize);
+            ReleaseEarlyLocks(txMan);
             m_rowsLocked = false;
         }
     }
@@ -162,6 +210,10 @@ private:
     /** @brief Validate Header for insert   */
     bool QuickHeaderValidation(const Access* access);
 
+    /** @brief Records a validation abort against the conflicting key. */
+    void RecordAbort();
+
+    /** release the locked headers, early locked headers are kept    */
     void ReleaseHeaderLocks(TxnManager* txMan, uint32_t numOfLocks);
     /** release all the locked rows    */
     void ReleaseRowsLocks(TxnManager* txMan, uint32_t numOfLocks);
@@ -177,6 +229,15 @@ private:
     /** @var aborts counter   */
     uint32_t m_abortsCounter;
 
+    /** @var Number of sentinels locked on first access. */
+    uint32_t m_earlyLockCount;
+
+    /** @var Hot key threshold (number of recent aborts). */
+    uint32_t m_hotKeyThreshold;
+
+    /** @var The sentinel that caused the last validation failure. */
+    const Sentinel* m_conflictSentinel;
+
     /** @var Write set size. */
     uint32_t m_writeSetSize;
 
@@ -199,6 +260,9 @@ private:
 
     /** @var Validate-no-wait configuration. */
     bool m_validationNoWait;
+
+    /** @var Hot key early lock configuration. */
+    bool m_hotKeyEarlyLock;
 };
 }  // namespace MOT
 
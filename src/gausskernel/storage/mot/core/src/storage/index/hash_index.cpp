@@ -0,0 +1,456 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * hash_index.cpp
+ *    Concurrent resizable hash index for equality-only access.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/storage/index/hash_index.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "hash_index.h"
+#include "mot_engine.h"
+#include "mot_atomic_ops.h"
+
+namespace MOT {
+IMPLEMENT_CLASS_LOGGER(HashPrimaryIndex, Storage);
+
+constexpr uint64_t HashPrimaryIndex::INITIAL_BUCKET_COUNT;
+constexpr uint64_t HashPrimaryIndex::MAX_LOAD_FACTOR;
+constexpr uintptr_t HashPrimaryIndex::BUCKET_LOCK_BIT;
+
+static constexpr uint64_t HASH_SEED = 0x9E3779B97F4A7C15ULL;
+static constexpr uint64_t HASH_MULT1 = 0xFF51AFD7ED558CCDULL;
+static constexpr uint64_t HASH_MULT2 = 0xC4CEB9FE1A85EC53ULL;
+
+static inline uint64_t HashMix(uint64_t hash)
+{
+    // 64 bit finalizer of murmur3, spreads entropy into the low bits used for bucket selection
+    hash ^= hash >> 33;
+    hash *= HASH_MULT1;
+    hash ^= hash >> 33;
+    hash *= HASH_MULT2;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+void HashPrimaryIndex::HashIterator::Next()
+{
+    if (m_node == nullptr) {
+        return;
+    }
+
+    if (m_pointLookup) {
+        m_node = nullptr;
+        m_valid = false;
+        return;
+    }
+
+    const HashNode* node = m_node->m_next;
+    while (node == nullptr && m_bucket < m_array->m_mask) {
+        ++m_bucket;
+        node = GetHead(m_array->m_buckets[m_bucket].load(std::memory_order_acquire));
+    }
+
+    m_node = node;
+    if (m_node == nullptr) {
+        m_valid = false;
+    }
+}
+
+RC HashPrimaryIndex::IndexInitImpl(void** args)
+{
+    m_nodePool = ObjAllocInterface::GetObjPool(sizeof(HashNode) + ALIGN8(m_keyLength), false);
+    if (m_nodePool == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Initialize Index", "Failed to create hash node pool");
+        return RC_MEMORY_ALLOCATION_ERROR;
+    }
+
+    BucketArray* array = CreateArray(INITIAL_BUCKET_COUNT);
+    if (array == nullptr) {
+        ObjAllocInterface::FreeObjPool(&m_nodePool);
+        m_nodePool = nullptr;
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Initialize Index", "Failed to allocate hash bucket array");
+        return RC_MEMORY_ALLOCATION_ERROR;
+    }
+
+    m_array.store(array, std::memory_order_release);
+    m_count.store(0, std::memory_order_relaxed);
+    m_resizing.store(false, std::memory_order_relaxed);
+    m_initialized = true;
+    return RC_OK;
+}
+
+uint64_t HashPrimaryIndex::HashKey(const uint8_t* keyBuf) const
+{
+    uint64_t hash = HASH_SEED ^ m_keyLength;
+    uint32_t offset = 0;
+
+    for (; offset + sizeof(uint64_t) <= m_keyLength; offset += sizeof(uint64_t)) {
+        uint64_t word = 0;
+        for (uint32_t i = 0; i < sizeof(uint64_t); ++i) {
+            word |= ((uint64_t)keyBuf[offset + i]) << (i * 8);
+        }
+        hash = HashMix(hash ^ word);
+    }
+
+    if (offset < m_keyLength) {
+        uint64_t word = 0;
+        for (uint32_t i = 0; offset + i < m_keyLength; ++i) {
+            word |= ((uint64_t)keyBuf[offset + i]) << (i * 8);
+        }
+        hash = HashMix(hash ^ word);
+    }
+
+    return hash;
+}
+
+const HashPrimaryIndex::HashNode* HashPrimaryIndex::Lookup(
+    const uint8_t* keyBuf, uint64_t hash, const BucketArray*& array, uint64_t& bucket) const
+{
+    array = m_array.load(std::memory_order_acquire);
+    bucket = hash & array->m_mask;
+
+    const HashNode* node = GetHead(array->m_buckets[bucket].load(std::memory_order_acquire));
+    while (node != nullptr) {
+        if (KeyEquals(node, hash, keyBuf)) {
+            return node;
+        }
+        node = node->m_next;
+    }
+
+    return nullptr;
+}
+
+HashPrimaryIndex::BucketArray* HashPrimaryIndex::CreateArray(uint64_t bucketCount) const
+{
+    BucketArray* array = (BucketArray*)MemGlobalAllocAligned(GetArraySize(bucketCount), CACHE_LINE_SIZE);
+    if (array == nullptr) {
+        return nullptr;
+    }
+
+    array->m_mask = bucketCount - 1;
+    for (uint64_t i = 0; i < bucketCount; ++i) {
+        array->m_buckets[i].store(0, std::memory_order_relaxed);
+    }
+
+    return array;
+}
+
+HashPrimaryIndex::HashNode* HashPrimaryIndex::CreateNode(const uint8_t* keyBuf, uint64_t hash, Sentinel* sentinel)
+{
+    HashNode* node = (HashNode*)m_nodePool->Alloc();
+    if (node == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Index Insert", "Failed to allocate hash node for index %s", m_name.c_str());
+        return nullptr;
+    }
+
+    node->m_next = nullptr;
+    node->m_hash = hash;
+    node->m_sentinel = sentinel;
+    errno_t erc = memcpy_s(node->m_key, ALIGN8(m_keyLength), keyBuf, m_keyLength);
+    securec_check(erc, "\0", "\0");
+    return node;
+}
+
+HashPrimaryIndex::BucketArray* HashPrimaryIndex::LockBucket(uint64_t hash, std::atomic<uintptr_t>*& bucket)
+{
+    // A bucket sealed by a resize is never unlocked, so reloading the array on every attempt moves us to the new
+    // array as soon as it is published
+    while (true) {
+        BucketArray* array = m_array.load(std::memory_order_acquire);
+        bucket = &array->m_buckets[hash & array->m_mask];
+        uintptr_t head = bucket->load(std::memory_order_relaxed);
+        if ((head & BUCKET_LOCK_BIT) == 0 &&
+            bucket->compare_exchange_weak(head, head | BUCKET_LOCK_BIT, std::memory_order_acquire)) {
+            return array;
+        }
+        PAUSE
+    }
+}
+
+Sentinel* HashPrimaryIndex::IndexInsertImpl(const Key* key, Sentinel* sentinel, bool& inserted, uint32_t pid)
+{
+    const uint8_t* keyBuf = key->GetKeyBuf();
+    uint64_t hash = HashKey(keyBuf);
+
+    // allocate outside the bucket lock to keep the critical section short
+    HashNode* node = CreateNode(keyBuf, hash, sentinel);
+    if (node == nullptr) {
+        inserted = false;
+        return nullptr;
+    }
+
+    std::atomic<uintptr_t>* bucket = nullptr;
+    BucketArray* array = LockBucket(hash, bucket);
+    uint64_t bucketCount = array->m_mask + 1;
+    HashNode* head = GetHead(bucket->load(std::memory_order_relaxed));
+
+    for (HashNode* curr = head; curr != nullptr; curr = curr->m_next) {
+        if (KeyEquals(curr, hash, keyBuf)) {
+            Sentinel* existing = curr->m_sentinel;
+            bucket->store((uintptr_t)head, std::memory_order_release);
+            m_nodePool->Release(node);
+            inserted = false;
+            return existing;
+        }
+    }
+
+    node->m_next = head;
+    bucket->store((uintptr_t)node, std::memory_order_release);
+    inserted = true;
+
+    uint64_t count = m_count.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (count > bucketCount * MAX_LOAD_FACTOR) {
+        Resize(array);
+    }
+
+    return nullptr;
+}
+
+Sentinel* HashPrimaryIndex::IndexReadImpl(const Key* key, uint32_t pid) const
+{
+    const uint8_t* keyBuf = key->GetKeyBuf();
+    const BucketArray* array = nullptr;
+    uint64_t bucket = 0;
+
+    const HashNode* node = Lookup(keyBuf, HashKey(keyBuf), array, bucket);
+    return (node != nullptr) ? node->m_sentinel : nullptr;
+}
+
+Sentinel* HashPrimaryIndex::IndexRemoveImpl(const Key* key, uint32_t pid)
+{
+    const uint8_t* keyBuf = key->GetKeyBuf();
+    uint64_t hash = HashKey(keyBuf);
+    std::atomic<uintptr_t>* bucket = nullptr;
+    (void)LockBucket(hash, bucket);
+
+    HashNode* head = GetHead(bucket->load(std::memory_order_relaxed));
+    HashNode* prev = nullptr;
+    HashNode* curr = head;
+    while (curr != nullptr && !KeyEquals(curr, hash, keyBuf)) {
+        prev = curr;
+        curr = curr->m_next;
+    }
+
+    if (curr == nullptr) {
+        bucket->store((uintptr_t)head, std::memory_order_release);
+        return nullptr;
+    }
+
+    // concurrent readers positioned on the removed node still see a valid successor
+    if (prev == nullptr) {
+        head = curr->m_next;
+    } else {
+        prev->m_next = curr->m_next;
+    }
+    bucket->store((uintptr_t)head, std::memory_order_release);
+    (void)m_count.fetch_sub(1, std::memory_order_relaxed);
+
+    Sentinel* sentinel = curr->m_sentinel;
+    RetireNode(curr);
+    return sentinel;
+}
+
+void HashPrimaryIndex::Resize(BucketArray* array)
+{
+    bool expected = false;
+    if (!m_resizing.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+        return;  // another thread is already resizing
+    }
+
+    if (m_array.load(std::memory_order_acquire) != array) {
+        m_resizing.store(false, std::memory_order_release);
+        return;
+    }
+
+    uint64_t oldCount = array->m_mask + 1;
+    uint64_t newCount = oldCount << 1;
+    BucketArray* newArray = CreateArray(newCount);
+    if (newArray == nullptr) {
+        // not fatal, the index keeps working with longer chains
+        MOT_LOG_WARN("Failed to grow hash index %s to %" PRIu64 " buckets", m_name.c_str(), newCount);
+        m_resizing.store(false, std::memory_order_release);
+        return;
+    }
+
+    // seal each old bucket by locking it for good, then copy its chain. Nodes are copied rather than relinked,
+    // since readers of the old array may still be walking the old chains
+    uint64_t sealed = 0;
+    bool failed = false;
+    for (; sealed < oldCount && !failed; ++sealed) {
+        std::atomic<uintptr_t>* bucket = &array->m_buckets[sealed];
+        uintptr_t head = bucket->load(std::memory_order_relaxed);
+        while ((head & BUCKET_LOCK_BIT) != 0 ||
+               !bucket->compare_exchange_weak(head, head | BUCKET_LOCK_BIT, std::memory_order_acquire)) {
+            PAUSE
+            head = bucket->load(std::memory_order_relaxed);
+        }
+
+        for (HashNode* curr = GetHead(head); curr != nullptr; curr = curr->m_next) {
+            HashNode* copy = CreateNode(curr->m_key, curr->m_hash, curr->m_sentinel);
+            if (copy == nullptr) {
+                failed = true;
+                break;
+            }
+            std::atomic<uintptr_t>& target = newArray->m_buckets[copy->m_hash & newArray->m_mask];
+            copy->m_next = GetHead(target.load(std::memory_order_relaxed));
+            target.store((uintptr_t)copy, std::memory_order_relaxed);
+        }
+    }
+
+    if (failed) {
+        MOT_LOG_WARN("Aborted growing hash index %s: out of memory", m_name.c_str());
+        for (uint64_t i = 0; i < sealed; ++i) {
+            std::atomic<uintptr_t>* bucket = &array->m_buckets[i];
+            bucket->store(bucket->load(std::memory_order_relaxed) & ~BUCKET_LOCK_BIT, std::memory_order_release);
+        }
+        for (uint64_t i = 0; i < newCount; ++i) {
+            HashNode* curr = GetHead(newArray->m_buckets[i].load(std::memory_order_relaxed));
+            while (curr != nullptr) {
+                HashNode* next = curr->m_next;
+                m_nodePool->Release(curr);
+                curr = next;
+            }
+        }
+        MemGlobalFree(newArray);
+        m_resizing.store(false, std::memory_order_release);
+        return;
+    }
+
+    m_array.store(newArray, std::memory_order_release);
+
+    for (uint64_t i = 0; i < oldCount; ++i) {
+        HashNode* curr = GetHead(array->m_buckets[i].load(std::memory_order_relaxed));
+        while (curr != nullptr) {
+            HashNode* next = curr->m_next;
+            RetireNode(curr);
+            curr = next;
+        }
+    }
+
+    GcManager* gcSession = MOTEngine::GetInstance()->GetCurrentGcSession();
+    if (gcSession != nullptr) {
+        gcSession->GcRecordObject(
+            GetIndexId(), nullptr, array, DeallocateArrayCallBack, (uint32_t)GetArraySize(oldCount));
+    } else {
+        MemGlobalFree(array);
+    }
+
+    MOT_LOG_DEBUG("Hash index %s grown to %" PRIu64 " buckets", m_name.c_str(), newCount);
+    m_resizing.store(false, std::memory_order_release);
+}
+
+void HashPrimaryIndex::RetireNode(HashNode* node)
+{
+    GcManager* gcSession = MOTEngine::GetInstance()->GetCurrentGcSession();
+    if (gcSession != nullptr) {
+        gcSession->GcRecordObject(GetIndexId(), m_nodePool, node, DeallocateNodeCallBack, m_nodePool->m_size);
+    } else {
+        // threads without a GC session (recovery, bootstrap) run without concurrent readers
+        m_nodePool->Release(node);
+    }
+}
+
+void HashPrimaryIndex::DestroyTable()
+{
+    BucketArray* array = m_array.load(std::memory_order_relaxed);
+    if (array != nullptr) {
+        MemGlobalFree(array);
+        m_array.store(nullptr, std::memory_order_relaxed);
+    }
+
+    // releasing the pool releases all the nodes
+    if (m_nodePool != nullptr) {
+        ObjAllocInterface::FreeObjPool(&m_nodePool);
+        m_nodePool = nullptr;
+    }
+    m_count.store(0, std::memory_order_relaxed);
+}
+
+uint64_t HashPrimaryIndex::GetIndexSize()
+{
+    PoolStatsSt stats;
+
+    errno_t erc = memset_s(&stats, sizeof(PoolStatsSt), 0, sizeof(PoolStatsSt));
+    securec_check(erc, "\0", "\0");
+    stats.m_type = PoolStatsT::POOL_STATS_ALL;
+    m_keyPool->GetStats(stats);
+    uint64_t res = stats.m_poolCount * stats.m_poolGrossSize;
+    uint64_t netto = (stats.m_totalObjCount - stats.m_freeObjCount) * stats.m_objSize;
+
+    erc = memset_s(&stats, sizeof(PoolStatsSt), 0, sizeof(PoolStatsSt));
+    securec_check(erc, "\0", "\0");
+    stats.m_type = PoolStatsT::POOL_STATS_ALL;
+    m_sentinelPool->GetStats(stats);
+    res += stats.m_poolCount * stats.m_poolGrossSize;
+    netto += (stats.m_totalObjCount - stats.m_freeObjCount) * stats.m_objSize;
+
+    erc = memset_s(&stats, sizeof(PoolStatsSt), 0, sizeof(PoolStatsSt));
+    securec_check(erc, "\0", "\0");
+    stats.m_type = PoolStatsT::POOL_STATS_ALL;
+    m_nodePool->GetStats(stats);
+    res += stats.m_poolCount * stats.m_poolGrossSize;
+    netto += (stats.m_totalObjCount - stats.m_freeObjCount) * stats.m_objSize;
+
+    uint64_t arraySize = GetArraySize(m_array.load(std::memory_order_acquire)->m_mask + 1);
+    res += arraySize;
+    netto += arraySize;
+
+    MOT_LOG_INFO("Index %s memory size: gross: %lu, netto: %lu", m_name.c_str(), res, netto);
+    return res;
+}
+
+// Iterator API
+IndexIterator* HashPrimaryIndex::Begin(uint32_t pid, bool passive) const
+{
+    const BucketArray* array = m_array.load(std::memory_order_acquire);
+    const HashNode* node = nullptr;
+    uint64_t bucket = 0;
+
+    for (; bucket <= array->m_mask; ++bucket) {
+        node = GetHead(array->m_buckets[bucket].load(std::memory_order_acquire));
+        if (node != nullptr) {
+            break;
+        }
+    }
+
+    IndexIterator* itr = new (std::nothrow) HashIterator(array, bucket, node, false);
+    if (itr == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Index Begin", "Failed to create hash iterator");
+    }
+    return itr;
+}
+
+IndexIterator* HashPrimaryIndex::Search(
+    const Key* key, bool matchKey, bool forward, uint32_t pid, bool& found, bool passive) const
+{
+    const uint8_t* keyBuf = key->GetKeyBuf();
+    const BucketArray* array = nullptr;
+    uint64_t bucket = 0;
+
+    // hash order carries no key order, so only an exact match can be positioned
+    const HashNode* node = Lookup(keyBuf, HashKey(keyBuf), array, bucket);
+    found = (node != nullptr);
+
+    IndexIterator* itr = new (std::nothrow) HashIterator(array, bucket, matchKey ? node : nullptr, true);
+    if (itr == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Index Search", "Failed to create hash iterator");
+    }
+    return itr;
+}
+}  // namespace MOT
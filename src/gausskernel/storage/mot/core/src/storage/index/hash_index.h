@@ -0,0 +1,358 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * hash_index.h
+ *    Concurrent resizable hash index for equality-only access.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/storage/index/hash_index.h
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef HASH_PRIMARY_INDEX_H
+#define HASH_PRIMARY_INDEX_H
+
+#include "index.h"
+#include "utilities.h"
+#include "mm_gc_manager.h"
+#include "mm_global_api.h"
+
+#include <atomic>
+
+namespace MOT {
+/**
+ * @class HashPrimaryIndex
+ * @brief Unique index implementation using a concurrent chained hash table.
+ * @detail Readers never lock: they load the current bucket array and walk the bucket chain. Writers lock a
+ * single bucket by setting the low bit of the bucket head pointer. Unlinked nodes and retired bucket arrays are
+ * reclaimed through the epoch based GC, so a reader that observed a node may keep using it until it quiesces.
+ * The table doubles when the average chain length exceeds @ref MAX_LOAD_FACTOR. Resize seals every bucket of the
+ * old array by locking it for good, copies the chains into a new array and publishes it.
+ * The index supports only point lookups and full scans in hash order. Range scans are not supported, so the
+ * planner must restrict hash indexes to full key equality predicates.
+ */
+class HashPrimaryIndex : public Index {
+public:
+    /**
+     * @struct HashNode
+     * @brief A single index entry. The key bytes follow the header.
+     */
+    struct HashNode {
+        /** @var Next node in the bucket chain. */
+        HashNode* volatile m_next;
+
+        /** @var Cached full hash code of the key. */
+        uint64_t m_hash;
+
+        /** @var The sentinel mapped to the key. */
+        Sentinel* m_sentinel;
+
+        /** @var The key bytes (index key length). */
+        uint8_t m_key[0];
+    };
+
+    /**
+     * @struct BucketArray
+     * @brief A bucket array snapshot. Each bucket holds a chain head pointer with the lock flag in bit zero.
+     */
+    struct BucketArray {
+        /** @var Bucket count minus one (bucket count is always a power of two). */
+        uint64_t m_mask;
+
+        /** @var The bucket heads. */
+        std::atomic<uintptr_t> m_buckets[0];
+    };
+
+    /** @var Initial bucket count of a new index. */
+    static constexpr uint64_t INITIAL_BUCKET_COUNT = 1024;
+
+    /** @var Average chain length that triggers doubling of the bucket array. */
+    static constexpr uint64_t MAX_LOAD_FACTOR = 2;
+
+    /** @var Lock flag in bucket head. */
+    static constexpr uintptr_t BUCKET_LOCK_BIT = 1;
+
+private:
+    /**
+     * @class HashIterator
+     * @brief Forward iterator over a hash index. Point lookup iterators become invalid after the first step.
+     */
+    class HashIterator : public IndexIterator {
+    public:
+        /**
+         * @brief Constructor.
+         * @param array The bucket array snapshot to iterate.
+         * @param bucket The bucket of the current node.
+         * @param node The current node or null pointer for an exhausted iterator.
+         * @param pointLookup Specifies whether the iterator was created by an exact key search.
+         */
+        HashIterator(const BucketArray* array, uint64_t bucket, const HashNode* node, bool pointLookup)
+            : IndexIterator(IteratorType::ITERATOR_TYPE_FORWARD, false, node != nullptr),
+              m_array(array),
+              m_bucket(bucket),
+              m_node(node),
+              m_pointLookup(pointLookup)
+        {}
+
+        /**
+         * @brief Destructor.
+         */
+        virtual ~HashIterator()
+        {
+            m_array = nullptr;
+            m_node = nullptr;
+        }
+
+        /**
+         * @brief Retrieves the key of the currently iterated item.
+         * @return A pointer to the key of the currently iterated item.
+         */
+        virtual const void* GetKey() const
+        {
+            return m_node->m_key;
+        }
+
+        /**
+         * @brief Retrieves the row of the currently iterated item.
+         * @return A pointer to the row of the currently iterated item.
+         */
+        virtual Row* GetRow() const
+        {
+            return m_node->m_sentinel->GetData();
+        }
+
+        /**
+         * @brief Retrieves the currently iterated primary sentinel.
+         * @return The primary sentinel.
+         */
+        virtual Sentinel* GetPrimarySentinel() const
+        {
+            return m_node->m_sentinel;
+        }
+
+        /**
+         * @brief Moves forwards the iterator to the next item in hash order.
+         */
+        virtual void Next();
+
+        /**
+         * @brief Moves backwards the iterator to the previous item.
+         * @detail Not supported by hash index.
+         */
+        virtual void Prev()
+        {
+            MOT_ASSERT(false);
+        }
+
+        /**
+         * @brief Queries whether this index iterator equals to another index iterator.
+         * @param rhs The index iterator with which to compare this iterator.
+         * @return True if iterators point to the same index item, otherwise false.
+         */
+        virtual bool Equals(const IndexIterator* rhs) const
+        {
+            return m_node == static_cast<const HashIterator*>(rhs)->m_node;
+        }
+
+        /**
+         * Serializes the iterator into a buffer.
+         * @detail Not implemented
+         */
+        virtual void Serialize(serialize_func_t serializeFunc, unsigned char* buff) const
+        {}
+
+        /**
+         * Deserializes the iterator from a buffer.
+         * @detail Not implemented
+         */
+        virtual void Deserialize(deserialize_func_t deserializeFunc, unsigned char* buff)
+        {}
+
+    private:
+        /** @var The iterated bucket array. */
+        const BucketArray* m_array;
+
+        /** @var The bucket of the current node. */
+        uint64_t m_bucket;
+
+        /** @var The current node. */
+        const HashNode* m_node;
+
+        /** @var Specifies whether this is a point lookup iterator. */
+        bool m_pointLookup;
+    };
+
+public:
+    /**
+     * @brief Default constructor.
+     */
+    HashPrimaryIndex()
+        : Index(MOT::IndexOrder::INDEX_ORDER_PRIMARY, IndexingMethod::INDEXING_METHOD_HASH),
+          m_array(nullptr),
+          m_nodePool(nullptr),
+          m_count(0),
+          m_resizing(false),
+          m_initialized(false)
+    {}
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~HashPrimaryIndex()
+    {
+        if (m_initialized) {
+            m_initialized = false;
+            DestroyTable();
+        }
+    }
+
+    /**
+     * @brief Calculate the Index memory consumption.
+     * @return The amount of memory the Index consumes.
+     */
+    virtual uint64_t GetIndexSize() override;
+
+    /**
+     * @brief Retrieves the number of rows stored in the index.
+     * @return The number of rows stored in the index.
+     */
+    virtual uint64_t GetSize() const
+    {
+        return m_count.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Destroy the bucket array and node pool and init index again.
+     */
+    virtual RC ReInitIndex()
+    {
+        m_initialized = false;
+        DestroyTable();
+
+        return IndexInitImpl(nullptr);
+    }
+
+    // Iterator API
+    virtual IndexIterator* Begin(uint32_t pid, bool passive = false) const;
+
+    virtual IndexIterator* Search(
+        const Key* key, bool matchKey, bool forward, uint32_t pid, bool& found, bool passive = false) const;
+
+    /**
+     * @brief Static callback function for releasing a retired node back to the node pool.
+     * @param pool Pool to deallocate from.
+     * @param ptr Pointer to the node.
+     * @param dropIndex Indicates if this callback is part of drop index process.
+     * @return Size of memory that was deallocated.
+     */
+    static uint32_t DeallocateNodeCallBack(void* pool, void* ptr, bool dropIndex)
+    {
+        // If dropIndex == true, all index's pools are going to be cleaned, so we skip the release here
+        ObjAllocInterface* localPoolPtr = (ObjAllocInterface*)pool;
+
+        if (dropIndex == false) {
+            localPoolPtr->Release(ptr);
+        }
+        return localPoolPtr->m_size;
+    }
+
+    /**
+     * @brief Static callback function for freeing a retired bucket array.
+     * @param pool Ignored.
+     * @param ptr Pointer to the bucket array.
+     * @param dropIndex Ignored, bucket arrays are not pooled so they are always freed.
+     * @return Size of memory that was deallocated.
+     */
+    static uint32_t DeallocateArrayCallBack(void* pool, void* ptr, bool dropIndex)
+    {
+        BucketArray* array = (BucketArray*)ptr;
+        uint32_t size = (uint32_t)GetArraySize(array->m_mask + 1);
+        MemGlobalFree(array);
+        return size;
+    }
+
+protected:
+    /**
+     * @brief Implements index initialization.
+     * @param args Null-terminated list of any additional arguments.
+     * @return Return code denoting success or error.
+     */
+    virtual RC IndexInitImpl(void** args);
+
+    virtual Sentinel* IndexInsertImpl(const Key* key, Sentinel* sentinel, bool& inserted, uint32_t pid);
+
+    virtual Sentinel* IndexReadImpl(const Key* key, uint32_t pid) const;
+
+    virtual Sentinel* IndexRemoveImpl(const Key* key, uint32_t pid);
+
+private:
+    /** @var The current bucket array. */
+    std::atomic<BucketArray*> m_array;
+
+    /** @var Memory pool for nodes. */
+    ObjAllocInterface* m_nodePool;
+
+    /** @var Number of entries in the index. */
+    std::atomic<uint64_t> m_count;
+
+    /** @var Set while a resize is in progress. */
+    std::atomic<bool> m_resizing;
+
+    /** @var Determine if object is initialized or not. */
+    bool m_initialized;
+
+    static inline uint64_t GetArraySize(uint64_t bucketCount)
+    {
+        return sizeof(BucketArray) + bucketCount * sizeof(std::atomic<uintptr_t>);
+    }
+
+    static inline HashNode* GetHead(uintptr_t bucketWord)
+    {
+        return reinterpret_cast<HashNode*>(bucketWord & ~BUCKET_LOCK_BIT);
+    }
+
+    uint64_t HashKey(const uint8_t* keyBuf) const;
+
+    inline bool KeyEquals(const HashNode* node, uint64_t hash, const uint8_t* keyBuf) const
+    {
+        return (node->m_hash == hash) && (memcmp(node->m_key, keyBuf, m_keyLength) == 0);
+    }
+
+    const HashNode* Lookup(const uint8_t* keyBuf, uint64_t hash, const BucketArray*& array, uint64_t& bucket) const;
+
+    BucketArray* CreateArray(uint64_t bucketCount) const;
+
+    HashNode* CreateNode(const uint8_t* keyBuf, uint64_t hash, Sentinel* sentinel);
+
+    /**
+     * @brief Locks the bucket holding the given hash in the current bucket array.
+     * @param hash The key hash code.
+     * @param[out] bucket The locked bucket.
+     * @return The array whose bucket was locked. The caller must release the bucket by storing the new head.
+     */
+    BucketArray* LockBucket(uint64_t hash, std::atomic<uintptr_t>*& bucket);
+
+    void Resize(BucketArray* array);
+
+    void RetireNode(HashNode* node);
+
+    void DestroyTable();
+
+    DECLARE_CLASS_LOGGER()
+};
+}  // namespace MOT
+
+#endif /* HASH_PRIMARY_INDEX_H */
@@ -256,6 +256,12 @@ bool Index::IndexInsert(Sentinel*& outputSentinel, const Key* key, uint32_t pid,
 
     while (retryInsert) {
         outputSentinel = IndexInsertImpl(key, sentinel, inserted, pid);
+        if (unlikely(inserted == false && outputSentinel == nullptr)) {
+            // index implementation failed to allocate its own entry
+            m_sentinelPool->Release<Sentinel>(sentinel);
+            rc = RC_MEMORY_ALLOCATION_ERROR;
+            return false;
+        }
         // sync between rollback/delete and insert
         if (inserted == false) {
             // Spin if the counter is 0 - aborting in parallel or sentinel is marks for commit
@@ -296,7 +302,11 @@ Sentinel* Index::IndexInsert(const Key* key, Row* row, uint32_t pid)
     sentinel->Init(this, nullptr);
     sentinel->UnSetDirty();
     currSentinel = IndexInsertImpl(key, sentinel, inserted, pid);
-    if (currSentinel != nullptr) {
+    if (unlikely(currSentinel == nullptr && inserted == false)) {
+        // error already reported by index implementation
+        m_sentinelPool->Release<Sentinel>(sentinel);
+        return nullptr;
+    } else if (currSentinel != nullptr) {
         // no need to report to full error stack
         SetLastError(MOT_ERROR_UNIQUE_VIOLATION, MOT_SEVERITY_NORMAL);
         m_sentinelPool->Release<Sentinel>(sentinel);
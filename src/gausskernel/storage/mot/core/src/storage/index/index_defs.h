@@ -131,7 +131,12 @@ enum class IndexingMethod : uint32_t {
     /**
      * @var Denotes tree-based indexing.
      */
-    INDEXING_METHOD_TREE
+    INDEXING_METHOD_TREE,
+
+    /**
+     * @var Denotes hash-based indexing (unique keys, equality lookups only).
+     */
+    INDEXING_METHOD_HASH
 };
 
 /**
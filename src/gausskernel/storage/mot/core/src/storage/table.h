@@ -740,6 +740,52 @@ public:
 
     Row* RemoveKeyFromIndex(Row* row, Sentinel* sentinel, uint64_t tid, GcManager* gc);
 
+    /**
+     * @brief Records that the table was modified during the given checkpoint generation.
+     * @param generation The current checkpoint generation.
+     */
+    inline void SetCheckpointWriteGen(uint64_t generation)
+    {
+        // avoid dirtying the cache line on every commit
+        if (m_cpWriteGen.load(std::memory_order_relaxed) != generation) {
+            m_cpWriteGen.store(generation, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Retrieves the checkpoint generation of the last modification of the table.
+     */
+    inline uint64_t GetCheckpointWriteGen() const
+    {
+        return m_cpWriteGen.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Records the checkpoint that captured the table. Must be called under the table lock.
+     * @param checkpointId The checkpoint id.
+     * @param generation The checkpoint generation.
+     * @param lastSeg The last data file segment written for the table.
+     */
+    inline void SetLastCheckpoint(uint64_t checkpointId, uint64_t generation, uint32_t lastSeg)
+    {
+        m_cpLastId = checkpointId;
+        m_cpLastGen = generation;
+        m_cpLastSeg = lastSeg;
+    }
+
+    /**
+     * @brief Retrieves the checkpoint that captured the table. Must be called under the table lock.
+     * @param[out] generation The checkpoint generation.
+     * @param[out] lastSeg The last data file segment written for the table.
+     * @return The checkpoint id, or zero if the table was never checkpointed.
+     */
+    inline uint64_t GetLastCheckpoint(uint64_t& generation, uint32_t& lastSeg) const
+    {
+        generation = m_cpLastGen;
+        lastSeg = m_cpLastSeg;
+        return m_cpLastId;
+    }
+
 private:
     /** @var Global atomic table identifier. */
     static std::atomic<uint32_t> tableCounter;
@@ -805,6 +851,18 @@ private:
 
     uint32_t m_rowCount = 0;
 
+    /** @var Checkpoint generation of the last modification of the table. */
+    std::atomic<uint64_t> m_cpWriteGen{0};
+
+    /** @var Id of the last checkpoint that captured the table. */
+    uint64_t m_cpLastId = 0;
+
+    /** @var Generation of the last checkpoint that captured the table. */
+    uint64_t m_cpLastGen = 0;
+
+    /** @var Last data file segment written by the last checkpoint that captured the table. */
+    uint32_t m_cpLastSeg = 0;
+
     DECLARE_CLASS_LOGGER();
 
 public:
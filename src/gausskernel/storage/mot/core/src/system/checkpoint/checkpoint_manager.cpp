@@ -49,6 +49,9 @@ CheckpointManager::CheckpointManager()
       m_numThreads(GetGlobalConfiguration().m_checkpointWorkers),
       m_checkpointValidation(GetGlobalConfiguration().m_validateCheckpoint),
       m_cpSegThreshold(GetGlobalConfiguration().m_checkpointSegThreshold),
+      m_deltaCheckpoint(GetGlobalConfiguration().m_enableDeltaCheckpoint),
+      m_generation(1),
+      m_lastCompletedId(0),
       m_stopFlag(false),
       m_checkpointEnded(false),
       m_checkpointError(0),
@@ -308,6 +311,11 @@ void CheckpointManager::MoveToNextPhase()
         m_redoLogHandler->WrLock();
     }
 
+    if (m_phase == PREPARE) {
+        // transactions that begin from now on may not be part of the checkpoint
+        ++m_generation;
+    }
+
     if (m_phase == PREPARE && m_checkpointValidation == true) {
         Checkbits();
     }
@@ -382,6 +390,8 @@ bool CheckpointManager::ApplyWrite(TxnManager* txnMan, Row* origRow, AccessType
         return false;
     }
 
+    MarkTableChanged(origRow->GetTable());
+
     bool statusBit = s->GetStableStatus();
     switch (startPhase) {
         case REST:
@@ -495,6 +505,7 @@ void CheckpointManager::CompleteCheckpoint(uint64_t checkpointId)
     }
 
     m_fetchLock.WrUnlock();
+    m_lastCompletedId = checkpointId;
     RemoveOldCheckpoints(checkpointId);
     MOT_LOG_INFO("Checkpoint [%lu] completed", checkpointId);
 }
@@ -509,8 +520,9 @@ void CheckpointManager::DestroyCheckpointers()
 
 void CheckpointManager::CreateCheckpointers()
 {
-    m_checkpointers = new (std::nothrow)
-        CheckpointWorkerPool(m_numThreads, !m_availableBit, m_tasksList, m_cpSegThreshold, m_id, *this);
+    uint64_t baseId = m_deltaCheckpoint ? m_lastCompletedId : 0;
+    m_checkpointers = new (std::nothrow) CheckpointWorkerPool(
+        m_numThreads, !m_availableBit, m_tasksList, m_cpSegThreshold, m_id, baseId, m_generation, *this);
 }
 
 void CheckpointManager::Capture()
@@ -109,6 +109,18 @@ public:
      */
     bool ApplyWrite(TxnManager* txnMan, Row* origRow, AccessType type);
 
+    /**
+     * @brief Marks a table as modified in the current checkpoint generation, so the next
+     * checkpoint does not reuse its data files from the previous checkpoint.
+     * @param table The modified table.
+     */
+    inline void MarkTableChanged(Table* table)
+    {
+        if (m_deltaCheckpoint) {
+            table->SetCheckpointWriteGen(m_generation.load(std::memory_order_relaxed));
+        }
+    }
+
     /**
      * @brief Checkpoint task completion callback
      * @param checkpointId The checkpoint's id.
@@ -235,6 +247,15 @@ private:
     // Checkpoint segments size threshold
     uint32_t m_cpSegThreshold;
 
+    // Reuse data files of tables that were not modified since the previous checkpoint
+    bool m_deltaCheckpoint;
+
+    // Checkpoint generation, advanced when a checkpoint enters the PREPARE phase
+    std::atomic<uint64_t> m_generation;
+
+    // Id of the last checkpoint that completed successfully in this process
+    uint64_t m_lastCompletedId;
+
     // Signal working threads to exit
     volatile bool m_stopFlag;
 
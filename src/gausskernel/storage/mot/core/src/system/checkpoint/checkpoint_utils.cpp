@@ -26,6 +26,8 @@
 #include "checkpoint_utils.h"
 #include "utilities.h"
 #include "mot_error.h"
+#include "checkpoint_worker.h"
+#include "lz4.h"
 
 namespace MOT {
 DECLARE_LOGGER(CheckpointUtils, Checkpoint);
@@ -130,6 +132,15 @@ extern bool SeekFile(int fd, uint64_t offset)
     return (rc != -1);
 }
 
+extern bool LinkFile(std::string srcFileName, std::string dstFileName)
+{
+    if (link(srcFileName.c_str(), dstFileName.c_str()) == -1) {
+        MOT_REPORT_SYSTEM_ERROR(link, "N/A", "Failed to link file %s to %s", srcFileName.c_str(), dstFileName.c_str());
+        return false;
+    }
+    return true;
+}
+
 extern bool GetWorkingDir(std::string& dir)
 {
     dir.clear();
@@ -215,5 +226,79 @@ extern void Hexdump(const char* msg, char* b, uint32_t buflen)
         fprintf(stderr, "%s\n", line);
     }
 }
+
+FileReader::~FileReader()
+{
+    if (m_block != nullptr) {
+        delete[] m_block;
+        m_block = nullptr;
+    }
+    if (m_compressedBlock != nullptr) {
+        delete[] m_compressedBlock;
+        m_compressedBlock = nullptr;
+    }
+}
+
+bool FileReader::Initialize()
+{
+    if (!m_compressed) {
+        return true;
+    }
+    m_block = new (std::nothrow) char[CHECKPOINT_BUFFER_SIZE];
+    m_compressedBlock = new (std::nothrow) char[LZ4_compressBound(CHECKPOINT_BUFFER_SIZE)];
+    if (m_block == nullptr || m_compressedBlock == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Checkpoint", "Failed to allocate checkpoint decompression buffers");
+        return false;
+    }
+    return true;
+}
+
+bool FileReader::ReadBlock()
+{
+    CompressedBlockHeader blockHeader;
+    if (ReadFile(m_fd, (char*)&blockHeader, sizeof(CompressedBlockHeader)) != sizeof(CompressedBlockHeader)) {
+        return false;
+    }
+    if (blockHeader.m_rawLen > CHECKPOINT_BUFFER_SIZE ||
+        blockHeader.m_compressedLen > (uint32_t)LZ4_compressBound(CHECKPOINT_BUFFER_SIZE)) {
+        MOT_LOG_ERROR("FileReader: invalid block header (raw %u, compressed %u)",
+            blockHeader.m_rawLen,
+            blockHeader.m_compressedLen);
+        return false;
+    }
+    if (ReadFile(m_fd, m_compressedBlock, blockHeader.m_compressedLen) != blockHeader.m_compressedLen) {
+        MOT_LOG_ERROR("FileReader: failed to read a compressed block of %u bytes", blockHeader.m_compressedLen);
+        return false;
+    }
+    int rawLen = LZ4_decompress_safe(
+        m_compressedBlock, m_block, (int)blockHeader.m_compressedLen, (int)CHECKPOINT_BUFFER_SIZE);
+    if (rawLen < 0 || (uint32_t)rawLen != blockHeader.m_rawLen) {
+        MOT_LOG_ERROR("FileReader: failed to decompress block (%d, expected %u)", rawLen, blockHeader.m_rawLen);
+        return false;
+    }
+    m_blockLen = (size_t)rawLen;
+    m_blockPos = 0;
+    return true;
+}
+
+size_t FileReader::Read(char* data, size_t len)
+{
+    if (!m_compressed) {
+        return ReadFile(m_fd, data, len);
+    }
+
+    size_t bytesRead = 0;
+    while (bytesRead < len) {
+        if (m_blockPos == m_blockLen && !ReadBlock()) {
+            break;
+        }
+        size_t chunk = std::min(len - bytesRead, m_blockLen - m_blockPos);
+        errno_t erc = memcpy_s(data + bytesRead, len - bytesRead, m_block + m_blockPos, chunk);
+        securec_check(erc, "\0", "\0");
+        m_blockPos += chunk;
+        bytesRead += chunk;
+    }
+    return bytesRead;
+}
 }  // namespace CheckpointUtils
 }  // namespace MOT
@@ -35,6 +35,9 @@
 
 const uint64_t CP_MGR_MAGIC = 0xaabbccdd;
 
+// Magic of checkpoint data files whose payload is a sequence of LZ4 compressed blocks
+const uint64_t CP_MGR_LZ4_MAGIC = 0xaabbccde;
+
 namespace MOT {
 namespace CheckpointUtils {
 
@@ -117,6 +120,14 @@ extern int FlushFile(int fd);
  */
 extern bool SeekFile(int fd, uint64_t offset);
 
+/**
+ * @brief A wrapper function that creates a hard link to a file.
+ * @param srcFileName The existing file name.
+ * @param dstFileName The new link name.
+ * @return Boolean value denoting success or failure.
+ */
+extern bool LinkFile(std::string srcFileName, std::string dstFileName);
+
 /**
  * @brief Frees a row's stable version row.
  * @param row The row which stable version needs to be freed.
@@ -320,6 +331,62 @@ struct EntryHeader {
     uint16_t m_keyLen;
 };
 
+struct CompressedBlockHeader {
+    uint32_t m_rawLen;
+    uint32_t m_compressedLen;
+};
+
+/**
+ * @class FileReader
+ * @brief Sequential reader of a checkpoint data file payload. Transparently
+ * decompresses files that were written with LZ4 block compression.
+ */
+class FileReader {
+public:
+    FileReader(int fd, bool compressed)
+        : m_fd(fd), m_compressed(compressed), m_block(nullptr), m_compressedBlock(nullptr), m_blockLen(0), m_blockPos(0)
+    {}
+
+    ~FileReader();
+
+    FileReader(const FileReader& orig) = delete;
+
+    FileReader& operator=(const FileReader&) = delete;
+
+    /**
+     * @brief Allocates the decompression buffers.
+     * @return Boolean value denoting success or failure.
+     */
+    bool Initialize();
+
+    /**
+     * @brief Reads the next bytes of the file payload.
+     * @param data A pointer to the data buffer to read to.
+     * @param len The number of bytes to read.
+     * @return size_t The number of bytes that were read.
+     */
+    size_t Read(char* data, size_t len);
+
+private:
+    /**
+     * @brief Reads and decompresses the next block of the file.
+     * @return Boolean value denoting success or failure (including end of file).
+     */
+    bool ReadBlock();
+
+    int m_fd;
+
+    bool m_compressed;
+
+    char* m_block;
+
+    char* m_compressedBlock;
+
+    size_t m_blockLen;
+
+    size_t m_blockPos;
+};
+
 struct MetaFileHeader {
     FileHeader m_fileHeader;
     EntryHeader m_entryHeader;
@@ -31,6 +31,7 @@
 #include "checkpoint_worker.h"
 #include "checkpoint_manager.h"
 #include "mot_engine.h"
+#include "lz4.h"
 
 namespace MOT {
 DECLARE_LOGGER(CheckpointWorkerPool, Checkpoint);
@@ -49,6 +50,13 @@ void CheckpointWorkerPool::Start()
     if (!CheckpointManager::CreateCheckpointDir(m_workingDir))
         m_cpManager.OnError(ErrCodes::FILE_IO, "failed to create working dir", m_workingDir.c_str());
 
+    if (m_baseCheckpointId != 0 && !CheckpointUtils::SetWorkingDir(m_baseDir, m_baseCheckpointId)) {
+        MOT_LOG_WARN("CheckpointWorkerPool::start: failed to setup base dir, all tables will be fully checkpointed");
+        m_baseCheckpointId = 0;
+    }
+
+    m_compress = GetGlobalConfiguration().m_enableCheckpointCompression;
+
     WorkerThreads* threads = new (std::nothrow) WorkerThreads();
     if (threads == nullptr) {
         m_cpManager.OnError(ErrCodes::MEMORY, "failed to allocate checkpoint thread pool");
@@ -77,7 +85,40 @@ CheckpointWorkerPool::~CheckpointWorkerPool()
     MOT_LOG_DEBUG("~CheckpointWorkerPool: done");
 }
 
-bool CheckpointWorkerPool::Write(Buffer* buffer, Row* row, int fd)
+bool CheckpointWorkerPool::FlushBuffer(Buffer* buffer, int fd, char* lz4Buf)
+{
+    char* data = (char*)buffer->Data();
+    size_t len = buffer->Size();
+    if (m_compress) {
+        CheckpointUtils::CompressedBlockHeader* blockHeader = (CheckpointUtils::CompressedBlockHeader*)lz4Buf;
+        int compressedLen = LZ4_compress_default(data,
+            lz4Buf + sizeof(CheckpointUtils::CompressedBlockHeader),
+            (int)len,
+            LZ4_compressBound(CHECKPOINT_BUFFER_SIZE));
+        if (compressedLen <= 0) {
+            MOT_LOG_ERROR("CheckpointWorkerPool::FlushBuffer - failed to compress %u bytes", buffer->Size());
+            return false;
+        }
+        blockHeader->m_rawLen = (uint32_t)len;
+        blockHeader->m_compressedLen = (uint32_t)compressedLen;
+        data = lz4Buf;
+        len = sizeof(CheckpointUtils::CompressedBlockHeader) + (size_t)compressedLen;
+    }
+
+    size_t wrSta = CheckpointUtils::WriteFile(fd, data, len);
+    if (wrSta != len) {
+        MOT_LOG_ERROR("CheckpointWorkerPool::FlushBuffer - failed to write %lu bytes to [%d] (%d:%s)",
+            len,
+            fd,
+            errno,
+            gs_strerror(errno));
+        return false;
+    }
+    buffer->Reset();
+    return true;
+}
+
+bool CheckpointWorkerPool::Write(Buffer* buffer, Row* row, int fd, char* lz4Buf)
 {
     MaxKey key;
     Key* primaryKey = &key;
@@ -87,13 +128,7 @@ bool CheckpointWorkerPool::Write(Buffer* buffer, Row* row, int fd)
     if (buffer->Size() + primaryKey->GetKeyLength() + row->GetTupleSize() + sizeof(CheckpointUtils::EntryHeader) >
         buffer->MaxSize()) {
         // need to flush the buffer before serializing the next row
-        size_t wrSta = CheckpointUtils::WriteFile(fd, (char*)buffer->Data(), buffer->Size());
-        if (wrSta != buffer->Size()) {
-            MOT_LOG_ERROR("CheckpointWorkerPool::write - failed to write %u bytes to [%d] (%d:%s)",
-                buffer->Size(),
-                fd,
-                errno,
-                gs_strerror(errno));
+        if (!FlushBuffer(buffer, fd, lz4Buf)) {
             return false;
         }
 
@@ -101,7 +136,6 @@ bool CheckpointWorkerPool::Write(Buffer* buffer, Row* row, int fd)
             MOT_LOG_ERROR("CheckpointWorkerPool::write - failed to flush [%d]", fd);
             return false;
         }
-        buffer->Reset();
     }
     CheckpointUtils::EntryHeader entryHeader;
     entryHeader.m_keyLen = primaryKey->GetKeyLength();
@@ -123,7 +157,7 @@ bool CheckpointWorkerPool::Write(Buffer* buffer, Row* row, int fd)
     return true;
 }
 
-int CheckpointWorkerPool::Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd, int tid)
+int CheckpointWorkerPool::Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd, int tid, char* lz4Buf, bool skipWrite)
 {
     Row* mainRow = sentinel->GetData();
     int wrote = 0;
@@ -151,7 +185,7 @@ int CheckpointWorkerPool::Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd,
             if (deleted && stableRow == nullptr)
                 break;
             if (stableRow != nullptr) {
-                if (!Write(buffer, stableRow, fd)) {
+                if (!skipWrite && !Write(buffer, stableRow, fd, lz4Buf)) {
                     wrote = -1;
                 } else {
                     CheckpointUtils::DestroyStableRow(stableRow);
@@ -172,7 +206,7 @@ int CheckpointWorkerPool::Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd,
                     break;
                 }
                 sentinel->SetStableStatus(!m_na);
-                if (!Write(buffer, mainRow, fd))
+                if (!skipWrite && !Write(buffer, mainRow, fd, lz4Buf))
                     wrote = -1;  // we failed to write, set error
                 else
                     wrote = 1;
@@ -217,6 +251,18 @@ void CheckpointWorkerPool::WorkerFunc()
         MOT_LOG_DEBUG("thread exiting");
         return;
     }
+    char* lz4Buf = nullptr;
+    if (m_compress) {
+        lz4Buf = new (std::nothrow)
+            char[sizeof(CheckpointUtils::CompressedBlockHeader) + LZ4_compressBound(CHECKPOINT_BUFFER_SIZE)];
+        if (lz4Buf == nullptr) {
+            MOT_LOG_ERROR("CheckpointWorkerPool::workerFunc: Failed to allocate compression buffer");
+            m_cpManager.OnError(ErrCodes::MEMORY, "Memory allocation failure");
+            MOT::MOTEngine::GetInstance()->OnCurrentThreadEnding();
+            MOT_LOG_DEBUG("thread exiting");
+            return;
+        }
+    }
     SessionContext* sessionContext = GetSessionManager()->CreateSessionContext();
 
     int threadId = MOTCurrThreadId;
@@ -303,12 +349,6 @@ void CheckpointWorkerPool::WorkerFunc()
                 tableBuf = nullptr;
                 fd = -1;
 
-                if (!BeginFile(fd, tableId, seg, exId)) {
-                    MOT_LOG_ERROR("CheckpointWorkerPool::workerFunc: failed to create file: %s", fileName.c_str());
-                    m_cpManager.OnError(ErrCodes::FILE_IO, "Failed to create data file", fileName.c_str());
-                    break;
-                }
-
                 Index* index = table->GetPrimaryIndex();
                 if (index == nullptr) {
                     MOT_LOG_ERROR("CheckpointWorkerPool::workerFunc: failed to get index for table: %u", tableId);
@@ -318,6 +358,46 @@ void CheckpointWorkerPool::WorkerFunc()
                     break;
                 }
 
+                uint32_t lastSeg = 0;
+                if (CanReuseTableFiles(table, lastSeg) && LinkTableFiles(tableId, lastSeg)) {
+                    // the data files are unchanged, only advance the stable status of the rows
+                    IndexIterator* it = index->Begin(0);
+                    if (it == nullptr) {
+                        m_cpManager.OnError(ErrCodes::INDEX,
+                            "Failed to obtain primary index iterator for table - ",
+                            std::to_string(tableId).c_str());
+                        break;
+                    }
+                    bool iterationSucceeded = true;
+                    while (it->IsValid()) {
+                        MOT::Sentinel* Sentinel = it->GetPrimarySentinel();
+                        if (Sentinel != nullptr && Checkpoint(nullptr, Sentinel, -1, threadId, nullptr, true) < 0) {
+                            m_cpManager.OnError(
+                                ErrCodes::CALC, "Checkpoint failed for table - ", std::to_string(tableId).c_str());
+                            iterationSucceeded = false;
+                            break;
+                        }
+                        it->Next();
+                    }
+                    delete it;
+                    if (!iterationSucceeded) {
+                        break;
+                    }
+                    seg = lastSeg;
+                    taskSucceeded = true;
+                    MOT_LOG_DEBUG("CheckpointWorkerPool::workerFunc: reused %u segments of table %u from %lu",
+                        lastSeg + 1,
+                        tableId,
+                        m_baseCheckpointId);
+                    break;
+                }
+
+                if (!BeginFile(fd, tableId, seg, exId)) {
+                    MOT_LOG_ERROR("CheckpointWorkerPool::workerFunc: failed to create file: %s", fileName.c_str());
+                    m_cpManager.OnError(ErrCodes::FILE_IO, "Failed to create data file", fileName.c_str());
+                    break;
+                }
+
                 struct timespec start, end;
                 uint64_t numOps = 0;
                 clock_gettime(CLOCK_MONOTONIC, &start);
@@ -342,14 +422,13 @@ void CheckpointWorkerPool::WorkerFunc()
                         continue;
                     }
 
-                    int ckptStatus = Checkpoint(&buffer, Sentinel, fd, threadId);
+                    int ckptStatus = Checkpoint(&buffer, Sentinel, fd, threadId, lz4Buf);
                     if (ckptStatus == 1) {
                         numOps++;
                         curSegLen += table->GetTupleSize() + sizeof(CheckpointUtils::EntryHeader);
                         if (m_checkpointSegsize > 0 && curSegLen >= m_checkpointSegsize) {
                             if (buffer.Size() > 0) {  // there is data in the buffer that needs to be written
-                                if (CheckpointUtils::WriteFile(fd, (char*)buffer.Data(), buffer.Size()) !=
-                                    buffer.Size()) {
+                                if (!FlushBuffer(&buffer, fd, lz4Buf)) {
                                     MOT_LOG_ERROR("CheckpointWorkerPool::workerFunc: failed to write to file: %s",
                                         fileName.c_str());
                                     m_cpManager.OnError(
@@ -357,7 +436,6 @@ void CheckpointWorkerPool::WorkerFunc()
                                     iterationSucceeded = false;
                                     break;
                                 }
-                                buffer.Reset();
                             }
 
                             seg++;
@@ -401,13 +479,12 @@ void CheckpointWorkerPool::WorkerFunc()
 
                 overallOps += numOps;
                 if (buffer.Size() > 0) {  // there is data in the buffer that needs to be written
-                    if (CheckpointUtils::WriteFile(fd, (char*)buffer.Data(), buffer.Size()) != buffer.Size()) {
+                    if (!FlushBuffer(&buffer, fd, lz4Buf)) {
                         m_cpManager.OnError(ErrCodes::FILE_IO,
                             "Failed to write remaining data for table - ",
                             std::to_string(tableId).c_str());
                         break;
                     }
-                    buffer.Reset();
                 }
 
                 /* FinishFile will reset the fd to -1 on success. */
@@ -439,6 +516,9 @@ void CheckpointWorkerPool::WorkerFunc()
             }
 
             if (table != nullptr) {
+                if (taskSucceeded) {
+                    table->SetLastCheckpoint(m_checkpointId, m_generation, seg);
+                }
                 table->Unlock();
                 m_cpManager.TaskDone(tableId, seg, taskSucceeded);
             } else {
@@ -457,6 +537,9 @@ void CheckpointWorkerPool::WorkerFunc()
         }
     }
 
+    if (lz4Buf != nullptr) {
+        delete[] lz4Buf;
+    }
     GetSessionManager()->DestroySessionContext(sessionContext);
     MOT::MOTEngine::GetInstance()->OnCurrentThreadEnding();
     MOT_LOG_DEBUG("thread exiting");
@@ -471,7 +554,7 @@ bool CheckpointWorkerPool::BeginFile(int& fd, uint32_t tableId, int seg, uint64_
         return false;
     }
     MOT_LOG_DEBUG("CheckpointWorkerPool::beginFile: %s", fileName.c_str());
-    CheckpointUtils::FileHeader fileHeader{CP_MGR_MAGIC, tableId, exId, 0};
+    CheckpointUtils::FileHeader fileHeader{m_compress ? CP_MGR_LZ4_MAGIC : CP_MGR_MAGIC, tableId, exId, 0};
     if (CheckpointUtils::WriteFile(fd, (char*)&fileHeader, sizeof(CheckpointUtils::FileHeader)) !=
         sizeof(CheckpointUtils::FileHeader)) {
         MOT_LOG_ERROR("CheckpointWorkerPool::beginFile: failed to write file header: %s", fileName.c_str());
@@ -490,7 +573,7 @@ bool CheckpointWorkerPool::FinishFile(int& fd, uint32_t tableId, uint64_t numOps
             MOT_LOG_ERROR("CheckpointWorkerPool::finishFile: failed to seek in file (id: %u)", tableId);
             break;
         }
-        CheckpointUtils::FileHeader fileHeader{CP_MGR_MAGIC, tableId, exId, numOps};
+        CheckpointUtils::FileHeader fileHeader{m_compress ? CP_MGR_LZ4_MAGIC : CP_MGR_MAGIC, tableId, exId, numOps};
         if (CheckpointUtils::WriteFile(fd, (char*)&fileHeader, sizeof(CheckpointUtils::FileHeader)) !=
             sizeof(CheckpointUtils::FileHeader)) {
             MOT_LOG_ERROR("CheckpointWorkerPool::finishFile: failed to write to file (id: %u)", tableId);
@@ -511,6 +594,40 @@ bool CheckpointWorkerPool::FinishFile(int& fd, uint32_t tableId, uint64_t numOps
     return ret;
 }
 
+bool CheckpointWorkerPool::CanReuseTableFiles(Table* table, uint32_t& lastSeg) const
+{
+    if (m_baseCheckpointId == 0) {
+        return false;
+    }
+    uint64_t lastGen = 0;
+    if (table->GetLastCheckpoint(lastGen, lastSeg) != m_baseCheckpointId) {
+        return false;
+    }
+    // writes stamped with the generation of the previous checkpoint may not be part of it
+    return table->GetCheckpointWriteGen() < lastGen;
+}
+
+bool CheckpointWorkerPool::LinkTableFiles(uint32_t tableId, uint32_t lastSeg)
+{
+    std::string srcFileName;
+    std::string dstFileName;
+    for (uint32_t seg = 0; seg <= lastSeg; seg++) {
+        CheckpointUtils::MakeCpFilename(tableId, srcFileName, m_baseDir, seg);
+        CheckpointUtils::MakeCpFilename(tableId, dstFileName, m_workingDir, seg);
+        if (!CheckpointUtils::LinkFile(srcFileName, dstFileName)) {
+            MOT_LOG_WARN("CheckpointWorkerPool::LinkTableFiles: failed to reuse data files of table %u, "
+                         "performing a full checkpoint of the table",
+                tableId);
+            for (uint32_t i = 0; i < seg; i++) {
+                CheckpointUtils::MakeCpFilename(tableId, dstFileName, m_workingDir, i);
+                (void)unlink(dstFileName.c_str());
+            }
+            return false;
+        }
+    }
+    return true;
+}
+
 bool CheckpointWorkerPool::SetCheckpointId()
 {
     if (!CheckpointManager::CreateCheckpointId(m_checkpointId))
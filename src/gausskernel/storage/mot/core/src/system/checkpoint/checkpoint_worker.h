@@ -77,8 +77,17 @@ public:
  */
 class CheckpointWorkerPool {
 public:
-    CheckpointWorkerPool(int n, bool b, std::list<uint32_t>& l, uint32_t s, uint64_t id, CheckpointManagerCallbacks& m)
-        : m_numWorkers(n), m_tasksList(l), m_checkpointId(id), m_na(b), m_cpManager(m), m_checkpointSegsize(s)
+    CheckpointWorkerPool(int n, bool b, std::list<uint32_t>& l, uint32_t s, uint64_t id, uint64_t baseId,
+        uint64_t gen, CheckpointManagerCallbacks& m)
+        : m_numWorkers(n),
+          m_tasksList(l),
+          m_checkpointId(id),
+          m_baseCheckpointId(baseId),
+          m_generation(gen),
+          m_na(b),
+          m_cpManager(m),
+          m_checkpointSegsize(s),
+          m_compress(false)
     {
         Start();
     }
@@ -101,9 +110,20 @@ private:
      * @param buffer The buffer to fill.
      * @param row The row to write.
      * @param fd The file descriptor to write to.
+     * @param lz4Buf Scratch buffer for compression (used only when compression is enabled).
      * @return Boolean value denoting success or failure.
      */
-    bool Write(Buffer* buffer, Row* row, int fd);
+    bool Write(Buffer* buffer, Row* row, int fd, char* lz4Buf);
+
+    /**
+     * @brief Writes the buffer content to the file and resets the buffer. When compression
+     * is enabled the content is written as a single LZ4 compressed block.
+     * @param buffer The buffer to flush.
+     * @param fd The file descriptor to write to.
+     * @param lz4Buf Scratch buffer for compression (used only when compression is enabled).
+     * @return Boolean value denoting success or failure.
+     */
+    bool FlushBuffer(Buffer* buffer, int fd, char* lz4Buf);
 
     /**
      * @brief Checkpoints a row, according to whether a stable version
@@ -112,9 +132,30 @@ private:
      * @param sentinel The sentinel that holds to row.
      * @param fd The file descriptor to write to.
      * @param tid The thread id.
+     * @param lz4Buf Scratch buffer for compression (used only when compression is enabled).
+     * @param skipWrite Only advance the stable status of the row without writing it. Used for
+     * tables whose data files are reused from the previous checkpoint.
      * @return Int equal to -1 on error, 0 if nothing was written and 1 if the row was written.
      */
-    int Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd, int tid);
+    int Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd, int tid, char* lz4Buf, bool skipWrite = false);
+
+    /**
+     * @brief Checks whether the table was not modified since the previous checkpoint,
+     * so its data files can be reused. Must be called under the table lock.
+     * @param table The table to check.
+     * @param[out] lastSeg The last data file segment of the table in the previous checkpoint.
+     * @return True if the data files of the previous checkpoint can be reused.
+     */
+    bool CanReuseTableFiles(Table* table, uint32_t& lastSeg) const;
+
+    /**
+     * @brief Hard links the table data files of the previous checkpoint into the current
+     * checkpoint directory. On failure, links that were already created are removed.
+     * @param tableId The table id.
+     * @param lastSeg The last data file segment of the table.
+     * @return Boolean value denoting success or failure.
+     */
+    bool LinkTableFiles(uint32_t tableId, uint32_t lastSeg);
 
     /**
      * @brief Pops a task (table id) from the tasks queue.
@@ -165,6 +206,15 @@ private:
     // Checkpoint's id
     uint64_t m_checkpointId;
 
+    // Id of the previous completed checkpoint whose data files may be reused (0 if none)
+    uint64_t m_baseCheckpointId;
+
+    // The directory of the previous completed checkpoint
+    std::string m_baseDir;
+
+    // Checkpoint generation of the current checkpoint
+    uint64_t m_generation;
+
     // The current NotAvailable bit
     bool m_na;
 
@@ -173,6 +223,9 @@ private:
 
     // Size threshold
     uint32_t m_checkpointSegsize;
+
+    // Compress data files with LZ4
+    bool m_compress;
 };
 }  // namespace MOT
 
@@ -51,8 +51,13 @@ constexpr const char* MOTConfiguration::DEFAULT_CHECKPOINT_SEGSIZE;
 constexpr uint32_t MOTConfiguration::DEFAULT_CHECKPOINT_SEGSIZE_BYTES;
 constexpr uint32_t MOTConfiguration::DEFAULT_CHECKPOINT_WORKERS;
 constexpr bool MOTConfiguration::DEFAULT_VALIDATE_CHECKPOINT;
+constexpr bool MOTConfiguration::DEFAULT_ENABLE_DELTA_CHECKPOINT;
+constexpr bool MOTConfiguration::DEFAULT_ENABLE_CHECKPOINT_COMPRESSION;
 // recovery configuration members
 constexpr uint32_t MOTConfiguration::DEFAULT_CHECKPOINT_RECOVERY_WORKERS;
+constexpr uint32_t MOTConfiguration::DEFAULT_LOG_RECOVERY_WORKERS;
+constexpr uint32_t MOTConfiguration::DEFAULT_HOT_KEY_THRESHOLD;
+constexpr bool MOTConfiguration::DEFAULT_ENABLE_HOT_KEY_EARLY_LOCK;
 constexpr bool MOTConfiguration::DEFAULT_ENABLE_LOG_RECOVERY_STATS;
 // machine configuration members
 constexpr uint16_t MOTConfiguration::DEFAULT_NUMA_NODES;
@@ -391,10 +396,15 @@ MOTConfiguration::MOTConfiguration()
       m_checkpointSegThreshold(DEFAULT_CHECKPOINT_SEGSIZE_BYTES),
       m_checkpointWorkers(DEFAULT_CHECKPOINT_WORKERS),
       m_validateCheckpoint(DEFAULT_VALIDATE_CHECKPOINT),
+      m_enableDeltaCheckpoint(DEFAULT_ENABLE_DELTA_CHECKPOINT),
+      m_enableCheckpointCompression(DEFAULT_ENABLE_CHECKPOINT_COMPRESSION),
       m_checkpointRecoveryWorkers(DEFAULT_CHECKPOINT_RECOVERY_WORKERS),
+      m_logRecoveryWorkers(DEFAULT_LOG_RECOVERY_WORKERS),
       m_abortBufferEnable(true),
       m_preAbort(true),
       m_validationLock(TxnValidation::TXN_VALIDATION_NO_WAIT),
+      m_hotKeyThreshold(DEFAULT_HOT_KEY_THRESHOLD),
+      m_enableHotKeyEarlyLock(DEFAULT_ENABLE_HOT_KEY_EARLY_LOCK),
       m_numaNodes(DEFAULT_NUMA_NODES),
       m_coresPerCpu(DEFAULT_CORES_PER_CPU),
       m_dataNodeId(DEFAULT_DATA_NODE_ID),
@@ -486,10 +496,15 @@ bool MOTConfiguration::SetFlag(const std::string& name, const std::string& value
     } else if (ParseUint32(name, "checkpoint_segsize", value, &m_checkpointSegThreshold)) {
     } else if (ParseUint32(name, "checkpoint_workers", value, &m_checkpointWorkers)) {
     } else if (ParseBool(name, "validate_checkpoint", value, &m_validateCheckpoint)) {
+    } else if (ParseBool(name, "enable_delta_checkpoint", value, &m_enableDeltaCheckpoint)) {
+    } else if (ParseBool(name, "enable_checkpoint_compression", value, &m_enableCheckpointCompression)) {
     } else if (ParseUint32(name, "checkpoint_recovery_workers", value, &m_checkpointRecoveryWorkers)) {
+    } else if (ParseUint32(name, "log_recovery_workers", value, &m_logRecoveryWorkers)) {
     } else if (ParseBool(name, "abort_buffer_enable", value, &m_abortBufferEnable)) {
     } else if (ParseBool(name, "pre_abort", value, &m_preAbort)) {
     } else if (ParseValidation(name, "validation_lock", value, &m_validationLock)) {
+    } else if (ParseUint32(name, "hot_key_threshold", value, &m_hotKeyThreshold)) {
+    } else if (ParseBool(name, "enable_hot_key_early_lock", value, &m_enableHotKeyEarlyLock)) {
     } else if (ParseBool(name, "enable_stats", value, &m_enableStats)) {
     } else if (ParseUint32(name, "stats_period_seconds", value, &m_statPrintPeriodSeconds)) {
     } else if (ParseUint32(name, "full_stats_period_seconds", value, &m_statPrintFullPeriodSeconds)) {
@@ -648,15 +663,22 @@ void MOTConfiguration::LoadConfig()
     UPDATE_MEM_CFG(m_checkpointSegThreshold, "checkpoint_segsize", DEFAULT_CHECKPOINT_SEGSIZE, 1);
     UPDATE_INT_CFG(m_checkpointWorkers, "checkpoint_workers", DEFAULT_CHECKPOINT_WORKERS);
     UPDATE_CFG(m_validateCheckpoint, "validate_checkpoint", DEFAULT_VALIDATE_CHECKPOINT);
+    UPDATE_CFG(m_enableDeltaCheckpoint, "enable_delta_checkpoint", DEFAULT_ENABLE_DELTA_CHECKPOINT);
+    UPDATE_CFG(m_enableCheckpointCompression, "enable_checkpoint_compression", DEFAULT_ENABLE_CHECKPOINT_COMPRESSION);
 
     // Recovery configuration
     UPDATE_INT_CFG(m_checkpointRecoveryWorkers, "checkpoint_recovery_workers", DEFAULT_CHECKPOINT_RECOVERY_WORKERS);
+    UPDATE_INT_CFG(m_logRecoveryWorkers, "log_recovery_workers", DEFAULT_LOG_RECOVERY_WORKERS);
 
     // Tx configuration - not configurable yet
     UPDATE_CFG(m_abortBufferEnable, "tx_abort_buffers_enable", true);
     UPDATE_CFG(m_preAbort, "tx_pre_abort", true);
     m_validationLock = TxnValidation::TXN_VALIDATION_NO_WAIT;
 
+    // contention configuration
+    UPDATE_INT_CFG(m_hotKeyThreshold, "hot_key_threshold", DEFAULT_HOT_KEY_THRESHOLD);
+    UPDATE_CFG(m_enableHotKeyEarlyLock, "enable_hot_key_early_lock", DEFAULT_ENABLE_HOT_KEY_EARLY_LOCK);
+
     // statistics configuration
     UPDATE_CFG(m_enableStats, "enable_stats", DEFAULT_ENABLE_STATS);
     UPDATE_TIME_CFG(m_statPrintPeriodSeconds, "print_stats_period", DEFAULT_STATS_PRINT_PERIOD, 1000000);
@@ -156,6 +156,12 @@ public:
     /** @var Do checkpoints bit validations - use it for debugging only */
     bool m_validateCheckpoint;
 
+    /** @var Specifies whether tables not modified since the previous checkpoint reuse its data files. */
+    bool m_enableDeltaCheckpoint;
+
+    /** @var Specifies whether checkpoint data files are compressed with LZ4. */
+    bool m_enableCheckpointCompression;
+
     /**********************************************************************/
     // Recovery configuration
     /**********************************************************************/
@@ -163,6 +169,9 @@ public:
     /** @var Specifies the number of workers used to recover from checkpoint. */
     uint32_t m_checkpointRecoveryWorkers;
 
+    /** @var Specifies the number of workers used to replay the redo log (1 means serial replay). */
+    uint32_t m_logRecoveryWorkers;
+
     /**********************************************************************/
     // Transaction management variables (not configurable)
     /**********************************************************************/
@@ -171,6 +180,12 @@ public:
     bool m_preAbort;
     TxnValidation m_validationLock;
 
+    /** @var Number of recent validation aborts after which a key is considered hot. */
+    uint32_t m_hotKeyThreshold;
+
+    /** @var Specifies whether hot keys are write-locked on first access instead of at commit. */
+    bool m_enableHotKeyEarlyLock;
+
     /**********************************************************************/
     // Machine configuration (not configurable, but loaded from system info)
     /**********************************************************************/
@@ -433,13 +448,29 @@ private:
     /** @var Default enable checkpoint validation. */
     static constexpr bool DEFAULT_VALIDATE_CHECKPOINT = false;
 
+    /** @var Default enable delta checkpoint. */
+    static constexpr bool DEFAULT_ENABLE_DELTA_CHECKPOINT = false;
+
+    /** @var Default enable checkpoint compression. */
+    static constexpr bool DEFAULT_ENABLE_CHECKPOINT_COMPRESSION = false;
+
     // default recovery configuration
     /** @var Default number of workers used in recovery from checkpoint. */
     static constexpr uint32_t DEFAULT_CHECKPOINT_RECOVERY_WORKERS = 3;
 
+    /** @var Default number of workers used in redo log recovery. */
+    static constexpr uint32_t DEFAULT_LOG_RECOVERY_WORKERS = 1;
+
     /** @var Default enable log recovery statistics. */
     static constexpr bool DEFAULT_ENABLE_LOG_RECOVERY_STATS = false;
 
+    // default transaction configuration
+    /** @var Default number of recent validation aborts after which a key is considered hot. */
+    static constexpr uint32_t DEFAULT_HOT_KEY_THRESHOLD = 16;
+
+    /** @var Default enable early locking of hot keys. */
+    static constexpr bool DEFAULT_ENABLE_HOT_KEY_EARLY_LOCK = false;
+
     // default machine configuration
     /** @var Default number of NUMA nodes of the machine. */
     static constexpr uint16_t DEFAULT_NUMA_NODES = 1;
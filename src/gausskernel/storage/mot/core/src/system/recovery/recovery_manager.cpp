@@ -256,12 +256,20 @@ bool RecoveryManager::RecoverTableRows(
         return false;
     }
 
-    if (fileHeader.m_magic != CP_MGR_MAGIC || fileHeader.m_tableId != tableId) {
+    if ((fileHeader.m_magic != CP_MGR_MAGIC && fileHeader.m_magic != CP_MGR_LZ4_MAGIC) ||
+        fileHeader.m_tableId != tableId) {
         MOT_LOG_ERROR("RecoveryManager::recoverTableRows: file: %s is corrupted", fileName.c_str());
         CheckpointUtils::CloseFile(fd);
         return false;
     }
 
+    CheckpointUtils::FileReader fileReader(fd, fileHeader.m_magic == CP_MGR_LZ4_MAGIC);
+    if (!fileReader.Initialize()) {
+        MOT_LOG_ERROR("RecoveryManager::recoverTableRows: failed to initialize reader for file: %s", fileName.c_str());
+        CheckpointUtils::CloseFile(fd);
+        return false;
+    }
+
     CheckpointUtils::EntryHeader entry;
     char* keyData = (char*)malloc(MAX_KEY_SIZE);
     if (keyData == nullptr) {
@@ -284,7 +292,7 @@ bool RecoveryManager::RecoverTableRows(
             status = RC_ERROR;
             break;
         }
-        reader = CheckpointUtils::ReadFile(fd, (char*)&entry, sizeof(CheckpointUtils::EntryHeader));
+        reader = fileReader.Read((char*)&entry, sizeof(CheckpointUtils::EntryHeader));
         if (reader != sizeof(CheckpointUtils::EntryHeader)) {
             MOT_LOG_ERROR(
                 "RecoveryManager::recoverTableRows: failed to read entry header (elem: %lu / %lu), reader %lu",
@@ -305,7 +313,7 @@ bool RecoveryManager::RecoverTableRows(
             break;
         }
 
-        reader = CheckpointUtils::ReadFile(fd, keyData, entry.m_keyLen);
+        reader = fileReader.Read(keyData, entry.m_keyLen);
         if (reader != entry.m_keyLen) {
             MOT_LOG_ERROR("RecoveryManager::recoverTableRows: failed to read entry key (elem: %lu / %lu), reader %lu",
                 i,
@@ -315,7 +323,7 @@ bool RecoveryManager::RecoverTableRows(
             break;
         }
 
-        reader = CheckpointUtils::ReadFile(fd, entryData, entry.m_dataLen);
+        reader = fileReader.Read(entryData, entry.m_dataLen);
         if (reader != entry.m_dataLen) {
             MOT_LOG_ERROR("RecoveryManager::recoverTableRows: failed to read entry data (elem: %lu / %lu), reader %lu",
                 i,
@@ -527,6 +535,9 @@ bool RecoveryManager::RecoverDbStart()
 
 bool RecoveryManager::RecoverDbEnd()
 {
+    // all the dispatched redo operations must be replayed before the in-process transactions are applied
+    StopRedoWorkers();
+
     if (ApplyInProcessTransactions() != RC_OK) {
         MOT_LOG_ERROR("applyInProcessTransactions failed!");
         return false;
@@ -544,7 +555,13 @@ bool RecoveryManager::RecoverDbEnd()
     ApplySurrogate();
 
     if (m_enableLogStats && m_logStats != nullptr) {
-        m_logStats->Print();
+        uint64_t replayMicros = 0;
+        if (m_redoStarted) {
+            replayMicros = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - m_redoStartTime)
+                               .count();
+        }
+        m_logStats->Print(replayMicros, m_numRedoWorkers);
     }
 
     if (m_numRedoOps != 0) {
@@ -565,6 +582,8 @@ void RecoveryManager::CleanUp()
         return;
     }
 
+    StopRedoWorkers();
+
     if (m_logStats != nullptr) {
         delete m_logStats;
         m_logStats = nullptr;
@@ -716,7 +735,18 @@ bool RecoveryManager::OperateOnRecoveredTransaction(
                 }
             }
         }
-        delete segments;
+
+        if (m_redoWorkers != nullptr && rState != RecoveryOpState::ABORT) {
+            // the workers still reference the segments data, release them on the next drain
+            FlushRedoBatches();
+            m_redoRetiredTxns.push_back(segments);
+            if (m_redoRetiredTxns.size() >= MAX_REDO_RETIRED_TRANSACTIONS && !DrainRedoWorkers()) {
+                MOT_LOG_ERROR("operateOnRecoveredTransaction: parallel redo failed");
+                return false;
+            }
+        } else {
+            delete segments;
+        }
     }
 
     if (rState == RecoveryOpState::ABORT && externalTransactionId != INVALID_TRANSACTIOIN_ID) {
@@ -733,6 +763,16 @@ RC RecoveryManager::RedoSegment(LogSegment* segment, uint64_t csn, uint64_t tran
     uint8_t* endPosition = (uint8_t*)(segment->m_data + segment->m_len);
     uint8_t* operationData = (uint8_t*)(segment->m_data);
 
+    if (!is2pcRecovery && !m_redoStarted) {
+        m_redoStartTime = std::chrono::steady_clock::now();
+        m_redoStarted = true;
+    }
+
+    if (!is2pcRecovery && m_numRedoWorkers > 1) {
+        return DispatchRedoSegment(segment, csn, transactionId);
+    }
+
+    uint64_t numOps = 0;
     while (operationData < endPosition) {
         // redolog recovery - single threaded
         if (IsRecoveryMemoryLimitReached(NUM_REDO_RECOVERY_THREADS)) {
@@ -761,18 +801,260 @@ RC RecoveryManager::RedoSegment(LogSegment* segment, uint64_t csn, uint64_t tran
         if (status != RC_OK) {
             break;
         }
+        ++numOps;
     }
 
     // single threaded, no need for locking or CAS
     if (!is2pcRecovery && csn > m_maxRecoveredCsn) {
         m_maxRecoveredCsn = csn;
     }
+    if (!is2pcRecovery && m_logStats != nullptr) {
+        m_logStats->AddRedoSegment(numOps, segment->m_len);
+    }
     if (status != RC_OK) {
         MOT_LOG_ERROR("RecoveryManager::redoSegment: got error %d on tid %lu", status, transactionId);
     }
     return status;
 }
 
+RC RecoveryManager::DispatchRedoSegment(LogSegment* segment, uint64_t csn, uint64_t transactionId)
+{
+    RC status = RC_OK;
+    uint8_t* endPosition = (uint8_t*)(segment->m_data + segment->m_len);
+    uint8_t* operationData = (uint8_t*)(segment->m_data);
+    uint64_t numOps = 0;
+
+    if (m_redoWorkers == nullptr && !StartRedoWorkers()) {
+        return RC_MEMORY_ALLOCATION_ERROR;
+    }
+
+    if (IsRecoveryMemoryLimitReached(m_numRedoWorkers)) {
+        MOT_LOG_ERROR("Memory hard limit reached. Cannot recover datanode");
+        return RC_ERROR;
+    }
+
+    while (operationData < endPosition) {
+        OperationCode opCode = *static_cast<OperationCode*>((void*)operationData);
+        if (IsRowOp(opCode)) {
+            uint32_t workerId = 0;
+            uint32_t opLength = GetRowOperationRoute(operationData, workerId, status);
+            if (status != RC_OK) {
+                break;
+            }
+            m_redoWorkers[workerId].m_batch.push_back({operationData, csn, transactionId});
+            operationData += opLength;
+        } else {
+            // DDL operations change the tables seen by the workers, so everything dispatched
+            // so far (including this transaction's row operations) must be replayed first
+            bool isEndOp = (opCode == COMMIT_TX || opCode == COMMIT_PREPARED_TX || opCode == PARTIAL_REDO_TX ||
+                            opCode == PREPARE_TX);
+            if (!isEndOp && !DrainRedoWorkers()) {
+                status = RC_ERROR;
+                break;
+            }
+            operationData += RecoverLogOperation(operationData, csn, transactionId, MOTCurrThreadId, m_sState, status);
+        }
+        if (status != RC_OK) {
+            break;
+        }
+        ++numOps;
+    }
+
+    // dispatching is single threaded, no need for locking or CAS
+    if (csn > m_maxRecoveredCsn) {
+        m_maxRecoveredCsn = csn;
+    }
+    if (m_logStats != nullptr) {
+        m_logStats->AddRedoSegment(numOps, segment->m_len);
+    }
+    if (status != RC_OK) {
+        MOT_LOG_ERROR("RecoveryManager::dispatchRedoSegment: got error %d on tid %lu", status, transactionId);
+    }
+    return status;
+}
+
+void RecoveryManager::FlushRedoBatches()
+{
+    for (uint32_t i = 0; i < m_numRedoWorkers; ++i) {
+        RedoWorker& worker = m_redoWorkers[i];
+        if (!worker.m_batch.empty()) {
+            m_redoPendingOps += worker.m_batch.size();
+            worker.Push(worker.m_batch);
+        }
+    }
+}
+
+bool RecoveryManager::DrainRedoWorkers()
+{
+    if (m_redoWorkers == nullptr) {
+        return !m_errorSet;
+    }
+
+    FlushRedoBatches();
+    {
+        std::unique_lock<std::mutex> lock(m_redoDrainLock);
+        m_redoDrainCV.wait(lock, [this]() { return m_redoPendingOps == 0; });
+    }
+
+    for (RedoTransactionSegments* segments : m_redoRetiredTxns) {
+        delete segments;
+    }
+    m_redoRetiredTxns.clear();
+
+    // workers are idle, it is safe to release the cached table memory
+    ClearTableCache();
+    return !m_errorSet;
+}
+
+bool RecoveryManager::StartRedoWorkers()
+{
+    m_redoWorkers = new (std::nothrow) RedoWorker[m_numRedoWorkers];
+    if (m_redoWorkers == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Redo Recovery", "Failed to allocate %u redo workers", m_numRedoWorkers);
+        OnError(RecoveryManager::ErrCodes::XLOG_SETUP, "RecoveryManager:: failed to allocate redo workers");
+        return false;
+    }
+
+    for (uint32_t i = 0; i < m_numRedoWorkers; ++i) {
+        if (m_redoWorkers[i].m_sState.IsValid() == false) {
+            delete[] m_redoWorkers;
+            m_redoWorkers = nullptr;
+            OnError(RecoveryManager::ErrCodes::SURROGATE,
+                "RecoveryManager:: failed to allocate redo worker surrogate state");
+            return false;
+        }
+    }
+
+    for (uint32_t i = 0; i < m_numRedoWorkers; ++i) {
+        m_redoWorkers[i].m_thread = std::thread(&RecoveryManager::RedoWorkerFunc, this, &m_redoWorkers[i]);
+    }
+    MOT_LOG_INFO("RecoveryManager:: started %u redo log recovery workers", m_numRedoWorkers);
+    return true;
+}
+
+void RecoveryManager::StopRedoWorkers()
+{
+    if (m_redoWorkers == nullptr) {
+        return;
+    }
+
+    (void)DrainRedoWorkers();
+    for (uint32_t i = 0; i < m_numRedoWorkers; ++i) {
+        m_redoWorkers[i].Stop();
+    }
+
+    for (uint32_t i = 0; i < m_numRedoWorkers; ++i) {
+        if (m_redoWorkers[i].m_thread.joinable()) {
+            m_redoWorkers[i].m_thread.join();
+        }
+        AddSurrogateArrayToList(m_redoWorkers[i].m_sState);
+    }
+
+    delete[] m_redoWorkers;
+    m_redoWorkers = nullptr;
+    MOT_LOG_INFO("RecoveryManager:: stopped %u redo log recovery workers", m_numRedoWorkers);
+}
+
+void RecoveryManager::RedoWorkerFunc(RedoWorker* worker)
+{
+    // since this is a non-kernel thread we must set-up our own u_sess struct for the current thread
+    MOT_DECLARE_NON_KERNEL_THREAD();
+
+    MOT::MOTEngine* engine = MOT::MOTEngine::GetInstance();
+    SessionContext* sessionContext = GetSessionManager()->CreateSessionContext();
+    int threadId = MOTCurrThreadId;
+    GcManager* gc = nullptr;
+
+    if (sessionContext == nullptr) {
+        OnError(RecoveryManager::ErrCodes::XLOG_SETUP, "RecoveryManager::redoWorkerFunc failed to create session");
+    } else {
+        gc = sessionContext->GetTxnManager()->GetGcSession();
+    }
+
+    // in a thread-pooled envelope the affinity could be disabled, so we use task affinity here
+    if (!GetTaskAffinity().SetAffinity(threadId)) {
+        MOT_LOG_WARN("Failed to set affinity of redo recovery worker, redo recovery performance may be affected");
+    }
+    MOT_LOG_DEBUG("RecoveryManager::redoWorkerFunc start [%u] on cpu %lu", (unsigned)threadId, sched_getcpu());
+
+    std::vector<RedoOp> ops;
+    uint32_t numOps = 0;
+    while (worker->Pop(ops)) {
+        // after an error the remaining operations are only consumed, so the dispatcher is not blocked
+        for (size_t i = 0; i < ops.size() && !m_errorSet; ++i) {
+            if (IsRecoveryMemoryLimitReached(m_numRedoWorkers)) {
+                MOT_LOG_ERROR("Memory hard limit reached. Cannot recover datanode");
+                OnError(RecoveryManager::ErrCodes::XLOG_RECOVERY, "RecoveryManager:: Memory hard limit reached");
+                break;
+            }
+
+            RC status = RC_OK;
+            if (numOps == 0 && gc != nullptr) {
+                gc->GcStartTxn();
+            }
+            (void)RecoverLogOperation(
+                ops[i].m_data, ops[i].m_csn, ops[i].m_transactionId, threadId, worker->m_sState, status);
+            if (++numOps > NUM_DELETE_THRESHOLD) {
+                if (gc != nullptr) {
+                    gc->GcEndTxn();
+                }
+                numOps = 0;
+            }
+            if (status != RC_OK) {
+                MOT_LOG_ERROR(
+                    "RecoveryManager::redoWorkerFunc: got error %d on tid %lu", status, ops[i].m_transactionId);
+                OnError(RecoveryManager::ErrCodes::XLOG_RECOVERY,
+                    "RecoveryManager::redoWorkerFunc: wal recovery failed");
+                break;
+            }
+        }
+
+        uint64_t count = ops.size();
+        ops.clear();
+        if (m_redoPendingOps.fetch_sub(count) == count) {
+            std::lock_guard<std::mutex> lock(m_redoDrainLock);
+            m_redoDrainCV.notify_all();
+        }
+    }
+
+    if (numOps != 0 && gc != nullptr) {
+        gc->GcEndTxn();
+    }
+
+    if (sessionContext != nullptr) {
+        GetSessionManager()->DestroySessionContext(sessionContext);
+    }
+    engine->OnCurrentThreadEnding();
+    MOT_LOG_DEBUG("RecoveryManager::redoWorkerFunc end [%u] on cpu %lu", (unsigned)threadId, sched_getcpu());
+}
+
+void RecoveryManager::RedoWorker::Push(std::vector<RedoOp>& ops)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_queue.insert(m_queue.end(), ops.begin(), ops.end());
+    ops.clear();
+    m_cv.notify_one();
+}
+
+bool RecoveryManager::RedoWorker::Pop(std::vector<RedoOp>& ops)
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+    m_cv.wait(lock, [this]() { return m_stop || !m_queue.empty(); });
+    if (m_queue.empty()) {
+        return false;
+    }
+    ops.assign(m_queue.begin(), m_queue.end());
+    m_queue.clear();
+    return true;
+}
+
+void RecoveryManager::RedoWorker::Stop()
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_stop = true;
+    m_cv.notify_one();
+}
+
 bool RecoveryManager::LogStats::FindIdx(uint64_t tableId, uint64_t& id)
 {
     id = m_numEntries;
@@ -794,7 +1076,7 @@ bool RecoveryManager::LogStats::FindIdx(uint64_t tableId, uint64_t& id)
     return true;
 }
 
-void RecoveryManager::LogStats::Print()
+void RecoveryManager::LogStats::Print(uint64_t replayMicros, uint32_t numWorkers)
 {
     MOT_LOG_ERROR(">> log recovery stats >>");
     for (int i = 0; i < m_numEntries; i++) {
@@ -805,6 +1087,17 @@ void RecoveryManager::LogStats::Print()
             m_tableStats[i]->m_deletes.load());
     }
     MOT_LOG_ERROR("Overall tcls: %lu", m_tcls.load());
+
+    uint64_t replayMillis = replayMicros / 1000;
+    uint64_t opsPerSec = (replayMicros > 0) ? (m_redoOps.load() * 1000000 / replayMicros) : 0;
+    uint64_t kbPerSec = (replayMicros > 0) ? (m_redoBytes.load() * 1000000 / replayMicros / 1024) : 0;
+    MOT_LOG_ERROR("Redo replay: %lu ops, %lu bytes in %lu ms using %u workers (%lu ops/sec, %lu KB/sec)",
+        m_redoOps.load(),
+        m_redoBytes.load(),
+        replayMillis,
+        numWorkers,
+        opsPerSec,
+        kbPerSec);
 }
 
 void RecoveryManager::SetCsnIfGreater(uint64_t csn)
@@ -949,6 +1242,10 @@ RC RecoveryManager::ApplyInProcessTransaction(uint64_t internalTransactionId)
 {
     RC status = RC_OK;
     MOT_LOG_DEBUG("applyInProcessTransaction (id %lu)", internalTransactionId);
+    if (!DrainRedoWorkers()) {
+        return RC_ERROR;
+    }
+
     map<uint64_t, RedoTransactionSegments*>::iterator it = m_inProcessTransactionMap.find(internalTransactionId);
     if (it != m_inProcessTransactionMap.end()) {
         RedoTransactionSegments* segments = it->second;
@@ -1236,6 +1533,19 @@ bool RecoveryManager::DeserializeInProcessTxns(int fd, uint64_t numEntries)
     return success;
 }
 
+bool RecoveryManager::IsRowOp(OperationCode op)
+{
+    switch (op) {
+        case CREATE_ROW:
+        case UPDATE_ROW:
+        case OVERWRITE_ROW:
+        case REMOVE_ROW:
+            return true;
+        default:
+            return false;
+    }
+}
+
 bool RecoveryManager::IsSupportedOp(OperationCode op)
 {
     switch (op) {
@@ -1262,11 +1572,16 @@ bool RecoveryManager::FetchTable(uint64_t id, Table*& table)
     bool ret = false;
     table = GetTableManager()->GetTable(id);
     if (table == nullptr) {
+        std::lock_guard<std::mutex> lock(m_preCommitedTablesLock);
         std::map<uint64_t, TableInfo*>::iterator it = m_preCommitedTables.find(id);
         if (it != m_preCommitedTables.end() && it->second != nullptr) {
             TableInfo* tableInfo = (TableInfo*)it->second;
             table = tableInfo->m_table;
             ret = true;
+        } else {
+            // a 2PC commit may have moved the table to the engine since the first lookup
+            table = GetTableManager()->GetTable(id);
+            ret = (table != nullptr);
         }
     } else {
         ret = true;
@@ -1332,6 +1647,7 @@ bool RecoveryManager::IsRecoveryMemoryLimitReached(uint32_t numThreads)
 
 void RecoveryManager::ClearTableCache()
 {
+    std::lock_guard<std::mutex> lock(m_tableDeletesStatLock);
     auto it = m_tableDeletesStat.begin();
     while (it != m_tableDeletesStat.end()) {
         auto table = *it;
@@ -27,6 +27,11 @@
 
 #include <set>
 #include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
 #include "checkpoint_ctrlfile.h"
 #include "redo_log_global.h"
 #include "transaction_buffer_iterator.h"
@@ -183,7 +188,11 @@ public:
           m_clogCallback(nullptr),
           m_threadId(AllocThreadId()),
           m_maxConnections(GetGlobalConfiguration().m_maxConnections),
-          m_numRedoOps(0)
+          m_numRedoOps(0),
+          m_numRedoWorkers(GetGlobalConfiguration().m_logRecoveryWorkers),
+          m_redoWorkers(nullptr),
+          m_redoPendingOps(0),
+          m_redoStarted(false)
     {}
 
     ~RecoveryManager()
@@ -394,7 +403,7 @@ private:
             uint64_t m_id;
         };
 
-        LogStats() : m_tcls(0), m_numEntries(0)
+        LogStats() : m_tcls(0), m_redoOps(0), m_redoBytes(0), m_numEntries(0)
         {}
 
         ~LogStats()
@@ -434,10 +443,23 @@ private:
          */
         bool FindIdx(uint64_t tableId, uint64_t& id);
 
+        /**
+         * @brief Accounts a replayed redo segment.
+         * @param numOps The number of redo operations in the segment.
+         * @param bytes The segment length in bytes.
+         */
+        void AddRedoSegment(uint64_t numOps, uint64_t bytes)
+        {
+            m_redoOps += numOps;
+            m_redoBytes += bytes;
+        }
+
         /**
          * @brief Prints the stats data to the log
+         * @param replayMicros The redo replay elapsed time in microseconds.
+         * @param numWorkers The number of redo replay workers.
          */
-        void Print();
+        void Print(uint64_t replayMicros, uint32_t numWorkers);
 
         std::map<uint64_t, int> m_idToIdx;
 
@@ -445,6 +467,12 @@ private:
 
         std::atomic<uint64_t> m_tcls;
 
+        /** @var Number of replayed redo operations. */
+        std::atomic<uint64_t> m_redoOps;
+
+        /** @var Number of replayed redo bytes. */
+        std::atomic<uint64_t> m_redoBytes;
+
     private:
         spin_lock m_slock;
 
@@ -604,6 +632,7 @@ public:
 
     inline void IncreaseTableDeletesStat(Table* t)
     {
+        std::lock_guard<std::mutex> lock(m_tableDeletesStatLock);
         m_tableDeletesStat[t]++;
     }
 
@@ -613,11 +642,78 @@ public:
 
     std::map<uint64_t, TableInfo*> m_preCommitedTables;
 
+    /** @var Protects m_preCommitedTables, which the redo workers read while 2PC apply updates it. */
+    std::mutex m_preCommitedTablesLock;
+
     std::unordered_map<Table*, uint32_t> m_tableDeletesStat;
 
 private:
     static constexpr uint32_t NUM_REDO_RECOVERY_THREADS = 1;
 
+    /** @var Number of transactions dispatched to the redo workers before a drain is forced. */
+    static constexpr uint32_t MAX_REDO_RETIRED_TRANSACTIONS = 1024;
+
+    /**
+     * @struct RedoOp
+     * @brief A single row operation handed to a parallel redo worker.
+     */
+    struct RedoOp {
+        uint8_t* m_data;
+
+        uint64_t m_csn;
+
+        uint64_t m_transactionId;
+    };
+
+    /**
+     * @class RedoWorker
+     * @brief A parallel redo replay worker. All the operations of a given key are
+     * routed to the same worker, so they are replayed in log (CSN) order.
+     */
+    class RedoWorker {
+    public:
+        RedoWorker() : m_stop(false)
+        {}
+
+        ~RedoWorker()
+        {}
+
+        /**
+         * @brief Appends a batch of operations to the worker queue.
+         * @param ops The operations to append. The vector is cleared on return.
+         */
+        void Push(std::vector<RedoOp>& ops);
+
+        /**
+         * @brief Waits for operations and moves them to the caller.
+         * @param ops The returned operations.
+         * @return Boolean value that is false if the worker was stopped and its queue is empty.
+         */
+        bool Pop(std::vector<RedoOp>& ops);
+
+        /**
+         * @brief Signals the worker to exit once its queue is empty.
+         */
+        void Stop();
+
+        std::thread m_thread;
+
+        /** @var The surrogate key state collected by this worker. */
+        SurrogateState m_sState;
+
+        /** @var The operations batch dispatched to this worker in the current transaction. */
+        std::vector<RedoOp> m_batch;
+
+    private:
+        std::deque<RedoOp> m_queue;
+
+        std::mutex m_lock;
+
+        std::condition_variable m_cv;
+
+        bool m_stop;
+    };
+
     /**
      * @brief performs a redo on a segment, which is either a recovery op
      * or a segment that belongs to a 2pc recovered transaction.
@@ -629,6 +725,62 @@ private:
      */
     RC RedoSegment(LogSegment* segment, uint64_t csn, uint64_t transactionId, RecoveryOpState rState);
 
+    /**
+     * @brief dispatches the row operations of a segment to the redo workers. DDL
+     * operations drain the workers and are performed by the caller.
+     * @param segment the segment to redo.
+     * @param csn the segment's csn
+     * @param transactionId the transaction id of the segment
+     * @return RC value denoting the operation's status
+     */
+    RC DispatchRedoSegment(LogSegment* segment, uint64_t csn, uint64_t transactionId);
+
+    /**
+     * @brief hands the operations dispatched for the current transaction to the workers.
+     */
+    void FlushRedoBatches();
+
+    /**
+     * @brief waits until all dispatched operations were replayed and releases the
+     * retired transactions.
+     * @return Boolean value denoting if the workers did not report an error.
+     */
+    bool DrainRedoWorkers();
+
+    /**
+     * @brief starts the parallel redo workers.
+     * @return Boolean value denoting success or failure.
+     */
+    bool StartRedoWorkers();
+
+    /**
+     * @brief drains and stops the parallel redo workers and collects their
+     * surrogate states.
+     */
+    void StopRedoWorkers();
+
+    /**
+     * @brief Implements a parallel redo worker.
+     * @param worker the worker's state.
+     */
+    void RedoWorkerFunc(RedoWorker* worker);
+
+    /**
+     * @brief parses the header of a row operation and computes the worker it belongs to.
+     * @param data the operation buffer.
+     * @param workerId the returned worker index.
+     * @param status the returned status of the operation
+     * @return Int value denoting the number of bytes of the operation
+     */
+    uint32_t GetRowOperationRoute(uint8_t* data, uint32_t& workerId, RC& status);
+
+    /**
+     * @brief checks if an operation is a row operation that may be replayed in parallel.
+     * @param op the operation code to check.
+     * @return Boolean value denoting if the op is a row operation.
+     */
+    static bool IsRowOp(OperationCode op);
+
     /**
      * @brief inserts a segment in to the in-process transactions map
      * @param segment the segment to redo.
@@ -1061,6 +1213,27 @@ private:
     uint16_t m_maxConnections;
 
     uint32_t m_numRedoOps;
+
+    std::mutex m_tableDeletesStatLock;
+
+    /** @var Number of parallel redo workers (1 means serial replay). */
+    uint32_t m_numRedoWorkers;
+
+    RedoWorker* m_redoWorkers;
+
+    /** @var Number of operations dispatched but not yet replayed. */
+    std::atomic<uint64_t> m_redoPendingOps;
+
+    std::mutex m_redoDrainLock;
+
+    std::condition_variable m_redoDrainCV;
+
+    /** @var Transactions whose segments are still referenced by the redo workers. */
+    std::vector<RedoTransactionSegments*> m_redoRetiredTxns;
+
+    bool m_redoStarted;
+
+    std::chrono::steady_clock::time_point m_redoStartTime;
 };
 }  // namespace MOT
 
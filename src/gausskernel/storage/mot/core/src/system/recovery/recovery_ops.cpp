@@ -34,6 +34,9 @@
 namespace MOT {
 DECLARE_LOGGER(RecoveryOps, Recovery);
 
+constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
 uint32_t RecoveryManager::RecoverLogOperation(
     uint8_t* data, uint64_t csn, uint64_t transactionId, uint32_t tid, SurrogateState& sState, RC& status)
 {
@@ -102,6 +105,7 @@ uint32_t RecoveryManager::RecoverLogOperationCreateTable(
             if (status == RC_OK && table != nullptr) {
                 tableInfo = new (std::nothrow) TableInfo(table, transactionId);
                 if (tableInfo != nullptr) {
+                    std::lock_guard<std::mutex> lock(MOT::GetRecoveryManager()->m_preCommitedTablesLock);
                     MOT::GetRecoveryManager()->m_preCommitedTables[table->GetTableId()] = tableInfo;
                 } else {
                     status = RC_ERROR;
@@ -120,28 +124,33 @@ uint32_t RecoveryManager::RecoverLogOperationCreateTable(
         case TPC_ABORT:
             MOT_LOG_INFO("RecoverLogOperationCreateTable: %s", (state == TPC_COMMIT) ? "TPC_COMMIT" : "TPC_ABORT");
             Table::DeserializeNameAndIds((const char*)data, tableId, extId, tableName, longName);
-            it = GetRecoveryManager()->m_preCommitedTables.find(tableId);
-            if (it != GetRecoveryManager()->m_preCommitedTables.end()) {
-                tableInfo = (TableInfo*)it->second;
-                if (tableInfo != nullptr) {
-                    if (state == TPC_COMMIT) {
-                        MOT_LOG_DEBUG("RecoverLogOperationCreateTable - adding table %s to engine", longName.c_str());
-                        status = GetTableManager()->AddTable(tableInfo->m_table) ? RC_OK : RC_ERROR;
-                    } else
-                        status = RC_OK;
+            {
+                // the table moves from the map to the engine under the lock, FetchTable sees it in one of them
+                std::lock_guard<std::mutex> lock(GetRecoveryManager()->m_preCommitedTablesLock);
+                it = GetRecoveryManager()->m_preCommitedTables.find(tableId);
+                if (it != GetRecoveryManager()->m_preCommitedTables.end()) {
+                    tableInfo = (TableInfo*)it->second;
+                    if (tableInfo != nullptr) {
+                        if (state == TPC_COMMIT) {
+                            MOT_LOG_DEBUG(
+                                "RecoverLogOperationCreateTable - adding table %s to engine", longName.c_str());
+                            status = GetTableManager()->AddTable(tableInfo->m_table) ? RC_OK : RC_ERROR;
+                        } else
+                            status = RC_OK;
+                    } else {
+                        MOT_LOG_ERROR("RecoverLogOperationCreateTable: no data on table info");
+                        status = RC_ERROR;
+                    }
+                    if (tableInfo != nullptr && tableInfo->m_table != nullptr && state == TPC_ABORT)
+                        delete tableInfo->m_table;
+                    if (tableInfo != nullptr)
+                        delete tableInfo;
+                    GetRecoveryManager()->m_preCommitedTables.erase(it);
                 } else {
-                    MOT_LOG_ERROR("RecoverLogOperationCreateTable: no data on table info");
+                    MOT_LOG_ERROR(
+                        "RecoverLogOperationCreateTable: could not find table [%lu] %s", tableId, tableName.c_str());
                     status = RC_ERROR;
                 }
-                if (tableInfo != nullptr && tableInfo->m_table != nullptr && state == TPC_ABORT)
-                    delete tableInfo->m_table;
-                if (tableInfo != nullptr)
-                    delete tableInfo;
-                GetRecoveryManager()->m_preCommitedTables.erase(it);
-            } else {
-                MOT_LOG_ERROR(
-                    "RecoverLogOperationCreateTable: could not find table [%lu] %s", tableId, tableName.c_str());
-                status = RC_ERROR;
             }
             break;
 
@@ -441,6 +450,79 @@ uint32_t RecoveryManager::RecoverLogOperationCommit(uint8_t* data, uint64_t csn,
     return sizeof(EndSegmentBlock);
 }
 
+uint32_t RecoveryManager::GetRowOperationRoute(uint8_t* data, uint32_t& workerId, RC& status)
+{
+    uint64_t tableId, exId, rowId, rowLength;
+    uint16_t keyLength;
+    uint8_t* keyData = nullptr;
+    uint8_t* start = data;
+    Table* table = nullptr;
+
+    OperationCode opCode = *(OperationCode*)data;
+    MOT_ASSERT(IsRowOp(opCode));
+    data += sizeof(OperationCode);
+
+    Extract(data, tableId);
+    Extract(data, exId);
+    if (opCode == CREATE_ROW) {
+        Extract(data, rowId);
+    }
+    Extract(data, keyLength);
+    keyData = ExtractPtr(data, keyLength);
+
+    if (!FetchTable(tableId, table)) {
+        status = RC_ERROR;
+        MOT_REPORT_ERROR(MOT_ERROR_INTERNAL, "Recovery Manager Route Row", "Table %lu does not exist", tableId);
+        return 0;
+    }
+
+    switch (opCode) {
+        case CREATE_ROW:
+        case OVERWRITE_ROW:
+            Extract(data, rowLength);
+            (void)ExtractPtr(data, rowLength);
+            break;
+        case UPDATE_ROW: {
+            // the delta length depends on the updated columns, as parsed by RecoverLogOperationUpdate
+            uint16_t numColumns = table->GetFieldCount() - 1;
+            BitmapSet updatedColumns(ExtractPtr(data, BitmapSet::GetLength(numColumns)), numColumns);
+            BitmapSet validColumns(ExtractPtr(data, BitmapSet::GetLength(numColumns)), numColumns);
+            BitmapSet::BitmapSetIterator updatedColumnsIt(updatedColumns);
+            BitmapSet::BitmapSetIterator validColumnsIt(validColumns);
+            while (!updatedColumnsIt.End()) {
+                if (updatedColumnsIt.IsSet() && validColumnsIt.IsSet()) {
+                    data += table->GetField(updatedColumnsIt.GetPosition() + 1)->m_size;
+                }
+                validColumnsIt.Next();
+                updatedColumnsIt.Next();
+            }
+            break;
+        }
+        default:
+            break;
+    }
+
+    // Operations are partitioned by primary key, so all the versions of a row are replayed by the same
+    // worker in log order. A unique secondary key may move from one row to another (delete followed by an
+    // insert with a different primary key), so tables with unique secondary indexes use a single worker.
+    uint64_t hash = FNV_OFFSET_BASIS;
+    hash = (hash ^ tableId) * FNV_PRIME;
+    bool hasUniqueSecondary = false;
+    for (uint16_t i = 1; i < table->GetNumIndexes(); i++) {
+        if (table->GetSecondaryIndex(i)->GetUnique()) {
+            hasUniqueSecondary = true;
+            break;
+        }
+    }
+    if (!hasUniqueSecondary) {
+        for (uint16_t i = 0; i < keyLength; i++) {
+            hash = (hash ^ keyData[i]) * FNV_PRIME;
+        }
+    }
+    workerId = (uint32_t)(hash % m_numRedoWorkers);
+    return (uint32_t)(data - start);
+}
+
 void RecoveryManager::InsertRow(uint64_t tableId, uint64_t exId, char* keyData, uint16_t keyLen, char* rowData,
     uint64_t rowLen, uint64_t csn, uint32_t tid, SurrogateState& sState, RC& status, uint64_t rowId, bool insertLocked)
 {
@@ -27,6 +27,7 @@
 #include "config_manager.h"
 #include "statistics_manager.h"
 #include "mot_error.h"
+#include "contention_sketch.h"
 
 namespace MOT {
 DECLARE_LOGGER(DbSessionStatisticsProvider, System)
@@ -41,7 +42,9 @@ DbSessionThreadStatistics::DbSessionThreadStatistics(uint64_t threadId, void* in
       m_commitTxnCount(MakeName("commit-txn", threadId).c_str()),
       m_rollbackTxnCount(MakeName("rollback-txn", threadId).c_str()),
       m_commitPreparedTxnCount(MakeName("commit-prepared-txn", threadId).c_str()),
-      m_rollbackPreparedTxnCount(MakeName("rollback-prepared-txn", threadId).c_str())
+      m_rollbackPreparedTxnCount(MakeName("rollback-prepared-txn", threadId).c_str()),
+      m_occAbortCount(MakeName("occ-abort", threadId).c_str()),
+      m_hotKeyEarlyLockCount(MakeName("hot-key-early-lock", threadId).c_str())
 {
     RegisterStatistics(&m_txnCount);
     RegisterStatistics(&m_rowPerTxnCount);
@@ -52,6 +55,8 @@ DbSessionThreadStatistics::DbSessionThreadStatistics(uint64_t threadId, void* in
     RegisterStatistics(&m_rollbackTxnCount);
     RegisterStatistics(&m_commitPreparedTxnCount);
     RegisterStatistics(&m_rollbackPreparedTxnCount);
+    RegisterStatistics(&m_occAbortCount);
+    RegisterStatistics(&m_hotKeyEarlyLockCount);
 }
 
 TypedStatisticsGenerator<DbSessionThreadStatistics, EmptyGlobalStatistics> DbSessionStatisticsProvider::m_generator;
@@ -129,4 +134,15 @@ void DbSessionStatisticsProvider::OnConfigChange()
         }
     }
 }
+
+void DbSessionStatisticsProvider::PrintStatisticsEx()
+{
+    ContentionSketch& sketch = ContentionSketch::GetInstance();
+    MOT_LOG_INFO("Contention: Hot keys = %" PRIu64 " (threshold %u), Max key aborts = %u, "
+                 "Total key aborts = %" PRIu64,
+        sketch.GetHotKeyCount(),
+        GetGlobalConfiguration().m_hotKeyThreshold,
+        sketch.GetMaxEstimate(),
+        sketch.GetAbortCount());
+}
 }  // namespace MOT
@@ -103,6 +103,18 @@ public:
         m_rollbackPreparedTxnCount.AddSample();
     }
 
+    /** @brief Updates the commit-validation abort count statistics. */
+    inline void AddOccAbortCount()
+    {
+        m_occAbortCount.AddSample();
+    }
+
+    /** @brief Updates the hot key early lock count statistics. */
+    inline void AddHotKeyEarlyLockCount()
+    {
+        m_hotKeyEarlyLockCount.AddSample();
+    }
+
 private:
     /** @var The transaction count statistic variable. */
     FrequencyStatisticVariable m_txnCount;
@@ -130,6 +142,12 @@ private:
 
     /** @var The rolled-back-prepared-transaction count statistic variable. */
     FrequencyStatisticVariable m_rollbackPreparedTxnCount;
+
+    /** @var The commit-validation abort count statistic variable. */
+    FrequencyStatisticVariable m_occAbortCount;
+
+    /** @var The hot key early lock count statistic variable. */
+    FrequencyStatisticVariable m_hotKeyEarlyLockCount;
 };
 
 /**
@@ -235,12 +253,36 @@ public:
         }
     }
 
+    /** @brief Records a commit-validation abort event. */
+    inline void AddOccAbort()
+    {
+        DbSessionThreadStatistics* dbts = GetCurrentThreadStatistics<DbSessionThreadStatistics>();
+        if (dbts != nullptr) {
+            dbts->AddOccAbortCount();
+        }
+    }
+
+    /** @brief Records a hot key early lock event. */
+    inline void AddHotKeyEarlyLock()
+    {
+        DbSessionThreadStatistics* dbts = GetCurrentThreadStatistics<DbSessionThreadStatistics>();
+        if (dbts != nullptr) {
+            dbts->AddHotKeyEarlyLockCount();
+        }
+    }
+
     /**
      * @brief Derives classes should react to a notification that configuration changed. New
      * configuration is accessible via the ConfigManager.
      */
     virtual void OnConfigChange();
 
+protected:
+    /**
+     * @brief Override default behavior, and print the hot key summary of the contention sketch.
+     */
+    virtual void PrintStatisticsEx();
+
 private:
     /** @brief Constructor. */
     DbSessionStatisticsProvider();
@@ -107,9 +107,11 @@ Row* TxnManager::RowLookup(const AccessType type, Sentinel* const& originalSenti
                 // For Read-Only Txn return the Commited row
                 if (GetTxnIsoLevel() == READ_COMMITED and type == AccessType::RD) {
                     return m_accessMgr->GetReadCommitedRow(originalSentinel);
-                } else {
+                } else if (type == AccessType::RD) {
                     // Row is not in the cache,map it and return the local row
                     return m_accessMgr->MapRowtoLocalTable(AccessType::RD, originalSentinel, rc);
+                } else {
+                    return MapRowForUpdate(originalSentinel, rc);
                 }
             } else
                 return nullptr;
@@ -121,6 +123,22 @@ Row* TxnManager::RowLookup(const AccessType type, Sentinel* const& originalSenti
     }
 }
 
+Row* TxnManager::MapRowForUpdate(Sentinel* const& originalSentinel, RC& rc)
+{
+    // Hot keys are locked before the row is copied so the copy cannot become stale before commit
+    Sentinel* primarySentinel = reinterpret_cast<Sentinel*>(originalSentinel->GetPrimarySentinel());
+    bool earlyLocked = m_occManager.TryEarlyLock(this, primarySentinel);
+    Row* localRow = m_accessMgr->MapRowtoLocalTable(AccessType::RD, originalSentinel, rc);
+    if (earlyLocked) {
+        if (localRow != nullptr) {
+            m_occManager.SetEarlyLocked(m_accessMgr->GetLastAccess());
+        } else {
+            primarySentinel->Release();
+        }
+    }
+    return localRow;
+}
+
 RC TxnManager::AccessLookup(const AccessType type, Sentinel* const& originalSentinel, Row*& localRow)
 {
     return m_accessMgr->AccessLookup(type, originalSentinel, localRow);
@@ -385,6 +403,7 @@ RC TxnManager::FailedCommitPrepared(uint64_t transcationId)
 void TxnManager::Cleanup()
 {
     if (m_isLightSession == false) {
+        m_occManager.ReleaseEarlyLocks(this);
         m_accessMgr->ClearSet();
     }
     m_txnDdlAccess->Reset();
@@ -476,6 +495,7 @@ void TxnManager::RollbackSecondaryIndexInsert(Index* index)
     while (it != access_row_set.end()) {
         Access* ac = it->second;
         if (ac->m_type == INS && ac->GetSentinel()->GetIndex() == index) {
+            m_occManager.ReleaseEarlyLock(ac);
             RollbackInsert(ac);
             it = access_row_set.erase(it);
             // need to perform index clean-up!
@@ -515,6 +535,9 @@ void TxnManager::RollbackDDLs()
                 indexes = (Index**)ddl_access->GetEntry();
                 table = indexes[0]->GetTable();
                 MOT_LOG_INFO("Rollback of truncate table %s", table->GetLongTableName().c_str());
+                if (GetGlobalConfiguration().m_enableCheckpoint) {
+                    GetCheckpointManager()->MarkTableChanged(table);
+                }
                 for (int idx = 0; idx < table->GetNumIndexes(); idx++) {
                     index = table->m_indexes[idx];
                     table->m_indexes[idx] = indexes[idx];
@@ -572,6 +595,9 @@ void TxnManager::WriteDDLChanges()
                 table = indexes[0]->GetTable();
                 table->Lock();
                 table->m_rowCount = 0;
+                if (GetGlobalConfiguration().m_enableCheckpoint) {
+                    GetCheckpointManager()->MarkTableChanged(table);
+                }
                 for (int i = 0; i < table->GetNumIndexes(); i++) {
                     index = indexes[i];
                     GcManager::ClearIndexElements(index->GetIndexId());
@@ -749,6 +775,8 @@ bool TxnManager::Init(uint64_t _thread_id, uint64_t connection_id, bool isLightT
     } else {
         MOT_ASSERT(false);
     }
+    m_occManager.SetHotKeyPolicy(
+        GetGlobalConfiguration().m_hotKeyThreshold, GetGlobalConfiguration().m_enableHotKeyEarlyLock);
 
     return true;
 }
@@ -1090,6 +1118,7 @@ RC TxnManager::DropTable(Table* table)
         while (it != access_row_set.end()) {
             Access* ac = it->second;
             if (ac->GetTxnRow()->GetTable() == table) {
+                m_occManager.ReleaseEarlyLock(ac);
                 if (ac->m_type == INS)
                     RollbackInsert(ac);
                 it = access_row_set.erase(it);
@@ -1150,6 +1179,7 @@ RC TxnManager::TruncateTable(Table* table)
         while (it != access_row_set.end()) {
             Access* ac = it->second;
             if (ac->GetTxnRow()->GetTable() == table) {
+                m_occManager.ReleaseEarlyLock(ac);
                 if (ac->m_type == INS)
                     RollbackInsert(ac);
                 it = access_row_set.erase(it);
@@ -1209,6 +1239,9 @@ RC TxnManager::TruncateTable(Table* table)
                 table->m_primaryIndex = index_copy;
         }
         m_txnDdlAccess->Add(ddl_access);
+        if (GetGlobalConfiguration().m_enableCheckpoint) {
+            GetCheckpointManager()->MarkTableChanged(table);
+        }
     }
 
     return res;
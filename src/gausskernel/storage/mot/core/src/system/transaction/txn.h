@@ -458,6 +458,15 @@ private:
      */
     void WriteDDLChanges();
 
+    /**
+     * @brief Maps a committed row into the local cache for a subsequent update or delete. Keys
+     * that are hot according to the contention sketch are write-locked first.
+     * @param originalSentinel The sentinel of the row.
+     * @param[out] rc The return code.
+     * @return The local row, or null if the row could not be mapped.
+     */
+    Row* MapRowForUpdate(Sentinel* const& originalSentinel, RC& rc);
+
     /**
      * @brief Reclaims all resources associated with the transaction and
      * prepares this object to execute another transaction.
@@ -43,6 +43,7 @@
 #include "executor/executor.h"
 #include "storage/ipc.h"
 #include "commands/dbcommands.h"
+#include "commands/defrem.h"
 #include "knl/knl_session.h"
 
 #include "log_statistics.h"
@@ -1495,6 +1496,19 @@ static MOT::RC TableFieldType(const ColumnDef* colDef, MOT::MOT_CATALOG_FIELD_TY
     return res;
 }
 
+// The index_method reloption picks the hash index instead of the default tree
+static bool IsHashIndexMethod(List* options)
+{
+    ListCell* lc = nullptr;
+    foreach (lc, options) {
+        DefElem* def = (DefElem*)lfirst(lc);
+        if (pg_strcasecmp(def->defname, "index_method") == 0) {
+            return (pg_strcasecmp(defGetString(def), "hash") == 0);
+        }
+    }
+    return false;
+}
+
 MOT::RC MOTAdaptor::CreateIndex(IndexStmt* index, ::TransactionId tid)
 {
     MOT::RC rc = MOT::RC_OK;
@@ -1531,13 +1545,26 @@ MOT::RC MOTAdaptor::CreateIndex(IndexStmt* index, ::TransactionId tid)
     MOT::IndexingMethod indexing_method;
     MOT::IndexTreeFlavor flavor;
 
-    if (strcmp(index->accessMethod, "btree") == 0) {
+    if (strcmp(index->accessMethod, "btree") != 0) {
+        ereport(ERROR, (errmodule(MOD_MM), errmsg("MOT supports indexes of type BTREE only")));
+        return MOT::RC_OK;
+    }
+
+    if (IsHashIndexMethod(index->options)) {
+        // Hash index serves equality lookups only, so each key must map to a single row
+        if (!index->unique && !index->primary) {
+            ereport(ERROR,
+                (errmodule(MOD_MM),
+                    errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+                    errmsg("MOT supports index_method hash on unique keys only")));
+            return MOT::RC_OK;
+        }
+        indexing_method = MOT::IndexingMethod::INDEXING_METHOD_HASH;
+        flavor = DEFAULT_TREE_FLAVOR;
+    } else {
         // Use the default index tree flavor from configuration file
         indexing_method = MOT::IndexingMethod::INDEXING_METHOD_TREE;
         flavor = MOT::GetGlobalConfiguration().m_indexTreeFlavor;
-    } else {
-        ereport(ERROR, (errmodule(MOD_MM), errmsg("MOT supports indexes of type BTREE only (btree or btree_art)")));
-        return MOT::RC_OK;
     }
 
     if (list_length(index->indexParams) > (int)MAX_KEY_COLUMNS) {
@@ -2755,6 +2782,12 @@ inline double MatchIndex::GetCost(int numClauses)
         return INT_MAX;
     }
 
+    // hash index can only serve a full key point lookup
+    if (m_ix->GetIndexingMethod() == MOT::IndexingMethod::INDEXING_METHOD_HASH &&
+        (m_end != -1 || m_ixOpers[m_start] != KEY_OPER::READ_KEY_EXACT)) {
+        return INT_MAX;
+    }
+
     return m_cost;
 }
 
@@ -2789,6 +2822,11 @@ bool MatchIndex::CanApplyOrdering(const int* orderCols) const
 {
     int16_t numKeyCols = m_ix->GetNumFields();
 
+    // hash order carries no key order
+    if (m_ix->GetIndexingMethod() == MOT::IndexingMethod::INDEXING_METHOD_HASH) {
+        return false;
+    }
+
     // check if order columns are overlap index matched columns or are suffix for it
     for (int16_t i = 0; i < numKeyCols; i++) {
         // overlap: we can use index ordering
@@ -313,6 +313,13 @@ public:
             }
         }
 
+        // hash index can only serve point queries
+        if ((_index->GetIndexingMethod() == MOT::IndexingMethod::INDEXING_METHOD_HASH) &&
+            (scan_type != JIT_INDEX_SCAN_POINT)) {
+            MOT_LOG_TRACE("RangeScanExpressionCollector(): Disqualifying query - range scan on hash index");
+            return;
+        }
+
         // final step: verify we have no holes in the columns according to the expected scan type
         if (!scanHasHoles(scan_type)) {
             _index_scan->_scan_type = scan_type;
@@ -63,6 +63,12 @@ static void begin_cb_wrapper(ReorderBuffer* cache, ReorderBufferTXN* txn);
 static void commit_cb_wrapper(ReorderBuffer* cache, ReorderBufferTXN* txn, XLogRecPtr commit_lsn);
 static void change_cb_wrapper(
     ReorderBuffer* cache, ReorderBufferTXN* txn, Relation relation, ReorderBufferChange* change);
+static void stream_start_cb_wrapper(ReorderBuffer* cache, ReorderBufferTXN* txn);
+static void stream_change_cb_wrapper(
+    ReorderBuffer* cache, ReorderBufferTXN* txn, Relation relation, ReorderBufferChange* change);
+static void stream_stop_cb_wrapper(ReorderBuffer* cache, ReorderBufferTXN* txn);
+static void stream_abort_cb_wrapper(ReorderBuffer* cache, ReorderBufferTXN* txn, XLogRecPtr abort_lsn);
+static void stream_commit_cb_wrapper(ReorderBuffer* cache, ReorderBufferTXN* txn, XLogRecPtr commit_lsn);
 static void LoadOutputPlugin(OutputPluginCallbacks* callbacks, const char* plugin);
 
 /*
@@ -155,6 +161,16 @@ static LogicalDecodingContext* StartupDecodingContext(List* output_plugin_option
     ctx->reorder->begin = begin_cb_wrapper;
     ctx->reorder->apply_change = change_cb_wrapper;
     ctx->reorder->commit = commit_cb_wrapper;
+    ctx->reorder->stream_start = stream_start_cb_wrapper;
+    ctx->reorder->stream_change = stream_change_cb_wrapper;
+    ctx->reorder->stream_stop = stream_stop_cb_wrapper;
+    ctx->reorder->stream_abort = stream_abort_cb_wrapper;
+    ctx->reorder->stream_commit = stream_commit_cb_wrapper;
+
+    /* the plugin's startup callback may still turn streaming off */
+    ctx->streaming = !fast_forward && ctx->callbacks.stream_start_cb != NULL &&
+                     ctx->callbacks.stream_change_cb != NULL && ctx->callbacks.stream_stop_cb != NULL &&
+                     ctx->callbacks.stream_abort_cb != NULL && ctx->callbacks.stream_commit_cb != NULL;
 
     ctx->out = makeStringInfo();
     ctx->prepare_write = prepare_write;
@@ -712,6 +728,154 @@ static void change_cb_wrapper(
     t_thrd.log_cxt.error_context_stack = errcallback.previous;
 }
 
+static void stream_start_cb_wrapper(ReorderBuffer* cache, ReorderBufferTXN* txn)
+{
+    LogicalDecodingContext* ctx = (LogicalDecodingContext*)cache->private_data;
+    LogicalErrorCallbackState state;
+    ErrorContextCallback errcallback;
+
+    Assert(ctx->streaming);
+
+    /* Push callback + info on the error context stack */
+    state.ctx = ctx;
+    state.callback_name = "stream_start";
+    state.report_location = txn->first_lsn;
+    errcallback.callback = output_plugin_error_callback;
+    errcallback.arg = (void*)&state;
+    errcallback.previous = t_thrd.log_cxt.error_context_stack;
+    t_thrd.log_cxt.error_context_stack = &errcallback;
+
+    /* set output state */
+    ctx->accept_writes = true;
+    ctx->write_xid = txn->xid;
+    ctx->write_location = txn->first_lsn;
+
+    /* do the actual work: call callback */
+    ctx->callbacks.stream_start_cb(ctx, txn);
+
+    /* Pop the error context stack */
+    t_thrd.log_cxt.error_context_stack = errcallback.previous;
+}
+
+static void stream_change_cb_wrapper(
+    ReorderBuffer* cache, ReorderBufferTXN* txn, Relation relation, ReorderBufferChange* change)
+{
+    LogicalDecodingContext* ctx = (LogicalDecodingContext*)cache->private_data;
+    LogicalErrorCallbackState state;
+    ErrorContextCallback errcallback;
+
+    Assert(ctx->streaming);
+
+    /* Push callback + info on the error context stack */
+    state.ctx = ctx;
+    state.callback_name = "stream_change";
+    state.report_location = change->lsn;
+    errcallback.callback = output_plugin_error_callback;
+    errcallback.arg = (void*)&state;
+    errcallback.previous = t_thrd.log_cxt.error_context_stack;
+    t_thrd.log_cxt.error_context_stack = &errcallback;
+
+    /*
+     * set output state, as for change_cb_wrapper the change's lsn is never
+     * enough to confirm receipt of the transaction
+     */
+    ctx->accept_writes = true;
+    ctx->write_xid = txn->xid;
+    ctx->write_location = change->lsn;
+
+    ctx->callbacks.stream_change_cb(ctx, txn, relation, change);
+
+    /* Pop the error context stack */
+    t_thrd.log_cxt.error_context_stack = errcallback.previous;
+}
+
+static void stream_stop_cb_wrapper(ReorderBuffer* cache, ReorderBufferTXN* txn)
+{
+    LogicalDecodingContext* ctx = (LogicalDecodingContext*)cache->private_data;
+    LogicalErrorCallbackState state;
+    ErrorContextCallback errcallback;
+
+    Assert(ctx->streaming);
+
+    /* Push callback + info on the error context stack */
+    state.ctx = ctx;
+    state.callback_name = "stream_stop";
+    state.report_location = InvalidXLogRecPtr;
+    errcallback.callback = output_plugin_error_callback;
+    errcallback.arg = (void*)&state;
+    errcallback.previous = t_thrd.log_cxt.error_context_stack;
+    t_thrd.log_cxt.error_context_stack = &errcallback;
+
+    /* set output state, keeping the location of the last change */
+    ctx->accept_writes = true;
+    ctx->write_xid = txn->xid;
+
+    /* do the actual work: call callback */
+    ctx->callbacks.stream_stop_cb(ctx, txn);
+
+    /* Pop the error context stack */
+    t_thrd.log_cxt.error_context_stack = errcallback.previous;
+}
+
+static void stream_abort_cb_wrapper(ReorderBuffer* cache, ReorderBufferTXN* txn, XLogRecPtr abort_lsn)
+{
+    LogicalDecodingContext* ctx = (LogicalDecodingContext*)cache->private_data;
+    LogicalErrorCallbackState state;
+    ErrorContextCallback errcallback;
+
+    Assert(ctx->streaming);
+
+    /* Push callback + info on the error context stack */
+    state.ctx = ctx;
+    state.callback_name = "stream_abort";
+    state.report_location = abort_lsn;
+    errcallback.callback = output_plugin_error_callback;
+    errcallback.arg = (void*)&state;
+    errcallback.previous = t_thrd.log_cxt.error_context_stack;
+    t_thrd.log_cxt.error_context_stack = &errcallback;
+
+    /* set output state, no abort record to point to after a restart */
+    ctx->accept_writes = true;
+    ctx->write_xid = txn->xid;
+    if (!XLByteEQ(abort_lsn, InvalidXLogRecPtr))
+        ctx->write_location = abort_lsn;
+
+    /* do the actual work: call callback */
+    ctx->callbacks.stream_abort_cb(ctx, txn, abort_lsn);
+
+    /* Pop the error context stack */
+    t_thrd.log_cxt.error_context_stack = errcallback.previous;
+}
+
+static void stream_commit_cb_wrapper(ReorderBuffer* cache, ReorderBufferTXN* txn, XLogRecPtr commit_lsn)
+{
+    LogicalDecodingContext* ctx = (LogicalDecodingContext*)cache->private_data;
+    LogicalErrorCallbackState state;
+    ErrorContextCallback errcallback;
+
+    Assert(ctx->streaming);
+
+    /* Push callback + info on the error context stack */
+    state.ctx = ctx;
+    state.callback_name = "stream_commit";
+    state.report_location = txn->final_lsn; /* beginning of commit record */
+    errcallback.callback = output_plugin_error_callback;
+    errcallback.arg = (void*)&state;
+    errcallback.previous = t_thrd.log_cxt.error_context_stack;
+    t_thrd.log_cxt.error_context_stack = &errcallback;
+
+    /* set output state */
+    ctx->accept_writes = true;
+    ctx->write_xid = txn->xid;
+    ctx->write_location = txn->end_lsn; /* points to the end of the record */
+
+    /* do the actual work: call callback */
+    ctx->callbacks.stream_commit_cb(ctx, txn, commit_lsn);
+
+    /* Pop the error context stack */
+    t_thrd.log_cxt.error_context_stack = errcallback.previous;
+}
+
 bool filter_by_origin_cb_wrapper(LogicalDecodingContext* ctx, RepOriginId origin_id)
 {
     LogicalErrorCallbackState state;
@@ -37,6 +37,11 @@
  *	contents of individual (sub-)transactions will be read from disk in
  *	chunks.
  *
+ *	If the output plugin can take them, the changes of a large transaction
+ *	that is still running are instead sent to it while they come in (c.f.
+ *	ReorderBufferStreamTXN()), and the rest of it at commit, so that neither
+ *	the disk nor the commit has to carry the whole transaction.
+ *
  *	This module also has to deal with reassembling toast records from the
  *	individual chunks stored in WAL. When a new (or initial) version of a
  *	tuple is stored in WAL it will always be preceded by the toast chunks
@@ -71,6 +76,7 @@
 
 #include "storage/bufmgr.h"
 #include "storage/fd.h"
+#include "storage/procarray.h"
 #include "storage/sinval.h"
 
 #include "utils/lsyscache.h"
@@ -168,6 +174,16 @@ static ReorderBufferIterTXNState* ReorderBufferIterTXNInit(ReorderBuffer* rb, Re
 static ReorderBufferChange* ReorderBufferIterTXNNext(ReorderBuffer* rb, ReorderBufferIterTXNState* state);
 static void ReorderBufferIterTXNFinish(ReorderBuffer* rb, ReorderBufferIterTXNState* state);
 static void ReorderBufferExecuteInvalidations(ReorderBuffer* rb, ReorderBufferTXN* txn);
+static bool ReorderBufferReplayTupleChange(
+    ReorderBuffer* rb, ReorderBufferTXN* txn, ReorderBufferChange* change, ReorderBufferApplyChangeCB apply_change);
+
+/*
+ * ---------------------------------------
+ * Streaming of large in-progress transactions
+ * ---------------------------------------
+ */
+static bool ReorderBufferCanStreamTXN(ReorderBuffer* rb, ReorderBufferTXN* txn);
+static void ReorderBufferStreamTXN(ReorderBuffer* rb, ReorderBufferTXN* txn);
 
 /*
  * ---------------------------------------
@@ -1064,6 +1080,13 @@ static void ReorderBufferCleanupTXN(ReorderBuffer* rb, ReorderBufferTXN* txn)
         dlist_delete(&txn->base_snapshot_node);
     }
 
+    /* a streamed transaction may end with its snapshot and toast chunks still around */
+    if (txn->stream_snapshot != NULL) {
+        ReorderBufferFreeSnap(rb, txn->stream_snapshot);
+        txn->stream_snapshot = NULL;
+    }
+    ReorderBufferToastReset(rb, txn);
+
     /*
      * Remove TXN from its containing list.
      *
@@ -1225,6 +1248,94 @@ static void ReorderBufferFreeSnap(ReorderBuffer* rb, Snapshot snap)
         SnapBuildSnapDecRefcount(snap);
 }
 
+/*
+ * Hand an insert/update/delete to the output plugin through apply_change,
+ * reassembling toast data on the way.
+ *
+ * Returns true if the change was a toast chunk which has been moved from the
+ * transaction's list of changes into its toast hash.
+ */
+static bool ReorderBufferReplayTupleChange(
+    ReorderBuffer* rb, ReorderBufferTXN* txn, ReorderBufferChange* change, ReorderBufferApplyChangeCB apply_change)
+{
+    Relation relation = NULL;
+    Oid reloid;
+    Oid partitionReltoastrelid = InvalidOid;
+    bool chunk_taken = false;
+
+    reloid = RelidByRelfilenode(change->data.tp.relnode.spcNode, change->data.tp.relnode.relNode);
+    if (reloid == InvalidOid) {
+        reloid = PartitionRelidByRelfilenode(
+            change->data.tp.relnode.spcNode, change->data.tp.relnode.relNode, partitionReltoastrelid);
+    }
+    /*
+     * Catalog tuple without data, emitted while catalog was
+     * in the process of being rewritten.
+     */
+    if (reloid == InvalidOid && change->data.tp.newtuple == NULL && change->data.tp.oldtuple == NULL)
+        return false;
+    else if (reloid == InvalidOid) {
+        /*
+         * description:
+         * When we try to decode a table who is already dropped.
+         * Maybe we could not find it relnode.In this time, we will undecode this log.
+         * It will be solve when we use MVCC.
+         */
+        ereport(DEBUG1,
+            (errmsg("could not lookup relation %s", relpathperm(change->data.tp.relnode, MAIN_FORKNUM))));
+        return false;
+    }
+
+    relation = RelationIdGetRelation(reloid);
+    if (relation == NULL) {
+        ereport(DEBUG1,
+            (errmsg("could open relation descriptor %s", relpathperm(change->data.tp.relnode, MAIN_FORKNUM))));
+        return false;
+    }
+
+    if (CSTORE_NAMESPACE == get_rel_namespace(RelationGetRelid(relation))) {
+        RelationClose(relation);
+        return false;
+    }
+
+    if (RelationIsLogicallyLogged(relation)) {
+        /*
+         * For now ignore sequence changes entirely. Most of
+         * the time they don't log changes using records we
+         * understand, so it doesn't make sense to handle the
+         * few cases we do.
+         */
+        if (relation->rd_rel->relkind == RELKIND_SEQUENCE) {
+        } else if (!IsToastRelation(relation)) { /* user-triggered change */
+            ReorderBufferToastReplace(rb, txn, relation, change, partitionReltoastrelid);
+            apply_change(rb, txn, relation, change);
+            /*
+             * Only clear reassembled toast chunks if we're
+             * sure they're not required anymore. The creator
+             * of the tuple tells us.
+             */
+            if (change->data.tp.clear_toast_afterwards)
+                ReorderBufferToastReset(rb, txn);
+        } else if (change->action == REORDER_BUFFER_CHANGE_INSERT) {
+            /* we're not interested in toast deletions
+             *
+             * Need to reassemble the full toasted Datum in
+             * memory, to ensure the chunks don't get reused
+             * till we're done remove it from the list of this
+             * transaction's changes. Otherwise it will get
+             * freed/reused while restoring spooled data from
+             * disk.
+             */
+            dlist_delete(&change->node);
+            ReorderBufferToastAppendChunk(rb, txn, relation, change);
+            chunk_taken = true;
+        }
+    }
+    RelationClose(relation);
+
+    return chunk_taken;
+}
+
 /*
  * Perform the replay of a transaction and its non-aborted subtransactions.
  *
@@ -1237,6 +1348,10 @@ static void ReorderBufferFreeSnap(ReorderBuffer* rb, Snapshot snap)
  * invalidations. Thus, once a toplevel commit is read, we iterate over the top
  * and subtransactions (using a k-way merge) and replay the changes in lsn
  * order.
+ *
+ * A transaction of which some changes were streamed already gets the rest of
+ * its changes sent as one more block of its stream, followed by the stream
+ * commit.
  */
 void ReorderBufferCommit(ReorderBuffer* rb, TransactionId xid, XLogRecPtr commit_lsn, XLogRecPtr end_lsn,
     RepOriginId origin_id, CommitSeqNo csn, TimestampTz commit_time)
@@ -1249,6 +1364,7 @@ void ReorderBufferCommit(ReorderBuffer* rb, TransactionId xid, XLogRecPtr commit
     volatile Snapshot snapshot_now = NULL;
     volatile bool txn_started = false;
     volatile bool subtxn_started = false;
+    ReorderBufferApplyChangeCB apply_change = NULL;
 
     txn = ReorderBufferTXNByXid(rb, xid, false, NULL, InvalidXLogRecPtr, false);
     /* unknown transaction, nothing to replay */
@@ -1273,7 +1389,15 @@ void ReorderBufferCommit(ReorderBuffer* rb, TransactionId xid, XLogRecPtr commit
         return;
     }
 
-    snapshot_now = txn->base_snapshot;
+    if (txn->stream_snapshot != NULL) {
+        /* continue where streaming stopped, now knowing all our subtransactions */
+        snapshot_now = ReorderBufferCopySnap(rb, txn->stream_snapshot, txn, command_id);
+        ReorderBufferFreeSnap(rb, txn->stream_snapshot);
+        txn->stream_snapshot = NULL;
+    } else {
+        snapshot_now = txn->base_snapshot;
+    }
+    apply_change = txn->streamed ? rb->stream_change : rb->apply_change;
 
     /* build data to be able to lookup the CommandIds of catalog tuples */
     ReorderBufferBuildTupleCidHash(rb, txn);
@@ -1303,89 +1427,20 @@ void ReorderBufferCommit(ReorderBuffer* rb, TransactionId xid, XLogRecPtr commit
             txn_started = true;
         }
 
-        rb->begin(rb, txn);
+        if (txn->streamed)
+            rb->stream_start(rb, txn);
+        else
+            rb->begin(rb, txn);
 
         iterstate = ReorderBufferIterTXNInit(rb, txn);
         while ((change = ReorderBufferIterTXNNext(rb, iterstate))) {
-            Relation relation = NULL;
-            Oid reloid;
-            Oid partitionReltoastrelid = InvalidOid;
-
             switch (change->action) {
                 case REORDER_BUFFER_CHANGE_INSERT:
                 case REORDER_BUFFER_CHANGE_UPDATE:
                 case REORDER_BUFFER_CHANGE_DELETE:
                     Assert(snapshot_now);
 
-                    reloid = RelidByRelfilenode(change->data.tp.relnode.spcNode, change->data.tp.relnode.relNode);
-                    if (reloid == InvalidOid) {
-                        reloid = PartitionRelidByRelfilenode(
-                            change->data.tp.relnode.spcNode, change->data.tp.relnode.relNode, partitionReltoastrelid);
-                    }
-                    /*
-                     * Catalog tuple without data, emitted while catalog was
-                     * in the process of being rewritten.
-                     */
-                    if (reloid == InvalidOid && change->data.tp.newtuple == NULL && change->data.tp.oldtuple == NULL)
-                        continue;
-                    else if (reloid == InvalidOid) {
-                        /*
-                         * description:
-                         * When we try to decode a table who is already dropped.
-                         * Maybe we could not find it relnode.In this time, we will undecode this log.
-                         * It will be solve when we use MVCC.
-                         */
-                        ereport(DEBUG1,
-                            (errmsg(
-                                "could not lookup relation %s", relpathperm(change->data.tp.relnode, MAIN_FORKNUM))));
-                        continue;
-                    }
-
-                    relation = RelationIdGetRelation(reloid);
-                    if (relation == NULL) {
-                        ereport(DEBUG1,
-                            (errmsg("could open relation descriptor %s",
-                                relpathperm(change->data.tp.relnode, MAIN_FORKNUM))));
-                        continue;
-                    }
-
-                    if (CSTORE_NAMESPACE == get_rel_namespace(RelationGetRelid(relation))) {
-                        continue;
-                    }
-
-                    if (RelationIsLogicallyLogged(relation)) {
-                        /*
-                         * For now ignore sequence changes entirely. Most of
-                         * the time they don't log changes using records we
-                         * understand, so it doesn't make sense to handle the
-                         * few cases we do.
-                         */
-                        if (relation->rd_rel->relkind == RELKIND_SEQUENCE) {
-                        } else if (!IsToastRelation(relation)) { /* user-triggered change */
-                            ReorderBufferToastReplace(rb, txn, relation, change, partitionReltoastrelid);
-                            rb->apply_change(rb, txn, relation, change);
-                            /*
-                             * Only clear reassembled toast chunks if we're
-                             * sure they're not required anymore. The creator
-                             * of the tuple tells us.
-                             */
-                            if (change->data.tp.clear_toast_afterwards)
-                                ReorderBufferToastReset(rb, txn);
-                        } else if (change->action == REORDER_BUFFER_CHANGE_INSERT) {
-                            /* we're not interested in toast deletions
-                             *
-                             * Need to reassemble the full toasted Datum in
-                             * memory, to ensure the chunks don't get reused
-                             * till we're done remove it from the list of this
-                             * transaction's changes. Otherwise it will get
-                             * freed/reused while restoring spooled data from
-                             * disk.
-                             */
-                            dlist_delete(&change->node);
-                            ReorderBufferToastAppendChunk(rb, txn, relation, change);
-                        }
-                    }
-                    RelationClose(relation);
+                    (void)ReorderBufferReplayTupleChange(rb, txn, change, apply_change);
                     break;
                 case REORDER_BUFFER_CHANGE_INTERNAL_SNAPSHOT:
                     /* get rid of the old */
@@ -1445,7 +1500,12 @@ void ReorderBufferCommit(ReorderBuffer* rb, TransactionId xid, XLogRecPtr commit
         iterstate = NULL;
 
         /* call commit callback */
-        rb->commit(rb, txn, commit_lsn);
+        if (txn->streamed) {
+            rb->stream_stop(rb, txn);
+            rb->stream_commit(rb, txn, commit_lsn);
+        } else {
+            rb->commit(rb, txn, commit_lsn);
+        }
 
         /* this is just a sanity check against bad output plugin behaviour */
         if (GetCurrentTransactionIdIfAny() != InvalidTransactionId)
@@ -1530,6 +1590,10 @@ void ReorderBufferAbort(ReorderBuffer* rb, TransactionId xid, XLogRecPtr lsn)
     /* cosmetic... */
     txn->final_lsn = lsn;
 
+    /* the output plugin has seen some of its changes, they are void now */
+    if (txn->streamed)
+        rb->stream_abort(rb, txn, lsn);
+
     /* remove potential on-disk data, and deallocate */
     ReorderBufferCleanupTXN(rb, txn);
 }
@@ -1561,6 +1625,9 @@ void ReorderBufferAbortOld(ReorderBuffer* rb, TransactionId oldestRunningXid)
             if (!RecoveryInProgress())
                 ereport(DEBUG2, (errmsg("aborting old transaction %lu", txn->xid)));
 
+            if (txn->streamed)
+                rb->stream_abort(rb, txn, InvalidXLogRecPtr);
+
             /* remove potential on-disk data, and deallocate this tx */
             ReorderBufferCleanupTXN(rb, txn);
         } else
@@ -1616,6 +1683,10 @@ void ReorderBufferForget(ReorderBuffer* rb, TransactionId xid, XLogRecPtr lsn)
     } else
         Assert(txn->ninvalidations == 0);
 
+    /* streamed changes the client isn't going to get a commit for */
+    if (txn->streamed)
+        rb->stream_abort(rb, txn, lsn);
+
     /* remove potential on-disk data, and deallocate */
     ReorderBufferCleanupTXN(rb, txn);
 }
@@ -1839,11 +1910,158 @@ static void ReorderBufferCheckSerializeTXN(ReorderBuffer* rb, ReorderBufferTXN*
      * account here.
      */
     if (txn->nentries_mem >= (unsigned)g_instance.attr.attr_common.max_changes_in_memory) {
-        ReorderBufferSerializeTXN(rb, txn);
+        if (ReorderBufferCanStreamTXN(rb, txn))
+            ReorderBufferStreamTXN(rb, txn);
+        else
+            ReorderBufferSerializeTXN(rb, txn);
         Assert(txn->nentries_mem == 0);
     }
 }
 
+/*
+ * Can the changes of txn collected so far be sent to the output plugin now,
+ * instead of being spilled to disk?
+ *
+ * Apart from the plugin taking streams, the changes have to be complete and in
+ * order as they are, which we only know for a top-level transaction without
+ * catalog changes that is still running on this node and has no live
+ * subtransaction: a subtransaction it starts later only has changes after the
+ * ones streamed now, and one that aborted is thrown away with its own abort
+ * record.  A streamed transaction that stops qualifying is spilled as usual,
+ * and the rest of it is streamed at commit.
+ */
+static bool ReorderBufferCanStreamTXN(ReorderBuffer* rb, ReorderBufferTXN* txn)
+{
+    LogicalDecodingContext* ctx = (LogicalDecodingContext*)rb->private_data;
+
+    if (ctx == NULL || !ctx->streaming)
+        return false;
+
+    /* nothing to send before the snapshot is usable, or what the client already has */
+    if (SnapBuildCurrentState(ctx->snapshot_builder) < SNAPBUILD_CONSISTENT ||
+        SnapBuildXactNeedsSkip(ctx->snapshot_builder, ctx->reader->EndRecPtr))
+        return false;
+
+    if (txn->is_known_as_subxact || txn->nsubtxns > 0 || txn->serialized)
+        return false;
+
+    if (txn->base_snapshot == NULL || txn->has_catalog_changes || txn->ntuplecids > 0)
+        return false;
+
+    return TransactionIdIsRunningWithoutSubxids(txn->xid);
+}
+
+/*
+ * Send the in-memory changes of a large in-progress transaction to the output
+ * plugin as one block of its stream, and free them.
+ *
+ * ReorderBufferCanStreamTXN() made sure all changes are in txn->changes, in
+ * lsn order, and need no catalog state of the transaction itself.  Toast
+ * chunks of a row not seen yet stay in the toast hash, the snapshot reached
+ * at the end is kept for the next block and for the commit.
+ */
+static void ReorderBufferStreamTXN(ReorderBuffer* rb, ReorderBufferTXN* txn)
+{
+    dlist_mutable_iter change_i;
+    volatile Snapshot snapshot_now = NULL;
+    volatile bool txn_started = false;
+    volatile bool subtxn_started = false;
+
+    Assert(!txn->serialized && txn->nsubtxns == 0);
+
+    if (txn->stream_snapshot != NULL) {
+        snapshot_now = txn->stream_snapshot;
+        txn->stream_snapshot = NULL;
+    } else {
+        snapshot_now = txn->base_snapshot;
+    }
+
+    SetupHistoricSnapshot(snapshot_now, txn->tuplecid_hash);
+
+    PG_TRY();
+    {
+        /* same as in ReorderBufferCommit, we need a transaction for catalog access */
+        if (IsTransactionOrTransactionBlock()) {
+            BeginInternalSubTransaction("stream");
+            subtxn_started = true;
+        } else {
+            StartTransactionCommand();
+            txn_started = true;
+        }
+
+        rb->stream_start(rb, txn);
+
+        dlist_foreach_modify(change_i, &txn->changes)
+        {
+            ReorderBufferChange* change = dlist_container(ReorderBufferChange, node, change_i.cur);
+            bool chunk_taken = false;
+
+            switch (change->action) {
+                case REORDER_BUFFER_CHANGE_INSERT:
+                case REORDER_BUFFER_CHANGE_UPDATE:
+                case REORDER_BUFFER_CHANGE_DELETE:
+                    chunk_taken = ReorderBufferReplayTupleChange(rb, txn, change, rb->stream_change);
+                    break;
+                case REORDER_BUFFER_CHANGE_INTERNAL_SNAPSHOT:
+                    /* the change goes away below, so always keep a copy */
+                    TeardownHistoricSnapshot(false);
+                    if (snapshot_now->copied)
+                        ReorderBufferFreeSnap(rb, snapshot_now);
+                    snapshot_now = ReorderBufferCopySnap(rb, change->data.snapshot, txn, FirstCommandId);
+                    SetupHistoricSnapshot(snapshot_now, txn->tuplecid_hash);
+                    break;
+                case REORDER_BUFFER_CHANGE_INTERNAL_COMMAND_ID:
+                    /* only catalog changes come with these, and those aren't streamed */
+                    break;
+                case REORDER_BUFFER_CHANGE_INTERNAL_TUPLECID:
+                    ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED), errmsg("tuplecid value in changequeue")));
+                    break;
+            }
+
+            txn->nentries--;
+            txn->nentries_mem--;
+            if (!chunk_taken) {
+                dlist_delete(&change->node);
+                ReorderBufferReturnChange(rb, change);
+            }
+        }
+
+        rb->stream_stop(rb, txn);
+
+        /* this is just a sanity check against bad output plugin behaviour */
+        if (GetCurrentTransactionIdIfAny() != InvalidTransactionId)
+            ereport(ERROR,
+                (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+                    errmsg("output plugin used xid %lu", GetCurrentTransactionId())));
+
+        TeardownHistoricSnapshot(false);
+
+        if (subtxn_started)
+            RollbackAndReleaseCurrentSubTransaction();
+        else if (txn_started)
+            AbortCurrentTransaction();
+    }
+    PG_CATCH();
+    {
+        TeardownHistoricSnapshot(true);
+
+        if (snapshot_now->copied)
+            ReorderBufferFreeSnap(rb, snapshot_now);
+
+        if (subtxn_started)
+            RollbackAndReleaseCurrentSubTransaction();
+        else if (txn_started)
+            AbortCurrentTransaction();
+
+        PG_RE_THROW();
+    }
+    PG_END_TRY();
+
+    txn->streamed = true;
+    if (snapshot_now->copied)
+        txn->stream_snapshot = snapshot_now;
+}
+
 /*
  * Spill data of a large transaction (and its subtransactions) to disk.
  */
@@ -3118,6 +3118,8 @@ static void InitWalSnd(void)
             securec_check(rc, "\0", "\0");
             walsnd->sync_standby_priority = 0;
             walsnd->index = i;
+            walsnd->xlog_buffer_hits = 0;
+            walsnd->xlog_buffer_misses = 0;
             walsnd->log_ctrl.sleep_time = 0;
             walsnd->log_ctrl.balance_sleep_time = 0;
             walsnd->log_ctrl.prev_RTO = -1;
@@ -3247,8 +3249,8 @@ static void WalSndShutdown(void)
 
 /*
  * Read 'count' bytes from WAL into 'buf', starting at location 'startptr'.
- * XXX probably this should be improved to suck data directly from the
- * WAL buffers when possible. Will open, and keep open, one WAL segment 
+ * WAL still in the WAL buffers is copied from there, the rest is read from
+ * the segment files. Will open, and keep open, one WAL segment
  * stored in the global file descriptor sendFile. This means if XLogRead is used
  * once, there will always be one descriptor left open until the process ends, but never
  * more than one.
@@ -3260,6 +3262,33 @@ static void XLogRead(char* buf, XLogRecPtr startptr, Size count)
     Size nbytes;
     XLogSegNo segno;
 
+    /*
+     * WAL sent while the standby keeps up was written moments ago, and is
+     * usually still in the WAL buffers. Only a primary has it there.
+     */
+    if (!RecoveryInProgress()) {
+        /* use volatile pointer to prevent code rearrangement */
+        volatile WalSnd* walsnd = t_thrd.walsender_cxt.MyWalSnd;
+        Size nread = XLogReadFromBuffers(buf, startptr, count);
+
+        if (walsnd != NULL) {
+            SpinLockAcquire(&walsnd->mutex);
+            if (nread == count) {
+                walsnd->xlog_buffer_hits++;
+            } else {
+                walsnd->xlog_buffer_misses++;
+            }
+            SpinLockRelease(&walsnd->mutex);
+        }
+
+        if (nread == count) {
+            return;
+        }
+        buf += nread;
+        XLByteAdvance(startptr, nread);
+        count -= nread;
+    }
+
 retry:
     p = buf;
     recptr = startptr;
@@ -4039,7 +4068,7 @@ Tuplestorestate* BuildTupleResult(FunctionCallInfo fcinfo, TupleDesc* tupdesc)
  */
 Datum pg_stat_get_wal_senders(PG_FUNCTION_ARGS)
 {
-#define PG_STAT_GET_WAL_SENDERS_COLS 21
+#define PG_STAT_GET_WAL_SENDERS_COLS 23
 
     TupleDesc tupdesc;
     Tuplestorestate* tupstore = NULL;
@@ -4093,6 +4122,8 @@ Datum pg_stat_get_wal_senders(PG_FUNCTION_ARGS)
         XLogRecPtr sndReplay;
         XLogRecPtr RcvReceived;
         XLogRecPtr syncStart;
+        uint64 xlogBufferHits;
+        uint64 xlogBufferMisses;
 
         int sync_percent = 0;
         ServerMode peer_role;
@@ -4141,6 +4172,8 @@ Datum pg_stat_get_wal_senders(PG_FUNCTION_ARGS)
         syncStart = walsnd->syncPercentCountStart;
         catchup_time[0] = walsnd->catchupTime[0];
         catchup_time[1] = walsnd->catchupTime[1];
+        xlogBufferHits = walsnd->xlog_buffer_hits;
+        xlogBufferMisses = walsnd->xlog_buffer_misses;
         if (IS_DN_MULTI_STANDYS_MODE())
             priority = walsnd->sync_standby_priority;
         SpinLockRelease(&walsnd->mutex);
@@ -4331,6 +4364,10 @@ Datum pg_stat_get_wal_senders(PG_FUNCTION_ARGS)
                 remoteport);
             securec_check_ss(ret, "\0", "\0");
             values[j++] = CStringGetTextDatum(location);
+
+            /* wal_buffer_hits, wal_buffer_misses */
+            values[j++] = Int64GetDatum((int64)xlogBufferHits);
+            values[j++] = Int64GetDatum((int64)xlogBufferMisses);
         }
 
         tuplestore_putvalues(tupstore, tupdesc, values, nulls);
@@ -622,7 +622,11 @@ void mdprefetch(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum)
     off_t seekpos;
     MdfdVec* v = NULL;
 
-    v = _mdfd_getseg(reln, forknum, blocknum, false, EXTENSION_FAIL);
+    /* a prefetch is only a hint, the file may be dropped by the time recovery reads ahead */
+    v = _mdfd_getseg(reln, forknum, blocknum, false, EXTENSION_RETURN_NULL);
+    if (v == NULL) {
+        return;
+    }
 
     seekpos = (off_t)BLCKSZ * (blocknum % ((BlockNumber)RELSEG_SIZE));
 
@@ -863,14 +867,17 @@ void mdasyncwrite(SMgrRelation reln, ForkNumber forkNumber, AioDispatchDesc_t**
 
 /*
  * @Description:  Complete the async write from the ADIO completer thread.
+ *  A failed write leaves the buffer dirty with BM_IO_ERROR set, like a
+ *  failed synchronous write, so the writer sees it and it is retried.
  * @Param[IN] aioDesc:  result of the read operation
  * @Param[IN] res: completed request from the dispatch list.
- * @Return: should always succeed
+ * @Return: 0, or a negative errno if the write failed
  * @See also:
  */
 int CompltrWriteReq(void* aioDesc, long res)
 {
     AioDispatchDesc_t* desc = (AioDispatchDesc_t*)aioDesc;
+    int error = 0;
 
     START_CRIT_SECTION();
     if (desc->blockDesc.descType == AioWrite) {
@@ -879,8 +886,10 @@ int CompltrWriteReq(void* aioDesc, long res)
         LWLockOwn(desc->blockDesc.bufHdr->io_in_progress_lock);
 
         if (res != desc->blockDesc.blockSize) {
-            ereport(PANIC,
-                (errmsg("async write failed, write_count(%ld), require_count(%d)", res, desc->blockDesc.blockSize)));
+            error = (res < 0) ? (int)res : -EIO;
+            ereport(WARNING,
+                (errcode(ERRCODE_IO_ERROR),
+                    errmsg("async write failed, write_count(%ld), require_count(%d)", res, desc->blockDesc.blockSize)));
             /* If there was an error handle the i/o accordingly */
             AsyncAbortBufferIO((void*)desc->blockDesc.bufHdr, false);
         } else {
@@ -897,6 +906,7 @@ int CompltrWriteReq(void* aioDesc, long res)
         Assert(desc->blockDesc.descType == AioVacummFull);
 
         if (res != desc->blockDesc.blockSize) {
+            error = (res < 0) ? (int)res : -EIO;
             AsyncAbortBufferIOByVacuum((void*)desc->blockDesc.bufHdr);
             ereport(WARNING,
                 (errmsg("vacuum full async write failed, write_count(%ld), require_count(%d)",
@@ -911,7 +921,7 @@ int CompltrWriteReq(void* aioDesc, long res)
     /* Deallocate the AIO control block and I/O descriptor */
     adio_share_free(desc);
 
-    return 0;
+    return error;
 }
 
 const int FILE_NAME_LEN = 128;
@@ -33,6 +33,7 @@
 #include "storage/custorage.h"
 #include "storage/cucache_mgr.h"
 #include "utils/snapshot.h"
+#include "utils/bloom_filter.h"
 
 #define MAX_CU_PREFETCH_REQSIZ (64)
 
@@ -81,6 +82,18 @@ struct LoadCUDescCtl : public BaseObject {
 };
 
 struct CStoreScanState;
+
+/*
+ * Hash join bloom filter pushed down to the cstore scan at run time.
+ * It is used to eliminate CUs by min/max and to drop rows before
+ * the late read columns are decompressed.
+ */
+typedef struct CStoreRuntimeFilter {
+    filter::BloomFilter* bf;
+    int seq;    /* index of the column in the accessed columns of CStore */
+    int colIdx; /* column index in the scan batch */
+    bool lateRead; /* column is filled after the quals, set by CStore */
+} CStoreRuntimeFilter;
 typedef CStoreScanState *CStoreScanDesc;
 
 struct CStoreIndexScanState;
@@ -162,6 +175,9 @@ public:
     // update cstore scan timing flag
     void SetTiming(CStoreScanState *state);
 
+    // bind the runtime filters collected by the scan state
+    void InitRuntimeFilterEnv(CStoreScanState *state);
+
     // CStore scan : pass vector to VE.
     void ScanByTids(_in_ CStoreIndexScanState *state, _in_ VectorBatch *idxOut, _out_ VectorBatch *vbout);
     void CStoreScanWithCU(_in_ CStoreScanState *state, BatchCUData *tmpCUData, _in_ bool isVerify = false);
@@ -273,6 +289,7 @@ private:  // private methods.
     bool NeedLoadCUDesc(int32 &cudesc_idx);
     void IncLoadCuDescIdx(int &idx) const;
     bool RoughCheck(CStoreScanKey scanKey, int nkeys, int cuDescIdx);
+    bool RuntimeFilterRoughCheck(int cuDescIdx);
 
     void FillColMinMax(CUDesc *cuDescPtr, ScalarVector *vec, int pos);
 
@@ -330,6 +347,15 @@ private:
     // 
     RoughCheckFunc *m_RCFuncs;
 
+    // Runtime filters and the [min, max] rough check of each one.
+    // The functions are NULL when the filter has no usable range.
+    CStoreRuntimeFilter *m_runtimeFilters;
+    RoughCheckFunc *m_runtimeFilterMinFuncs;
+    RoughCheckFunc *m_runtimeFilterMaxFuncs;
+    Datum *m_runtimeFilterMin;
+    Datum *m_runtimeFilterMax;
+    int m_runtimeFilterNum;
+
     typedef int (CStore::*m_colFillFun)(int seq, CUDesc *cuDescPtr, ScalarVector *vec);
 
     typedef struct {
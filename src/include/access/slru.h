@@ -75,6 +75,17 @@ typedef struct SlruSharedData {
     int* page_lru_count;
     LWLock** buffer_locks;
 
+    /*
+     * Page-to-slot hash map, so that finding the buffer of a page does not
+     * need to scan all slots.  page_hash_head[] holds page_hash_mask + 1
+     * chain heads and page_hash_next[] links the slots of one chain.  A slot
+     * stays in the chain of its page_number, whatever its status, until it is
+     * assigned to another page.  Changed only under exclusive control lock.
+     */
+    int* page_hash_head;
+    int* page_hash_next;
+    int page_hash_mask;
+
     /*
      * Optional array of WAL flush LSNs associated with entries in the SLRU
      * pages.  If not zero/NULL, we must flush WAL before writing pages (true
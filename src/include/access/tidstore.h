@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * tidstore.h
+ *        compact store of heap TIDs, used by vacuum for the dead tuples
+ *
+ * TIDs are added in ascending order.  The offsets of each heap block are
+ * kept either as a bitmap or, when that is smaller, as a sorted array, so
+ * a dense page costs a few bytes instead of six per TID.  Membership tests
+ * go through a directory indexed by block number and never search more than
+ * a small, fixed number of entries.
+ *
+ * IDENTIFICATION
+ *        src/include/access/tidstore.h
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+
+#ifndef TIDSTORE_H
+#define TIDSTORE_H
+
+#include "access/htup.h"
+#include "storage/block.h"
+#include "storage/itemptr.h"
+
+typedef struct TidStore TidStore;
+
+typedef struct TidStoreIter {
+    TidStore* store;
+    int next_block; /* entry to return next, sealed entries first */
+} TidStoreIter;
+
+extern TidStore* TidStoreCreate(Size max_bytes, BlockNumber nblocks);
+extern void TidStoreDestroy(TidStore* ts);
+extern void TidStoreReset(TidStore* ts);
+extern void TidStoreAddTid(TidStore* ts, ItemPointer tid);
+extern bool TidStoreIsFull(const TidStore* ts);
+extern bool TidStoreIsMember(TidStore* ts, ItemPointer tid);
+extern int TidStoreGetBlockOffsets(TidStore* ts, BlockNumber blkno, OffsetNumber* offsets);
+extern void TidStoreBeginIterate(TidStore* ts, TidStoreIter* iter);
+extern bool TidStoreIterateNext(TidStoreIter* iter, BlockNumber* blkno, OffsetNumber* offsets, int* noffsets);
+extern int64 TidStoreNumTids(const TidStore* ts);
+extern Size TidStoreMemoryUsage(const TidStore* ts);
+extern Size TidStoreMaxMemory(const TidStore* ts);
+
+#endif /* TIDSTORE_H */
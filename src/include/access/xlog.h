@@ -316,6 +316,7 @@ extern void GetFullPageWriteInfo(XLogFPWInfo* fpwInfo_p);
 extern XLogRecPtr GetRedoRecPtr(void);
 extern XLogRecPtr GetInsertRecPtr(void);
 extern XLogRecPtr GetFlushRecPtr(void);
+extern Size XLogReadFromBuffers(char* buf, XLogRecPtr startptr, Size count);
 extern TimeLineID GetRecoveryTargetTLI(void);
 extern void DummyStandbySetRecoveryTargetTLI(TimeLineID timeLineID);
 
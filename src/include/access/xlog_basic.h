@@ -111,6 +111,7 @@
 #define XLR_BLOCK_ID_DATA_SHORT 255
 #define XLR_BLOCK_ID_DATA_LONG 254
 #define XLR_BLOCK_ID_ORIGIN 253
+#define XLR_BLOCK_ID_COMPRESSED 252
 
 /*
  * The fork number fits in the lower 4 bits in the fork_flags field. The upper
@@ -130,4 +130,30 @@ typedef struct XLogRecordDataHeaderLong {
 } XLogRecordDataHeaderLong;
 
 #define SizeOfXLogRecordDataHeaderLong (sizeof(uint8) + sizeof(uint32))
+
+/*
+ * When wal_compression is enabled and the payload of a record (backup block
+ * images, block data and main data, in that order) is at least
+ * wal_compression_threshold bytes, the whole payload is compressed with LZ4
+ * as a single unit. Such a record starts with an XLogRecordCompressHeader,
+ * followed by the usual fragment headers and then the compressed payload.
+ * The reader expands the record in place before decoding it, so redo
+ * routines never see the compressed form.
+ *
+ * xl_crc covers the record as stored, that is with the compression header
+ * and the compressed payload. The reader verifies it before expanding the
+ * record; the expanded record keeps the stored xl_crc.
+ *
+ * Any payload size is accepted, as long as the expanded record stays below
+ * XLogRecordMaxSize.
+ */
+typedef struct XLogRecordCompressHeader {
+    uint8 id; /* XLR_BLOCK_ID_COMPRESSED */
+              /* followed by uint32 raw_length and uint32 compressed_length, unaligned */
+} XLogRecordCompressHeader;
+
+#define SizeOfXLogRecordCompressHeader (sizeof(uint8) + sizeof(uint32) * 2)
+
+/* initial size of the compression work areas, they grow to fit larger payloads */
+#define XLR_COMPRESS_SCRATCH_SIZE (8 * BLCKSZ)
 #endif /* XLOGRECORD_H */
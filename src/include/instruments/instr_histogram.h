@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * instr_histogram.h
+ *        log-linear latency histogram for percentile estimation
+ *
+ * Values are bucketed by their power of two and INSTR_HIST_SUB_BUCKETS linear
+ * sub-buckets inside it (as in HDR histograms), so the relative error of a
+ * reported percentile is below 1 / INSTR_HIST_SUB_BUCKETS. Bucket boundaries
+ * are fixed, so histograms from different sessions or nodes merge by adding
+ * bucket counters, and recording is a single atomic add.
+ *
+ * IDENTIFICATION
+ *        src/include/instruments/instr_histogram.h
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+
+#ifndef INSTR_HISTOGRAM_H
+#define INSTR_HISTOGRAM_H
+
+#include "c.h"
+#include "utils/atomic.h"
+
+#define INSTR_HIST_SUB_BUCKET_BITS 4
+#define INSTR_HIST_SUB_BUCKETS (1 << INSTR_HIST_SUB_BUCKET_BITS)
+/* values at or above 2^INSTR_HIST_MAX_BITS (about 12 days in microseconds) share the last bucket */
+#define INSTR_HIST_MAX_BITS 40
+#define INSTR_HIST_NUM_BUCKETS ((INSTR_HIST_MAX_BITS - INSTR_HIST_SUB_BUCKET_BITS + 1) * INSTR_HIST_SUB_BUCKETS)
+
+typedef struct InstrHistogram {
+    pg_atomic_uint64 buckets[INSTR_HIST_NUM_BUCKETS];
+} InstrHistogram;
+
+extern void InstrHistogramReset(InstrHistogram* hist);
+extern void InstrHistogramRecord(InstrHistogram* hist, int64 value);
+extern uint64 InstrHistogramSnapshot(const InstrHistogram* hist, uint64* counts);
+extern bool InstrHistogramBucketBounds(int bucket, int64* lower, int64* upper);
+extern void InstrHistogramPercentiles(const InstrHistogram* hist, const int* permille, int num, int64* result);
+
+#endif /* INSTR_HISTOGRAM_H */
@@ -48,6 +48,7 @@ typedef struct knl_instance_attr_storage {
     bool enable_gtm_free;
     bool comm_cn_dn_logic_conn;
     bool enable_adio_function;
+    bool enable_adio_io_uring;
     bool enable_access_server_directory;
     bool enableIncrementalCheckpoint;
     bool enable_double_write;
@@ -78,8 +79,10 @@ typedef struct knl_instance_attr_storage {
     int real_recovery_parallelism;
 	int batch_redo_num;
     int remote_read_mode;
+    int buffer_replacement_policy;
     int advance_xlog_file_num;
     int gtm_option;
+    char* lwlock_numa_tranches;
 } knl_instance_attr_storage;
 
 #endif /* SRC_INCLUDE_KNL_KNL_INSTANCE_ATTR_STORAGE_H_ */
@@ -64,6 +64,7 @@ typedef struct knl_session_attr_sql {
     bool enable_tidscan;
     bool enable_sort;
     bool enable_compress_spill;
+    bool enable_compress_sort_spill;
     bool enable_hashagg;
     bool enable_material;
     bool enable_nestloop;
@@ -149,6 +150,7 @@ typedef struct knl_session_attr_sql {
     int best_agg_plan;
     int query_dop_tmp;
     int plan_mode_seed;
+    int gpc_plan_variants;
     int codegen_cost_threshold;
     int acce_min_datasize_per_thread;
     int max_cn_temp_file_size;
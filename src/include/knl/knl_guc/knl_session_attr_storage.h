@@ -104,6 +104,7 @@ typedef struct knl_session_attr_storage {
     int Trace_lock_table;
 #endif
     int replorigin_sesssion_origin;
+    int wal_compression_threshold;
     int wal_keep_segments;
     int CheckPointSegments;
     int CheckPointTimeout;
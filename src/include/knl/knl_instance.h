@@ -92,6 +92,10 @@ typedef struct knl_instance_attr {
 
 typedef struct knl_g_cache_context{
     MemoryContext global_cache_mem;
+    /* buckets of the global catalog cache, see utils/globalcatcache.h */
+    struct GlobalCatCacheBucket* global_catcache;
+    pg_atomic_uint64 global_catcache_size; /* bytes of the linked entries */
+    pg_atomic_uint32 global_catcache_hand; /* next bucket to sweep when over size */
 } knl_g_cache_context;
 
 typedef struct knl_g_cost_context {
@@ -497,6 +501,15 @@ typedef struct knl_g_executor_context {
 
 typedef struct knl_g_xlog_context {
     int num_locks_in_group;
+
+    /* WAL record payload compression statistics, times are in microseconds */
+    pg_atomic_uint64 compress_attempts;
+    pg_atomic_uint64 compressed_records;
+    pg_atomic_uint64 compress_raw_bytes;
+    pg_atomic_uint64 compressed_bytes;
+    pg_atomic_uint64 compress_time;
+    pg_atomic_uint64 decompressed_records;
+    pg_atomic_uint64 decompress_time;
 } knl_g_xlog_context;
 
 struct NumaMemAllocInfo {
@@ -1999,6 +1999,10 @@ enum knl_session_status {
 typedef struct knl_session_context {
     volatile knl_session_status status;
     Dlelem elem;
+    /* thread pool group whose listener polls the session's socket */
+    class ThreadPoolGroup* homeGroup;
+    /* when the session was queued to wait for a free worker */
+    TimestampTz readyTime;
 
     ThreadId attachPid;
 
@@ -648,6 +648,16 @@ typedef struct knl_t_xlog_context {
     struct XLogRecData* ptr_hdr_rdt;
     char* hdr_scratch;
 
+    /*
+     * Work areas for payload compression, allocated on first use: the raw
+     * payload gathered from the rdata chain, the compressed payload, and the
+     * XLogRecData that replaces the payload chain in a compressed record.
+     */
+    char* payload_scratch;
+    char* compressed_payload;
+    uint32 payload_scratch_size; /* size of each of the two areas above */
+    struct XLogRecData* ptr_payload_rdt;
+
     /*
      * An array of XLogRecData structs, to hold registered data.
      */
@@ -1358,6 +1368,9 @@ typedef struct knl_t_aiocompleter_context {
     /* Flags set by interrupt handlers for later service in the main loop. */
     volatile sig_atomic_t shutdown_requested;
     volatile sig_atomic_t config_requested;
+
+    /* index of this completer in the completer array */
+    int compltr_idx;
 } knl_t_aiocompleter_context;
 
 typedef struct knl_t_twophasecleaner_context {
@@ -60,6 +60,9 @@ public:
 
     static bool process(int op, StringInfo msg, char* completionTag, bool isTopLevel);
 
+    static bool processBatch(CachedPlanSource* psrc, ParamListInfo* paramsSet, int count, char* completionTag,
+        bool isTopLevel);
+
     void CopyFormats(int16* formats, int numRFormats);
 
     void updatePreAllocParamter(StringInfo msg);
@@ -80,6 +83,18 @@ public:
         return;
     }
 
+    /* whether executeBatch() can run several parameter sets in one call */
+    virtual bool supportBatch()
+    {
+        return false;
+    }
+
+    virtual bool executeBatch(ParamListInfo* paramsSet, int count, char* completionTag)
+    {
+        Assert(false);
+        return false;
+    }
+
     void setPreparedDestReceiver(DestReceiver* preparedDest);
 
     Datum CalFuncNodeVal(Oid functionId, List* args, bool* is_null);
@@ -185,17 +200,46 @@ public:
 
     bool execute(long max_rows, char* completionTag);
 
+    bool supportBatch()
+    {
+        return true;
+    }
+
+    bool executeBatch(ParamListInfo* paramsSet, int count, char* completionTag);
+
 private:
-    void refreshParameterIfNecessary();
+    /* one row of the VALUES list: consts are set once, params and func/op exprs at each execution */
+    struct ValuesRow {
+        Datum* values;
 
-    EState* m_estate;
+        bool* isnull;
 
-    /* for func/op expr calculation */
-    FuncExprInfo* m_targetFuncNodes;
+        ParamLoc* paramLoc;
 
-    int m_targetFuncNum;
+        int paramNum;
 
-    int m_targetParamNum;
+        FuncExprInfo* funcNodes;
+
+        int funcNum;
+    };
+
+    void initValuesRow(ValuesRow* row, List* targetList, List* valuesList, int natts);
+
+    void refreshParameterIfNecessary(const ValuesRow* row);
+
+    uint64 insertRows(ParamListInfo* paramsSet, int count);
+
+    void insertOneTuple(Relation rel, ResultRelInfo* resultRelInfo, HeapTuple tuple, CommandId cid);
+
+    void insertBufferedTuples(Relation rel, ResultRelInfo* resultRelInfo, HeapTuple* tuples, int ntuples,
+        CommandId cid);
+
+    EState* m_estate;
+
+    /* rows to insert per execution, more than one for a multi-row VALUES */
+    ValuesRow* m_rows;
+
+    int m_rowNum;
 
     bool m_is_bucket_rel;
 };
@@ -1087,6 +1087,48 @@ typedef struct WaitInfo {
     WaitStatusInfo status_info;
 } WaitInfo;
 
+/* ----------
+ * Progress of a lazy vacuum, shown by pg_stat_progress_vacuum and
+ * pg_stat_progress_vacuum_index.
+ * ----------
+ */
+typedef enum VacuumProgressPhase {
+    VACUUM_PHASE_NONE = 0,
+    VACUUM_PHASE_SCAN_HEAP,
+    VACUUM_PHASE_VACUUM_INDEX,
+    VACUUM_PHASE_VACUUM_HEAP,
+    VACUUM_PHASE_CLEANUP_INDEX
+} VacuumProgressPhase;
+
+typedef enum VacuumProgressField {
+    VACUUM_PROGRESS_PHASE = 0,
+    VACUUM_PROGRESS_HEAP_BLKS_TOTAL,
+    VACUUM_PROGRESS_HEAP_BLKS_SCANNED,
+    VACUUM_PROGRESS_HEAP_BLKS_VACUUMED,
+    VACUUM_PROGRESS_INDEX_VACUUM_COUNT,
+    VACUUM_PROGRESS_MAX_DEAD_TUPLE_BYTES,
+    VACUUM_PROGRESS_DEAD_TUPLE_BYTES,
+    VACUUM_PROGRESS_NUM_DEAD_TUPLES,
+    VACUUM_PROGRESS_NUM_FIELDS
+} VacuumProgressField;
+
+/* indexes beyond this are vacuumed as usual but not timed */
+#define VACUUM_PROGRESS_MAX_INDEXES 32
+
+typedef struct VacuumIndexProgress {
+    Oid indexoid;
+    int64 vacuum_time;  /* microseconds removing dead entries, all passes */
+    int64 cleanup_time; /* microseconds in post-vacuum cleanup */
+} VacuumIndexProgress;
+
+typedef struct VacuumProgress {
+    Oid relid;         /* relation being vacuumed, InvalidOid if none */
+    int64 params[VACUUM_PROGRESS_NUM_FIELDS];
+    int nindexes;      /* valid entries of indexes[] */
+    int current_index; /* entry of indexes[] being processed, -1 if none */
+    VacuumIndexProgress indexes[VACUUM_PROGRESS_MAX_INDEXES];
+} VacuumProgress;
+
 /* ----------
  * PgBackendStatus
  *
@@ -1197,6 +1239,9 @@ typedef struct PgBackendStatus {
 
     RemoteInfo remote_info;
     WaitInfo waitInfo;
+
+    /* lazy vacuum progress, relid is InvalidOid when not vacuuming */
+    VacuumProgress st_vacuum_progress;
 } PgBackendStatus;
 
 typedef struct ThreadWaitStatusInfo {
@@ -1339,6 +1384,13 @@ extern void pgstat_report_queryid(uint64 queryid);
 extern void pgstat_report_jobid(uint64 jobid);
 extern void pgstat_report_parent_sessionid(uint64 sessionid, uint32 level = 0);
 extern void pgstat_report_smpid(uint32 smpid);
+extern void pgstat_progress_vacuum_start(Oid relid, Relation* Irel, int nindexes);
+extern void pgstat_progress_vacuum_update(VacuumProgressField field, int64 value);
+extern void pgstat_progress_vacuum_update_multi(int nfields, const VacuumProgressField* fields, const int64* values);
+extern void pgstat_progress_vacuum_index_start(int idx);
+extern void pgstat_progress_vacuum_index_end(int idx, bool cleanup, int64 elapsed);
+extern void pgstat_progress_vacuum_end(void);
+extern const char* pgstat_get_vacuum_phase_name(VacuumProgressPhase phase);
 extern bool pgstat_get_waitlock(uint32 wait_event_info);
 extern const char* pgstat_get_wait_event(uint32 wait_event_info);
 extern const char* pgstat_get_backend_current_activity(ThreadId pid, bool checkUser);
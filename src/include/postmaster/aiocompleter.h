@@ -96,11 +96,15 @@ typedef struct AioDispatchCUDesc {
 extern int AioCompltrSets;
 extern int AioCompltrEvents;
 
-extern void AioCompltrMain(int ac, char** av);
+extern void AioCompltrMain(void);
 extern void AioCompltrStop(int signal);
 extern int AioCompltrStart(void);
 extern bool AioCompltrIsReady(void);
+extern bool AioCompltrIsRunning(void);
+extern bool AioCompltrIsThread(ThreadId tid);
+extern bool AioCompltrReap(ThreadId tid);
 extern io_context_t CompltrContext(AioCompltrType reqType, int h);
+extern int CompltrSubmit(AioCompltrType reqType, int h, long nr, struct iocb** iocbs);
 extern short CompltrPriority(AioCompltrType reqType);
 
 /*
@@ -43,6 +43,13 @@ typedef struct LogicalDecodingContext {
      */
     bool fast_forward;
 
+    /*
+     * Does the output plugin take large in-progress transactions through
+     * its stream callbacks?  Set when the plugin provides them, the plugin
+     * may clear it in its startup callback.
+     */
+    bool streaming;
+
     OutputPluginCallbacks callbacks;
     OutputPluginOptions options;
 
@@ -73,6 +73,39 @@ typedef void (*LogicalDecodeShutdownCB)(struct LogicalDecodingContext* ctx);
  */
 typedef bool (*LogicalDecodeFilterByOriginCB)(struct LogicalDecodingContext* ctx, RepOriginId origin_id);
 
+/*
+ * Called before a block of changes of a large, still in-progress transaction
+ * is sent.  The changes of such a transaction may come in several blocks, and
+ * the transaction may still abort after some of them have been sent.
+ */
+typedef void (*LogicalDecodeStreamStartCB)(struct LogicalDecodingContext* ctx, ReorderBufferTXN* txn);
+
+/*
+ * Callback for every individual change sent in a block of an in-progress
+ * transaction.
+ */
+typedef void (*LogicalDecodeStreamChangeCB)(
+    struct LogicalDecodingContext* ctx, ReorderBufferTXN* txn, Relation relation, ReorderBufferChange* change);
+
+/*
+ * Called after a block of changes of an in-progress transaction was sent.
+ */
+typedef void (*LogicalDecodeStreamStopCB)(struct LogicalDecodingContext* ctx, ReorderBufferTXN* txn);
+
+/*
+ * Called when a transaction whose changes were (partly) streamed aborts, or
+ * turns out not to be wanted after all; the streamed changes are void.
+ */
+typedef void (*LogicalDecodeStreamAbortCB)(
+    struct LogicalDecodingContext* ctx, ReorderBufferTXN* txn, XLogRecPtr abort_lsn);
+
+/*
+ * Called when a transaction whose changes were streamed commits, after the
+ * last block of its changes.
+ */
+typedef void (*LogicalDecodeStreamCommitCB)(
+    struct LogicalDecodingContext* ctx, ReorderBufferTXN* txn, XLogRecPtr commit_lsn);
+
 /*
  * Output plugin callbacks
  */
@@ -83,6 +116,12 @@ typedef struct OutputPluginCallbacks {
     LogicalDecodeCommitCB commit_cb;
     LogicalDecodeShutdownCB shutdown_cb;
     LogicalDecodeFilterByOriginCB filter_by_origin_cb;
+    /* optional, streaming of in-progress transactions needs all of them */
+    LogicalDecodeStreamStartCB stream_start_cb;
+    LogicalDecodeStreamChangeCB stream_change_cb;
+    LogicalDecodeStreamStopCB stream_stop_cb;
+    LogicalDecodeStreamAbortCB stream_abort_cb;
+    LogicalDecodeStreamCommitCB stream_commit_cb;
 } OutputPluginCallbacks;
 
 extern void OutputPluginPrepareWrite(struct LogicalDecodingContext* ctx, bool last_write);
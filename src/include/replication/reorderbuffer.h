@@ -205,6 +205,20 @@ typedef struct ReorderBufferTXN {
      */
     bool serialized;
 
+    /*
+     * Have changes of this (still in-progress) transaction already been sent
+     * to the output plugin with the stream callbacks?  Once set, the rest of
+     * the transaction is sent the same way, ending in a stream commit or
+     * abort.
+     */
+    bool streamed;
+
+    /*
+     * Snapshot in effect after the last streamed change, NULL if streaming
+     * hasn't moved past the base snapshot.  Always a copied snapshot.
+     */
+    Snapshot stream_snapshot;
+
     /*
      * List of ReorderBufferChange structs, including new Snapshots and new
      * CommandIds
@@ -267,6 +281,14 @@ typedef void (*ReorderBufferBeginCB)(ReorderBuffer* rb, ReorderBufferTXN* txn);
 /* commit callback signature */
 typedef void (*ReorderBufferCommitCB)(ReorderBuffer* rb, ReorderBufferTXN* txn, XLogRecPtr commit_lsn);
 
+/* stream start/stop callback signature */
+typedef void (*ReorderBufferStreamStartCB)(ReorderBuffer* rb, ReorderBufferTXN* txn);
+typedef void (*ReorderBufferStreamStopCB)(ReorderBuffer* rb, ReorderBufferTXN* txn);
+
+/* stream abort/commit callback signature */
+typedef void (*ReorderBufferStreamAbortCB)(ReorderBuffer* rb, ReorderBufferTXN* txn, XLogRecPtr abort_lsn);
+typedef void (*ReorderBufferStreamCommitCB)(ReorderBuffer* rb, ReorderBufferTXN* txn, XLogRecPtr commit_lsn);
+
 struct ReorderBuffer {
     /*
      * xid => ReorderBufferTXN lookup table
@@ -302,6 +324,16 @@ struct ReorderBuffer {
     ReorderBufferApplyChangeCB apply_change;
     ReorderBufferCommitCB commit;
 
+    /*
+     * Callbacks to be called for large in-progress transactions, whose
+     * changes are sent before the commit instead of being spilled to disk.
+     */
+    ReorderBufferStreamStartCB stream_start;
+    ReorderBufferApplyChangeCB stream_change;
+    ReorderBufferStreamStopCB stream_stop;
+    ReorderBufferStreamAbortCB stream_abort;
+    ReorderBufferStreamCommitCB stream_commit;
+
     /*
      * Pointer that will be passed untouched to the callbacks.
      */
@@ -92,6 +92,10 @@ typedef struct WalSnd {
      */
     XLogRecPtr syncPercentCountStart;
 
+    /* reads of WAL served from the WAL buffers, and the ones that had to read segment files */
+    uint64 xlog_buffer_hits;
+    uint64 xlog_buffer_misses;
+
     ReplConnInfo wal_sender_channel;
     int channel_get_replc;
 
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * aio_uring.h
+ *        io_uring backend of the ADIO completers.
+ *
+ *
+ * IDENTIFICATION
+ *        src/include/storage/aio_uring.h
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#ifndef AIO_URING_H
+#define AIO_URING_H
+
+#include <libaio.h>
+
+/*
+ * An io_uring instance. The submission queue may be fed by any thread, the
+ * completion queue is consumed by a single ADIO completer thread.
+ */
+typedef struct AioUring AioUring;
+
+extern bool AioUringSupported(void);
+extern AioUring* AioUringSetup(unsigned int entries);
+extern void AioUringDestroy(AioUring* ring);
+extern bool AioUringRegisterBuffers(AioUring* ring, char* base, Size len);
+extern int AioUringSubmit(AioUring* ring, long nr, struct iocb** iocbs);
+extern int AioUringGetEvents(AioUring* ring, long max_nr, struct io_event* events, const struct timespec* timeout);
+
+#endif /* AIO_URING_H */
@@ -311,6 +311,24 @@ typedef struct BufListElem{
         (a)->lock = LWLockAssign(LWTRANCHE_BUFFER_FREELIST); \
     }while(0)
 
+/*
+ * Replacement policy queues. With the clock policy every buffer is in
+ * BUF_QUEUE_MAIN. With 2Q a buffer enters BUF_QUEUE_A1 when it is first
+ * read in, and BUF_QUEUE_AM when it is read in again while its tag is
+ * still on the ghost list of recently evicted A1 pages.
+ */
+#define BUF_QUEUE_MAIN 0
+#define BUF_QUEUE_A1 1
+#define BUF_QUEUE_AM 2
+#define BUF_QUEUE_NUM 3
+
+/* Per queue statistics reported by StrategyGetQueueStats() */
+typedef struct BufferQueueStat {
+    uint64 buffers;   /* buffers currently in the queue, or ghost entries */
+    uint64 hits;      /* lookups that found the page in the queue */
+    uint64 evictions; /* pages of the queue that were replaced */
+} BufferQueueStat;
+
 /*
  * Internal routines: only called by bufmgr
  */
@@ -332,6 +350,11 @@ extern void StrategyNotifyBgWriter(int bgwprocno);
 extern Size StrategyShmemSize(void);
 extern void StrategyInitialize(bool init);
 
+extern void StrategyBufferHit(BufferDesc* buf);
+extern void StrategyBufferReplaced(BufferDesc* buf, BufferTag* old_tag, uint32 old_hash, BufferTag* new_tag,
+    uint32 new_hash, BufferAccessStrategy strategy);
+extern void StrategyGetQueueStats(BufferQueueStat* queues, BufferQueueStat* ghost, uint64* misses);
+
 /* buf_table.c */
 extern Size BufTableShmemSize(int size);
 extern void InitBufTable(int size);
@@ -40,6 +40,12 @@ typedef enum BufferAccessStrategyType {
     BAS_VACUUM     /* VACUUM */
 } BufferAccessStrategyType;
 
+/* Possible values of buffer_replacement_policy */
+typedef enum BufferReplacementPolicy {
+    BUFFER_POLICY_CLOCK, /* clock sweep over all shared buffers */
+    BUFFER_POLICY_2Q     /* separate recency and frequency queues, plus a ghost list */
+} BufferReplacementPolicy;
+
 /* Possible modes for ReadBufferExtended() */
 typedef enum {
     RBM_NORMAL,                /* Normal read */
@@ -193,6 +199,7 @@ struct WritebackContext;
  * prototypes for functions in bufmgr.c
  */
 extern void PrefetchBuffer(Relation reln, ForkNumber forkNum, BlockNumber blockNum);
+extern void PrefetchSharedBuffer(struct SMgrRelationData* smgr_reln, ForkNumber forkNum, BlockNumber blockNum);
 extern void PageRangePrefetch(
     Relation reln, ForkNumber forkNum, BlockNumber blockNum, int32 n, uint32 flags, uint32 col);
 extern void PageListPrefetch(
@@ -73,6 +73,9 @@ extern const char *const MainLWLockNames[];
 /* Number of partions the global plan cache hashtable */
 #define NUM_GPC_PARTITIONS 128
 
+/* Number of partions of the global catalog cache */
+#define NUM_GLOBAL_CATCACHE_PARTITIONS 128
+
 /*
  * WARNING---Please keep the order of LWLockTrunkOffset and BuiltinTrancheIds consistent!!!
  */
@@ -96,9 +99,11 @@ enum LWLockTrunkOffset {
     /* global plan cache */
     FirstGPCMappingLock = FirstInstrUserLock + NUM_INSTR_USER_PARTITIONS,
     FirstGPCPrepareMappingLock = FirstGPCMappingLock + NUM_GPC_PARTITIONS,
+    /* global catalog cache */
+    FirstGlobalCatCacheLock = FirstGPCPrepareMappingLock + NUM_GPC_PARTITIONS,
 
     /* must be last: */
-    NumFixedLWLocks = FirstGPCPrepareMappingLock + NUM_GPC_PARTITIONS,
+    NumFixedLWLocks = FirstGlobalCatCacheLock + NUM_GLOBAL_CATCACHE_PARTITIONS,
 };
 
 /*
@@ -125,6 +130,7 @@ enum BuiltinTrancheIds {
     LWTRANCHE_INSTR_USER,
     LWTRANCHE_GPC_MAPPING,
     LWTRANCHE_GPC_PREPARE_MAPPING,
+    LWTRANCHE_GLOBAL_CATCACHE,
     LWTRANCHE_BUFFER_IO_IN_PROGRESS,
     LWTRANCHE_BUFFER_CONTENT,
     LWTRANCHE_DATA_CACHE,
@@ -182,11 +188,13 @@ struct PGPROC;
 
 typedef struct LWLock {
     uint16 tranche;         /* tranche ID */
+    bool numa_aware;        /* prefer waking waiters on the releaser's NUMA node */
+    uint8 numa_handoffs;    /* times in a row a remote waiter was passed over */
     pg_atomic_uint32 state; /* state of exlusive/nonexclusive lockers */
     dlist_head waiters;     /* list of waiting PGPROCs */
+    struct PGPROC *owner;   /* last exlusive owner of the lock */
 #ifdef LOCK_DEBUG
     pg_atomic_uint32 nwaiters; /* number of waiters */
-    struct PGPROC *owner;      /* last exlusive owner of the lock */
 #endif
 #ifdef ENABLE_THREAD_CHECK
     pg_atomic_uint32 rwlock;
@@ -246,6 +254,7 @@ typedef struct LWLockHandle {
 extern void DumpLWLockInfo();
 extern LWLock *LWLockAssign(int trancheId);
 extern void LWLockInitialize(LWLock *lock, int tranche_id);
+extern void LWLockSetNumaAware(LWLock *lock, bool numa_aware);
 extern bool LWLockAcquire(LWLock *lock, LWLockMode mode, bool need_update_lockid = false);
 extern bool LWLockConditionalAcquire(LWLock *lock, LWLockMode mode);
 extern bool LWLockAcquireOrWait(LWLock *lock, LWLockMode mode);
@@ -269,6 +278,38 @@ extern void CreateLWLocks(void);
 extern void RequestAddinLWLocks(int n);
 extern const char *GetBuiltInTrancheName(int trancheId);
 
+/*
+ * Wait statistics kept for every tranche, see pg_stat_get_lwlock_waits().
+ * Counters are indexed by LWLockMode (LW_EXCLUSIVE or LW_SHARED). Wait times
+ * go into log2 buckets of microseconds: bucket 0 counts waits below 1us,
+ * bucket i those in [2^(i-1), 2^i) us, and the last bucket is open-ended.
+ * Dynamically registered tranches share the last slot.
+ */
+#define LWLOCK_WAIT_HIST_BUCKETS 24
+#define LWLOCK_HOLDER_SAMPLES 16
+#define LWLOCK_STAT_SLOTS (LWTRANCHE_NATIVE_TRANCHE_NUM + 1)
+
+/* what the exclusive holder was doing when a contended wait started */
+typedef struct LWLockHolderSample {
+    int waiter_mode;
+    int64 wait_us;
+    ThreadId holder_tid; /* 0 if the lock was held in shared mode */
+    uint64 holder_query_id;
+    uint32 holder_wait_event;
+} LWLockHolderSample;
+
+typedef struct LWLockWaitStat {
+    uint64 acquires[2];
+    uint64 contended[2];
+    uint64 wait_time[2]; /* in microseconds */
+    uint64 wait_hist[2][LWLOCK_WAIT_HIST_BUCKETS];
+    int nsamples;
+    LWLockHolderSample samples[LWLOCK_HOLDER_SAMPLES];
+} LWLockWaitStat;
+
+extern const char *GetLWLockStatSlotName(int slot);
+extern void GetLWLockWaitStat(int slot, LWLockWaitStat *stat);
+
 extern void wakeup_victim(LWLock *lock, ThreadId victim_tid);
 extern int *get_held_lwlocks_num(void);
 extern uint32 get_held_lwlocks_maxnum(void);
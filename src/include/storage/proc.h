@@ -151,8 +151,12 @@ struct PGPROC {
     bool lwWaiting;        /* true if waiting for an LW lock */
     uint8 lwWaitMode;      /* lwlock mode being waited for */
     bool lwIsVictim;       /* force to give up LWLock acquire */
+    int8 lwWaitNode;       /* NUMA node we queued from, -1 if unknown */
     dlist_node lwWaitLink; /* next waiter for same LW lock */
 
+    /* pgstat entry of whoever runs on this PGPROC, to tell LWLock waiters what the holder does */
+    struct PgBackendStatus* volatile statusEntry;
+
     /* Info about lock the process is currently waiting for, if any. */
     /* waitLock and waitProcLock are NULL if not currently waiting. */
     LOCK* waitLock;         /* Lock object we're sleeping on ... */
@@ -242,6 +246,13 @@ struct PGPROC {
     bool fpVXIDLock;                                /* are we holding a fast-path VXID lock? */
     LocalTransactionId fpLocalTransactionId;        /* lxid for fast-path VXID
                                                      * lock */
+
+    /*
+     * LWLock acquisitions per statistics slot and mode, only ever written by
+     * the thread running on this PGPROC, see LWLockCountAcquire().  Never
+     * reset, so they count for every session that used this PGPROC.
+     */
+    uint64 lwAcquires[LWLOCK_STAT_SLOTS][2];
 };
 
 /* NOTE: "typedef struct PGPROC PGPROC" appears in storage/lock.h. */
@@ -338,13 +349,15 @@ typedef struct PROC_HDR {
  * PGXC needs another slot for the pool manager process
  */
 const int MAX_PAGE_WRITER_THREAD_NUM = 8;
+const int MAX_AIO_COMPLETER_THREAD_NUM = 4;
 #ifdef PGXC
-#define NUM_AUXILIARY_PROCS                                       \
-    (10 + MAX_RECOVERY_THREAD_NUM + MAX_PAGE_WRITER_THREAD_NUM + \
+#define NUM_AUXILIARY_PROCS                                                                      \
+    (10 + MAX_RECOVERY_THREAD_NUM + MAX_PAGE_WRITER_THREAD_NUM + MAX_AIO_COMPLETER_THREAD_NUM + \
         g_instance.shmem_cxt.ThreadPoolGroupNum) /* number of InitAuxiliaryProcess */
 #else
-#define NUM_AUXILIARY_PROCS \
-    (8 + MAX_RECOVERY_THREAD_NUM + MAX_PAGE_WRITER_THREAD_NUM + g_instance.shmem_cxt.ThreadPoolGroupNum)
+#define NUM_AUXILIARY_PROCS                                                                     \
+    (8 + MAX_RECOVERY_THREAD_NUM + MAX_PAGE_WRITER_THREAD_NUM + MAX_AIO_COMPLETER_THREAD_NUM + \
+        g_instance.shmem_cxt.ThreadPoolGroupNum)
 #endif
 
 #define GLOBAL_ALL_PROCS \
@@ -358,7 +371,7 @@ const int MAX_PAGE_WRITER_THREAD_NUM = 8;
 
 #define BackendStatusArray_size                                                                        \
     (MAX_BACKEND_SLOT + NUM_AUXPROCTYPES + MAX_RECOVERY_THREAD_NUM + MAX_PAGE_WRITER_THREAD_NUM - 1 + \
-        g_instance.shmem_cxt.ThreadPoolGroupNum)
+        MAX_AIO_COMPLETER_THREAD_NUM - 1 + g_instance.shmem_cxt.ThreadPoolGroupNum)
 
 extern AlarmCheckResult ConnectionOverloadChecker(Alarm* alarm, AlarmAdditionalParam* additionalParam);
 
@@ -73,6 +73,7 @@ extern bool HaveVirtualXIDsDelayingChkpt(VirtualTransactionId* vxids, int nvxids
 
 extern PGPROC* BackendPidGetProc(ThreadId pid);
 extern int BackendXidGetPid(TransactionId xid);
+extern bool TransactionIdIsRunningWithoutSubxids(TransactionId xid);
 extern bool IsBackendPid(ThreadId pid);
 
 extern VirtualTransactionId* GetCurrentVirtualXIDs(
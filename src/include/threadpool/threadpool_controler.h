@@ -73,6 +73,8 @@ public:
     void CloseAllSessions();
     bool CheckNumaDistribute(int numaNodeNum) const;
     CPUBindType GetCpuBindType() const;
+    knl_session_context* StealSession(ThreadPoolGroup* thief);
+    void RequestSteal(ThreadPoolGroup* busy);
 
     inline ThreadPoolSessControl* GetSessionCtrl()
     {
@@ -88,6 +90,8 @@ public:
 
 private:
     ThreadPoolGroup* FindThreadGroupWithLeastSession();
+    void InitGroupDistance();
+    bool CanStealFrom(int thiefIdx, ThreadPoolGroup* busy) const;
     void ParseAttr();
     void ParseBindCpu();
     int ParseRangeStr(char* attr, bool* arr, int totalNum, char* bindtype);
@@ -104,6 +108,7 @@ private:
 private:
     MemoryContext m_threadPoolContext;
     ThreadPoolGroup** m_groups;
+    int* m_groupDistance; /* m_groupNum x m_groupNum NUMA distances, for work stealing */
     ThreadPoolScheduler* m_scheduler;
     CPUInfo m_cpuInfo;
     ThreadPoolAttr m_attr;
@@ -92,6 +92,16 @@ public:
         return m_numaId;
     }
 
+    inline int GetIdleWorkerNum()
+    {
+        return m_idleWorkerNum;
+    }
+
+    inline int GetWaitServeSessionNum()
+    {
+        return m_waitServeSessionCount;
+    }
+
     inline bool AllSessionClosed()
     {
         return (m_sessionCount <= 0);
@@ -127,6 +137,9 @@ private:
     volatile int m_sessionCount;           // all session count;
     volatile int m_waitServeSessionCount;  // wait for worker to server
     volatile int m_processTaskCount;
+    volatile uint64 m_queuedSessionCount;  // sessions served from the ready queue
+    volatile uint64 m_queuedWaitTime;      // their total wait in the queue, in us
+    volatile uint64 m_stolenSessionCount;  // of them, served by workers of other groups
 
     int m_groupId;
     int m_numaId;
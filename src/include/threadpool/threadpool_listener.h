@@ -42,6 +42,8 @@ public:
     void CreateEpoll();
     void NotifyReady();
     bool TryFeedWorker(ThreadPoolWorker* worker);
+    knl_session_context* GetReadySession(ThreadPoolGroup* taker);
+    bool WakeUpWorkerToSteal();
     void AddNewSession(knl_session_context* session);
     void WaitTask();
     void DelSessionFromEpoll(knl_session_context* session);
@@ -88,6 +88,7 @@ public:
     void CleanUpSessionWithLock();
     bool WakeUpToWork(knl_session_context* session);
     void WakeUpToUpdate(ThreadStatus status);
+    void WakeUpToSteal();
 
     friend class ThreadPoolListener;
 
@@ -136,6 +137,7 @@ private:
     uint m_idx;
     knl_session_context* m_currentSession;
     volatile ThreadStatus m_threadStatus;
+    volatile bool m_stealRequested;
     ThreadStayReason m_reason;
     Dlelem m_elem;
     ThreadPoolGroup* m_group;
@@ -133,6 +133,8 @@ public:
 
     LogicalTapeSet* m_tapeset;
 
+    int64 m_tapesetMem; /* LogicalTapeSetMemory() charged to m_availMem */
+
     /*
      * While building initial runs, this is the current output run number
      * (starting at 0).  Afterwards, it is the number of initial runs we made.
@@ -225,6 +227,8 @@ public:
 
     void DumpMultiColumn(bool all);
 
+    void ChargeTapesetMem();
+
     int HeapCompare(MultiColumns* a, MultiColumns* b, bool checkIdx);
 
     template <bool checkIdx>
@@ -120,6 +120,13 @@ typedef struct catctup {
      */
     struct catclist* c_list; /* containing CatCList, or NULL if none */
     CatCache* my_cache;      /* link to owning catcache */
+
+    /*
+     * Entry of the global catalog cache this tuple was loaded from, or NULL.
+     * If set, tuple.t_data and the by-reference keys point into that shared
+     * entry, and we hold one reference on it.
+     */
+    struct GlobalCatCTup* global;
 } CatCTup;
 
 /*
@@ -191,6 +198,7 @@ extern CatCList* SearchCatCacheList(CatCache* cache, int nkeys, Datum v1, Datum
 extern void ReleaseCatCacheList(CatCList* list);
 
 extern void ResetCatalogCaches(void);
+extern void AtSessExit_CatCache(int code, Datum arg);
 extern void CatalogCacheFlushCatalog(Oid catId);
 extern void CatalogCacheIdInvalidate(int cacheId, uint32 hashValue);
 extern void PrepareToInvalidateCacheTuple(
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * globalcatcache.h
+ *        instance-wide catalog cache shared by thread pool sessions
+ *
+ * The global catalog cache holds committed catalog tuples, keyed like the
+ * session catcaches.  A session that misses in its own catcache looks here
+ * before scanning the catalog, and its CatCTup then points at the shared
+ * tuple instead of copying it.  Entries are dropped by the committing
+ * session when it sends its sinval messages, before other sessions can see
+ * those.  A session whose transaction changed catalogs neither reads nor
+ * fills the global cache: its own catcache is the overlay holding the
+ * uncommitted rows.
+ *
+ * The cache is bounded by global_catcache_max_size.  Above it, a clock sweep
+ * over the buckets drops the entries no session holds and nobody looked up
+ * since the previous pass.  DROP DATABASE drops the entries of the database.
+ *
+ * IDENTIFICATION
+ *        src/include/utils/globalcatcache.h
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+
+#ifndef GLOBALCATCACHE_H
+#define GLOBALCATCACHE_H
+
+#include "access/htup.h"
+#include "storage/sinval.h"
+#include "utils/atomic.h"
+#include "utils/catcache.h"
+
+#define ENABLE_GLOBAL_CATCACHE (g_instance.attr.attr_common.enable_global_catcache == true && \
+                                g_instance.attr.attr_common.enable_thread_pool == true)
+
+/* must be a power of 2 */
+#define GLOBAL_CATCACHE_NUM_BUCKETS 8192
+
+typedef struct GlobalCatCTup {
+    struct GlobalCatCTup* next; /* next entry of the bucket */
+    Oid db_id;                  /* InvalidOid for shared catalogs */
+    Oid reloid;                 /* catalog the tuple comes from */
+    int cache_id;
+    uint32 hash_value;
+
+    /* one for the bucket link, plus one per session CatCTup pointing here */
+    pg_atomic_uint32 refcount;
+    uint32 size;     /* bytes allocated for the entry */
+    bool referenced; /* looked up since the last sweep */
+
+    /* by-reference keys point into the tuple */
+    Datum keys[CATCACHE_MAXKEYS];
+    HeapTupleData tuple;
+} GlobalCatCTup;
+
+typedef struct GlobalCatCacheBucket {
+    GlobalCatCTup* head;
+
+    /*
+     * Bumped by every invalidation hitting the bucket, so that a session
+     * can tell whether the catalog row it read may already be stale.
+     */
+    uint64 version;
+} GlobalCatCacheBucket;
+
+extern void InitGlobalCatCache(void);
+extern bool GlobalCatCacheUsable(const CatCache* cache);
+extern GlobalCatCTup* GlobalCatCacheSearch(
+    const CatCache* cache, uint32 hashValue, const Datum* arguments, uint64* version);
+extern GlobalCatCTup* GlobalCatCacheInsert(CatCache* cache, uint32 hashValue, HeapTuple ntp, uint64 version);
+extern void GlobalCatCacheRelease(GlobalCatCTup* gct);
+extern void GlobalCatCacheInvalMsg(const SharedInvalidationMessage* msgs, int n);
+extern void GlobalCatCacheDropDatabase(Oid dbId);
+
+#endif /* GLOBALCATCACHE_H */
@@ -195,6 +195,16 @@ typedef struct GPCPrepareStatus
     bool is_shared;
 } GPCPrepareStatus;
 
+typedef struct GPCVariantStatus
+{
+    char *query;
+    int variant;
+    uint32 signature;
+    int64 hits;
+    int64 exec_count;
+    int64 total_exec_time;
+} GPCVariantStatus;
+
 class GlobalPlanCache : public BaseObject
 {
 public:
@@ -237,9 +247,16 @@ public:
     void PrepareClean(uint32 cn_id);
     void CheckTimeline(uint32 timeline);
 
+    /* parameter-sensitive plan variants */
+    uint32 ParamSignature(CachedPlanSource *plansource, ParamListInfo boundParams);
+    struct GPCPlanVariant* VariantFetch(CachedPlanSource *plansource, uint32 signature);
+    struct GPCPlanVariant* VariantStore(CachedPlanSource *plansource, uint32 signature, struct CachedPlan *plan);
+    void VariantDropAll(CachedPlanSource *plansource);
+
     /* system function */
     void* GetStatus(uint32 *num);
     void* GetPrepareStatus(uint32 *num);
+    void* GetVariantStatus(uint32 *num);
     void SendPrepareDestoryMsg();
 
 private:
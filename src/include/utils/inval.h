@@ -63,6 +63,8 @@ extern void PostPrepare_Inval(void);
 
 extern void CommandEndInvalidationMessages(void);
 
+extern bool HasPendingInvalidationMessages(void);
+
 extern void CacheInvalidateHeapTuple(Relation relation, HeapTuple tuple, HeapTuple newtuple);
 
 extern void CacheInvalidateCatalog(Oid catalogId);
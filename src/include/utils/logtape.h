@@ -24,7 +24,7 @@ typedef struct LogicalTapeSet LogicalTapeSet;
  * prototypes for functions in logtape.c
  */
 
-extern LogicalTapeSet* LogicalTapeSetCreate(int ntapes);
+extern LogicalTapeSet* LogicalTapeSetCreate(int ntapes, bool compress = false);
 extern void LogicalTapeSetClose(LogicalTapeSet* lts);
 extern void LogicalTapeSetForgetFreeSpace(LogicalTapeSet* lts);
 extern size_t LogicalTapeRead(LogicalTapeSet* lts, int tapenum, void* ptr, size_t size);
@@ -35,5 +35,6 @@ extern bool LogicalTapeBackspace(LogicalTapeSet* lts, int tapenum, size_t size);
 extern bool LogicalTapeSeek(LogicalTapeSet* lts, int tapenum, long blocknum, int offset);
 extern void LogicalTapeTell(LogicalTapeSet* lts, int tapenum, long* blocknum, int* offset);
 extern long LogicalTapeSetBlocks(LogicalTapeSet* lts);
+extern Size LogicalTapeSetMemory(LogicalTapeSet* lts);
 
 #endif /* LOGTAPE_H */
@@ -46,6 +46,23 @@ typedef enum {
     PLAN_CACHE_MODE_FORCE_CUSTOM_PLAN
 } PlanCacheMode;
 
+/* upper limit of gpc_plan_variants */
+#define GPC_MAX_PLAN_VARIANTS 8
+
+/*
+ * A plan of a shared CachedPlanSource built for parameter values of one
+ * selectivity class, see GlobalPlanCache::ParamSignature.  Counters are updated atomically
+ * by every session running the plan.
+ */
+typedef struct GPCPlanVariant
+{
+    uint32 signature;       /* selectivity buckets of the parameterized quals */
+    struct CachedPlan *plan;
+    int64 hits;             /* binds that picked this variant */
+    int64 exec_count;       /* portal runs of the variant */
+    int64 total_exec_time;  /* time spent in those runs, in microseconds */
+} GPCPlanVariant;
+
 typedef struct GPCSource
 {
     /* the purpose of the falg is_share is to record whether the plancache can be shared between different sessions, 
@@ -65,6 +82,15 @@ typedef struct GPCSource
     int refcount;
 
     bool in_revalidate;
+
+    /*
+     * Plan variants of a shared plansource, GPC_MAX_PLAN_VARIANTS slots allocated
+     * on first use.  Slots below num_variants are filled and never change;
+     * variant_CAS_flag serializes adding one.
+     */
+    GPCPlanVariant *variants;
+    volatile int num_variants;
+    int32 variant_CAS_flag;
 } GPCSource;
 
 /*
@@ -210,6 +236,7 @@ typedef struct CachedPlan {
     MemoryContext context;    /* context containing this CachedPlan */
 
     bool        is_share;       /* is it gpc share plan? */
+    GPCPlanVariant *variant;    /* the gpc plan variant this plan is, if any */
 } CachedPlan;
 
 extern void InitPlanCache(void);
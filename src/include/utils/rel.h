@@ -306,6 +306,7 @@ typedef struct StdRdOptions {
     char* start_ctid_internal;
     char* end_ctid_internal;
     char        *merge_list;
+    char* index_method; /* index structure of a MOT index, tree or hash */
 } StdRdOptions;
 
 #define HEAP_MIN_FILLFACTOR 10
@@ -219,6 +219,11 @@ typedef struct CStoreScanState : ScanState {
     int m_ScanRunTimeKeysNum;
     bool m_ScanRunTimeKeysReady;
 
+    /* hash join bloom filters, collected after the build side is done */
+    CStoreRuntimeFilter* m_runtimeFilters;
+    int m_runtimeFilterNum;
+    bool m_runtimeFiltersReady;
+
     CStore* m_CStore;
     /*Optimizer Information*/
     CStoreScanKey csss_ScanKeys;  // support pushing predicate down to cstore scan.
@@ -46,6 +46,15 @@
 
 typedef enum { CALC_BASE = 0, CALC_SPILL, CALC_HASHTABLE } CalcBatchHashType;
 
+/*
+ * Batch key comparison kernel for integer join keys widened to int64:
+ * match[i] = match[i] && notnull[i] && inner[i] == outer[i].
+ * match and notnull hold 0 or 1 only.
+ */
+typedef void (*SonicMatchKernel)(const int64* inner, const int64* outer, const uint8* notnull, bool* match, int nrows);
+
+extern SonicMatchKernel SonicChooseMatchKernel(void);
+
 struct hashStateLog {
     int lastProcessIdx;
     bool restore;
@@ -225,6 +234,35 @@ public:
         }
     }
 
+    /*
+     * Batch version of matchCheckColT<innerType, outerType, true, false> for
+     * integer keys. The inner keys are read straight from the atoms of the
+     * SonicIntTemplateDatumArray without virtual calls, and the comparison
+     * of the whole batch runs through the SIMD kernel m_matchKernel.
+     */
+    template <typename innerType, typename outerType>
+    void matchIntKeyBatch(ScalarVector* val, SonicDatumArray* array, int nrows, int keyNum)
+    {
+        atom** arr = array->m_arr;
+        uint32 nbit = array->m_nbit;
+        uint32 mask = array->m_atomSize - 1;
+        int64* inner = (int64*)m_matchKeys;
+
+        Assert(array->m_desc.dataType == SONIC_INT_TYPE && array->m_atomTypeSize == sizeof(innerType));
+
+        for (int i = 0; i < nrows; i++) {
+            atom* datum_atom = arr[getArrayIndx(m_loc[i], nbit)];
+            int atom_idx = getArrayLoc(m_loc[i], mask);
+            uint16 row = m_selectIndx[i];
+
+            inner[i] = (int64)((innerType*)datum_atom->data)[atom_idx];
+            m_outerKeys[i] = (int64)(outerType)val->m_vals[row];
+            m_nullFlag[i] = NOT_NULL((uint8)val->m_flag[row] | (uint8)datum_atom->nullFlag[atom_idx]) ? 1 : 0;
+        }
+
+        m_matchKernel(inner, m_outerKeys, m_nullFlag, m_match, nrows);
+    }
+
 public:
     typedef void (SonicHash::*hashValFun)(char* val, uint8* flag, int nval, uint32* res, PGFunction func);
 
@@ -298,6 +336,8 @@ public:
     Datum m_matchKeys[BatchMaxSize];
     uint8 m_nullFlag[BatchMaxSize];
     ArrayIdx m_arrayIdx[BatchMaxSize]; /* record matched idx */
+    int64 m_outerKeys[BatchMaxSize];   /* outer keys widened for batch matching */
+    SonicMatchKernel m_matchKernel;    /* best key comparison kernel of this CPU */
 };
 
 extern uint64 hashfindprime(uint64 n);
@@ -187,6 +187,9 @@ private:
     /* current partition index */
     int m_currPartIdx;
 
+    /* spill level of the partitions being processed, 0 for the first spill */
+    int m_spillLevel;
+
     /*
      * Create a list of the tuple columns that actually need to be stored in
      * hashtable entries.  The incoming tuples from the outer plan node will
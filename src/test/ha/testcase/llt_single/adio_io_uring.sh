@@ -0,0 +1,79 @@
+#!/bin/sh
+# drive ADIO through io_uring: pagewriter and column store writes go through the completers
+
+source ./standby_env.sh
+
+function adio_logs()
+{
+log_dir=`gsql -d $db -p $dn1_primary_port -t -A -c "show log_directory;"`
+case $log_dir in
+  /*) ;;
+  *) log_dir=$primary_data_dir/$log_dir ;;
+esac
+find $log_dir -name "*.log" -newer $scripts_dir/data/adio_io_uring.mark | xargs cat
+}
+
+function test_1()
+{
+check_instance
+
+stop_primary
+gs_guc set -D $primary_data_dir -c "enable_adio_function=on"
+gs_guc set -D $primary_data_dir -c "enable_adio_io_uring=on"
+touch $scripts_dir/data/adio_io_uring.mark
+start_primary
+check_primary_startup
+
+if [ $(adio_logs | grep "io_uring_setup\|io_uring is not supported" | wc -l) -gt 0 ]; then
+  echo "io_uring is not available, adio_io_uring skipped"
+  return
+fi
+if [ $(adio_logs | grep "AIO Completer [0-9]* STARTED" | wc -l) -lt 4 ]; then
+  echo "AIO completers did not start $failed_keyword"
+  exit 1
+fi
+
+# row store pages are flushed by the pagewriter, column store CUs are written directly
+gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists adio_row; CREATE TABLE adio_row(a int, b text);"
+gsql -d $db -p $dn1_primary_port -c "insert into adio_row select g, repeat('x', 200) from generate_series(1, 200000) g; checkpoint;"
+gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists adio_col; CREATE TABLE adio_col(a int, b text) with (orientation = column);"
+gsql -d $db -p $dn1_primary_port -c "insert into adio_col select * from adio_row; checkpoint;"
+gsql -d $db -p $dn1_primary_port -c "update adio_row set b = repeat('y', 200) where a % 10 = 0; checkpoint;"
+
+# the completers log their wakeups when they are stopped
+stop_primary
+start_primary
+check_primary_startup
+
+if [ $(gsql -d $db -p $dn1_primary_port -t -A -c "select count(*), sum(a), sum(length(b)) from adio_row where b like 'y%' or a % 10 <> 0;") != "200000|20000100000|40000000" ]; then
+  echo "row store data lost with io_uring $failed_keyword"
+  exit 1
+fi
+if [ $(gsql -d $db -p $dn1_primary_port -t -A -c "select count(*), sum(a) from adio_col where b = repeat('x', 200);") != "200000|20000100000" ]; then
+  echo "column store data lost with io_uring $failed_keyword"
+  exit 1
+fi
+if [ $(adio_logs | grep "AIO Completer [0-9]* reaped [0-9]* completions" | wc -l) -lt 4 ]; then
+  echo "AIO completers did not report their wakeups $failed_keyword"
+  exit 1
+fi
+if [ $(adio_logs | grep "falling back to synchronous I/O\|async write failed\|io_uring_enter() failed" | wc -l) -gt 0 ]; then
+  echo "AIO through io_uring failed $failed_keyword"
+  exit 1
+fi
+adio_logs | grep "AIO Completer [0-9]* reaped"
+echo "adio_io_uring success"
+}
+
+function tear_down()
+{
+gsql -d $db -p $dn1_primary_port -c "DROP TABLE if exists adio_row; DROP TABLE if exists adio_col;"
+stop_primary
+gs_guc set -D $primary_data_dir -c "enable_adio_function=off"
+gs_guc set -D $primary_data_dir -c "enable_adio_io_uring=off"
+rm -f $scripts_dir/data/adio_io_uring.mark
+start_primary
+}
+
+test_1
+tear_down
@@ -0,0 +1,76 @@
+#!/bin/sh
+# a MOT table dropped or truncated by a transaction that holds an early lock on one of its rows
+
+source ./standby_env.sh
+
+function set_early_lock()
+{
+sed -i '/^hot_key_threshold\|^enable_hot_key_early_lock/d' $primary_data_dir/mot.conf
+if [ "$1" = "on" ]; then
+  echo "hot_key_threshold = 1" >> $primary_data_dir/mot.conf
+  echo "enable_hot_key_early_lock = true" >> $primary_data_dir/mot.conf
+fi
+}
+
+# one commit-validation abort on the row makes it hot with hot_key_threshold = 1
+function make_hot()
+{
+gsql -d $db -p $dn1_primary_port -c "begin; update mot_hot set v = v + 1 where id = 1; select pg_sleep(3); commit;" &
+sleep 1
+gsql -d $db -p $dn1_primary_port -c "update mot_hot set v = v + 1 where id = 1;"
+wait
+}
+
+# the row must still be updatable once the early locking transaction is gone
+function check_unlocked()
+{
+for i in 1 2 3; do
+  if [ $(timeout 10 gsql -d $db -p $dn1_primary_port -c "update mot_hot set v = v + 1 where id = 1;" 2>&1 | grep "UPDATE 1" | wc -l) -ne 1 ]; then
+    echo "hot row is still locked after $1 $failed_keyword"
+    exit 1
+  fi
+done
+}
+
+function test_1()
+{
+check_instance
+
+stop_primary
+set_early_lock on
+start_primary
+check_primary_startup
+
+gsql -d $db -p $dn1_primary_port -c "DROP FOREIGN TABLE if exists mot_hot; CREATE FOREIGN TABLE mot_hot(id int primary key, v int) SERVER mot_server;"
+gsql -d $db -p $dn1_primary_port -c "insert into mot_hot values (1, 0), (2, 0);"
+
+make_hot
+gsql -d $db -p $dn1_primary_port -c "begin; update mot_hot set v = v + 1 where id = 1; truncate mot_hot; rollback;"
+check_unlocked "truncate"
+
+make_hot
+gsql -d $db -p $dn1_primary_port -c "begin; update mot_hot set v = v + 1 where id = 1; DROP FOREIGN TABLE mot_hot; rollback;"
+check_unlocked "drop"
+
+make_hot
+gsql -d $db -p $dn1_primary_port -c "begin; update mot_hot set v = v + 1 where id = 1; truncate mot_hot; commit;"
+gsql -d $db -p $dn1_primary_port -c "insert into mot_hot values (1, 0);"
+check_unlocked "committed truncate"
+
+if [ $(gsql -d $db -p $dn1_primary_port -t -A -c "select count(*), sum(v) from mot_hot;") != "1|3" ]; then
+  echo "mot_hot content is wrong after truncate $failed_keyword"
+  exit 1
+fi
+echo "mot_hot_key_early_lock success"
+}
+
+function tear_down()
+{
+gsql -d $db -p $dn1_primary_port -c "DROP FOREIGN TABLE if exists mot_hot;"
+stop_primary
+set_early_lock off
+start_primary
+}
+
+test_1
+tear_down
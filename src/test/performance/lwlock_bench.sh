@@ -0,0 +1,88 @@
+#!/bin/bash
+#
+# lwlock_bench.sh
+#     Compare the plain and the NUMA-aware LWLock wakeup policies.
+#
+# Runs pg_lwlock_benchmark() of contrib/lwlock_bench from many sessions at
+# once, first against the plain benchmark lock and then against the
+# NUMA-aware one, and reports for each the total acquire throughput, Jain's
+# fairness index over the per-session throughputs (1.0 means every session
+# got the same share) and the average and worst time an acquisition took.
+# The extension is created in the target database if it is not there yet.
+#
+# The NUMA-aware lock only behaves differently on a machine with more than
+# one NUMA node. Run it against a server using the thread pool with its
+# groups bound to the nodes, so that sessions are spread across sockets.
+#
+# The NUMA-aware policy only reorders the wakeup of sleeping waiters, so
+# whether it helps depends on the machine. To evaluate it:
+#   1. check that "numactl -H" reports at least two nodes, and set
+#      thread_pool_attr so that there is one group per node, bound to it
+#      (for example '64, 2, (nodebind: 0, 1)');
+#   2. run with -c at least twice the number of cores, so that the lock is
+#      contended and waiters actually sleep;
+#   3. run each of -s 0 and -s 50 five times, and compare the median
+#      acquires/s and the worst max wait of the two policies;
+#   4. repeat with -c equal to the number of cores of one node, where the
+#      policy should make no difference.
+#
+# usage: lwlock_bench.sh [-d dbname] [-p port] [-c sessions] [-n loops] [-s shared_percent]
+#
+
+DBNAME=postgres
+PORT=5432
+SESSIONS=64
+LOOPS=200000
+SHARED_PERCENT=0
+
+while getopts "d:p:c:n:s:" opt; do
+    case $opt in
+        d) DBNAME=$OPTARG ;;
+        p) PORT=$OPTARG ;;
+        c) SESSIONS=$OPTARG ;;
+        n) LOOPS=$OPTARG ;;
+        s) SHARED_PERCENT=$OPTARG ;;
+        *) echo "usage: $0 [-d dbname] [-p port] [-c sessions] [-n loops] [-s shared_percent]"; exit 1 ;;
+    esac
+done
+
+WORKDIR=$(mktemp -d)
+trap 'rm -rf $WORKDIR' EXIT
+
+run_policy()
+{
+    local numa_aware=$1
+
+    for i in $(seq 1 $SESSIONS); do
+        gsql -X -q -A -t -d $DBNAME -p $PORT \
+            -c "select acquires, elapsed_us, avg_wait_us, max_wait_us from pg_lwlock_benchmark($LOOPS, $numa_aware, $SHARED_PERCENT)" \
+            > $WORKDIR/$numa_aware.$i 2>&1 &
+    done
+    wait
+
+    cat $WORKDIR/$numa_aware.* | awk -F'|' -v policy="$numa_aware" '
+        NF == 4 {
+            n++
+            acquires += $1
+            if ($2 > elapsed) elapsed = $2
+            rate = $1 / ($2 > 0 ? $2 : 1)
+            rate_sum += rate
+            rate_sq += rate * rate
+            wait_sum += $3 * $1
+            if ($4 > max_wait) max_wait = $4
+        }
+        END {
+            if (n == 0) {
+                print "no session finished, check the server log"
+                exit 1
+            }
+            printf "%-12s sessions %4d  acquires/s %12.0f  fairness %.3f  avg wait %10.2f us  max wait %10d us\n",
+                (policy == "true" ? "numa-aware" : "plain"), n, acquires * 1000000 / elapsed,
+                rate_sum * rate_sum / (n * rate_sq), wait_sum / acquires, max_wait
+        }'
+}
+
+gsql -X -q -d $DBNAME -p $PORT -c "create extension if not exists lwlock_bench" || exit 1
+
+run_policy false
+run_policy true
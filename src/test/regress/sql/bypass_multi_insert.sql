@@ -0,0 +1,43 @@
+--
+--multi-row VALUES insert through the insert bypass
+--
+set enable_opfusion=on;
+set opfusion_debug_mode = 'log';
+create schema bypass_multi_insert;
+set current_schema=bypass_multi_insert;
+create table test_bypass_mi(col1 int, col2 int, col3 text);
+create unique index itest_bypass_mi on test_bypass_mi(col1);
+-- bypass
+explain (costs off) insert into test_bypass_mi values (1,1,'test_insert'),(2,2,'test_insert'),(3,3,'test_insert');
+insert into test_bypass_mi values (1,1,'test_insert'),(2,2,'test_insert'),(3,3,'test_insert');
+insert into test_bypass_mi(col1,col3) values (4,'test_insert2'),(5,upper('test_insert2'));
+select * from test_bypass_mi order by col1;
+-- a unique violation in the middle of the rows leaves none of them behind
+insert into test_bypass_mi values (6,6,'test_dup'),(7,7,'test_dup'),(2,2,'test_dup'),(8,8,'test_dup');
+select count(*) from test_bypass_mi where col1 >= 6 or col3 = 'test_dup';
+-- the same with parameters, one set of them per execute
+prepare p_mi(int,int,text) as insert into test_bypass_mi values ($1,$1,$3),($2,$2,$3);
+explain (costs off) execute p_mi(6,7,'test_prepare');
+execute p_mi(6,7,'test_prepare');
+execute p_mi(8,9,'test_prepare');
+execute p_mi(10,1,'test_dup');
+select * from test_bypass_mi where col1 >= 6 order by col1;
+deallocate p_mi;
+-- no bypass with RETURNING
+explain (costs off) insert into test_bypass_mi values (11,11,'test_returning'),(12,12,'test_returning') returning col1;
+insert into test_bypass_mi values (11,11,'test_returning'),(12,12,'test_returning') returning col1;
+-- no bypass with a trigger, which sees every row
+create function test_bypass_mi_trig() returns trigger as
+$$
+begin
+    new.col2 := new.col1 * 10;
+    return new;
+end;
+$$ language plpgsql;
+create trigger test_bypass_mi_trig before insert on test_bypass_mi for each row execute procedure test_bypass_mi_trig();
+explain (costs off) insert into test_bypass_mi values (13,0,'test_trigger'),(14,0,'test_trigger');
+insert into test_bypass_mi values (13,0,'test_trigger'),(14,0,'test_trigger');
+select * from test_bypass_mi where col1 >= 11 order by col1;
+reset opfusion_debug_mode;
+reset enable_opfusion;
+drop schema bypass_multi_insert cascade;
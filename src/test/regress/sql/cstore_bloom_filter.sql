@@ -0,0 +1,69 @@
+/*
+ * hash join bloom filters pushed down into column store scans,
+ * without a stream plan
+ */
+create schema cstore_bloom_filter;
+set current_schema=cstore_bloom_filter;
+
+create table cbf_probe(a int, b int) with(orientation=column);
+insert into cbf_probe select g, g from generate_series(1, 2000) g;
+create table cbf_build(a int, c int) with(orientation=column);
+insert into cbf_build select g * 10, g from generate_series(1, 10) g;
+analyze cbf_probe;
+analyze cbf_build;
+
+set enable_nestloop=off;
+set enable_mergejoin=off;
+
+/* keep the bloom filter lines only, the number of removed rows depends on the false positive rate */
+create function cbf_explain(query text) returns setof text
+language plpgsql as
+$$
+declare
+    ln text;
+begin
+    for ln in execute 'explain (analyze on, costs off, timing off) ' || query loop
+        if ln like '%Bloom Filter%' then
+            return next regexp_replace(ltrim(ln), 'Rows Removed by Bloom Filter: [1-9][0-9]*', 'Rows Removed by Bloom Filter: N');
+        end if;
+    end loop;
+end;
+$$;
+
+select * from cbf_explain('select count(*) from cbf_probe join cbf_build on cbf_probe.a = cbf_build.a');
+select count(*) from cbf_probe join cbf_build on cbf_probe.a = cbf_build.a;
+select cbf_probe.a, cbf_probe.b, cbf_build.c from cbf_probe join cbf_build on cbf_probe.a = cbf_build.a order by 1;
+
+/* empty build side */
+select * from cbf_explain('select count(*) from cbf_probe join cbf_build on cbf_probe.a = cbf_build.a where cbf_build.c > 100');
+select count(*) from cbf_probe join cbf_build on cbf_probe.a = cbf_build.a where cbf_build.c > 100;
+
+set enable_bloom_filter=off;
+select * from cbf_explain('select count(*) from cbf_probe join cbf_build on cbf_probe.a = cbf_build.a');
+select count(*) from cbf_probe join cbf_build on cbf_probe.a = cbf_build.a;
+reset enable_bloom_filter;
+
+/*
+ * a correlated subplan rebuilds the hash table on every rescan; the second
+ * build is too large for a bloom filter, so the filter of the first build
+ * must not be applied to the probe side again
+ */
+create table cbf_rescan_probe(a int) with(orientation=column);
+insert into cbf_rescan_probe select g from generate_series(1, 120000) g;
+create table cbf_rescan_build(a int) with(orientation=column);
+insert into cbf_rescan_build select g from generate_series(1, 60000) g;
+create table cbf_rescan_outer(x int);
+insert into cbf_rescan_outer values (10), (60000);
+analyze cbf_rescan_probe;
+analyze cbf_rescan_build;
+analyze cbf_rescan_outer;
+
+select * from cbf_explain('select x, (select count(*) from cbf_rescan_probe join cbf_rescan_build on cbf_rescan_probe.a = cbf_rescan_build.a where cbf_rescan_build.a <= o.x) from cbf_rescan_outer o');
+select x, (select count(*) from cbf_rescan_probe join cbf_rescan_build on cbf_rescan_probe.a = cbf_rescan_build.a where cbf_rescan_build.a <= o.x) from cbf_rescan_outer o order by 1;
+set enable_sonic_hashjoin=off;
+select x, (select count(*) from cbf_rescan_probe join cbf_rescan_build on cbf_rescan_probe.a = cbf_rescan_build.a where cbf_rescan_build.a <= o.x) from cbf_rescan_outer o order by 1;
+reset enable_sonic_hashjoin;
+
+reset enable_nestloop;
+reset enable_mergejoin;
+drop schema cstore_bloom_filter cascade;
@@ -0,0 +1,37 @@
+--
+-- GPC_PLAN_VARIANTS
+-- parameter-sensitive plans of shared plansources, run by gpccheck with
+-- enable_global_plancache on and a single datanode, so that every statement
+-- is shipped to datanode1 as it is
+--
+create table gpc_variant_skew (a int, b int) distribute by hash(a);
+insert into gpc_variant_skew select i, case when i <= 1000 then i else 0 end from generate_series(1, 100000) i;
+create index gpc_variant_skew_b on gpc_variant_skew(b);
+analyze gpc_variant_skew;
+
+set gpc_plan_variants = 4;
+prepare gpc_variant_q(int) as select count(*) from gpc_variant_skew where b = $1;
+
+-- the first execution builds the generic plan and shares the plansource
+execute gpc_variant_q(0);
+
+-- a rare value plans a variant of its own, the next rare value reuses it
+execute gpc_variant_q(5);
+execute gpc_variant_q(7);
+
+-- the common value is in another class and gets a second variant
+execute gpc_variant_q(0);
+execute gpc_variant_q(0);
+execute gpc_variant_q(0);
+
+-- one variant per class: signature 4 is the rare bucket, 7 the common one
+execute direct on (datanode1) 'select variant, signature, hits from plancache_variant_status() where query like ''%gpc_variant_skew%'' order by variant';
+
+-- ANALYZE invalidates the plansource, and its variants go with it
+analyze gpc_variant_skew;
+execute gpc_variant_q(5);
+execute direct on (datanode1) 'select count(*) from plancache_variant_status() where query like ''%gpc_variant_skew%''';
+
+deallocate gpc_variant_q;
+reset gpc_plan_variants;
+drop table gpc_variant_skew;
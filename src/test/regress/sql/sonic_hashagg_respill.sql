@@ -0,0 +1,25 @@
+/*
+ * SonicHashAgg partitions that overflow again and are respilled
+ */
+create schema sonic_hashagg_respill;
+set current_schema=sonic_hashagg_respill;
+/* 60000 groups of two rows each, far more than fit into 64kB */
+create table shr_row(a int, b int, c text);
+insert into shr_row select g % 60000, g, 'g' || (g % 60000) from generate_series(1, 120000) g;
+create table shr_col(a int, b int, c text) with(orientation=column);
+insert into shr_col select * from shr_row;
+set enable_sonic_hashagg=on;
+set work_mem='64kB';
+/* every partition overflows, so rows are respilled a level further down */
+select count(*), sum(s), min(s), max(s) from (select a, sum(b) as s from shr_col group by a) t;
+select a, count(*), sum(b), max(c) from shr_col group by a having a < 5 or a > 59995 order by a;
+/* no group is lost or split across partitions */
+select count(*) from (select a, sum(b) as s, count(*) as n from shr_col group by a) t where n <> 2 or s <> 2 * a + 60000 + (case when a = 0 then 120000 else 0 end);
+/* the same without the optimized spill format */
+set enable_sonic_optspill=off;
+select count(*), sum(s), min(s), max(s) from (select a, sum(b) as s from shr_col group by a) t;
+select count(*) from (select c, count(*) as n from shr_col group by c) t where n <> 2;
+reset enable_sonic_optspill;
+reset work_mem;
+reset enable_sonic_hashagg;
+drop schema sonic_hashagg_respill cascade;
@@ -0,0 +1,27 @@
+/*
+ * external sorts with LZ4-compressed logical tapes
+ */
+create schema sort_compress_spill;
+set current_schema=sort_compress_spill;
+/* b is a permutation of most of 1..30010, c makes the tuples wide enough to spill */
+create table scs_row(a int, b int, c text);
+insert into scs_row select g, (g * 7919) % 30011, repeat('x', 100) from generate_series(1, 30000) g;
+create table scs_col(a int, b int, c text) with(orientation=column);
+insert into scs_col select * from scs_row;
+set work_mem='64kB';
+set enable_compress_sort_spill=on;
+select a, b from scs_row order by b offset 29995;
+select count(*) from (select b, lag(b) over (order by b) as prev from scs_row) s where prev >= b;
+/* the vectorized sort spills through the same tapes */
+select a, b from scs_col order by b offset 29995;
+/* random access reads compressed blocks back */
+start transaction;
+declare scs_cur scroll cursor for select a, b from scs_row order by b;
+fetch last from scs_cur;
+fetch absolute 15000 from scs_cur;
+fetch backward 2 from scs_cur;
+close scs_cur;
+commit;
+reset enable_compress_sort_spill;
+reset work_mem;
+drop schema sort_compress_spill cascade;